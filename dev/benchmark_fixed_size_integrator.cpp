@@ -0,0 +1,150 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Benchmark of the time per step of the dense output integrator with fixed-size (6- and 7-element) states, compared
+ *    to dynamic-size states, for a (perturbed) two-body problem with and without mass propagation. The state derivative
+ *    is a cheap analytic function, not a Tudat state derivative model, so the benchmark measures the cost of the
+ *    integrator internals (stages, error estimate, continuous extension), which is only a small part of the time per
+ *    step of a propagation with Tudat environment and acceleration models. The fixed-size case is timed both with a
+ *    fixed-size derivative, and with a derivative that converts the state to and from a dynamic-size vector in each
+ *    evaluation (as for a Tudat state derivative model, see createDenseOutputIntegrator). The speedups are machine
+ *    dependent and vary between runs: on a development machine, between about 1.0 and 1.7 with a fixed-size derivative,
+ *    and between about 1.0 and 1.2 with the conversion. Only requires Eigen; build and run from the repository root
+ *    with, e.g.:
+ *
+ *        g++ -O2 -std=c++14 -I/usr/include/eigen3 -Iinclude dev/benchmark_fixed_size_integrator.cpp -o benchmark
+ *        ./benchmark
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudatpy/math/denseOutputIntegrator.h"
+
+//! Gravitational parameter of the Earth
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Unnormalized J2 coefficient and equatorial radius of the Earth
+const double earthJ2 = 1.08263E-3;
+const double earthRadius = 6378137.0;
+
+//! Thrust acceleration magnitude (at the initial mass) and mass rate of the thrusting case
+const double thrustForce = 0.1;
+const double massRate = -2.0E-6;
+
+//! State derivative of a spacecraft under point-mass and J2 gravity, with (if the state has 7 elements) constant
+//! along-track thrust and mass flow
+template< typename StateType >
+StateType computeStateDerivative( const double, const StateType& state )
+{
+    StateType stateDerivative( state.rows( ) );
+    const Eigen::Vector3d position = state.template segment< 3 >( 0 );
+    const Eigen::Vector3d velocity = state.template segment< 3 >( 3 );
+
+    const double radiusSquared = position.squaredNorm( );
+    const double radius = std::sqrt( radiusSquared );
+    const double j2Factor = 1.5 * earthJ2 * earthRadius * earthRadius / radiusSquared;
+    const double zRatioSquared = position.z( ) * position.z( ) / radiusSquared;
+    Eigen::Vector3d acceleration = -earthGravitationalParameter / ( radiusSquared * radius ) * position;
+    acceleration.x( ) *= 1.0 + j2Factor * ( 1.0 - 5.0 * zRatioSquared );
+    acceleration.y( ) *= 1.0 + j2Factor * ( 1.0 - 5.0 * zRatioSquared );
+    acceleration.z( ) *= 1.0 + j2Factor * ( 3.0 - 5.0 * zRatioSquared );
+
+    stateDerivative.template segment< 3 >( 0 ) = velocity;
+    if( state.rows( ) == 7 )
+    {
+        acceleration += thrustForce / state( 6 ) * velocity.normalized( );
+        stateDerivative( 6 ) = massRate;
+    }
+    stateDerivative.template segment< 3 >( 3 ) = acceleration;
+    return stateDerivative;
+}
+
+//! Function to compute the time per (accepted or rejected) step of the dense output integrator with a given state type
+//! (converting the state to and from a dynamic-size vector in each state derivative evaluation, if requested)
+template< typename StateType >
+double computeTimePerStep( const Eigen::VectorXd& initialState,
+                           const std::vector< double >& outputEpochs,
+                           const int numberOfRepetitions,
+                           Eigen::VectorXd& finalState,
+                           const bool convertToDynamicSize = false )
+{
+    tudat::numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, double > integrator(
+                [ = ]( const double time, const StateType& state )
+    {
+        return convertToDynamicSize ?
+                    StateType( computeStateDerivative< Eigen::VectorXd >( time, Eigen::VectorXd( state ) ) ) :
+                    computeStateDerivative< StateType >( time, state );
+    }, 1.0E-12, 1.0E-6, 1.0E-3, 300.0 );
+
+    unsigned int numberOfSteps = 0;
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+    for( int i = 0; i < numberOfRepetitions; i++ )
+    {
+        integrator.integrateToOutputEpochs(
+                    0.0, StateType( initialState ), 10.0, outputEpochs,
+                    [ & ]( const unsigned int, const double, const StateType& state )
+        {
+            finalState = state;
+        } );
+        numberOfSteps += integrator.getNumberOfAcceptedSteps( ) + integrator.getNumberOfRejectedSteps( );
+    }
+    return std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime ).count( ) / numberOfSteps;
+}
+
+//! Function to run the benchmark for states of size 6 or 7
+template< int StateSize >
+void runBenchmark( const Eigen::VectorXd& initialState, const std::vector< double >& outputEpochs )
+{
+    typedef Eigen::Matrix< double, StateSize, 1 > FixedSizeStateType;
+    const int numberOfRepetitions = 20;
+    Eigen::VectorXd dynamicFinalState, fixedFinalState, convertedFinalState;
+
+    // Warm-up
+    computeTimePerStep< Eigen::VectorXd >( initialState, outputEpochs, 1, dynamicFinalState );
+    computeTimePerStep< FixedSizeStateType >( initialState, outputEpochs, 1, fixedFinalState );
+
+    const double dynamicTimePerStep = computeTimePerStep< Eigen::VectorXd >(
+                initialState, outputEpochs, numberOfRepetitions, dynamicFinalState );
+    const double fixedTimePerStep = computeTimePerStep< FixedSizeStateType >(
+                initialState, outputEpochs, numberOfRepetitions, fixedFinalState );
+    const double convertedTimePerStep = computeTimePerStep< FixedSizeStateType >(
+                initialState, outputEpochs, numberOfRepetitions, convertedFinalState, true );
+
+    std::cout << StateSize << "-element state: dynamic-size " << dynamicTimePerStep * 1.0E9 << " ns/step, fixed-size "
+              << fixedTimePerStep * 1.0E9 << " ns/step (speedup " << dynamicTimePerStep / fixedTimePerStep
+              << "), fixed-size with dynamic-size derivative " << convertedTimePerStep * 1.0E9 << " ns/step (speedup "
+              << dynamicTimePerStep / convertedTimePerStep << "), final state difference "
+              << std::max( ( dynamicFinalState - fixedFinalState ).cwiseAbs( ).maxCoeff( ),
+                           ( dynamicFinalState - convertedFinalState ).cwiseAbs( ).maxCoeff( ) ) << std::endl;
+}
+
+int main( )
+{
+    std::vector< double > outputEpochs;
+    for( int i = 1; i <= 1440; i++ )
+    {
+        outputEpochs.push_back( 60.0 * i );
+    }
+
+    const double initialRadius = earthRadius + 500.0E3;
+    const double circularVelocity = std::sqrt( earthGravitationalParameter / initialRadius );
+    Eigen::VectorXd initialState( 7 );
+    initialState << initialRadius, 0.0, 0.0, 0.0, 0.8 * circularVelocity, 0.6 * circularVelocity, 500.0;
+
+    runBenchmark< 6 >( initialState.segment( 0, 6 ), outputEpochs );
+    runBenchmark< 7 >( initialState, outputEpochs );
+
+    return 0;
+}
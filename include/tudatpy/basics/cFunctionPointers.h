@@ -0,0 +1,165 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_C_FUNCTION_POINTERS_H
+#define TUDATPY_C_FUNCTION_POINTERS_H
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+// Signatures of C functions (e.g. created with numba.cfunc or ctypes.CFUNCTYPE) that can be used for custom models.
+// Functions are passed as their address (e.g. the address attribute of a numba cfunc), together with an (optional)
+// address of user data, which is passed unmodified as the last argument. The functions are called directly, without
+// acquiring the Python global interpreter lock, so they must not call into the Python interpreter. In numba notation:
+//  - scalar function of time:       float64(float64 time, voidptr userData)
+//  - vector function of time:       void(float64 time, CPointer(float64) result, voidptr userData)
+//  - scalar function of 4 scalars:  float64(float64, float64, float64, float64, voidptr userData)
+//  - vector function of vector:     void(CPointer(float64) input, int32 inputSize, CPointer(float64) result,
+//                                        voidptr userData)
+// where result points to memory for the full output vector (e.g. 3 elements for an acceleration, 6 for a state).
+
+//! Signature of a C function returning a scalar as a function of time
+typedef double ( *CScalarFunctionOfTime )( double time, void* userData );
+
+//! Signature of a C function computing a vector as a function of time
+typedef void ( *CVectorFunctionOfTime )( double time, double* result, void* userData );
+
+//! Signature of a C function returning a scalar as a function of four scalars
+typedef double ( *CFourDimensionalScalarFunction )( double firstArgument, double secondArgument,
+                                                    double thirdArgument, double fourthArgument, void* userData );
+
+//! Signature of a C function computing a vector as a function of a vector
+typedef void ( *CVectorFunctionOfVector )( const double* input, int inputSize, double* result, void* userData );
+
+//! Function to convert the address of a C function to a function pointer of the given signature
+template< typename FunctionPointerType >
+FunctionPointerType getCFunctionPointer( const std::uintptr_t functionAddress, const std::string& functionDescription )
+{
+    if( functionAddress == 0 )
+    {
+        throw std::runtime_error( "Error when retrieving C function for " + functionDescription + ", address is null." );
+    }
+    return reinterpret_cast< FunctionPointerType >( functionAddress );
+}
+
+//! Function to create a function returning a scalar as a function of time, from the address of a C function
+/*!
+ *  Function to create a function returning a scalar as a function of time, from the address of a C function with
+ *  signature CScalarFunctionOfTime.
+ *  \param functionAddress Address of the C function
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \param functionDescription Description of the function (used in error messages)
+ *  \return Function calling the C function
+ */
+inline std::function< double( const double ) > createScalarFunctionOfTimeFromCFunction(
+        const std::uintptr_t functionAddress,
+        const std::uintptr_t userDataAddress,
+        const std::string& functionDescription )
+{
+    const CScalarFunctionOfTime cFunction =
+            getCFunctionPointer< CScalarFunctionOfTime >( functionAddress, functionDescription );
+    void* const userData = reinterpret_cast< void* >( userDataAddress );
+    return [ = ]( const double time ){ return cFunction( time, userData ); };
+}
+
+//! Function to create a function returning a fixed-size vector as a function of time, from the address of a C function
+/*!
+ *  Function to create a function returning a fixed-size vector as a function of time, from the address of a C function
+ *  with signature CVectorFunctionOfTime, which is to write VectorSize elements.
+ *  \param functionAddress Address of the C function
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \param functionDescription Description of the function (used in error messages)
+ *  \return Function calling the C function
+ */
+template< int VectorSize >
+std::function< Eigen::Matrix< double, VectorSize, 1 >( const double ) > createVectorFunctionOfTimeFromCFunction(
+        const std::uintptr_t functionAddress,
+        const std::uintptr_t userDataAddress,
+        const std::string& functionDescription )
+{
+    const CVectorFunctionOfTime cFunction =
+            getCFunctionPointer< CVectorFunctionOfTime >( functionAddress, functionDescription );
+    void* const userData = reinterpret_cast< void* >( userDataAddress );
+    return [ = ]( const double time )
+    {
+        Eigen::Matrix< double, VectorSize, 1 > result = Eigen::Matrix< double, VectorSize, 1 >::Zero( );
+        cFunction( time, result.data( ), userData );
+        return result;
+    };
+}
+
+//! Function to create a function returning a scalar as a function of four scalars, from the address of a C function
+/*!
+ *  Function to create a function returning a scalar as a function of four scalars, from the address of a C function
+ *  with signature CFourDimensionalScalarFunction.
+ *  \param functionAddress Address of the C function
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \param functionDescription Description of the function (used in error messages)
+ *  \return Function calling the C function
+ */
+inline std::function< double( const double, const double, const double, const double ) >
+createFourDimensionalScalarFunctionFromCFunction(
+        const std::uintptr_t functionAddress,
+        const std::uintptr_t userDataAddress,
+        const std::string& functionDescription )
+{
+    const CFourDimensionalScalarFunction cFunction =
+            getCFunctionPointer< CFourDimensionalScalarFunction >( functionAddress, functionDescription );
+    void* const userData = reinterpret_cast< void* >( userDataAddress );
+    return [ = ]( const double firstArgument, const double secondArgument,
+                  const double thirdArgument, const double fourthArgument )
+    {
+        return cFunction( firstArgument, secondArgument, thirdArgument, fourthArgument, userData );
+    };
+}
+
+//! Function to create a function returning a fixed-size vector as a function of a vector, from the address of a C function
+/*!
+ *  Function to create a function returning a fixed-size vector as a function of a vector (of arbitrary size), from the
+ *  address of a C function with signature CVectorFunctionOfVector, which is to write VectorSize elements.
+ *  \param functionAddress Address of the C function
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \param functionDescription Description of the function (used in error messages)
+ *  \return Function calling the C function
+ */
+template< int VectorSize >
+std::function< Eigen::Matrix< double, VectorSize, 1 >( const std::vector< double >& ) >
+createVectorFunctionOfVectorFromCFunction(
+        const std::uintptr_t functionAddress,
+        const std::uintptr_t userDataAddress,
+        const std::string& functionDescription )
+{
+    const CVectorFunctionOfVector cFunction =
+            getCFunctionPointer< CVectorFunctionOfVector >( functionAddress, functionDescription );
+    void* const userData = reinterpret_cast< void* >( userDataAddress );
+    return [ = ]( const std::vector< double >& input )
+    {
+        Eigen::Matrix< double, VectorSize, 1 > result = Eigen::Matrix< double, VectorSize, 1 >::Zero( );
+        cFunction( input.data( ), static_cast< int >( input.size( ) ), result.data( ), userData );
+        return result;
+    };
+}
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDATPY_C_FUNCTION_POINTERS_H
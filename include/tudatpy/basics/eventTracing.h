@@ -0,0 +1,266 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EVENT_TRACING_H
+#define TUDATPY_EVENT_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Single (complete) event recorded by the event tracer
+struct TraceEvent
+{
+    //! Name of the event
+    const char* name_;
+
+    //! Category of the event
+    const char* category_;
+
+    //! Start time of the event, in microseconds since tracing was started
+    double startTime_;
+
+    //! Duration of the event, in microseconds
+    double duration_;
+
+    //! Index of the thread on which the event was recorded
+    unsigned int threadIndex_;
+};
+
+//! Tracer recording scoped events (see ScopedTraceEvent) from the main phases of propagations and estimations
+/*!
+ *  Tracer recording scoped events (see ScopedTraceEvent) from the main phases of propagations and estimations, which
+ *  are written to a file in the Chrome trace-event format (which can be viewed in chrome://tracing or Perfetto) when
+ *  tracing is stopped. Events are recorded from any thread, with threads numbered in the order in which they first
+ *  record an event. When tracing is disabled, a scoped event only checks an atomic flag, so the instrumentation can be
+ *  left in place. Event names and categories must be string literals (or otherwise outlive the tracer).
+ */
+class EventTracer
+{
+public:
+
+    //! Constructor
+    EventTracer( ): isEnabled_( false ), startTimeTicks_( 0 ){ }
+
+    //! Function to start tracing, discarding any previously recorded events
+    /*!
+     *  Function to start tracing, discarding any previously recorded events
+     *  \param traceFilePath Path of the file to which the events are written when tracing is stopped
+     */
+    void startTracing( const std::string& traceFilePath )
+    {
+        std::lock_guard< std::mutex > tracerLock( tracerMutex_ );
+        if( isEnabled_ )
+        {
+            throw std::runtime_error( "Error when starting event tracing, tracing is already enabled (to " +
+                                      traceFilePath_ + ")." );
+        }
+        traceFilePath_ = traceFilePath;
+        events_.clear( );
+        threadIndices_.clear( );
+        startTimeTicks_.store( std::chrono::steady_clock::now( ).time_since_epoch( ).count( ), std::memory_order_release );
+        isEnabled_ = true;
+    }
+
+    //! Function to stop tracing, and write the recorded events to the trace file (returning the number of events)
+    unsigned int stopTracing( )
+    {
+        std::lock_guard< std::mutex > tracerLock( tracerMutex_ );
+        if( !isEnabled_ )
+        {
+            throw std::runtime_error( "Error when stopping event tracing, tracing is not enabled." );
+        }
+        isEnabled_ = false;
+
+        std::ofstream traceFile( traceFilePath_ );
+        if( !traceFile.is_open( ) )
+        {
+            throw std::runtime_error( "Error when stopping event tracing, could not open file " + traceFilePath_ + "." );
+        }
+
+        traceFile << "{\"traceEvents\":[" << std::endl;
+        for( auto threadIterator : threadIndices_ )
+        {
+            traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIterator.second
+                      << ",\"args\":{\"name\":\"thread " << threadIterator.second << "\"}}," << std::endl;
+        }
+        for( unsigned int i = 0; i < events_.size( ); i++ )
+        {
+            const TraceEvent& event = events_.at( i );
+            traceFile << "{\"name\":\"" << getEscapedString( event.name_ ) << "\",\"cat\":\""
+                      << getEscapedString( event.category_ ) << "\",\"ph\":\"X\",\"ts\":" << std::to_string( event.startTime_ )
+                      << ",\"dur\":" << std::to_string( event.duration_ ) << ",\"pid\":1,\"tid\":" << event.threadIndex_ << "}"
+                      << ( ( i + 1 < events_.size( ) ) ? "," : "" ) << std::endl;
+        }
+        traceFile << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+        const unsigned int numberOfEvents = events_.size( );
+        events_.clear( );
+        threadIndices_.clear( );
+        return numberOfEvents;
+    }
+
+    //! Function to check whether tracing is enabled
+    bool isTracingEnabled( ) const
+    {
+        return isEnabled_.load( std::memory_order_acquire );
+    }
+
+    //! Function to retrieve the current time, in microseconds since tracing was started
+    double getCurrentTime( ) const
+    {
+        const std::chrono::steady_clock::time_point startTime(
+                    std::chrono::steady_clock::duration( startTimeTicks_.load( std::memory_order_acquire ) ) );
+        return std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now( ) - startTime ).count( );
+    }
+
+    //! Function to record a complete event (ignored if tracing was stopped in the meantime)
+    void recordEvent( const char* name, const char* category, const double startTime, const double duration )
+    {
+        std::lock_guard< std::mutex > tracerLock( tracerMutex_ );
+        if( !isEnabled_ )
+        {
+            return;
+        }
+
+        const std::thread::id threadId = std::this_thread::get_id( );
+        auto threadIterator = threadIndices_.find( threadId );
+        if( threadIterator == threadIndices_.end( ) )
+        {
+            threadIterator = threadIndices_.insert( std::make_pair(
+                                                        threadId, static_cast< unsigned int >( threadIndices_.size( ) ) ) ).first;
+        }
+        events_.push_back( TraceEvent{ name, category, startTime, duration, threadIterator->second } );
+    }
+
+private:
+
+    //! Function to escape a string for use in a JSON string
+    static std::string getEscapedString( const char* rawString )
+    {
+        std::string escapedString;
+        for( const char* currentCharacter = rawString; *currentCharacter != '\0'; currentCharacter++ )
+        {
+            if( *currentCharacter == '"' || *currentCharacter == '\\' )
+            {
+                escapedString += '\\';
+            }
+            escapedString += *currentCharacter;
+        }
+        return escapedString;
+    }
+
+    //! Boolean denoting whether tracing is enabled
+    std::atomic< bool > isEnabled_;
+
+    //! Mutex protecting the recorded events and thread indices
+    std::mutex tracerMutex_;
+
+    //! Path of the file to which the events are written when tracing is stopped
+    std::string traceFilePath_;
+
+    //! Time at which tracing was started (in clock ticks), atomic as it is read by scoped events without the mutex
+    std::atomic< std::chrono::steady_clock::rep > startTimeTicks_;
+
+    //! Recorded events
+    std::vector< TraceEvent > events_;
+
+    //! Index of each thread that recorded an event
+    std::map< std::thread::id, unsigned int > threadIndices_;
+};
+
+//! Function to retrieve the (global) event tracer
+inline EventTracer& getEventTracer( )
+{
+    static EventTracer eventTracer;
+    return eventTracer;
+}
+
+//! Event recorded by the global event tracer, from its construction to its destruction
+/*!
+ *  Event recorded by the global event tracer, from its construction to its destruction. If tracing is disabled when
+ *  the event is created, the event is not recorded.
+ */
+class ScopedTraceEvent
+{
+public:
+
+    //! Constructor, starting the event
+    /*!
+     *  Constructor, starting the event
+     *  \param name Name of the event (string literal)
+     *  \param category Category of the event (string literal)
+     */
+    ScopedTraceEvent( const char* name, const char* category ):
+        name_( name ), category_( category ), isRecorded_( getEventTracer( ).isTracingEnabled( ) ),
+        startTime_( isRecorded_ ? getEventTracer( ).getCurrentTime( ) : 0.0 ){ }
+
+    //! Destructor, ending and recording the event
+    ~ScopedTraceEvent( )
+    {
+        if( isRecorded_ )
+        {
+            getEventTracer( ).recordEvent( name_, category_, startTime_, getEventTracer( ).getCurrentTime( ) - startTime_ );
+        }
+    }
+
+    ScopedTraceEvent( const ScopedTraceEvent& ) = delete;
+    ScopedTraceEvent& operator=( const ScopedTraceEvent& ) = delete;
+
+private:
+
+    //! Name of the event
+    const char* name_;
+
+    //! Category of the event
+    const char* category_;
+
+    //! Boolean denoting whether the event is recorded
+    bool isRecorded_;
+
+    //! Start time of the event, in microseconds since tracing was started
+    double startTime_;
+};
+
+//! Function to start tracing with the global event tracer (see EventTracer)
+inline void startTracing( const std::string& traceFilePath )
+{
+    getEventTracer( ).startTracing( traceFilePath );
+}
+
+//! Function to stop tracing with the global event tracer, writing the trace file (returning the number of events)
+inline unsigned int stopTracing( )
+{
+    return getEventTracer( ).stopTracing( );
+}
+
+//! Function to check whether tracing with the global event tracer is enabled
+inline bool isTracingEnabled( )
+{
+    return getEventTracer( ).isTracingEnabled( );
+}
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDATPY_EVENT_TRACING_H
@@ -0,0 +1,218 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PARALLEL_FOR_H
+#define TUDATPY_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to determine the number of threads that is to be used for a given number of independent tasks.
+/*!
+ *  Function to determine the number of threads that is to be used for a given number of independent tasks. A
+ *  non-positive requested number of threads is replaced by the hardware concurrency, and the result is never larger
+ *  than the number of tasks (and never smaller than 1).
+ *  \param requestedNumberOfThreads Number of threads requested by the user (<= 0 for hardware concurrency)
+ *  \param numberOfTasks Number of independent tasks that are to be executed
+ *  \return Number of threads that is to be used
+ */
+inline unsigned int getNumberOfThreadsToUse( const int requestedNumberOfThreads, const unsigned int numberOfTasks )
+{
+    unsigned int numberOfThreads = ( requestedNumberOfThreads > 0 ) ?
+                static_cast< unsigned int >( requestedNumberOfThreads ) : std::thread::hardware_concurrency( );
+    numberOfThreads = std::min( numberOfThreads, numberOfTasks );
+    return std::max( numberOfThreads, 1u );
+}
+
+//! Function to execute a task for each index in [0, numberOfTasks), distributed over a pool of threads.
+/*!
+ *  Function to execute a task for each index in [0, numberOfTasks), distributed over a pool of threads. Task indices
+ *  are handed out dynamically, so the order in which tasks are executed is not defined. Callers that require
+ *  reproducible output should write the result of each task to a slot that is determined by the task index only.
+ *  The task function is called as taskFunction( taskIndex, threadIndex ), with threadIndex in [0, numberOfThreads),
+ *  allowing per-thread scratch data to be used. If a task throws an exception, no new tasks are started and the first
+ *  exception is rethrown on the calling thread once all threads have finished. If only a single thread is used, all
+ *  tasks are executed (in order) on the calling thread.
+ *  \param numberOfTasks Number of tasks that are to be executed
+ *  \param numberOfThreads Number of threads that are to be used (<= 0 for hardware concurrency)
+ *  \param taskFunction Function that executes a single task
+ */
+template< typename TaskFunction >
+void parallelFor( const unsigned int numberOfTasks, const int numberOfThreads, const TaskFunction& taskFunction )
+{
+    const unsigned int numberOfThreadsToUse = getNumberOfThreadsToUse( numberOfThreads, numberOfTasks );
+    if( numberOfThreadsToUse == 1 )
+    {
+        for( unsigned int i = 0; i < numberOfTasks; i++ )
+        {
+            taskFunction( i, 0 );
+        }
+        return;
+    }
+
+    std::atomic< unsigned int > nextTaskIndex( 0 );
+    std::atomic< bool > exceptionCaught( false );
+    std::exception_ptr firstException = nullptr;
+    std::mutex exceptionMutex;
+
+    auto threadFunction = [ & ]( const unsigned int threadIndex )
+    {
+        unsigned int taskIndex;
+        while( !exceptionCaught && ( taskIndex = nextTaskIndex++ ) < numberOfTasks )
+        {
+            try
+            {
+                taskFunction( taskIndex, threadIndex );
+            }
+            catch( ... )
+            {
+                std::lock_guard< std::mutex > lock( exceptionMutex );
+                if( !exceptionCaught )
+                {
+                    firstException = std::current_exception( );
+                    exceptionCaught = true;
+                }
+            }
+        }
+    };
+
+    std::vector< std::thread > threads;
+    for( unsigned int i = 1; i < numberOfThreadsToUse; i++ )
+    {
+        threads.push_back( std::thread( threadFunction, i ) );
+    }
+    threadFunction( 0 );
+    for( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads.at( i ).join( );
+    }
+
+    if( firstException != nullptr )
+    {
+        std::rethrow_exception( firstException );
+    }
+}
+
+//! Function to split a range of elements into contiguous chunks of (at most) a given size.
+/*!
+ *  Function to split a range of elements into contiguous chunks of (at most) a given size. The chunk boundaries depend
+ *  only on the number of elements and the chunk size, not on the number of threads, so that results that are computed
+ *  per chunk and combined in chunk order are reproducible.
+ *  \param numberOfElements Total number of elements
+ *  \param chunkSize Maximum number of elements per chunk (must be larger than 0)
+ *  \return List of (start index, number of elements) per chunk
+ */
+inline std::vector< std::pair< unsigned int, unsigned int > > getChunkRanges(
+        const unsigned int numberOfElements, const unsigned int chunkSize )
+{
+    std::vector< std::pair< unsigned int, unsigned int > > chunkRanges;
+    for( unsigned int startIndex = 0; startIndex < numberOfElements; startIndex += chunkSize )
+    {
+        chunkRanges.push_back( std::make_pair( startIndex, std::min( chunkSize, numberOfElements - startIndex ) ) );
+    }
+    return chunkRanges;
+}
+
+//! Class to combine the results of tasks that are executed in parallel (see parallelFor) in task order.
+/*!
+ *  Class to combine the results of tasks that are executed in parallel (see parallelFor) in task order. Each task
+ *  passes its own result (with its task index) to addTaskResult, and the results are combined into the reduced value
+ *  in order of task index, starting from task 0, as soon as all preceding results are available. Results that arrive
+ *  out of order are kept until they can be combined. The reduced value therefore does not depend on the number of
+ *  threads or on the order in which the tasks are executed, even if the combination is not associative (such as a
+ *  floating-point sum), while only the results of tasks that are executed out of order are kept in memory.
+ */
+template< typename ResultType >
+class OrderedReduction
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param initialValue Value with which the reduced value is initialized
+     *  \param combineFunction Function that combines a task result into the reduced value (first argument)
+     */
+    OrderedReduction( const ResultType& initialValue,
+                      const std::function< void( ResultType&, const ResultType& ) >& combineFunction ):
+        reducedValue_( initialValue ), combineFunction_( combineFunction ), nextTaskIndex_( 0 ){ }
+
+    //! Function to add the result of a task, combining all results that are available in task order
+    void addTaskResult( const unsigned int taskIndex, ResultType taskResult )
+    {
+        std::lock_guard< std::mutex > lock( reductionMutex_ );
+        if( taskIndex != nextTaskIndex_ )
+        {
+            pendingTaskResults_.insert( std::make_pair( taskIndex, std::move( taskResult ) ) );
+            return;
+        }
+
+        combineFunction_( reducedValue_, taskResult );
+        nextTaskIndex_++;
+        typename std::map< unsigned int, ResultType >::iterator pendingIterator;
+        while( ( pendingIterator = pendingTaskResults_.find( nextTaskIndex_ ) ) != pendingTaskResults_.end( ) )
+        {
+            combineFunction_( reducedValue_, pendingIterator->second );
+            pendingTaskResults_.erase( pendingIterator );
+            nextTaskIndex_++;
+        }
+    }
+
+    //! Function to retrieve the reduced value, checking that the results of a given number of tasks are combined
+    const ResultType& getReducedValue( const unsigned int numberOfTasks )
+    {
+        std::lock_guard< std::mutex > lock( reductionMutex_ );
+        if( nextTaskIndex_ != numberOfTasks || pendingTaskResults_.size( ) > 0 )
+        {
+            throw std::runtime_error( "Error in ordered reduction, results of " + std::to_string( numberOfTasks ) +
+                                      " tasks requested, but " + std::to_string( nextTaskIndex_ ) +
+                                      " consecutive results are available." );
+        }
+        return reducedValue_;
+    }
+
+private:
+
+    //! Combination of the results of tasks 0 to nextTaskIndex_ - 1
+    ResultType reducedValue_;
+
+    //! Function that combines a task result into the reduced value
+    std::function< void( ResultType&, const ResultType& ) > combineFunction_;
+
+    //! Index of the next task of which the result is to be combined
+    unsigned int nextTaskIndex_;
+
+    //! Results of tasks that are not yet combined, because the result of a preceding task is not yet available
+    std::map< unsigned int, ResultType > pendingTaskResults_;
+
+    //! Mutex protecting the reduced value and pending results
+    std::mutex reductionMutex_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDATPY_PARALLEL_FOR_H
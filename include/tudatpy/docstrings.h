@@ -10,6 +10,65 @@ static inline std::string get_docstring(std::string name, int variant=0) {
         return "test";
 
 
+    } else if(name == "non_dominated_sorting" && variant==0) {
+            return R"(
+
+        Performs a non-dominated sorting of a set of objective values.
+
+        Function to sort a set of points into Pareto fronts. Points of rank 0 form the Pareto front, points of rank 1 form
+        the Pareto front once the points of rank 0 are removed, etc. Points with identical objective values do not dominate
+        each other, and receive the same rank. Dedicated algorithms are used for two and three objectives; for more
+        objectives, the sorting is performed on multiple threads. The result does not depend on the number of threads.
+
+
+        Parameters
+        ----------
+        objective_values : numpy.ndarray
+            Matrix of objective values, with one row per point and one column per objective.
+        maximize_objective : list[bool], default=[]
+            Flags denoting, per objective, whether it is to be maximized (instead of minimized). If empty, all objectives are
+            minimized.
+        number_of_threads : int, default=0
+            Number of threads that is to be used (<= 0 for the hardware concurrency).
+
+        Returns
+        -------
+        tuple[list[numpy.ndarray], numpy.ndarray]
+            Point indices (in ascending order) per front, with front i containing the points of rank i, and the rank of
+            each point.
+
+    )";
+
+
+
+    } else if(name == "non_dominated_sorting_ranks" && variant==0) {
+            return R"(
+
+        Computes the non-dominated sorting rank of each point in a set of objective values.
+
+        Function to compute the non-dominated sorting rank of each point, as in :func:`non_dominated_sorting`, without
+        grouping the points per front.
+
+
+        Parameters
+        ----------
+        objective_values : numpy.ndarray
+            Matrix of objective values, with one row per point and one column per objective.
+        maximize_objective : list[bool], default=[]
+            Flags denoting, per objective, whether it is to be maximized (instead of minimized). If empty, all objectives are
+            minimized.
+        number_of_threads : int, default=0
+            Number of threads that is to be used (<= 0 for the hardware concurrency).
+
+        Returns
+        -------
+        numpy.ndarray
+            Non-dominated sorting rank of each point.
+
+    )";
+
+
+
 
 
     } else {
@@ -9501,5 +9560,2447 @@ static inline std::string get_docstring(std::string name, int variant=0) {
 
 
 
+
+    
+namespace numerical_simulation {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "SingleArcVariationalSimulator.state_transition_interface") {
+         return R"(
+
+        **read-only**
+
+        Interface that provides the state transition and sensitivity matrices at arbitrary epochs, by interpolation of the
+        solution of the variational equations.
+
+        :type: CombinedStateTransitionAndSensitivityMatrixInterface
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory") {
+         return R"(
+
+        Class for the compact storage of the solution of the single-arc variational equations.
+
+        Class that stores the state transition and sensitivity matrices of a :class:`SingleArcVariationalSimulator` on a
+        user-defined output grid (by interpolation of the full solution), contiguously, and optionally with the sensitivity
+        matrix in single precision. The compact history is interpolated by a state transition interface that can be used
+        wherever the interface of the variational equations solver is used. The memory used by the full and compact histories,
+        and the error of the compact history (at the epochs of the full solution inside the output grid), are computed on
+        creation.
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory.ctor" && variant==0) {
+            return R"(
+
+        Constructor.
+
+        Constructor, creating the compact history from the current solution of a variational equations solver. By default,
+        the full solution is released afterwards: the state transition and sensitivity matrix histories of the solver are
+        cleared, and its state transition interface is set to interpolate the compact history.
+
+
+        Parameters
+        ----------
+        variational_solver : SingleArcVariationalSimulator
+            Solver from which the full solution of the variational equations is taken.
+        output_times : List[ float ]
+            Epochs at which the solution is to be stored (must be strictly increasing).
+        single_precision_sensitivity : bool, default=True
+            Boolean denoting whether the sensitivity matrix is stored in single precision.
+        interpolation_order : int, default=8
+            Number of nodes used by the Lagrange interpolation of the compact history.
+        clear_full_solution : bool, default=True
+            Boolean denoting whether the full solution of the solver is released once the compact history is created.
+
+    )";
+
+
+
+    } else if(name == "CompactVariationalHistory.state_transition_interface") {
+         return R"(
+
+        **read-only**
+
+        Interface that provides the state transition and sensitivity matrices at arbitrary epochs, by interpolation of the
+        compact history.
+
+        :type: CombinedStateTransitionAndSensitivityMatrixInterface
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory.full_storage_size") {
+         return R"(
+
+        **read-only**
+
+        Memory (in bytes) used by the matrices of the full solution of the variational equations.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory.compact_storage_size") {
+         return R"(
+
+        **read-only**
+
+        Memory (in bytes) used by the matrices of the compact history.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory.maximum_state_transition_error") {
+         return R"(
+
+        **read-only**
+
+        Maximum absolute error of the entries of the compact state transition matrix history, w.r.t. the full solution.
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "CompactVariationalHistory.maximum_sensitivity_error") {
+         return R"(
+
+        **read-only**
+
+        Maximum absolute error of the entries of the compact sensitivity matrix history, w.r.t. the full solution.
+
+        :type: float
+
+     )";
+
+
+    } else if(name == "ReducedSingleArcVariationalSimulator") {
+         return R"(
+
+        Class for the single-arc variational equations, integrating only the sensitivity to dynamical parameters.
+
+        Derived class of :class:`SingleArcVariationalSimulator` that only integrates the sensitivity to the estimated
+        parameters that influence the dynamics (e.g. initial states and gravitational parameters, but not observation biases or
+        ground station positions). The variational equations are solved for this reduced parameter set, while the
+        :attr:`full_state_transition_interface` provides the state transition and sensitivity matrices for the full parameter
+        set, with zero sensitivity to the removed parameters.
+
+     )";
+
+
+
+    } else if(name == "ReducedSingleArcVariationalSimulator.ctor" && variant==0) {
+            return R"(
+
+        Constructor.
+
+        Constructor, with the same arguments as the constructor of :class:`SingleArcVariationalSimulator`, where the
+        estimated parameters are the full parameter set.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            Object consolidating all bodies and environment models that constitute the physical environment.
+        integrator_settings : IntegratorSettings
+            Integrator settings for the propagation of the dynamical and variational equations.
+        propagator_settings : PropagatorSettings
+            Settings for the dynamical model of the propagation.
+        estimated_parameters : EstimatableParameterSet
+            Full set of estimated parameters, from which the dynamical parameters are selected.
+        integrate_equations_concurrently : bool, default=True
+            Boolean denoting whether the dynamical and variational equations are integrated concurrently.
+        variational_only_integrator_settings : IntegratorSettings, default=None
+            Integrator settings for the variational equations, if they are not integrated concurrently.
+        clear_numerical_solutions : bool, default=False
+            Boolean denoting whether the numerical solutions are cleared after the interpolators are created.
+        integrate_on_creation : bool, default=True
+            Boolean denoting whether the equations are integrated upon creation of the object.
+        set_integrated_result : bool, default=False
+            Boolean denoting whether the integrated result is set in the environment.
+
+    )";
+
+
+
+    } else if(name == "ReducedSingleArcVariationalSimulator.full_parameter_vector") {
+         return R"(
+
+        Values of the full set of estimated parameters. Setting the vector re-integrates the (reduced) variational equations.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+
+    } else if(name == "ReducedSingleArcVariationalSimulator.full_state_transition_interface") {
+         return R"(
+
+        **read-only**
+
+        Interface that provides the state transition and sensitivity matrices for the full parameter set, with zero sensitivity
+        to the parameters that do not influence the dynamics.
+
+        :type: CombinedStateTransitionAndSensitivityMatrixInterface
+
+     )";
+
+
+
+    } else if(name == "ReducedSingleArcVariationalSimulator.number_of_removed_parameters") {
+         return R"(
+
+        **read-only**
+
+        Number of estimated parameters for which the sensitivity is not integrated.
+
+        :type: int
+
+     )";
+
+
+    } else if(name == "Estimator.compute_residuals_and_design_matrix" && variant==0) {
+            return R"(
+
+        Function to compute the residuals and design matrix of a set of observations for the current parameters.
+
+        Function to compute the residuals and (unnormalized) design matrix of a set of observations for the current parameter
+        values, with the dynamics and variational equations as last propagated (the dynamics is not re-propagated). The rows
+        are ordered as the concatenated observation vector of the observation collection. The partials are computed in
+        parallel, in chunks of observations, as in :meth:`perform_estimation`. The GIL is released during the computation.
+
+
+        Parameters
+        ----------
+        observations : ObservationCollection
+            Observations for which the residuals and partials are to be computed.
+        number_of_threads : int, default=1
+            Number of threads used to compute the partials (<= 0 for the hardware concurrency).
+        observation_chunk_size : int, default=10000
+            Maximum number of observations for which the partials are computed at once.
+
+        Returns
+        -------
+        Tuple[ numpy.ndarray, numpy.ndarray ]
+            Residual vector and design matrix.
+
+    )";
+
+
+    } else if(name == "SingleArcSimulator.profile_state_derivative" && variant==0) {
+            return R"(
+
+        Function to profile the computational cost of the components of the state derivative.
+
+        Function to profile the computational cost of the components of the state derivative of the propagation. The
+        equations of motion are integrated again, from the first to the last epoch of the saved state history, with the
+        integrator settings of this simulator, using an instrumented state derivative function; the saved results of this
+        simulator are not modified. Each state derivative evaluation is timed, after which each acceleration model, the
+        ephemeris and rotation model of each body involved in the accelerations (except the propagated bodies), and the
+        flight conditions and atmosphere of each propagated body are re-evaluated and timed, at the same time and in the same
+        environment. The given dependent variables are evaluated and timed after each step. All numbers of calls are those
+        measured during the profiled propagation. Models that cache intermediate results may be faster on re-evaluation than
+        within the state derivative, the timing of which includes all models and the environment update.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies used by this simulator.
+        dependent_variables : List[ SingleDependentVariableSaveSettings ], default=[]
+            Settings of the dependent variables that are to be profiled.
+
+        Returns
+        -------
+        StateDerivativeProfile
+            Profile of the components of the state derivative.
+
+    )";
+
+
+    } else if(name == "start_tracing" && variant==0) {
+            return R"(
+
+        Function to start tracing the main phases of propagations and estimations.
+
+        Function to start recording events for the main phases of propagations and estimations (creation and propagation of
+        single-arc simulators, estimator creation, estimation iterations and their propagation, residual and partial
+        computation and least-squares solution, and observation simulation), from any thread. The events are written to the
+        trace file when tracing is stopped, in the Chrome trace-event format, which can be viewed in ``chrome://tracing`` or
+        Perfetto. Any previously recorded events are discarded. When tracing is disabled, the instrumentation has a negligible
+        cost.
+
+
+        Parameters
+        ----------
+        trace_file_path : str
+            Path of the file to which the events are written when tracing is stopped.
+
+    )";
+
+
+
+    } else if(name == "stop_tracing" && variant==0) {
+            return R"(
+
+        Function to stop tracing, and write the recorded events to the trace file.
+
+        Function to stop tracing, and write the events recorded since
+        :func:`~tudatpy.numerical_simulation.start_tracing` to the trace file, as a JSON object with a ``traceEvents`` list
+        holding a ``thread_name`` metadata event for each thread that recorded an event, and a complete event (``"ph": "X"``,
+        with start time ``ts`` and duration ``dur`` in microseconds since tracing was started) for each traced phase.
+
+        Returns
+        -------
+        int
+            Number of recorded (complete) events.
+
+    )";
+
+
+
+    } else if(name == "is_tracing_enabled" && variant==0) {
+            return R"(
+
+        Function to check whether tracing is enabled.
+
+        Returns
+        -------
+        bool
+            True if tracing was started and not yet stopped.
+
+    )";
+
+
+    } else if(name == "SingleArcSimulator.resume_from_checkpoint" && variant==0) {
+            return R"(
+
+        Function to resume an interrupted propagation from a checkpoint.
+
+        Function to resume the integration of the equations of motion from a checkpoint, written by an interrupted propagation
+        with the dense output integrator (see the ``checkpoint_file_path`` of
+        :func:`~tudatpy.numerical_simulation.propagation_setup.integrator.runge_kutta_dense_output`). The integration
+        continues exactly as the interrupted propagation would have, from the last complete checkpoint; a checkpoint that was
+        only partially written when the propagation was interrupted is ignored. The simulator must have been created with the
+        same settings as the interrupted propagation, without integrating the equations of motion
+        (``are_equations_of_motion_to_be_integrated=False``). During the resumed integration, checkpoints are written as
+        defined in the integrator settings.
+
+
+        Parameters
+        ----------
+        checkpoint_file_path : str, default=""
+            Path of the checkpoint file (if empty, the checkpoint file of the integrator settings).
+
+    )";
+
+
+
+
+
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+
+    
+namespace estimation {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "simulate_observations_parallel" && variant==0) {
+            return R"(
+
+        Function to simulate observations on multiple threads.
+
+        Function to simulate observations from a list of (tabulated) observation simulation settings, distributing the epochs
+        over a pool of threads in chunks. Each thread uses its own observation simulators, created from the observation model
+        settings. The noise is added after all chunks are simulated, in the same order as in :func:`simulate_observations`,
+        such that the resulting observation collection is identical for any number of threads. The environment models used by
+        the observation models are evaluated concurrently: calls to Spice ephemerides are serialized, and the observations are
+        simulated on a single thread if any body has a Spice rotation model.
+
+
+        Parameters
+        ----------
+        simulation_settings : List[ TabulatedObservationSimulationSettings ]
+            List of settings for the observations that are to be simulated.
+        observation_settings : List[ ObservationSettings ]
+            List of settings for the observation models that are used to simulate the observations.
+        bodies : SystemOfBodies
+            Object consolidating all bodies and environment models that constitute the physical environment.
+        number_of_threads : int, default=0
+            Number of threads that is to be used (<= 0 for the hardware concurrency).
+        epochs_per_chunk : int, default=1000
+            Maximum number of epochs that is simulated in a single task.
+
+        Returns
+        -------
+        ObservationCollection
+            Object collecting all simulated observations.
+
+    )";
+
+
+    } else if(name == "PodOutput.computation_time_per_phase") {
+         return R"(
+
+        **read-only**
+
+        Wall-clock time (in seconds) spent per phase of the estimation, summed over all iterations. The keys are the names of
+        the phases (such as ``propagation``, ``partials`` and ``solution``). When the estimation is performed by the Tudat orbit
+        determination manager, only the ``total`` time is available.
+
+        :type: dict[str, float]
+
+     )";
+
+
+    } else if(name == "CombinedStateTransitionAndSensitivityMatrixInterface.state_transition_sensitivity_at_epochs" && variant==0) {
+            return R"(
+
+        Function to retrieve the concatenated state transition and sensitivity matrices at a list of epochs.
+
+        Function to retrieve the concatenated state transition and sensitivity matrices at a list of epochs, as a single
+        three-dimensional array, without creating a list of matrices. The matrices are retrieved with the GIL released.
+
+
+        Parameters
+        ----------
+        times : List[ float ]
+            Epochs at which the matrices are to be retrieved.
+        full_parameter_vector : bool, default=False
+            Boolean denoting whether the matrices are to be retrieved for the full parameter vector (as
+            :meth:`full_state_transition_sensitivity_at_epoch`), instead of the parameters of the variational equations (as
+            :meth:`state_transition_sensitivity_at_epoch`).
+
+        Returns
+        -------
+        numpy.ndarray
+            Array of size (number of epochs x number of states x number of parameters), with the matrix at each epoch.
+
+    )";
+
+
+
+    } else if(name == "propagate_covariance_array" && variant==0) {
+            return R"(
+
+        Function to propagate a covariance matrix to a list of epochs, as a single array.
+
+        Function to propagate the covariance of the estimated parameters to the covariance of the propagated states at a list
+        of epochs, as :func:`propagate_covariance`, writing the result into a single three-dimensional array instead of a
+        dictionary of matrices. The epochs are processed in chunks on a number of threads, with the GIL released.
+
+
+        Parameters
+        ----------
+        initial_covariance : numpy.ndarray
+            Covariance of the full parameter vector at the initial epoch.
+        state_transition_interface : CombinedStateTransitionAndSensitivityMatrixInterface
+            Interface from which the state transition and sensitivity matrices are retrieved.
+        output_times : List[ float ]
+            Epochs at which the result is to be computed.
+        number_of_threads : int, default=0
+            Number of threads that is to be used (<= 0 for the hardware concurrency).
+
+        Returns
+        -------
+        numpy.ndarray
+            Array of size (number of epochs x number of states x number of states), with the covariance at each epoch.
+
+    )";
+
+
+
+    } else if(name == "propagate_formal_errors_array" && variant==0) {
+            return R"(
+
+        Function to propagate the formal errors to a list of epochs, as a single array.
+
+        Function to propagate the covariance of the estimated parameters to the formal errors of the propagated states at a
+        list of epochs, as :func:`propagate_formal_errors`, writing the result into a single two-dimensional array instead of
+        a dictionary of vectors. Only the diagonal of the propagated covariance is computed. The epochs are processed in chunks
+        on a number of threads, with the GIL released.
+
+
+        Parameters
+        ----------
+        initial_covariance : numpy.ndarray
+            Covariance of the full parameter vector at the initial epoch.
+        state_transition_interface : CombinedStateTransitionAndSensitivityMatrixInterface
+            Interface from which the state transition and sensitivity matrices are retrieved.
+        output_times : List[ float ]
+            Epochs at which the result is to be computed.
+        number_of_threads : int, default=0
+            Number of threads that is to be used (<= 0 for the hardware concurrency).
+
+        Returns
+        -------
+        numpy.ndarray
+            Array of size (number of epochs x number of states), with the formal errors at each epoch.
+
+    )";
+
+
+    } else if(name == "ObservationCollection.concatenated_observations") {
+         return R"(
+
+        **read-only**
+
+        Vector with all observations of the collection, concatenated (sorted by observable type and link ends). The vector is
+        returned without copying it, and remains valid as long as the collection exists.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+
+    } else if(name == "ObservationCollection.from_arrays" && variant==0) {
+            return R"(
+
+        Function to create an observation collection, for a single observable and set of link ends, from arrays.
+
+
+        Parameters
+        ----------
+        observable_type : ObservableType
+            Observable type of the observations.
+        link_ends : Dict[ LinkEndType, Tuple[str, str] ]
+            Link ends of the observations.
+        times : numpy.ndarray
+            Epochs of the observations (size N).
+        values : numpy.ndarray
+            Values of the observations (size N x observable size).
+        reference_link_end : LinkEndType, default=receiver
+            Link end at which the observation epochs are defined.
+
+        Returns
+        -------
+        ObservationCollection
+            Observation collection with a single set of observations.
+
+    )";
+
+
+
+    } else if(name == "ObservationCollection.observations" && variant==0) {
+            return R"(
+
+        Function to retrieve the observations of a single observable (and, optionally, a single set of link ends).
+
+        Function to retrieve the observations of a single observable (and, optionally, a single set of link ends), as a
+        segment of the concatenated observation vector. The segment is returned without copying it, and remains valid as long
+        as the collection exists.
+
+
+        Parameters
+        ----------
+        observable_type : ObservableType
+            Observable type of which the observations are to be retrieved.
+        link_ends : Dict[ LinkEndType, Tuple[str, str] ], default={}
+            Link ends of which the observations are to be retrieved (all link ends of the observable if empty).
+
+        Returns
+        -------
+        numpy.ndarray
+            Concatenated observations of the observable (and link ends).
+
+    )";
+
+
+
+    } else if(name == "ObservationCollection.observation_times" && variant==0) {
+            return R"(
+
+        Function to retrieve the epochs of the observations of a single observable (and, optionally, a single set of link ends).
+
+        Function to retrieve the epochs of the observations of a single observable (and, optionally, a single set of link ends),
+        with one entry for each entry of :meth:`observations` (an epoch is repeated for each component of a multi-dimensional
+        observable). The epochs are returned as a copy.
+
+
+        Parameters
+        ----------
+        observable_type : ObservableType
+            Observable type of which the observation epochs are to be retrieved.
+        link_ends : Dict[ LinkEndType, Tuple[str, str] ], default={}
+            Link ends of which the observation epochs are to be retrieved (all link ends of the observable if empty).
+
+        Returns
+        -------
+        numpy.ndarray
+            Epochs of the concatenated observations of the observable (and link ends).
+
+    )";
+
+
+
+    } else if(name == "ObservationCollection.save" && variant==0) {
+            return R"(
+
+        Function to save the observation collection to a binary file.
+
+        Function to save the observation collection to a binary file, storing for each observation set its observable type,
+        link ends, reference link end, epochs and observations (in native byte order). Observation dependent variables are not
+        saved.
+
+
+        Parameters
+        ----------
+        file_name : str
+            Name of the file to which the collection is saved.
+
+    )";
+
+
+
+    } else if(name == "ObservationCollection.load" && variant==0) {
+            return R"(
+
+        Function to load an observation collection from a binary file.
+
+        Function to load an observation collection from a binary file created with :meth:`save`. The contents of the file
+        are checked before they are used, such that an error is raised for a corrupt, truncated or incompatible file.
+
+
+        Parameters
+        ----------
+        file_name : str
+            Name of the file from which the collection is loaded.
+
+        Returns
+        -------
+        ObservationCollection
+            Observation collection that was loaded from the file.
+
+    )";
+
+
+
+    } else if(name == "merge_observation_collections" && variant==0) {
+            return R"(
+
+        Function to merge a list of observation collections into a single collection.
+
+        Function to merge a list of observation collections into a single collection. The observation sets of the collections
+        are not copied, and are added to the merged collection in the order of the list.
+
+
+        Parameters
+        ----------
+        observation_collections : List[ ObservationCollection ]
+            Observation collections that are to be merged.
+
+        Returns
+        -------
+        ObservationCollection
+            Collection with the observation sets of all collections.
+
+    )";
+
+
+    } else if(name == "PodOutput.number_of_propagations") {
+         return R"(
+
+        **read-only**
+
+        Number of iterations in which the dynamics (and variational equations) were propagated (-1 if the estimation was
+        performed by the Tudat orbit determination manager, which does not count them).
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "PodOutput.number_of_linear_updates") {
+         return R"(
+
+        **read-only**
+
+        Number of iterations in which the propagated states were updated linearly, using the variational equations of the last
+        propagation, instead of re-propagating the dynamics (see the ``linear_update_threshold`` of
+        :meth:`PodInput.define_estimation_settings`).
+
+        :type: int
+
+     )";
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis") {
+         return R"(
+
+        Monte Carlo covariance analysis of an estimation, linearized about the current parameter values.
+
+        Monte Carlo covariance analysis of an estimation, linearized about the current parameter values (taken as the true
+        parameters). The residuals and design matrix of the observations are computed once, and the normal equations are
+        factorized once. Each sample then perturbs the residuals with Gaussian observation noise (with the standard deviation
+        implied by the observation weights) and, optionally, a constant bias per observation set, perturbs the a priori
+        parameter values with a sample from the a priori covariance, and solves the linearized estimation. Only the running
+        statistics of the estimation errors and post-fit residual RMS are kept. The samples are processed in parallel, and the
+        results do not depend on the number of threads.
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.ctor" && variant==0) {
+            return R"(
+
+        Constructor, computing the residuals and design matrix of the observations for the current parameter values, and
+        factorizing the normal equations. The GIL is released during the computation.
+
+
+        Parameters
+        ----------
+        estimator : Estimator
+            Estimator, with the dynamics propagated for the true parameter values.
+        estimation_input : PodInput
+            Input of the estimation, defining the observations, weights and inverse a priori covariance.
+        number_of_threads : int, default=1
+            Number of threads used for the partials and samples (<= 0 for the hardware concurrency).
+
+    )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.run_samples" && variant==0) {
+            return R"(
+
+        Function to process a number of samples, adding their results to the statistics.
+
+        Function to process a number of samples, adding their results to the statistics. Repeated calls continue the sequence
+        of samples (use a different seed, or call :meth:`reset_statistics`, to start a new sequence). The GIL is released during
+        the computation.
+
+
+        Parameters
+        ----------
+        number_of_samples : int
+            Number of samples to process.
+        seed : int
+            Seed of the random number generator.
+        perturb_apriori_values : bool, default=False
+            Boolean denoting whether the a priori parameter values are perturbed with a sample from the a priori covariance
+            (requires a positive definite inverse a priori covariance).
+        observation_bias_standard_deviation : float, default=0.0
+            Standard deviation of the constant (unestimated) bias that is added to each observation set (0 for no bias).
+
+    )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.reset_statistics" && variant==0) {
+            return R"(
+
+        Function to reset the statistics, and restart the sequence of samples.
+
+    )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.number_of_samples") {
+         return R"(
+
+        **read-only**
+
+        Number of samples processed since creation, or the last call to :meth:`reset_statistics`.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.mean_estimation_error") {
+         return R"(
+
+        **read-only**
+
+        Mean of the estimation error (estimated minus true parameters) over the samples.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.estimation_error_covariance") {
+         return R"(
+
+        **read-only**
+
+        Sample covariance of the estimation error.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.formal_covariance") {
+         return R"(
+
+        **read-only**
+
+        Formal covariance of the linearized estimation, for comparison with the sample covariance
+        of the estimation error.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.mean_residual_rms") {
+         return R"(
+
+        **read-only**
+
+        Mean of the post-fit residual RMS over the samples.
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.residual_rms_standard_deviation") {
+         return R"(
+
+        **read-only**
+
+        Standard deviation of the post-fit residual RMS over the samples.
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "MonteCarloCovarianceAnalysis.design_matrix") {
+         return R"(
+
+        **read-only**
+
+        Design matrix (unnormalized) of the observations, for the true parameter values.
+
+        :type: numpy.ndarray
+
+     )";
+
+
+    } else if(name == "EstimationSolverTypes") {
+         return R"(
+
+        Enumeration of available solvers for the least-squares problem in each iteration of the estimation.
+
+        Enumeration of the solvers for the (linearized) least-squares problem in each iteration of the estimation:
+        ``normal_equations_solver`` (Cholesky decomposition of the normal equations), ``householder_qr_solver`` (Householder QR
+        decomposition of the full weighted design matrix, requiring the design matrix to be saved), and
+        ``square_root_information_filter_solver`` (triangularizing the observations one chunk at a time). The orthogonal
+        factorizations avoid squaring the condition number of the design matrix, at a higher computational cost.
+
+     )";
+
+
+
+    } else if(name == "PodInput.define_estimation_settings" && variant==0) {
+            return R"(
+
+        Function to define the settings of the estimation.
+
+        Function to define the settings of the estimation. When the number of threads, observation chunk size, linear update
+        threshold and solver type are at their default values, and the design matrix is saved, the estimation is performed by
+        the Tudat orbit determination manager. Otherwise, the partials are computed in parallel, in chunks of observations, and
+        (unless it is saved) the design matrix is never built in full.
+
+
+        Parameters
+        ----------
+        reintegrate_equations_on_first_iteration : bool, default=True
+            Boolean denoting whether the dynamics and variational equations are to be re-propagated on the first iteration.
+        reintegrate_variational_equations : bool, default=True
+            Boolean denoting whether the variational equations are to be re-propagated in each iteration (or only the
+            dynamics).
+        save_design_matrix : bool, default=True
+            Boolean denoting whether the design matrix is to be saved in the estimation output.
+        print_output_to_terminal : bool, default=True
+            Boolean denoting whether the progress of the estimation is to be printed to the terminal.
+        save_residuals_and_parameters_per_iteration : bool, default=True
+            Boolean denoting whether the residuals and parameters of each iteration are to be saved.
+        save_state_history_per_iteration : bool, default=False
+            Boolean denoting whether the propagated state history of each iteration is to be saved.
+        number_of_threads : int, default=1
+            Number of threads used to compute the observation partials (<= 0 for the hardware concurrency).
+        observation_chunk_size : int, default=10000
+            Maximum number of observations for which the partials are computed at once. If the design matrix is not saved, the
+            memory used by the partials is bounded by this number times the number of parameters.
+        linear_update_threshold : float, default=0.0
+            Maximum predicted position correction (in m) for which the propagated states are updated linearly, using the
+            variational equations of the last propagation, instead of re-propagating the dynamics (<= 0 to always
+            re-propagate).
+
+    )";
+
+
+
+    } else if(name == "PodInput.solver_type") {
+         return R"(
+
+        Solver for the least-squares problem in each iteration of the estimation (default ``normal_equations_solver``).
+
+        :type: EstimationSolverTypes
+
+     )";
+
+
+
+
+
+
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace estimation_setup {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+
+    
+namespace observation {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "ObservationNoiseModelTypes") {
+         return R"(
+
+        Enumeration of available observation noise models.
+
+        Enumeration of the native observation noise models, which generate reproducible noise independently of the order in
+        which (and the thread on which) the observations are simulated.
+
+     )";
+
+
+
+    } else if(name == "ObservationNoiseModelSettings") {
+         return R"(
+
+        Base class to define settings for an observation noise model.
+
+        Base class to define settings for a native observation noise model. Instances of this class are created through
+        the factory functions of this module (e.g. :func:`gaussian_noise`), and are added to observation simulation settings
+        with :func:`add_noise_models_to_settings`. The noise is generated from counter-based random numbers, with a separate
+        random number stream for each observable, set of link ends and noise model, such that the noise of each observation
+        does not depend on the order in which (or the thread on which) the observations are simulated.
+
+     )";
+
+
+
+    } else if(name == "gaussian_noise" && variant==0) {
+            return R"(
+
+        Creates the settings for white Gaussian observation noise.
+
+
+        Parameters
+        ----------
+        standard_deviation : float
+            Standard deviation of the noise.
+        mean : float, default=0.0
+            Mean of the noise.
+        seed : int, default=0
+            Seed of the random number generator.
+
+        Returns
+        -------
+        ObservationNoiseModelSettings
+            Settings for the noise model.
+
+    )";
+
+
+
+    } else if(name == "uniform_noise" && variant==0) {
+            return R"(
+
+        Creates the settings for white, uniformly distributed observation noise.
+
+
+        Parameters
+        ----------
+        lower_bound : float
+            Lower bound of the noise.
+        upper_bound : float
+            Upper bound of the noise.
+        seed : int, default=0
+            Seed of the random number generator.
+
+        Returns
+        -------
+        ObservationNoiseModelSettings
+            Settings for the noise model.
+
+    )";
+
+
+
+    } else if(name == "autoregressive_noise" && variant==0) {
+            return R"(
+
+        Creates the settings for colored observation noise, modelled as a first-order autoregressive process.
+
+        Factory function to create the settings for colored observation noise, modelled as a first-order autoregressive
+        (Gauss-Markov) process with a given steady-state standard deviation and correlation time. For observation epochs
+        :math:`t_{k}`, the noise is computed as :math:`x_{k}=\phi_{k}x_{k-1}+\sigma\sqrt{1-\phi_{k}^{2}}w_{k}`, with
+        :math:`\phi_{k}=\exp(-(t_{k}-t_{k-1})/\tau)` and :math:`w_{k}` white Gaussian noise with unit variance. This noise
+        model can only be added to tabulated observation simulation settings.
+
+
+        Parameters
+        ----------
+        standard_deviation : float
+            Steady-state standard deviation :math:`\sigma` of the noise.
+        correlation_time : float
+            Correlation time :math:`\tau` of the noise.
+        seed : int, default=0
+            Seed of the random number generator.
+
+        Returns
+        -------
+        ObservationNoiseModelSettings
+            Settings for the noise model.
+
+    )";
+
+
+
+    } else if(name == "bias_drift_noise" && variant==0) {
+            return R"(
+
+        Creates the settings for an observation bias that drifts linearly in time.
+
+        Factory function to create the settings for an observation bias that drifts linearly in time, computed as
+        :math:`b+d(t-t_{0})`. The bias :math:`b` and drift :math:`d` are drawn once for each observable, set of link ends and
+        observable entry, from zero-mean Gaussian distributions.
+
+
+        Parameters
+        ----------
+        bias_standard_deviation : float
+            Standard deviation of the bias :math:`b`.
+        drift_standard_deviation : float
+            Standard deviation of the drift :math:`d` (per unit time).
+        reference_epoch : float, default=0.0
+            Reference epoch :math:`t_{0}` of the drift.
+        seed : int, default=0
+            Seed of the random number generator.
+
+        Returns
+        -------
+        ObservationNoiseModelSettings
+            Settings for the noise model.
+
+    )";
+
+
+
+    } else if(name == "add_noise_models_to_settings" && variant==0) {
+            return R"(
+
+        Function for adding native noise models to existing observation simulation settings.
+
+        Function for adding noise models to a list of existing observation simulation settings. The noise of all models in
+        the list is summed, and replaces any existing noise function of the settings. Noise models that are combined on a
+        single observable (with the same seed) draw independent random numbers.
+
+
+        Parameters
+        ----------
+        observation_simulation_settings : List[ ObservationSimulationSettings ]
+            Observation simulation settings to which the noise is to be added.
+        noise_model_settings : List[ ObservationNoiseModelSettings ]
+            Settings of the noise models that are to be added.
+
+    )";
+
+
+    } else if(name == "compute_visibility_windows" && variant==0) {
+            return R"(
+
+        Function to compute the visibility windows of a list of links.
+
+        Function to compute the intervals in which a list of links is viable, according to a list of observation viability
+        settings (e.g. :func:`elevation_angle_viability`, :func:`body_avoidance_viability`, :func:`body_occultation_viability`).
+        The viability margin of each link (the smallest margin of all applicable viability settings, positive for a viable
+        link) is evaluated geometrically, without light-time corrections, on a grid of epochs. Each change in viability between
+        two grid epochs is located with a root finder. Changes of viability that occur between two grid epochs, and revert
+        before the next grid epoch, are not detected, so the grid step should be smaller than the shortest window (or gap).
+
+
+        Parameters
+        ----------
+        link_ends_list : List[ Dict[ LinkEndType, Tuple[str, str] ] ]
+            List of link ends for which the visibility windows are to be computed.
+        viability_settings : List[ ObservationViabilitySettings ]
+            Observation viability settings that are to be applied to the links.
+        bodies : SystemOfBodies
+            System of bodies defining the environment.
+        start_time : float
+            Start time of the interval in which the windows are computed.
+        end_time : float
+            End time of the interval in which the windows are computed.
+        grid_step : float
+            Step size of the grid on which the viability is evaluated.
+        root_finder_settings : RootFinderSettings, default=None
+            Settings of the root finder with which the window edges are located (bisection, with a tolerance of 1 ms, if None).
+
+        Returns
+        -------
+        List[ List[ Tuple[float, float] ] ]
+            List (per link) of the visibility windows, each given by its start and end time. Windows that are open at the start
+            (end) time start (end) at the start (end) time.
+
+    )";
+
+
+
+    } else if(name == "tabulated_simulation_settings_in_windows" && variant==0) {
+            return R"(
+
+        Function to create tabulated observation simulation settings, with the epochs sampled in visibility windows.
+
+        Function to create tabulated observation simulation settings (see :func:`tabulated_simulation_settings`) for a list of
+        links, with the observation epochs sampled at a fixed interval inside the visibility windows of each link (typically
+        computed with :func:`compute_visibility_windows`). The epochs are aligned to a reference epoch, such that they are the
+        same for all windows and links.
+
+
+        Parameters
+        ----------
+        observable_type : ObservableType
+            Observable type of the observations that are to be simulated.
+        link_ends_list : List[ Dict[ LinkEndType, Tuple[str, str] ] ]
+            List of link ends for which the observations are to be simulated.
+        visibility_windows : List[ List[ Tuple[float, float] ] ]
+            List (per link) of the windows in which the observation epochs are sampled.
+        sampling_interval : float
+            Interval between two subsequent observation epochs.
+        reference_epoch : float, default=0.0
+            Epoch to which the observation epochs are aligned.
+        reference_link_end_type : LinkEndType, default=receiver
+            Link end at which the observation epochs are defined.
+        viability_settings : List[ ObservationViabilitySettings ], default=[]
+            Observation viability settings that are applied when the observations are simulated.
+
+        Returns
+        -------
+        List[ TabulatedObservationSimulationSettings ]
+            List (per link) of the observation simulation settings.
+
+    )";
+
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+}
+
+
+
+
+
+    
+namespace environment {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "CachedEphemeris") {
+         return R"(
+
+        Ephemeris that stores the states computed by another ephemeris.
+
+        Ephemeris that stores the states computed by another ephemeris, and returns the stored state when it is requested again
+        at the exact same epoch (e.g. by observation models with common link ends). Since the stored states are returned
+        unmodified, results are identical to those obtained without the cache. The cache may be used from multiple threads, and
+        is cleared when it reaches its maximum number of entries. Instances of this class are created with
+        :func:`add_ephemeris_caches`.
+
+     )";
+
+
+
+    } else if(name == "CachedEphemeris.original_ephemeris") {
+         return R"(
+
+        **read-only**
+
+        Ephemeris from which the states are computed (a Spice ephemeris is wrapped in an ephemeris that serializes the calls to
+        Spice from multiple threads).
+
+        :type: Ephemeris
+
+     )";
+
+
+
+    } else if(name == "CachedEphemeris.number_of_hits") {
+         return R"(
+
+        **read-only**
+
+        Number of state requests that were served from the cache (since creation, or the last call to :meth:`clear`).
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "CachedEphemeris.number_of_misses") {
+         return R"(
+
+        **read-only**
+
+        Number of state requests for which the state had to be computed (since creation, or the last call to :meth:`clear`).
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "CachedEphemeris.hit_rate") {
+         return R"(
+
+        **read-only**
+
+        Fraction of the state requests that were served from the cache (0 if no state has been requested).
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "CachedEphemeris.clear" && variant==0) {
+            return R"(
+
+        Function to clear the cache, and reset the hit and miss counters.
+
+    )";
+
+
+
+    } else if(name == "add_ephemeris_caches" && variant==0) {
+            return R"(
+
+        Function to replace the ephemerides of a list of bodies by cached ephemerides.
+
+        Function to replace the ephemerides of a list of bodies by cached ephemerides (see :class:`CachedEphemeris`). Tabulated
+        ephemerides cannot be cached, as they are reset when the dynamics is re-propagated during an estimation. The original
+        ephemerides are restored with :func:`remove_ephemeris_caches`.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies in which the ephemerides are replaced.
+        body_names : List[ str ]
+            Names of the bodies of which the ephemeris is to be cached.
+        maximum_number_of_entries : int, default=1000000
+            Number of stored states at which each cache is cleared.
+
+        Returns
+        -------
+        List[ CachedEphemeris ]
+            Cached ephemerides, in the order of ``body_names``.
+
+    )";
+
+
+
+    } else if(name == "remove_ephemeris_caches" && variant==0) {
+            return R"(
+
+        Function to restore the original ephemerides of a list of bodies, of which the ephemerides were cached.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies in which the ephemerides are restored.
+        body_names : List[ str ]
+            Names of the bodies of which the original ephemeris is to be restored.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace propagation_setup {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "load_model_plugin" && variant==0) {
+            return R"(
+
+        Function to load a plugin providing natively compiled acceleration and torque models.
+
+        Function to load a shared library (plugin) providing natively compiled acceleration and torque models, and to register
+        its models by name, such that they can be used with
+        :func:`~tudatpy.numerical_simulation.propagation_setup.acceleration.plugin` and
+        :func:`~tudatpy.numerical_simulation.propagation_setup.torque.plugin`. The plugin is to implement the C interface
+        defined in ``tudatpy/plugins/modelPluginAbi.h``. A plugin built for a different version of the interface is rejected,
+        as is a plugin providing a model with the name of a model that is already registered. Registered models remain
+        available for the lifetime of the process.
+
+
+        Parameters
+        ----------
+        library_path : str
+            Path of the shared library.
+
+        Returns
+        -------
+        List[ str ]
+            Names of the models registered from the plugin.
+
+    )";
+
+
+
+    } else if(name == "get_registered_plugin_models" && variant==0) {
+            return R"(
+
+        Function to retrieve the models registered from loaded plugins.
+
+        Function to retrieve the names of the models registered with
+        :func:`~tudatpy.numerical_simulation.propagation_setup.load_model_plugin`, with the path of the library providing them.
+
+        Returns
+        -------
+        Dict[ str, str ]
+            Path of the library providing each registered model (key: model name).
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+
+    
+namespace integrator {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "DenseOutputIntegratorSettings") {
+         return R"(
+
+        `IntegratorSettings`-derived class to define settings for the Dormand-Prince 5(4) integrator with dense output.
+
+        Class to define settings for the variable step size Dormand-Prince 5(4) integrator with dense output, created with
+        :func:`runge_kutta_dense_output`. The integration runs from the initial time to the last output epoch, and the saved
+        state history contains exactly the output epochs, evaluated with the continuous extension of the integrator (the step
+        size is not limited by the output epochs). These settings are only supported by the single-arc simulator.
+
+     )";
+
+
+
+    } else if(name == "DenseOutputIntegratorSettings.output_epochs") {
+         return R"(
+
+        Epochs at which the state (and dependent variables) are saved, monotonic in the direction of integration.
+
+        :type: List[ float ]
+
+     )";
+
+
+
+    } else if(name == "runge_kutta_dense_output" && variant==0) {
+            return R"(
+
+        Creates the settings for the Dormand-Prince 5(4) integrator with dense output.
+
+        Factory function to create settings for the variable step size Dormand-Prince 5(4) integrator with dense output. The
+        state (and the dependent variables) are saved exactly at the output epochs, evaluated with the continuous extension of
+        the integrator, such that the step size is not limited by the output epochs. The propagation must be terminated by a
+        time termination condition, at or beyond the last output epoch; other termination conditions are not supported. These
+        settings are only supported by the single-arc simulator.
+
+
+        Parameters
+        ----------
+        initial_time : float
+            Start time (independent variable) of numerical integration.
+        initial_time_step : float
+            Initial time step to be used.
+        output_epochs : List[ float ]
+            Epochs at which the state is to be saved (monotonic, in the direction of integration).
+        minimum_step_size : float
+            Minimum time step to be used during the integration.
+        maximum_step_size : float
+            Maximum time step to be used during the integration.
+        relative_error_tolerance : float
+            Relative tolerance per state element to adjust the time step.
+        absolute_error_tolerance : float
+            Absolute tolerance per state element to adjust the time step.
+        safety_factor : float, default=0.8
+            Safety factor used in the step size control.
+        maximum_factor_increase : float, default=4.0
+            Maximum increase between consecutive time steps, expressed as the factor between new and old step size.
+        minimum_factor_increase : float, default=0.1
+            Minimum increase between consecutive time steps, expressed as the factor between new and old step size.
+        throw_exception_if_minimum_step_exceeded : bool, default=True
+            Whether an exception is thrown if the minimum step size does not meet the tolerances.
+        checkpoint_file_path : str, default=""
+            Path of the file to which checkpoints of the integration are written, from which an interrupted propagation
+            can be resumed with :func:`~tudatpy.numerical_simulation.SingleArcSimulator.resume_from_checkpoint` (no
+            checkpoints are written if empty). Each checkpoint only appends the states saved since the previous one.
+        checkpoint_interval : float, default=600.0
+            Minimum (wall-clock) time in seconds between two checkpoints. A checkpoint is always written after the
+            final step.
+
+        Returns
+        -------
+        DenseOutputIntegratorSettings
+            Settings of the dense output integrator.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace propagator {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "PropagationExpressionTerminationSettings") {
+         return R"(
+
+        `PropagationCustomTerminationSettings`-derived class to define termination settings from an expression over dependent variables.
+
+        Class to define termination settings, with the propagation terminated when an expression over dependent variables is
+        true (non-zero). The expression is evaluated natively after each step. Instances of this class are created with the
+        :func:`~tudatpy.numerical_simulation.propagation_setup.propagator.expression_termination` function.
+
+     )";
+
+
+
+    } else if(name == "PropagationExpressionTerminationSettings.condition") {
+         return R"(
+
+        **read-only**
+
+        Expression terminating the propagation when true.
+
+        :type: str
+
+     )";
+
+
+
+    } else if(name == "expression_termination" && variant==0) {
+            return R"(
+
+        Function to create termination settings from an expression over dependent variables.
+
+        Function to create termination settings from an expression over dependent variables, terminating the propagation
+        when the expression is true (non-zero), e.g. ``"altitude < 120.0E3 and mach > 5"``. The expression is evaluated
+        natively after each step, avoiding a call to Python. See
+        :func:`~tudatpy.numerical_simulation.propagation.expression_aerodynamic_guidance` for the syntax of the expressions.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies from which the dependent variables are computed.
+        condition : str
+            Expression terminating the propagation when true.
+        variables : Dict[ str, SingleDependentVariableSaveSettings ]
+            Dependent variables that can be used in the expression (key: name in the expression).
+        tables : Dict[ str, Tuple[ List[ float ], List[ float ] ] ], default={}
+            Tables that can be used in the expression (key: name; value: independent and dependent values).
+
+        Returns
+        -------
+        PropagationExpressionTerminationSettings
+            Termination settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace acceleration {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "custom" && variant==1) {
+            return R"(
+
+        Creates settings for a custom acceleration computed by a C function.
+
+        Creates settings for a custom acceleration, computed by a C function with signature
+        ``void(double time, double* acceleration, void* user_data)``, which is to write the 3 elements of the acceleration
+        (in the inertial frame). The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        acceleration_function : int
+            Address of the C function computing the acceleration.
+        user_data : int, default=0
+            Address of the user data passed to the C function.
+
+        Returns
+        -------
+        CustomAccelerationSettings
+            Custom acceleration settings object.
+
+    )";
+
+
+    } else if(name == "plugin" && variant==0) {
+            return R"(
+
+        Creates settings for an acceleration model provided by a loaded plugin.
+
+        Creates settings for an acceleration model provided by a plugin loaded with
+        :func:`~tudatpy.numerical_simulation.propagation_setup.load_model_plugin`, with an instance of the model created
+        from the given parameters. The model is evaluated natively every time the state derivative is computed, with the time, the Cartesian states of
+        both bodies, and the rotation, angular velocity and mass of the body undergoing the acceleration as input (see
+        ``TudatpyPluginModelInput`` in ``tudatpy/plugins/modelPluginAbi.h``). A non-zero error code returned by the model
+        raises an exception.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies from which the input of the model is retrieved.
+        model_name : str
+            Name with which the model is registered.
+        body_undergoing_acceleration : str
+            Name of the body undergoing the acceleration.
+        body_exerting_acceleration : str
+            Name of the body exerting the acceleration.
+        model_parameters : List[ float ], default=[]
+            Parameters from which the instance of the model is created.
+
+        Returns
+        -------
+        CustomAccelerationSettings
+            Acceleration settings object.
+
+    )";
+
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace thrust {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "custom_thrust_magnitude" && variant==1) {
+            return R"(
+
+        Function to create thrust magnitude settings, with the magnitude and specific impulse computed by C functions.
+
+        Function to create thrust magnitude settings, with the thrust magnitude and specific impulse computed by C functions
+        with signature ``double(double time, void* user_data)``. The engine is always on, and the thrust direction is
+        constant in the body-fixed frame. The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        thrust_magnitude_function : int
+            Address of the C function computing the thrust magnitude.
+        specific_impulse_function : int
+            Address of the C function computing the specific impulse.
+        body_fixed_thrust_direction : numpy.ndarray, default=numpy.array([1, 0, 0])
+            Thrust direction in the body-fixed frame.
+        user_data : int, default=0
+            Address of the user data passed to both C functions.
+
+        Returns
+        -------
+        CustomThrustMagnitudeSettings
+            Thrust magnitude settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace torque {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "plugin" && variant==0) {
+            return R"(
+
+        Creates settings for a torque model provided by a loaded plugin.
+
+        Creates settings for a torque model provided by a plugin loaded with
+        :func:`~tudatpy.numerical_simulation.propagation_setup.load_model_plugin`, with an instance of the model created
+        from the given parameters. The torque is computed in the body-fixed frame of the body undergoing the torque. The model is evaluated natively every time the state derivative is computed, with the time, the Cartesian states of
+        both bodies, and the rotation, angular velocity and mass of the body undergoing the torque as input (see
+        ``TudatpyPluginModelInput`` in ``tudatpy/plugins/modelPluginAbi.h``). A non-zero error code returned by the model
+        raises an exception.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies from which the input of the model is retrieved.
+        model_name : str
+            Name with which the model is registered.
+        body_undergoing_torque : str
+            Name of the body undergoing the torque.
+        body_exerting_torque : str
+            Name of the body exerting the torque.
+        model_parameters : List[ float ], default=[]
+            Parameters from which the instance of the model is created.
+
+        Returns
+        -------
+        CustomTorqueSettings
+            Torque settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+}
+
+
+
+
+
+    
+namespace propagation {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "compute_deferred_dependent_variables" && variant==0) {
+            return R"(
+
+        Function to evaluate dependent variables after a propagation, from the saved state history.
+
+        Function to evaluate dependent variables after a propagation, from the saved state history, instead of at every step
+        of the propagation, such that expensive dependent variables can be evaluated at a subset of the epochs only. For each
+        evaluation epoch, the environment is updated by evaluating the state derivative at the saved state, after which the
+        dependent variables are computed, identically to their evaluation during the propagation. States at evaluation epochs
+        that are not in the state history are obtained by 8th order Lagrange interpolation. Since the state derivative only
+        updates the environment models that the propagation requires, a dependent variable that requires any other model (e.g.
+        the altitude, if the rotation of the central body is not used by the propagation) is rejected; such variables must be
+        added to the propagator settings instead. The same epochs are used for all dependent variables.
+
+
+        Parameters
+        ----------
+        dynamics_simulator : SingleArcSimulator
+            Dynamics simulator with which the equations of motion were integrated.
+        bodies : SystemOfBodies
+            System of bodies used by the dynamics simulator.
+        dependent_variables : List[ SingleDependentVariableSaveSettings ]
+            Settings of the dependent variables that are to be evaluated.
+        evaluation_epochs : List[ float ], default=[]
+            Epochs at which the dependent variables are to be evaluated (if empty, the epochs are selected with
+            ``evaluation_stride``).
+        evaluation_stride : int, default=1
+            Interval (in saved epochs of the state history) at which the dependent variables are evaluated, starting at the
+            first, and always including the last, saved epoch.
+
+        Returns
+        -------
+        Tuple[ Dict[ float, numpy.ndarray ], Dict[ int, str ] ]
+            Dependent variable history, and the start index and name of each dependent variable in the vector of dependent
+            variables.
+
+    )";
+
+
+    } else if(name == "ExpressionAerodynamicGuidance") {
+         return R"(
+
+        Aerodynamic guidance, with the aerodynamic angles computed from expressions over dependent variables.
+
+        Aerodynamic guidance, with the angle of attack, bank angle and sideslip angle computed natively from expressions over
+        dependent variables, instead of by a Python guidance class. Angles without an expression are zero. Instances of this
+        class are created with the :func:`~tudatpy.numerical_simulation.propagation.expression_aerodynamic_guidance` function.
+
+     )";
+
+
+
+    } else if(name == "expression_aerodynamic_guidance" && variant==0) {
+            return R"(
+
+        Function to create an aerodynamic guidance from expressions over dependent variables.
+
+        Function to create an aerodynamic guidance from expressions over dependent variables, e.g. a bank angle schedule as a
+        function of energy, given by a table. The expressions support the operators ``+``, ``-``, ``*``, ``/``, ``^`` (or
+        ``**``), comparisons, ``and``, ``or`` and ``not``, the functions ``sqrt``, ``abs``, ``min``, ``max``, ``atan2``,
+        trigonometric functions and ``if(condition, a, b)``, the constant ``pi`` and the variable ``time``. Components of
+        vector dependent variables are accessed as ``name[i]``, and tables are evaluated by linear interpolation as
+        ``name(x)``, with the first/last value returned outside of the range of the table. Numbers are always written with a
+        point as decimal separator, irrespective of the locale.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies from which the dependent variables are computed.
+        angle_of_attack : str, default=""
+            Expression for the angle of attack (zero if empty).
+        bank_angle : str, default=""
+            Expression for the bank angle (zero if empty).
+        sideslip_angle : str, default=""
+            Expression for the sideslip angle (zero if empty).
+        variables : Dict[ str, SingleDependentVariableSaveSettings ], default={}
+            Dependent variables that can be used in the expressions (key: name in the expressions).
+        tables : Dict[ str, Tuple[ List[ float ], List[ float ] ] ], default={}
+            Tables that can be used in the expressions (key: name; value: independent and dependent values).
+
+        Returns
+        -------
+        ExpressionAerodynamicGuidance
+            Aerodynamic guidance computing the angles from the expressions.
+
+    )";
+
+
+    } else if(name == "StateDerivativeProfileEntry") {
+         return R"(
+
+        Timing of a single component of the state derivative.
+
+        Timing of a single component of the state derivative (state derivative, acceleration model, environment model or
+        dependent variable), as measured by :func:`~tudatpy.numerical_simulation.SingleArcSimulator.profile_state_derivative`.
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfileEntry.category") {
+         return R"(
+
+        **read-only**
+
+        Category of the component: ``state_derivative``, ``acceleration``, ``ephemeris``, ``rotation``,
+        ``flight_conditions``, ``atmosphere`` or ``dependent_variable``.
+
+        :type: str
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfileEntry.name") {
+         return R"(
+
+        **read-only**
+
+        Name of the component (e.g. the type of the acceleration and the bodies involved, or the name of the body).
+
+        :type: str
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfileEntry.number_of_calls") {
+         return R"(
+
+        **read-only**
+
+        Number of timed calls of the component.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfileEntry.total_time") {
+         return R"(
+
+        **read-only**
+
+        Total (wall-clock) duration of the timed calls of the component, in seconds.
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfileEntry.mean_time") {
+         return R"(
+
+        **read-only**
+
+        Mean (wall-clock) duration of a single call of the component, in seconds.
+
+        :type: float
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfile") {
+         return R"(
+
+        Profile of the computational cost of the components of the state derivative of a propagation.
+
+        Profile of the computational cost of the components of the state derivative of a propagation, created by
+        :func:`~tudatpy.numerical_simulation.SingleArcSimulator.profile_state_derivative`. Converting the profile to a string
+        gives the same table as :func:`~tudatpy.numerical_simulation.propagation.StateDerivativeProfile.report`.
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfile.entries") {
+         return R"(
+
+        **read-only**
+
+        Timings of the profiled components, with the full state derivative first.
+
+        :type: List[ StateDerivativeProfileEntry ]
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfile.number_of_function_evaluations") {
+         return R"(
+
+        **read-only**
+
+        Number of state derivative evaluations during the profiled propagation.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfile.number_of_steps") {
+         return R"(
+
+        **read-only**
+
+        Number of (accepted) integration steps during the profiled propagation.
+
+        :type: int
+
+     )";
+
+
+
+    } else if(name == "StateDerivativeProfile.report" && variant==0) {
+            return R"(
+
+        Function to create a table of the profiled components.
+
+        Function to create a table of the profiled components, with their numbers of calls, mean and total durations,
+        sorted by total duration.
+
+        Returns
+        -------
+        str
+            Table of the profiled components.
+
+    )";
+
+
+    } else if(name == "EnsembleStepSizeControl") {
+         return R"(
+
+        Enumeration of step size control types for the propagation of an ensemble of particles.
+
+        Enumeration of the step size control types for :func:`propagate_ensemble`. With ``common_ensemble_step_size``, all
+        particles are integrated as a single state, such that each state derivative evaluation is shared by all particles,
+        and the step size is limited by the particle with the largest error. With ``per_particle_step_size``, each particle is
+        integrated separately with its own step size, and the particles are distributed over a pool of threads.
+
+     )";
+
+
+
+    } else if(name == "propagate_ensemble" && variant==0) {
+            return R"(
+
+        Function to propagate an ensemble of particles, and evaluate their states at a list of output epochs.
+
+        Function to propagate an ensemble of particles about a central body with the variable step-size Dormand-Prince 5(4)
+        integrator with dense output, and evaluate their states at a list of output epochs. The particles are subject to the
+        point mass gravity of the central body, and optionally its J2 term (which requires a spherical harmonic gravity
+        field), the point mass gravity of third bodies, and drag in an exponential atmosphere (above the average radius of
+        the shape model of the central body). The GIL is released during the propagation, such that other Python threads can
+        run concurrently. The output states do not depend on the number of threads.
+
+
+        Parameters
+        ----------
+        bodies : SystemOfBodies
+            System of bodies defining the environment.
+        central_body : str
+            Name of the central body.
+        initial_states : numpy.ndarray
+            Initial Cartesian states of the particles w.r.t. the central body (one row per particle, particles x 6).
+        initial_time : float
+            Initial epoch.
+        output_epochs : List[ float ]
+            Epochs at which the states are to be evaluated (monotonic, in the direction of integration).
+        initial_time_step : float
+            Initial (absolute) step size.
+        minimum_step_size : float
+            Minimum (absolute) step size.
+        maximum_step_size : float
+            Maximum (absolute) step size.
+        relative_error_tolerance : float
+            Relative error tolerance per state element.
+        absolute_error_tolerance : float
+            Absolute error tolerance per state element.
+        include_j2 : bool, default=True
+            Boolean denoting whether the J2 term of the gravity field of the central body is included.
+        third_bodies : List[ str ], default=[]
+            Names of the bodies exerting a third-body point mass gravity acceleration.
+        ballistic_coefficients : numpy.ndarray, default=numpy.array([])
+            Ballistic coefficients (C_D A / m) of the particles (if empty, no drag is included).
+        reference_density : float, default=0.0
+            Density of the exponential atmosphere at the reference altitude.
+        reference_altitude : float, default=0.0
+            Reference altitude of the exponential atmosphere.
+        scale_height : float, default=0.0
+            Scale height of the exponential atmosphere.
+        step_size_control : EnsembleStepSizeControl, default=common_ensemble_step_size
+            Type of step size control.
+        number_of_threads : int, default=0
+            Number of threads used with per-particle step sizes (if <= 0, the hardware concurrency).
+        Returns
+        -------
+        numpy.ndarray
+            States of the particles at the output epochs (particles x output epochs x 6).
+
+    )";
+
+
+
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace environment_setup {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+
+    
+namespace atmosphere {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "custom_four_dimensional_constant_temperature" && variant==1) {
+            return R"(
+
+        Function to create settings for a custom constant-temperature atmosphere, with the density computed by a C function.
+
+        Function to create settings for a custom atmosphere with a constant temperature, with the density computed by a C
+        function with signature ``double(double altitude, double longitude, double latitude, double time, void* user_data)``.
+        The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        density_function : int
+            Address of the C function computing the density.
+        constant_temperature : float
+            Constant atmospheric temperature.
+        specific_gas_constant : float, default=287.058
+            Specific gas constant of the atmosphere.
+        ratio_of_specific_heats : float, default=1.4
+            Ratio of specific heats of the atmosphere.
+        user_data : int, default=0
+            Address of the user data passed to the C function.
+
+        Returns
+        -------
+        CustomConstantTemperatureAtmosphereSettings
+            Atmosphere settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace ephemeris {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "scaled_by_vector_function" && variant==1) {
+            return R"(
+
+        Function to create settings for an ephemeris scaled by a vector computed by a C function.
+
+        Function to create settings for an ephemeris of which the state is scaled by a vector, computed by a C function with
+        signature ``void(double time, double* scaling, void* user_data)``, which is to write 6 elements. The scaling is
+        added to (if absolute) or multiplied element-wise with (if relative) the state of the unscaled ephemeris. The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        unscaled_ephemeris_settings : EphemerisSettings
+            Settings of the ephemeris that is to be scaled.
+        scaling_vector_function : int
+            Address of the C function computing the scaling vector.
+        is_scaling_absolute : bool, default=False
+            Boolean denoting whether the scaling is absolute (added) or relative (multiplied).
+        user_data : int, default=0
+            Address of the user data passed to the C function.
+
+        Returns
+        -------
+        ScaledEphemerisSettings
+            Scaled ephemeris settings object.
+
+    )";
+
+
+
+    } else if(name == "custom" && variant==1) {
+            return R"(
+
+        Function to create settings for a custom ephemeris, with the state computed by a C function.
+
+        Function to create settings for a custom ephemeris, with the Cartesian state computed by a C function with signature
+        ``void(double time, double* state, void* user_data)``, which is to write the 6 elements of the state. The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        custom_state_function : int
+            Address of the C function computing the state.
+        frame_origin : str, default="SSB"
+            Origin of the frame in which the state is defined.
+        frame_orientation : str, default="ECLIPJ2000"
+            Orientation of the frame in which the state is defined.
+        user_data : int, default=0
+            Address of the user data passed to the C function.
+
+        Returns
+        -------
+        CustomEphemerisSettings
+            Custom ephemeris settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+
+    
+namespace aerodynamic_coefficients {
+
+static inline std::string get_docstring(std::string name, int variant=0) {
+
+    if (name == "test") {
+        return "test";
+
+
+    } else if(name == "custom" && variant==1) {
+            return R"(
+
+        Function to create settings for custom aerodynamic force coefficients, computed by a C function.
+
+        Function to create settings for custom aerodynamic force coefficients, computed by a C function with signature
+        ``void(const double* independent_variables, int number_of_independent_variables, double* coefficients,
+        void* user_data)``, which is to write the 3 force coefficients. The independent variables are passed in the order
+        of ``independent_variable_names``. The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        force_coefficient_function : int
+            Address of the C function computing the force coefficients.
+        reference_area : float
+            Reference area of the aerodynamic coefficients.
+        independent_variable_names : List[ AerodynamicCoefficientsIndependentVariables ]
+            Independent variables of the coefficients, in the order in which they are passed to the C function.
+        are_coefficients_in_aerodynamic_frame : bool, default=True
+            Boolean denoting whether the coefficients are defined in the aerodynamic frame (or in the body-fixed frame).
+        are_coefficients_in_negative_axis_direction : bool, default=True
+            Boolean denoting whether the coefficients are defined in the negative axis direction.
+        user_data : int, default=0
+            Address of the user data passed to the C function.
+
+        Returns
+        -------
+        CustomAerodynamicCoefficientSettings
+            Custom aerodynamic coefficient settings object.
+
+    )";
+
+
+
+    } else if(name == "scaled_by_vector_function" && variant==1) {
+            return R"(
+
+        Function to create settings for aerodynamic coefficients scaled by vectors computed by C functions.
+
+        Function to create settings for aerodynamic coefficients, of which the force and moment coefficients are scaled by
+        vectors computed by C functions with signature ``void(double time, double* scaling, void* user_data)``, which are to
+        write 3 elements each. The address of the C function can be obtained from a numba ``cfunc`` (its ``address`` attribute) or from a ctypes
+        function (``ctypes.cast(function, ctypes.c_void_p).value``). The function is called directly from the propagation,
+        without acquiring the GIL, and the user data address is passed to it unchanged as its last argument. The C function
+        (and the user data) must remain alive for as long as the settings, or the models created from them, are used.
+
+
+        Parameters
+        ----------
+        unscaled_coefficient_settings : AerodynamicCoefficientSettings
+            Settings of the coefficients that are to be scaled.
+        force_scaling_vector_function : int
+            Address of the C function computing the force coefficient scaling.
+        moment_scaling_vector_function : int
+            Address of the C function computing the moment coefficient scaling.
+        is_scaling_absolute : bool, default=False
+            Boolean denoting whether the scaling is absolute (added) or relative (multiplied).
+        user_data : int, default=0
+            Address of the user data passed to both C functions.
+
+        Returns
+        -------
+        ScaledAerodynamicCoefficientInterfaceSettings
+            Scaled aerodynamic coefficient settings object.
+
+    )";
+
+
+
+
+
+    } else {
+        return "No documentation found.";
+    }
+
+}
+
+
+}
+
+
+
+
+}
+
+
+
+
+}
+
+
+
+
 }
 
@@ -0,0 +1,712 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_COMPILED_EXPRESSION_H
+#define TUDATPY_COMPILED_EXPRESSION_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace expressions
+{
+
+//! Table of (independent variable, value) pairs, evaluated by linear interpolation
+/*!
+ *  Table of (independent variable, value) pairs, evaluated by linear interpolation. Outside of the range of the
+ *  independent variables, the first/last value is returned.
+ */
+class ExpressionTable
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param independentValues Values of the independent variable (strictly increasing)
+     *  \param dependentValues Values of the table at the independent values
+     */
+    ExpressionTable( const std::vector< double >& independentValues,
+                     const std::vector< double >& dependentValues ):
+        independentValues_( independentValues ), dependentValues_( dependentValues )
+    {
+        if( independentValues_.size( ) != dependentValues_.size( ) )
+        {
+            throw std::runtime_error( "Error when creating expression table, independent and dependent values have different sizes." );
+        }
+        else if( independentValues_.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when creating expression table, no values provided." );
+        }
+        for( unsigned int i = 1; i < independentValues_.size( ); i++ )
+        {
+            if( !( independentValues_.at( i ) > independentValues_.at( i - 1 ) ) )
+            {
+                throw std::runtime_error( "Error when creating expression table, independent values are not strictly increasing." );
+            }
+        }
+    }
+
+    //! Function to evaluate the table at a given value of the independent variable
+    double evaluate( const double independentValue ) const
+    {
+        if( !( independentValue > independentValues_.front( ) ) )
+        {
+            return dependentValues_.front( );
+        }
+        else if( !( independentValue < independentValues_.back( ) ) )
+        {
+            return dependentValues_.back( );
+        }
+
+        const unsigned int upperIndex = static_cast< unsigned int >(
+                    std::upper_bound( independentValues_.begin( ), independentValues_.end( ), independentValue ) -
+                    independentValues_.begin( ) );
+        const double fraction = ( independentValue - independentValues_[ upperIndex - 1 ] ) /
+                ( independentValues_[ upperIndex ] - independentValues_[ upperIndex - 1 ] );
+        return dependentValues_[ upperIndex - 1 ] + fraction * ( dependentValues_[ upperIndex ] - dependentValues_[ upperIndex - 1 ] );
+    }
+
+private:
+
+    //! Values of the independent variable (strictly increasing)
+    std::vector< double > independentValues_;
+
+    //! Values of the table at the independent values
+    std::vector< double > dependentValues_;
+};
+
+//! Set of named (vector) variables that are used by one or more compiled expressions
+/*!
+ *  Set of named (vector) variables that are used by one or more compiled expressions. The value of each variable is
+ *  retrieved from its function when calling updateVariables (only for variables that are used by an expression), after
+ *  which all expressions using the set can be evaluated. The variable 'time' is always defined, and is set by
+ *  updateVariables. The variable functions may be set after the expressions have been compiled, but before the first
+ *  update.
+ */
+class ExpressionVariableSet
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param variableNames Names of the variables (excluding 'time')
+     */
+    ExpressionVariableSet( const std::vector< std::string >& variableNames ):
+        variableNames_( variableNames ), variableValues_( variableNames.size( ) ),
+        isVariableUsed_( variableNames.size( ), false ), currentTime_( std::numeric_limits< double >::quiet_NaN( ) )
+    {
+        for( unsigned int i = 0; i < variableNames_.size( ); i++ )
+        {
+            if( variableNames_.at( i ) == "time" )
+            {
+                throw std::runtime_error( "Error when creating expression variables, variable name 'time' is reserved." );
+            }
+            else if( std::count( variableNames_.begin( ), variableNames_.end( ), variableNames_.at( i ) ) > 1 )
+            {
+                throw std::runtime_error( "Error when creating expression variables, variable " + variableNames_.at( i ) +
+                                          " is defined more than once." );
+            }
+        }
+    }
+
+    // Variable values are referenced by compiled expressions
+    ExpressionVariableSet( const ExpressionVariableSet& ) = delete;
+    ExpressionVariableSet& operator=( const ExpressionVariableSet& ) = delete;
+
+    //! Function to set the functions returning the current values of the variables (in the order of the variable names)
+    void setVariableFunctions( const std::vector< std::function< Eigen::VectorXd( ) > >& variableFunctions )
+    {
+        if( variableFunctions.size( ) != variableNames_.size( ) )
+        {
+            throw std::runtime_error( "Error when setting expression variable functions, number of functions is inconsistent." );
+        }
+        variableFunctions_ = variableFunctions;
+    }
+
+    //! Function to check whether the variable functions have been set
+    bool areVariableFunctionsSet( ){ return variableFunctions_.size( ) == variableNames_.size( ); }
+
+    //! Function to update the time and the values of all used variables
+    void updateVariables( const double currentTime )
+    {
+        if( !areVariableFunctionsSet( ) )
+        {
+            throw std::runtime_error( "Error when updating expression variables, variable functions have not been set." );
+        }
+
+        currentTime_ = currentTime;
+        for( unsigned int i = 0; i < variableNames_.size( ); i++ )
+        {
+            if( isVariableUsed_[ i ] )
+            {
+                variableValues_[ i ] = variableFunctions_[ i ]( );
+            }
+        }
+    }
+
+    //! Function to retrieve the names of the variables
+    const std::vector< std::string >& getVariableNames( ){ return variableNames_; }
+
+    //! Function to retrieve which variables are used by the compiled expressions
+    const std::vector< bool >& getIsVariableUsed( ){ return isVariableUsed_; }
+
+    //! Function to retrieve the index of a variable in the set (-1 if not present), and flag it as used
+    int registerVariableUse( const std::string& variableName )
+    {
+        auto nameIterator = std::find( variableNames_.begin( ), variableNames_.end( ), variableName );
+        if( nameIterator == variableNames_.end( ) )
+        {
+            return -1;
+        }
+        const int variableIndex = static_cast< int >( nameIterator - variableNames_.begin( ) );
+        isVariableUsed_[ variableIndex ] = true;
+        return variableIndex;
+    }
+
+    //! Function to retrieve the current value of a variable
+    const Eigen::VectorXd& getVariableValue( const int variableIndex ) const { return variableValues_[ variableIndex ]; }
+
+    //! Function to retrieve the time of the current variable values
+    const double& getCurrentTime( ) const { return currentTime_; }
+
+private:
+
+    //! Names of the variables (excluding 'time')
+    std::vector< std::string > variableNames_;
+
+    //! Functions returning the current values of the variables
+    std::vector< std::function< Eigen::VectorXd( ) > > variableFunctions_;
+
+    //! Current values of the variables
+    std::vector< Eigen::VectorXd > variableValues_;
+
+    //! List of booleans denoting which variables are used by compiled expressions
+    std::vector< bool > isVariableUsed_;
+
+    //! Time of the current variable values
+    double currentTime_;
+};
+
+//! Arithmetic/logical expression, compiled into a tree of closures over the values of an ExpressionVariableSet
+/*!
+ *  Arithmetic/logical expression, compiled into a tree of closures over the values of an ExpressionVariableSet, such
+ *  that it can be evaluated without parsing or name lookups. The supported syntax is:
+ *  - numbers (e.g. 2, 1.5, 120.0E3), the constant pi, the variable time, and the variables of the variable set, where
+ *    element i of a vector variable is accessed as name[i] (name without index denotes element 0)
+ *  - arithmetic operators + - * / and ^ (or **, power, right-associative)
+ *  - comparison operators < <= > >= == !=, and logical operators and/&&, or/||, not/!, evaluating to 1.0 (true) or
+ *    0.0 (false), where any non-zero value is considered true
+ *  - functions sin, cos, tan, asin, acos, atan, atan2, sinh, cosh, tanh, sqrt, exp, log, log10, abs, sign, floor, ceil,
+ *    min, max, pow, and if( condition, value if true, value if false )
+ *  - tables (see ExpressionTable), called by name as a function of a single argument
+ *  Logical operators and the if function evaluate their operands lazily.
+ */
+class CompiledExpression
+{
+public:
+
+    //! Constructor, compiling the expression
+    /*!
+     *  Constructor, compiling the expression
+     *  \param expression Expression that is to be compiled
+     *  \param variableSet Variables that can be used in the expression
+     *  \param tables Tables that can be used in the expression (key: name)
+     */
+    CompiledExpression( const std::string& expression,
+                        const std::shared_ptr< ExpressionVariableSet > variableSet,
+                        const std::map< std::string, std::shared_ptr< ExpressionTable > >& tables =
+            std::map< std::string, std::shared_ptr< ExpressionTable > >( ) ):
+        expression_( expression ), variableSet_( variableSet ), tables_( tables ), currentPosition_( 0 )
+    {
+        readNextToken( );
+        compiledExpression_ = parseLogicalOr( );
+        if( currentToken_.type_ != end_token )
+        {
+            throwParsingError( "unexpected '" + currentToken_.text_ + "'" );
+        }
+    }
+
+    //! Function to evaluate the expression at the current values of the variable set
+    double evaluate( ) const { return compiledExpression_( ); }
+
+    //! Function to retrieve the (uncompiled) expression
+    std::string getExpression( ){ return expression_; }
+
+    //! Function to retrieve the variables that can be used in the expression
+    std::shared_ptr< ExpressionVariableSet > getVariableSet( ){ return variableSet_; }
+
+private:
+
+    typedef std::function< double( ) > ExpressionFunction;
+
+    enum TokenTypes
+    {
+        number_token,
+        name_token,
+        operator_token,
+        end_token
+    };
+
+    struct Token
+    {
+        TokenTypes type_;
+        std::string text_;
+        double value_;
+    };
+
+    void throwParsingError( const std::string& errorMessage )
+    {
+        throw std::runtime_error( "Error when compiling expression \"" + expression_ + "\", " + errorMessage +
+                                  " at position " + std::to_string( tokenPosition_ ) + "." );
+    }
+
+    void readNextToken( )
+    {
+        while( currentPosition_ < expression_.size( ) && std::isspace( static_cast< unsigned char >( expression_[ currentPosition_ ] ) ) )
+        {
+            currentPosition_++;
+        }
+        tokenPosition_ = currentPosition_;
+
+        if( currentPosition_ >= expression_.size( ) )
+        {
+            currentToken_ = Token{ end_token, "end of expression", 0.0 };
+            return;
+        }
+
+        const char currentCharacter = expression_[ currentPosition_ ];
+        if( std::isdigit( static_cast< unsigned char >( currentCharacter ) ) || currentCharacter == '.' )
+        {
+            // Numbers are parsed in the classic locale, such that the decimal separator is always a point
+            const std::string remainingExpression = expression_.substr( currentPosition_ );
+            std::istringstream numberStream( remainingExpression );
+            numberStream.imbue( std::locale::classic( ) );
+            double value;
+            numberStream >> value;
+            if( numberStream.fail( ) )
+            {
+                throwParsingError( "invalid number" );
+            }
+            const unsigned int numberLength = numberStream.eof( ) ?
+                        static_cast< unsigned int >( remainingExpression.size( ) ) :
+                        static_cast< unsigned int >( numberStream.tellg( ) );
+            currentPosition_ += numberLength;
+            currentToken_ = Token{ number_token, remainingExpression.substr( 0, numberLength ), value };
+        }
+        else if( std::isalpha( static_cast< unsigned char >( currentCharacter ) ) || currentCharacter == '_' )
+        {
+            unsigned int nameEnd = currentPosition_;
+            while( nameEnd < expression_.size( ) &&
+                   ( std::isalnum( static_cast< unsigned char >( expression_[ nameEnd ] ) ) || expression_[ nameEnd ] == '_' ) )
+            {
+                nameEnd++;
+            }
+            currentToken_ = Token{ name_token, expression_.substr( currentPosition_, nameEnd - currentPosition_ ), 0.0 };
+            currentPosition_ = nameEnd;
+        }
+        else
+        {
+            static const std::vector< std::string > twoCharacterOperators = { "<=", ">=", "==", "!=", "&&", "||", "**" };
+            const std::string nextTwoCharacters = expression_.substr( currentPosition_, 2 );
+            if( std::find( twoCharacterOperators.begin( ), twoCharacterOperators.end( ), nextTwoCharacters ) !=
+                    twoCharacterOperators.end( ) )
+            {
+                currentToken_ = Token{ operator_token, nextTwoCharacters == "**" ? "^" : nextTwoCharacters, 0.0 };
+                currentPosition_ += 2;
+            }
+            else if( std::string( "+-*/^<>!(),[]" ).find( currentCharacter ) != std::string::npos )
+            {
+                currentToken_ = Token{ operator_token, std::string( 1, currentCharacter ), 0.0 };
+                currentPosition_++;
+            }
+            else
+            {
+                throwParsingError( "unknown character '" + std::string( 1, currentCharacter ) + "'" );
+            }
+        }
+    }
+
+    bool isCurrentToken( const std::string& operatorText )
+    {
+        return ( currentToken_.type_ == operator_token && currentToken_.text_ == operatorText );
+    }
+
+    bool isCurrentKeyword( const std::string& keywordText )
+    {
+        return ( currentToken_.type_ == name_token && currentToken_.text_ == keywordText );
+    }
+
+    void expectToken( const std::string& operatorText )
+    {
+        if( !isCurrentToken( operatorText ) )
+        {
+            throwParsingError( "expected '" + operatorText + "' but found '" + currentToken_.text_ + "'" );
+        }
+        readNextToken( );
+    }
+
+    ExpressionFunction parseLogicalOr( )
+    {
+        ExpressionFunction leftOperand = parseLogicalAnd( );
+        while( isCurrentToken( "||" ) || isCurrentKeyword( "or" ) )
+        {
+            readNextToken( );
+            ExpressionFunction rightOperand = parseLogicalAnd( );
+            leftOperand = [ = ]( ){ return ( leftOperand( ) != 0.0 || rightOperand( ) != 0.0 ) ? 1.0 : 0.0; };
+        }
+        return leftOperand;
+    }
+
+    ExpressionFunction parseLogicalAnd( )
+    {
+        ExpressionFunction leftOperand = parseLogicalNot( );
+        while( isCurrentToken( "&&" ) || isCurrentKeyword( "and" ) )
+        {
+            readNextToken( );
+            ExpressionFunction rightOperand = parseLogicalNot( );
+            leftOperand = [ = ]( ){ return ( leftOperand( ) != 0.0 && rightOperand( ) != 0.0 ) ? 1.0 : 0.0; };
+        }
+        return leftOperand;
+    }
+
+    ExpressionFunction parseLogicalNot( )
+    {
+        if( isCurrentToken( "!" ) || isCurrentKeyword( "not" ) )
+        {
+            readNextToken( );
+            ExpressionFunction operand = parseLogicalNot( );
+            return [ = ]( ){ return ( operand( ) == 0.0 ) ? 1.0 : 0.0; };
+        }
+        return parseComparison( );
+    }
+
+    ExpressionFunction parseComparison( )
+    {
+        ExpressionFunction leftOperand = parseAdditive( );
+        if( currentToken_.type_ == operator_token )
+        {
+            const std::string comparisonOperator = currentToken_.text_;
+            if( comparisonOperator == "<" || comparisonOperator == "<=" || comparisonOperator == ">" ||
+                    comparisonOperator == ">=" || comparisonOperator == "==" || comparisonOperator == "!=" )
+            {
+                readNextToken( );
+                ExpressionFunction rightOperand = parseAdditive( );
+                if( comparisonOperator == "<" )
+                {
+                    return [ = ]( ){ return ( leftOperand( ) < rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+                else if( comparisonOperator == "<=" )
+                {
+                    return [ = ]( ){ return ( leftOperand( ) <= rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+                else if( comparisonOperator == ">" )
+                {
+                    return [ = ]( ){ return ( leftOperand( ) > rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+                else if( comparisonOperator == ">=" )
+                {
+                    return [ = ]( ){ return ( leftOperand( ) >= rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+                else if( comparisonOperator == "==" )
+                {
+                    return [ = ]( ){ return ( leftOperand( ) == rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+                else
+                {
+                    return [ = ]( ){ return ( leftOperand( ) != rightOperand( ) ) ? 1.0 : 0.0; };
+                }
+            }
+        }
+        return leftOperand;
+    }
+
+    ExpressionFunction parseAdditive( )
+    {
+        ExpressionFunction leftOperand = parseMultiplicative( );
+        while( isCurrentToken( "+" ) || isCurrentToken( "-" ) )
+        {
+            const bool isAddition = isCurrentToken( "+" );
+            readNextToken( );
+            ExpressionFunction rightOperand = parseMultiplicative( );
+            if( isAddition )
+            {
+                leftOperand = [ = ]( ){ return leftOperand( ) + rightOperand( ); };
+            }
+            else
+            {
+                leftOperand = [ = ]( ){ return leftOperand( ) - rightOperand( ); };
+            }
+        }
+        return leftOperand;
+    }
+
+    ExpressionFunction parseMultiplicative( )
+    {
+        ExpressionFunction leftOperand = parseUnary( );
+        while( isCurrentToken( "*" ) || isCurrentToken( "/" ) )
+        {
+            const bool isMultiplication = isCurrentToken( "*" );
+            readNextToken( );
+            ExpressionFunction rightOperand = parseUnary( );
+            if( isMultiplication )
+            {
+                leftOperand = [ = ]( ){ return leftOperand( ) * rightOperand( ); };
+            }
+            else
+            {
+                leftOperand = [ = ]( ){ return leftOperand( ) / rightOperand( ); };
+            }
+        }
+        return leftOperand;
+    }
+
+    ExpressionFunction parseUnary( )
+    {
+        if( isCurrentToken( "-" ) )
+        {
+            readNextToken( );
+            ExpressionFunction operand = parseUnary( );
+            return [ = ]( ){ return -operand( ); };
+        }
+        else if( isCurrentToken( "+" ) )
+        {
+            readNextToken( );
+            return parseUnary( );
+        }
+        return parsePower( );
+    }
+
+    ExpressionFunction parsePower( )
+    {
+        ExpressionFunction base = parsePrimary( );
+        if( isCurrentToken( "^" ) )
+        {
+            readNextToken( );
+            ExpressionFunction exponent = parseUnary( );
+            return [ = ]( ){ return std::pow( base( ), exponent( ) ); };
+        }
+        return base;
+    }
+
+    std::vector< ExpressionFunction > parseFunctionArguments( const std::string& functionName,
+                                                              const unsigned int numberOfArguments )
+    {
+        std::vector< ExpressionFunction > arguments;
+        expectToken( "(" );
+        if( !isCurrentToken( ")" ) )
+        {
+            arguments.push_back( parseLogicalOr( ) );
+            while( isCurrentToken( "," ) )
+            {
+                readNextToken( );
+                arguments.push_back( parseLogicalOr( ) );
+            }
+        }
+        if( arguments.size( ) != numberOfArguments )
+        {
+            throwParsingError( "function " + functionName + " requires " + std::to_string( numberOfArguments ) +
+                               " argument(s), but " + std::to_string( arguments.size( ) ) + " were provided" );
+        }
+        expectToken( ")" );
+        return arguments;
+    }
+
+    ExpressionFunction parseFunctionCall( const std::string& functionName )
+    {
+        typedef double( *UnaryFunction )( double );
+        static const std::map< std::string, UnaryFunction > unaryFunctions =
+        {
+            { "sin", static_cast< UnaryFunction >( std::sin ) },
+            { "cos", static_cast< UnaryFunction >( std::cos ) },
+            { "tan", static_cast< UnaryFunction >( std::tan ) },
+            { "asin", static_cast< UnaryFunction >( std::asin ) },
+            { "acos", static_cast< UnaryFunction >( std::acos ) },
+            { "atan", static_cast< UnaryFunction >( std::atan ) },
+            { "sinh", static_cast< UnaryFunction >( std::sinh ) },
+            { "cosh", static_cast< UnaryFunction >( std::cosh ) },
+            { "tanh", static_cast< UnaryFunction >( std::tanh ) },
+            { "sqrt", static_cast< UnaryFunction >( std::sqrt ) },
+            { "exp", static_cast< UnaryFunction >( std::exp ) },
+            { "log", static_cast< UnaryFunction >( std::log ) },
+            { "log10", static_cast< UnaryFunction >( std::log10 ) },
+            { "abs", static_cast< UnaryFunction >( std::fabs ) },
+            { "floor", static_cast< UnaryFunction >( std::floor ) },
+            { "ceil", static_cast< UnaryFunction >( std::ceil ) }
+        };
+
+        if( unaryFunctions.count( functionName ) > 0 )
+        {
+            const UnaryFunction unaryFunction = unaryFunctions.at( functionName );
+            ExpressionFunction argument = parseFunctionArguments( functionName, 1 ).at( 0 );
+            return [ = ]( ){ return unaryFunction( argument( ) ); };
+        }
+        else if( functionName == "sign" )
+        {
+            ExpressionFunction argument = parseFunctionArguments( functionName, 1 ).at( 0 );
+            return [ = ]( ){ const double value = argument( ); return ( value > 0.0 ) ? 1.0 : ( ( value < 0.0 ) ? -1.0 : 0.0 ); };
+        }
+        else if( functionName == "atan2" || functionName == "pow" || functionName == "min" || functionName == "max" )
+        {
+            std::vector< ExpressionFunction > arguments = parseFunctionArguments( functionName, 2 );
+            ExpressionFunction firstArgument = arguments.at( 0 );
+            ExpressionFunction secondArgument = arguments.at( 1 );
+            if( functionName == "atan2" )
+            {
+                return [ = ]( ){ return std::atan2( firstArgument( ), secondArgument( ) ); };
+            }
+            else if( functionName == "pow" )
+            {
+                return [ = ]( ){ return std::pow( firstArgument( ), secondArgument( ) ); };
+            }
+            else if( functionName == "min" )
+            {
+                return [ = ]( ){ return std::min( firstArgument( ), secondArgument( ) ); };
+            }
+            else
+            {
+                return [ = ]( ){ return std::max( firstArgument( ), secondArgument( ) ); };
+            }
+        }
+        else if( functionName == "if" )
+        {
+            std::vector< ExpressionFunction > arguments = parseFunctionArguments( functionName, 3 );
+            ExpressionFunction condition = arguments.at( 0 );
+            ExpressionFunction valueIfTrue = arguments.at( 1 );
+            ExpressionFunction valueIfFalse = arguments.at( 2 );
+            return [ = ]( ){ return ( condition( ) != 0.0 ) ? valueIfTrue( ) : valueIfFalse( ); };
+        }
+        else if( tables_.count( functionName ) > 0 )
+        {
+            std::shared_ptr< ExpressionTable > table = tables_.at( functionName );
+            ExpressionFunction argument = parseFunctionArguments( functionName, 1 ).at( 0 );
+            return [ = ]( ){ return table->evaluate( argument( ) ); };
+        }
+
+        throwParsingError( "unknown function or table " + functionName );
+        return ExpressionFunction( );
+    }
+
+    ExpressionFunction parsePrimary( )
+    {
+        if( currentToken_.type_ == number_token )
+        {
+            const double value = currentToken_.value_;
+            readNextToken( );
+            return [ = ]( ){ return value; };
+        }
+        else if( isCurrentToken( "(" ) )
+        {
+            readNextToken( );
+            ExpressionFunction innerExpression = parseLogicalOr( );
+            expectToken( ")" );
+            return innerExpression;
+        }
+        else if( currentToken_.type_ != name_token )
+        {
+            throwParsingError( "unexpected '" + currentToken_.text_ + "'" );
+        }
+
+        const std::string name = currentToken_.text_;
+        const unsigned int namePosition = tokenPosition_;
+        readNextToken( );
+        if( isCurrentToken( "(" ) )
+        {
+            return parseFunctionCall( name );
+        }
+        else if( name == "pi" )
+        {
+            const double piValue = std::acos( -1.0 );
+            return [ = ]( ){ return piValue; };
+        }
+        else if( name == "time" )
+        {
+            std::shared_ptr< ExpressionVariableSet > variableSet = variableSet_;
+            return [ = ]( ){ return variableSet->getCurrentTime( ); };
+        }
+
+        const int variableIndex = variableSet_->registerVariableUse( name );
+        if( variableIndex < 0 )
+        {
+            tokenPosition_ = namePosition;
+            throwParsingError( "unknown variable " + name );
+        }
+
+        int elementIndex = 0;
+        if( isCurrentToken( "[" ) )
+        {
+            readNextToken( );
+            if( currentToken_.type_ != number_token || currentToken_.value_ < 0.0 ||
+                    currentToken_.value_ != std::floor( currentToken_.value_ ) )
+            {
+                throwParsingError( "index of variable " + name + " must be a non-negative integer" );
+            }
+            elementIndex = static_cast< int >( currentToken_.value_ );
+            readNextToken( );
+            expectToken( "]" );
+        }
+
+        std::shared_ptr< ExpressionVariableSet > variableSet = variableSet_;
+        return [ = ]( )
+        {
+            const Eigen::VectorXd& variableValue = variableSet->getVariableValue( variableIndex );
+            if( elementIndex >= variableValue.rows( ) )
+            {
+                throw std::runtime_error( "Error when evaluating expression, index " + std::to_string( elementIndex ) +
+                                          " of variable " + name + " is out of range (size " +
+                                          std::to_string( variableValue.rows( ) ) + ")." );
+            }
+            return variableValue( elementIndex );
+        };
+    }
+
+    //! Expression that is compiled
+    std::string expression_;
+
+    //! Variables that can be used in the expression
+    std::shared_ptr< ExpressionVariableSet > variableSet_;
+
+    //! Tables that can be used in the expression (key: name)
+    std::map< std::string, std::shared_ptr< ExpressionTable > > tables_;
+
+    //! Compiled expression
+    ExpressionFunction compiledExpression_;
+
+    //! Current token during compilation
+    Token currentToken_;
+
+    //! Position in the expression after the current token during compilation
+    unsigned int currentPosition_;
+
+    //! Position in the expression of the current token during compilation
+    unsigned int tokenPosition_;
+};
+
+} // namespace expressions
+
+} // namespace tudat
+
+#endif // TUDATPY_COMPILED_EXPRESSION_H
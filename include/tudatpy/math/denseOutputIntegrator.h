@@ -0,0 +1,447 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DENSE_OUTPUT_INTEGRATOR_H
+#define TUDATPY_DENSE_OUTPUT_INTEGRATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! State of the dense output integrator between two steps, from which an integration can be resumed exactly
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+struct DenseOutputIntegratorState
+{
+    //! Current epoch
+    TimeType currentTime_;
+
+    //! State at the current epoch
+    StateType currentState_;
+
+    //! State derivative at the current epoch (first stage of the next step)
+    StateType currentStateDerivative_;
+
+    //! Step size of the next step (signed in the direction of integration)
+    TimeType stepSize_;
+
+    //! Boolean denoting whether the last step was rejected
+    bool lastStepRejected_;
+
+    //! Index of the next output epoch
+    unsigned int outputIndex_;
+
+    //! Number of accepted steps since the start of the integration
+    unsigned int numberOfAcceptedSteps_;
+
+    //! Number of rejected steps since the start of the integration
+    unsigned int numberOfRejectedSteps_;
+
+    //! Number of state derivative evaluations since the start of the integration
+    unsigned int numberOfFunctionEvaluations_;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//! Variable step-size Dormand-Prince 5(4) integrator with continuous extension (dense output)
+/*!
+ *  Variable step-size Dormand-Prince 5(4) integrator (5th order propagation, local extrapolation, FSAL) with the
+ *  4th order continuous extension of Dormand and Prince (Shampine, 1986). The stages of each accepted step are used to
+ *  evaluate the state at all output epochs inside the step, such that the step size is only limited by the error
+ *  tolerances, and the output is not affected by interpolation of the saved states. The state type may be a dynamic-
+ *  or fixed-size Eigen vector.
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+class DormandPrinceDenseOutputIntegrator
+{
+public:
+
+    typedef std::function< StateType( const TimeType, const StateType& ) > StateDerivativeFunction;
+
+    typedef std::function< void( const unsigned int, const TimeType, const StateType& ) > OutputFunction;
+
+    typedef DenseOutputIntegratorState< StateType, TimeType > IntegratorState;
+
+    typedef std::function< void( const IntegratorState& ) > CheckpointFunction;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param stateDerivativeFunction Function returning the state derivative as a function of time and state
+     *  \param relativeErrorTolerance Relative error tolerance per state element
+     *  \param absoluteErrorTolerance Absolute error tolerance per state element
+     *  \param minimumStepSize Minimum (absolute) step size
+     *  \param maximumStepSize Maximum (absolute) step size
+     *  \param safetyFactor Safety factor for the step size control
+     *  \param maximumFactorIncrease Maximum factor by which the step size is increased after a step
+     *  \param minimumFactorDecrease Minimum factor by which the step size is decreased after a rejected step
+     *  \param throwExceptionIfMinimumStepExceeded Boolean denoting whether an exception is thrown if the minimum step
+     *  size does not meet the tolerances (if false, the step is accepted with the minimum step size)
+     */
+    DormandPrinceDenseOutputIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const double relativeErrorTolerance,
+            const double absoluteErrorTolerance,
+            const TimeType minimumStepSize,
+            const TimeType maximumStepSize,
+            const double safetyFactor = 0.8,
+            const double maximumFactorIncrease = 4.0,
+            const double minimumFactorDecrease = 0.1,
+            const bool throwExceptionIfMinimumStepExceeded = true ):
+        stateDerivativeFunction_( stateDerivativeFunction ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        safetyFactor_( safetyFactor ), maximumFactorIncrease_( maximumFactorIncrease ),
+        minimumFactorDecrease_( minimumFactorDecrease ),
+        throwExceptionIfMinimumStepExceeded_( throwExceptionIfMinimumStepExceeded ),
+        numberOfAcceptedSteps_( 0 ), numberOfRejectedSteps_( 0 ), numberOfFunctionEvaluations_( 0 )
+    {
+        if( !( relativeErrorTolerance > 0.0 ) && !( absoluteErrorTolerance > 0.0 ) )
+        {
+            throw std::runtime_error( "Error in dense output integrator, at least one error tolerance must be positive." );
+        }
+        if( !( minimumStepSize > 0.0 ) || maximumStepSize < minimumStepSize )
+        {
+            throw std::runtime_error( "Error in dense output integrator, step size limits are inconsistent." );
+        }
+    }
+
+    //! Function to integrate the state, and evaluate it at a list of output epochs
+    /*!
+     *  Function to integrate the state from an initial epoch to the last output epoch, evaluating the state at each output
+     *  epoch with the continuous extension of the step that contains it. The integration direction is defined by the
+     *  output epochs, which must be monotonic, and not precede the initial epoch (in the direction of integration).
+     *  \param initialTime Initial epoch
+     *  \param initialState Initial state
+     *  \param initialStepSize Initial (absolute) step size
+     *  \param outputEpochs Epochs at which the state is to be evaluated
+     *  \param outputFunction Function called with the index of the output epoch, the epoch and the state, in the order
+     *  of the output epochs
+     *  \param checkpointFunction Function called with the state of the integrator after each accepted step, from which
+     *  the integration can be resumed with resumeIntegrationToOutputEpochs (ignored if empty)
+     */
+    void integrateToOutputEpochs( const TimeType initialTime,
+                                  const StateType& initialState,
+                                  const TimeType initialStepSize,
+                                  const std::vector< TimeType >& outputEpochs,
+                                  const OutputFunction& outputFunction,
+                                  const CheckpointFunction& checkpointFunction = CheckpointFunction( ) )
+    {
+        numberOfAcceptedSteps_ = 0;
+        numberOfRejectedSteps_ = 0;
+        numberOfFunctionEvaluations_ = 0;
+        if( outputEpochs.size( ) == 0 )
+        {
+            return;
+        }
+
+        const double direction = ( outputEpochs.back( ) < initialTime ) ? -1.0 : 1.0;
+        for( unsigned int i = 0; i < outputEpochs.size( ); i++ )
+        {
+            const TimeType previousEpoch = ( i == 0 ) ? initialTime : outputEpochs.at( i - 1 );
+            if( direction * ( outputEpochs.at( i ) - previousEpoch ) < 0.0 )
+            {
+                throw std::runtime_error( "Error in dense output integrator, output epochs must be monotonic, and may not precede the initial epoch." );
+            }
+        }
+
+        IntegratorState integratorState;
+        integratorState.currentTime_ = initialTime;
+        integratorState.currentState_ = initialState;
+        integratorState.currentStateDerivative_ = evaluateStateDerivative( initialTime, initialState );
+        integratorState.stepSize_ = direction * std::min( std::max( std::fabs( initialStepSize ), minimumStepSize_ ),
+                                                          maximumStepSize_ );
+        integratorState.lastStepRejected_ = false;
+        integratorState.outputIndex_ = 0;
+        while( integratorState.outputIndex_ < outputEpochs.size( ) &&
+               outputEpochs.at( integratorState.outputIndex_ ) == initialTime )
+        {
+            outputFunction( integratorState.outputIndex_, initialTime, initialState );
+            integratorState.outputIndex_++;
+        }
+
+        continueIntegration( integratorState, outputEpochs, outputFunction, checkpointFunction );
+    }
+
+    //! Function to resume an integration to a list of output epochs from a saved integrator state
+    /*!
+     *  Function to resume an integration to a list of output epochs from a saved integrator state (as passed to the
+     *  checkpoint function of integrateToOutputEpochs). The integration continues exactly as it would have without
+     *  interruption, calling the output function only for the output epochs that had not yet been reached.
+     *  \param integratorState Saved state of the integrator
+     *  \param outputEpochs Epochs at which the state is to be evaluated (identical to those of the original integration)
+     *  \param outputFunction Function called with the index of the output epoch, the epoch and the state
+     *  \param checkpointFunction Function called with the state of the integrator after each accepted step
+     */
+    void resumeIntegrationToOutputEpochs( const IntegratorState& integratorState,
+                                          const std::vector< TimeType >& outputEpochs,
+                                          const OutputFunction& outputFunction,
+                                          const CheckpointFunction& checkpointFunction = CheckpointFunction( ) )
+    {
+        if( integratorState.outputIndex_ > outputEpochs.size( ) )
+        {
+            throw std::runtime_error( "Error in dense output integrator, saved state is inconsistent with output epochs." );
+        }
+
+        IntegratorState currentIntegratorState = integratorState;
+        numberOfAcceptedSteps_ = integratorState.numberOfAcceptedSteps_;
+        numberOfRejectedSteps_ = integratorState.numberOfRejectedSteps_;
+        numberOfFunctionEvaluations_ = integratorState.numberOfFunctionEvaluations_;
+        continueIntegration( currentIntegratorState, outputEpochs, outputFunction, checkpointFunction );
+    }
+
+    //! Function to retrieve the number of accepted steps of the last integration
+    unsigned int getNumberOfAcceptedSteps( ){ return numberOfAcceptedSteps_; }
+
+    //! Function to retrieve the number of rejected steps of the last integration
+    unsigned int getNumberOfRejectedSteps( ){ return numberOfRejectedSteps_; }
+
+    //! Function to retrieve the number of state derivative evaluations of the last integration
+    unsigned int getNumberOfFunctionEvaluations( ){ return numberOfFunctionEvaluations_; }
+
+private:
+
+    //! Function to continue an integration from the given integrator state, until all output epochs are reached
+    void continueIntegration( IntegratorState& integratorState,
+                              const std::vector< TimeType >& outputEpochs,
+                              const OutputFunction& outputFunction,
+                              const CheckpointFunction& checkpointFunction )
+    {
+        TimeType& currentTime = integratorState.currentTime_;
+        StateType& currentState = integratorState.currentState_;
+        StateType& currentStateDerivative = integratorState.currentStateDerivative_;
+        TimeType& stepSize = integratorState.stepSize_;
+        bool& lastStepRejected = integratorState.lastStepRejected_;
+        unsigned int& outputIndex = integratorState.outputIndex_;
+
+        const double direction = ( stepSize < 0.0 ) ? -1.0 : 1.0;
+        const TimeType finalTime = outputEpochs.back( );
+        while( outputIndex < outputEpochs.size( ) )
+        {
+            // Limit step to final epoch
+            if( direction * ( currentTime + stepSize - finalTime ) > 0.0 )
+            {
+                stepSize = finalTime - currentTime;
+            }
+
+            bool isStepAccepted = false;
+            performStep( currentTime, currentState, currentStateDerivative, stepSize );
+            const double errorNorm = computeErrorNorm( currentState );
+
+            if( errorNorm <= 1.0 || std::fabs( stepSize ) <= minimumStepSize_ )
+            {
+                if( errorNorm > 1.0 && throwExceptionIfMinimumStepExceeded_ )
+                {
+                    throw std::runtime_error( "Error in dense output integrator, minimum step size exceeded at t = " +
+                                              std::to_string( static_cast< double >( currentTime ) ) );
+                }
+
+                // Evaluate continuous extension at output epochs within step
+                const TimeType newTime = ( direction * ( currentTime + stepSize - finalTime ) >= 0.0 ) ?
+                            finalTime : currentTime + stepSize;
+                while( outputIndex < outputEpochs.size( ) && direction * ( outputEpochs.at( outputIndex ) - newTime ) <= 0.0 )
+                {
+                    if( outputEpochs.at( outputIndex ) == newTime )
+                    {
+                        outputFunction( outputIndex, newTime, newState_ );
+                    }
+                    else
+                    {
+                        outputFunction( outputIndex, outputEpochs.at( outputIndex ),
+                                        evaluateContinuousExtension( currentState, stepSize, static_cast< double >(
+                                                                         ( outputEpochs.at( outputIndex ) - currentTime ) / stepSize ) ) );
+                    }
+                    outputIndex++;
+                }
+
+                currentTime = newTime;
+                currentState = newState_;
+                currentStateDerivative = stageDerivatives_[ 6 ];
+                numberOfAcceptedSteps_++;
+                isStepAccepted = true;
+            }
+            else
+            {
+                numberOfRejectedSteps_++;
+            }
+
+            // Compute new step size
+            double stepSizeFactor = ( errorNorm == 0.0 ) ? maximumFactorIncrease_ :
+                                                           safetyFactor_ * std::pow( errorNorm, -0.2 );
+            stepSizeFactor = std::min( std::max( stepSizeFactor, minimumFactorDecrease_ ), maximumFactorIncrease_ );
+            if( lastStepRejected )
+            {
+                stepSizeFactor = std::min( stepSizeFactor, 1.0 );
+            }
+            lastStepRejected = ( errorNorm > 1.0 );
+            stepSize = direction * std::min( std::max( std::fabs( stepSize ) * stepSizeFactor, minimumStepSize_ ),
+                                             maximumStepSize_ );
+
+            if( isStepAccepted && checkpointFunction )
+            {
+                integratorState.numberOfAcceptedSteps_ = numberOfAcceptedSteps_;
+                integratorState.numberOfRejectedSteps_ = numberOfRejectedSteps_;
+                integratorState.numberOfFunctionEvaluations_ = numberOfFunctionEvaluations_;
+                checkpointFunction( integratorState );
+            }
+        }
+    }
+
+    //! Function to evaluate the state derivative, counting the number of evaluations
+    StateType evaluateStateDerivative( const TimeType time, const StateType& state )
+    {
+        numberOfFunctionEvaluations_++;
+        return stateDerivativeFunction_( time, state );
+    }
+
+    //! Function to compute the stages of a step, the new state (5th order) and the error estimate
+    void performStep( const TimeType currentTime, const StateType& currentState,
+                      const StateType& currentStateDerivative, const TimeType stepSize )
+    {
+        const double h = static_cast< double >( stepSize );
+        stageDerivatives_[ 0 ] = currentStateDerivative;
+        stageDerivatives_[ 1 ] = evaluateStateDerivative(
+                    currentTime + stepSize / 5.0,
+                    currentState + h * ( 1.0 / 5.0 ) * stageDerivatives_[ 0 ] );
+        stageDerivatives_[ 2 ] = evaluateStateDerivative(
+                    currentTime + stepSize * 3.0 / 10.0,
+                    currentState + h * ( ( 3.0 / 40.0 ) * stageDerivatives_[ 0 ] + ( 9.0 / 40.0 ) * stageDerivatives_[ 1 ] ) );
+        stageDerivatives_[ 3 ] = evaluateStateDerivative(
+                    currentTime + stepSize * 4.0 / 5.0,
+                    currentState + h * ( ( 44.0 / 45.0 ) * stageDerivatives_[ 0 ] - ( 56.0 / 15.0 ) * stageDerivatives_[ 1 ] +
+                                         ( 32.0 / 9.0 ) * stageDerivatives_[ 2 ] ) );
+        stageDerivatives_[ 4 ] = evaluateStateDerivative(
+                    currentTime + stepSize * 8.0 / 9.0,
+                    currentState + h * ( ( 19372.0 / 6561.0 ) * stageDerivatives_[ 0 ] - ( 25360.0 / 2187.0 ) * stageDerivatives_[ 1 ] +
+                                         ( 64448.0 / 6561.0 ) * stageDerivatives_[ 2 ] - ( 212.0 / 729.0 ) * stageDerivatives_[ 3 ] ) );
+        stageDerivatives_[ 5 ] = evaluateStateDerivative(
+                    currentTime + stepSize,
+                    currentState + h * ( ( 9017.0 / 3168.0 ) * stageDerivatives_[ 0 ] - ( 355.0 / 33.0 ) * stageDerivatives_[ 1 ] +
+                                         ( 46732.0 / 5247.0 ) * stageDerivatives_[ 2 ] + ( 49.0 / 176.0 ) * stageDerivatives_[ 3 ] -
+                                         ( 5103.0 / 18656.0 ) * stageDerivatives_[ 4 ] ) );
+        newState_ = currentState + h * ( ( 35.0 / 384.0 ) * stageDerivatives_[ 0 ] + ( 500.0 / 1113.0 ) * stageDerivatives_[ 2 ] +
+                                         ( 125.0 / 192.0 ) * stageDerivatives_[ 3 ] - ( 2187.0 / 6784.0 ) * stageDerivatives_[ 4 ] +
+                                         ( 11.0 / 84.0 ) * stageDerivatives_[ 5 ] );
+        stageDerivatives_[ 6 ] = evaluateStateDerivative( currentTime + stepSize, newState_ );
+
+        errorEstimate_ = h * ( ( 71.0 / 57600.0 ) * stageDerivatives_[ 0 ] - ( 71.0 / 16695.0 ) * stageDerivatives_[ 2 ] +
+                               ( 71.0 / 1920.0 ) * stageDerivatives_[ 3 ] - ( 17253.0 / 339200.0 ) * stageDerivatives_[ 4 ] +
+                               ( 22.0 / 525.0 ) * stageDerivatives_[ 5 ] - ( 1.0 / 40.0 ) * stageDerivatives_[ 6 ] );
+    }
+
+    //! Function to compute the (maximum) error norm of the last step, relative to the tolerances
+    double computeErrorNorm( const StateType& currentState )
+    {
+        double errorNorm = 0.0;
+        for( int i = 0; i < currentState.rows( ); i++ )
+        {
+            const double stateScale = std::max( std::fabs( currentState( i ) ), std::fabs( newState_( i ) ) );
+            errorNorm = std::max( errorNorm, std::fabs( errorEstimate_( i ) ) /
+                                  ( absoluteErrorTolerance_ + relativeErrorTolerance_ * stateScale ) );
+        }
+        if( !std::isfinite( errorNorm ) )
+        {
+            errorNorm = std::numeric_limits< double >::max( );
+        }
+        return errorNorm;
+    }
+
+    //! Function to evaluate the continuous extension of the last step, at a fraction of the step
+    StateType evaluateContinuousExtension( const StateType& currentState, const TimeType stepSize, const double theta )
+    {
+        const double thetaMinusOne = theta - 1.0;
+        const double thetaSquared = theta * theta;
+        const double termA = thetaSquared * ( 3.0 - 2.0 * theta );
+        const double termB = thetaSquared * thetaMinusOne;
+        const double termC = thetaSquared * thetaMinusOne * thetaMinusOne;
+        const double termD = theta * thetaMinusOne * thetaMinusOne;
+
+        const double x1 = 5.0 * ( 2558722523.0 - 31403016.0 * theta ) / 11282082432.0;
+        const double x3 = 100.0 * ( 882725551.0 - 15701508.0 * theta ) / 32700410799.0;
+        const double x4 = 25.0 * ( 443332067.0 - 31403016.0 * theta ) / 1880347072.0;
+        const double x5 = 32805.0 * ( 23143187.0 - 3489224.0 * theta ) / 199316789632.0;
+        const double x6 = 55.0 * ( 29972135.0 - 7076736.0 * theta ) / 822651844.0;
+        const double x7 = 10.0 * ( 7414447.0 - 829305.0 * theta ) / 29380423.0;
+
+        const double h = static_cast< double >( stepSize );
+        return currentState + h * ( ( termA * ( 35.0 / 384.0 ) - termC * x1 + termD ) * stageDerivatives_[ 0 ] +
+                                    ( termA * ( 500.0 / 1113.0 ) + termC * x3 ) * stageDerivatives_[ 2 ] +
+                                    ( termA * ( 125.0 / 192.0 ) - termC * x4 ) * stageDerivatives_[ 3 ] +
+                                    ( termA * ( -2187.0 / 6784.0 ) + termC * x5 ) * stageDerivatives_[ 4 ] +
+                                    ( termA * ( 11.0 / 84.0 ) - termC * x6 ) * stageDerivatives_[ 5 ] +
+                                    ( termB + termC * x7 ) * stageDerivatives_[ 6 ] );
+    }
+
+    //! Function returning the state derivative as a function of time and state
+    StateDerivativeFunction stateDerivativeFunction_;
+
+    //! Relative error tolerance per state element
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance per state element
+    double absoluteErrorTolerance_;
+
+    //! Minimum (absolute) step size
+    TimeType minimumStepSize_;
+
+    //! Maximum (absolute) step size
+    TimeType maximumStepSize_;
+
+    //! Safety factor for the step size control
+    double safetyFactor_;
+
+    //! Maximum factor by which the step size is increased after a step
+    double maximumFactorIncrease_;
+
+    //! Minimum factor by which the step size is decreased after a rejected step
+    double minimumFactorDecrease_;
+
+    //! Boolean denoting whether an exception is thrown if the minimum step size does not meet the tolerances
+    bool throwExceptionIfMinimumStepExceeded_;
+
+    //! Stage derivatives of the last step (last entry is the derivative at the end of the step)
+    StateType stageDerivatives_[ 7 ];
+
+    //! State at the end of the last step
+    StateType newState_;
+
+    //! Error estimate of the last step
+    StateType errorEstimate_;
+
+    //! Number of accepted steps of the last integration
+    unsigned int numberOfAcceptedSteps_;
+
+    //! Number of rejected steps of the last integration
+    unsigned int numberOfRejectedSteps_;
+
+    //! Number of state derivative evaluations of the last integration
+    unsigned int numberOfFunctionEvaluations_;
+
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+} // namespace numerical_integrators
+
+} // namespace tudat
+
+#endif // TUDATPY_DENSE_OUTPUT_INTEGRATOR_H
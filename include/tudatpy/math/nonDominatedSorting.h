@@ -0,0 +1,391 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Zhang, X., Tian, Y., Cheng, R., Jin, Y., An efficient approach to nondominated sorting for evolutionary
+ *          multiobjective optimization, IEEE Transactions on Evolutionary Computation 19(2), 2015.
+ *      Kung, H.T., Luccio, F., Preparata, F.P., On finding the maxima of a set of vectors, Journal of the ACM 22(4),
+ *          1975.
+ */
+
+#ifndef TUDATPY_NON_DOMINATED_SORTING_H
+#define TUDATPY_NON_DOMINATED_SORTING_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudatpy/basics/parallelFor.h"
+
+namespace tudat
+{
+
+namespace optimization
+{
+
+//! Function to check whether one (minimization) objective vector dominates another.
+/*!
+ *  Function to check whether one (minimization) objective vector dominates another, i.e. whether it is not worse in any
+ *  objective, and strictly better in at least one.
+ *  \param objectiveValues Matrix of objective values, with one row per point
+ *  \param dominatingIndex Row index of the point for which it is checked whether it dominates the other
+ *  \param dominatedIndex Row index of the point for which it is checked whether it is dominated by the other
+ *  \return True if the point at dominatingIndex dominates the point at dominatedIndex
+ */
+inline bool doesPointDominate( const Eigen::MatrixXd& objectiveValues,
+                               const int dominatingIndex,
+                               const int dominatedIndex )
+{
+    bool isStrictlyBetter = false;
+    for( int j = 0; j < objectiveValues.cols( ); j++ )
+    {
+        if( objectiveValues( dominatingIndex, j ) > objectiveValues( dominatedIndex, j ) )
+        {
+            return false;
+        }
+        else if( objectiveValues( dominatingIndex, j ) < objectiveValues( dominatedIndex, j ) )
+        {
+            isStrictlyBetter = true;
+        }
+    }
+    return isStrictlyBetter;
+}
+
+//! Function to find the first front in a (prefix-ordered) list of fronts that does not dominate a point.
+/*!
+ *  Function to find the first front in a list of fronts that does not dominate a point, using a binary search. When
+ *  points are inserted in lexicographic order, the fronts that dominate a given point always form a prefix of the list
+ *  of fronts (Zhang et al., 2015), which makes the binary search valid.
+ *  \param numberOfFronts Number of fronts that currently exist
+ *  \param isDominatedByFront Function returning whether the point is dominated by the front with the given index
+ *  \return Index of the first front that does not dominate the point (numberOfFronts if all fronts dominate it)
+ */
+template< typename FrontCheckFunction >
+int findFirstNonDominatingFront( const int numberOfFronts, const FrontCheckFunction& isDominatedByFront )
+{
+    int lowerIndex = 0;
+    int upperIndex = numberOfFronts;
+    while( lowerIndex < upperIndex )
+    {
+        int middleIndex = lowerIndex + ( upperIndex - lowerIndex ) / 2;
+        if( isDominatedByFront( middleIndex ) )
+        {
+            lowerIndex = middleIndex + 1;
+        }
+        else
+        {
+            upperIndex = middleIndex;
+        }
+    }
+    return lowerIndex;
+}
+
+//! Function to compute the non-dominated sorting ranks of lexicographically sorted, unique, bi-objective points.
+inline std::vector< int > computeBiObjectiveRanks( const Eigen::MatrixXd& objectiveValues,
+                                                   const std::vector< int >& sortedIndices )
+{
+    // For two objectives, the last point added to a front has the smallest second objective in that front.
+    std::vector< double > lastSecondObjectivePerFront;
+    std::vector< int > ranks( sortedIndices.size( ) );
+    for( unsigned int i = 0; i < sortedIndices.size( ); i++ )
+    {
+        const double currentSecondObjective = objectiveValues( sortedIndices.at( i ), 1 );
+        int rank = findFirstNonDominatingFront(
+                    lastSecondObjectivePerFront.size( ), [ & ]( const int frontIndex )
+        {
+            return lastSecondObjectivePerFront.at( frontIndex ) <= currentSecondObjective;
+        } );
+
+        if( rank == static_cast< int >( lastSecondObjectivePerFront.size( ) ) )
+        {
+            lastSecondObjectivePerFront.push_back( currentSecondObjective );
+        }
+        else
+        {
+            lastSecondObjectivePerFront[ rank ] = currentSecondObjective;
+        }
+        ranks[ i ] = rank;
+    }
+    return ranks;
+}
+
+//! Function to compute the non-dominated sorting ranks of lexicographically sorted, unique, tri-objective points.
+/*!
+ *  Function to compute the non-dominated sorting ranks of lexicographically sorted, unique, tri-objective points. For
+ *  each front, the (second, third) objective pairs that are non-dominated in two dimensions are kept as a staircase
+ *  (Kung et al., 1975), with the third objective strictly decreasing as the second objective increases. A point is
+ *  dominated by a front if the staircase entry with the largest second objective not exceeding that of the point has a
+ *  third objective not exceeding that of the point.
+ */
+inline std::vector< int > computeTriObjectiveRanks( const Eigen::MatrixXd& objectiveValues,
+                                                    const std::vector< int >& sortedIndices )
+{
+    std::vector< std::map< double, double > > staircasePerFront;
+    std::vector< int > ranks( sortedIndices.size( ) );
+    for( unsigned int i = 0; i < sortedIndices.size( ); i++ )
+    {
+        const double secondObjective = objectiveValues( sortedIndices.at( i ), 1 );
+        const double thirdObjective = objectiveValues( sortedIndices.at( i ), 2 );
+
+        int rank = findFirstNonDominatingFront(
+                    staircasePerFront.size( ), [ & ]( const int frontIndex )
+        {
+            const std::map< double, double >& staircase = staircasePerFront.at( frontIndex );
+            std::map< double, double >::const_iterator staircaseIterator = staircase.upper_bound( secondObjective );
+            if( staircaseIterator == staircase.begin( ) )
+            {
+                return false;
+            }
+            --staircaseIterator;
+            return staircaseIterator->second <= thirdObjective;
+        } );
+
+        if( rank == static_cast< int >( staircasePerFront.size( ) ) )
+        {
+            staircasePerFront.push_back( std::map< double, double >( ) );
+        }
+
+        // Remove staircase entries that are dominated (in two dimensions) by the new point, and add the new point.
+        std::map< double, double >& staircase = staircasePerFront[ rank ];
+        std::map< double, double >::iterator staircaseIterator = staircase.lower_bound( secondObjective );
+        while( staircaseIterator != staircase.end( ) && staircaseIterator->second >= thirdObjective )
+        {
+            staircaseIterator = staircase.erase( staircaseIterator );
+        }
+        staircase[ secondObjective ] = thirdObjective;
+        ranks[ i ] = rank;
+    }
+    return ranks;
+}
+
+//! Function to compute the non-dominated sorting ranks of lexicographically sorted, unique points (any dimension).
+/*!
+ *  Function to compute the non-dominated sorting ranks of lexicographically sorted, unique points, for any number of
+ *  objectives. The rank of a point is one more than the maximum rank of the points dominating it, and all dominating
+ *  points precede it in lexicographic order. The points are processed in blocks: the contribution of all previous
+ *  blocks to the rank of each point in a block is computed in parallel (binary search over the fronts that have been
+ *  built so far), after which the dominance relations inside the block are resolved sequentially. The result does not
+ *  depend on the number of threads.
+ */
+inline std::vector< int > computeMultiObjectiveRanks( const Eigen::MatrixXd& objectiveValues,
+                                                      const std::vector< int >& sortedIndices,
+                                                      const int numberOfThreads )
+{
+    const unsigned int numberOfPoints = sortedIndices.size( );
+    const unsigned int blockSize = ( utilities::getNumberOfThreadsToUse( numberOfThreads, numberOfPoints ) > 1 ) ?
+                256 : 1;
+
+    std::vector< std::vector< int > > frontMembers;
+    std::vector< int > ranks( numberOfPoints );
+    for( unsigned int blockStart = 0; blockStart < numberOfPoints; blockStart += blockSize )
+    {
+        const unsigned int currentBlockSize = std::min( blockSize, numberOfPoints - blockStart );
+        const int numberOfFronts = frontMembers.size( );
+
+        // Compute minimum rank of each point in block, due to points in previous blocks
+        utilities::parallelFor(
+                    currentBlockSize, ( currentBlockSize > 1 ) ? numberOfThreads : 1,
+                    [ & ]( const unsigned int indexInBlock, const unsigned int )
+        {
+            const int currentIndex = sortedIndices.at( blockStart + indexInBlock );
+            ranks[ blockStart + indexInBlock ] = findFirstNonDominatingFront(
+                        numberOfFronts, [ & ]( const int frontIndex )
+            {
+                const std::vector< int >& currentFront = frontMembers.at( frontIndex );
+                for( int k = static_cast< int >( currentFront.size( ) ) - 1; k >= 0; k-- )
+                {
+                    if( doesPointDominate( objectiveValues, currentFront.at( k ), currentIndex ) )
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            } );
+        } );
+
+        // Resolve dominance inside block, and add points to fronts
+        for( unsigned int i = blockStart; i < blockStart + currentBlockSize; i++ )
+        {
+            for( unsigned int j = blockStart; j < i; j++ )
+            {
+                if( ranks[ j ] >= ranks[ i ] && doesPointDominate( objectiveValues, sortedIndices.at( j ),
+                                                                   sortedIndices.at( i ) ) )
+                {
+                    ranks[ i ] = ranks[ j ] + 1;
+                }
+            }
+
+            if( ranks[ i ] == static_cast< int >( frontMembers.size( ) ) )
+            {
+                frontMembers.push_back( std::vector< int >( ) );
+            }
+            frontMembers[ ranks[ i ] ].push_back( sortedIndices.at( i ) );
+        }
+    }
+    return ranks;
+}
+
+//! Function to compute the non-dominated sorting rank of each point in a set of objective values.
+/*!
+ *  Function to compute the non-dominated sorting rank of each point in a set of objective values. Points with rank 0
+ *  form the Pareto front, points with rank 1 are the Pareto front once rank 0 is removed, etc. Points with identical
+ *  objective values do not dominate each other, and receive the same rank. The points are first sorted
+ *  lexicographically, after which a dedicated O(N log N) algorithm is used for two objectives, an O(N log^2 N) staircase
+ *  algorithm for three objectives, and a (multi-threaded) efficient non-dominated sort for more objectives.
+ *  \param objectiveValues Matrix of objective values, with one row per point and one column per objective
+ *  \param maximizeObjective List of flags denoting, per objective, whether it is to be maximized (instead of
+ *  minimized). If empty, all objectives are minimized.
+ *  \param numberOfThreads Number of threads that is to be used (<= 0 for hardware concurrency)
+ *  \return Non-dominated sorting rank of each point
+ */
+inline Eigen::VectorXi computeNonDominatedSortingRanks( const Eigen::MatrixXd& objectiveValues,
+                                                        const std::vector< bool >& maximizeObjective,
+                                                        const int numberOfThreads = 0 )
+{
+    const int numberOfPoints = objectiveValues.rows( );
+    const int numberOfObjectives = objectiveValues.cols( );
+    if( numberOfObjectives == 0 && numberOfPoints > 0 )
+    {
+        throw std::runtime_error( "Error in non-dominated sorting, no objectives provided." );
+    }
+    if( maximizeObjective.size( ) != 0 && static_cast< int >( maximizeObjective.size( ) ) != numberOfObjectives )
+    {
+        throw std::runtime_error( "Error in non-dominated sorting, number of min/max flags (" +
+                                  std::to_string( maximizeObjective.size( ) ) + ") is not equal to number of objectives (" +
+                                  std::to_string( numberOfObjectives ) + ")." );
+    }
+    if( objectiveValues.hasNaN( ) )
+    {
+        throw std::runtime_error( "Error in non-dominated sorting, NaN objective value detected." );
+    }
+
+    // Convert to pure minimization problem
+    Eigen::MatrixXd minimizationObjectiveValues = objectiveValues;
+    for( unsigned int j = 0; j < maximizeObjective.size( ); j++ )
+    {
+        if( maximizeObjective.at( j ) )
+        {
+            minimizationObjectiveValues.col( j ) *= -1.0;
+        }
+    }
+
+    // Sort points lexicographically
+    std::vector< int > sortedIndices( numberOfPoints );
+    std::iota( sortedIndices.begin( ), sortedIndices.end( ), 0 );
+    auto lexicographicComparison = [ & ]( const int firstIndex, const int secondIndex )
+    {
+        for( int j = 0; j < numberOfObjectives; j++ )
+        {
+            if( minimizationObjectiveValues( firstIndex, j ) != minimizationObjectiveValues( secondIndex, j ) )
+            {
+                return minimizationObjectiveValues( firstIndex, j ) < minimizationObjectiveValues( secondIndex, j );
+            }
+        }
+        return firstIndex < secondIndex;
+    };
+    std::sort( sortedIndices.begin( ), sortedIndices.end( ), lexicographicComparison );
+
+    // Remove duplicate points, which are given the rank of their (unique) representative
+    std::vector< int > uniqueSortedIndices;
+    std::vector< int > uniqueIndexPerSortedIndex( numberOfPoints );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        if( i == 0 || ( minimizationObjectiveValues.row( sortedIndices.at( i ) ).array( ) !=
+                        minimizationObjectiveValues.row( sortedIndices.at( i - 1 ) ).array( ) ).any( ) )
+        {
+            uniqueSortedIndices.push_back( sortedIndices.at( i ) );
+        }
+        uniqueIndexPerSortedIndex[ i ] = uniqueSortedIndices.size( ) - 1;
+    }
+
+    std::vector< int > uniqueRanks;
+    if( numberOfObjectives == 1 )
+    {
+        uniqueRanks.resize( uniqueSortedIndices.size( ) );
+        std::iota( uniqueRanks.begin( ), uniqueRanks.end( ), 0 );
+    }
+    else if( numberOfObjectives == 2 )
+    {
+        uniqueRanks = computeBiObjectiveRanks( minimizationObjectiveValues, uniqueSortedIndices );
+    }
+    else if( numberOfObjectives == 3 )
+    {
+        uniqueRanks = computeTriObjectiveRanks( minimizationObjectiveValues, uniqueSortedIndices );
+    }
+    else
+    {
+        uniqueRanks = computeMultiObjectiveRanks( minimizationObjectiveValues, uniqueSortedIndices, numberOfThreads );
+    }
+
+    Eigen::VectorXi ranks = Eigen::VectorXi::Zero( numberOfPoints );
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        ranks( sortedIndices.at( i ) ) = uniqueRanks.at( uniqueIndexPerSortedIndex.at( i ) );
+    }
+    return ranks;
+}
+
+//! Function to retrieve the indices of the points in each front, from the non-dominated sorting rank of each point.
+/*!
+ *  Function to retrieve the indices of the points in each front, from the non-dominated sorting rank of each point.
+ *  \param ranks Non-dominated sorting rank of each point
+ *  \return List of point indices (in ascending order) per front, with front i containing the points of rank i.
+ */
+inline std::vector< Eigen::VectorXi > getFrontIndicesFromRanks( const Eigen::VectorXi& ranks )
+{
+    const int numberOfFronts = ( ranks.rows( ) > 0 ) ? ranks.maxCoeff( ) + 1 : 0;
+    std::vector< int > frontSizes( numberOfFronts, 0 );
+    for( int i = 0; i < ranks.rows( ); i++ )
+    {
+        frontSizes[ ranks( i ) ]++;
+    }
+
+    std::vector< Eigen::VectorXi > frontIndices( numberOfFronts );
+    for( int i = 0; i < numberOfFronts; i++ )
+    {
+        frontIndices[ i ].resize( frontSizes.at( i ) );
+        frontSizes[ i ] = 0;
+    }
+    for( int i = 0; i < ranks.rows( ); i++ )
+    {
+        frontIndices[ ranks( i ) ]( frontSizes[ ranks( i ) ]++ ) = i;
+    }
+    return frontIndices;
+}
+
+//! Function to perform a non-dominated sorting of a set of objective values.
+/*!
+ *  Function to perform a non-dominated sorting of a set of objective values, see computeNonDominatedSortingRanks.
+ *  \param objectiveValues Matrix of objective values, with one row per point and one column per objective
+ *  \param maximizeObjective List of flags denoting, per objective, whether it is to be maximized (instead of
+ *  minimized). If empty, all objectives are minimized.
+ *  \param numberOfThreads Number of threads that is to be used (<= 0 for hardware concurrency)
+ *  \return Pair with the point indices per front (first) and the rank of each point (second)
+ */
+inline std::pair< std::vector< Eigen::VectorXi >, Eigen::VectorXi > performNonDominatedSorting(
+        const Eigen::MatrixXd& objectiveValues,
+        const std::vector< bool >& maximizeObjective,
+        const int numberOfThreads = 0 )
+{
+    Eigen::VectorXi ranks = computeNonDominatedSortingRanks( objectiveValues, maximizeObjective, numberOfThreads );
+    return std::make_pair( getFrontIndicesFromRanks( ranks ), ranks );
+}
+
+} // namespace optimization
+
+} // namespace tudat
+
+#endif // TUDATPY_NON_DOMINATED_SORTING_H
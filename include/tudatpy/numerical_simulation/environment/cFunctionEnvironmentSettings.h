@@ -0,0 +1,161 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_C_FUNCTION_ENVIRONMENT_SETTINGS_H
+#define TUDATPY_C_FUNCTION_ENVIRONMENT_SETTINGS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/simulation/environment_setup.h"
+
+#include "tudatpy/basics/cFunctionPointers.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Function to create custom ephemeris settings, with the state computed by a C function
+/*!
+ *  Function to create custom ephemeris settings, with the state computed by a C function (see cFunctionPointers.h) with
+ *  signature void(double time, double* state, void* userData), writing the 6 Cartesian state elements.
+ *  \param stateFunctionAddress Address of the C function computing the state
+ *  \param frameOrigin Origin of the frame in which the state is defined
+ *  \param frameOrientation Orientation of the frame in which the state is defined
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \return Ephemeris settings
+ */
+inline std::shared_ptr< EphemerisSettings > customEphemerisSettingsFromCFunction(
+        const std::uintptr_t stateFunctionAddress,
+        const std::string& frameOrigin = "SSB",
+        const std::string& frameOrientation = "ECLIPJ2000",
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return customEphemerisSettings(
+                utilities::createVectorFunctionOfTimeFromCFunction< 6 >(
+                    stateFunctionAddress, userDataAddress, "custom ephemeris state" ),
+                frameOrigin, frameOrientation );
+}
+
+//! Function to create scaled ephemeris settings, with the scaling vector computed by a C function
+/*!
+ *  Function to create scaled ephemeris settings, with the scaling vector computed by a C function (see
+ *  cFunctionPointers.h) with signature void(double time, double* scaling, void* userData), writing 6 elements.
+ *  \param unscaledEphemerisSettings Settings of the ephemeris that is to be scaled
+ *  \param scalingFunctionAddress Address of the C function computing the scaling vector
+ *  \param isScalingAbsolute Boolean denoting whether the scaling is absolute (added) or relative (multiplied)
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \return Ephemeris settings
+ */
+inline std::shared_ptr< EphemerisSettings > scaledEphemerisSettingsFromCFunction(
+        const std::shared_ptr< EphemerisSettings > unscaledEphemerisSettings,
+        const std::uintptr_t scalingFunctionAddress,
+        const bool isScalingAbsolute = false,
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return scaledEphemerisSettings(
+                unscaledEphemerisSettings,
+                utilities::createVectorFunctionOfTimeFromCFunction< 6 >(
+                    scalingFunctionAddress, userDataAddress, "ephemeris scaling" ),
+                isScalingAbsolute );
+}
+
+//! Function to create custom constant-temperature atmosphere settings, with the density computed by a C function
+/*!
+ *  Function to create custom constant-temperature atmosphere settings, with the density computed by a C function (see
+ *  cFunctionPointers.h) with signature double(double altitude, double longitude, double latitude, double time,
+ *  void* userData).
+ *  \param densityFunctionAddress Address of the C function computing the density
+ *  \param constantTemperature Constant temperature of the atmosphere
+ *  \param specificGasConstant Specific gas constant of the atmosphere
+ *  \param ratioOfSpecificHeats Ratio of specific heats of the atmosphere
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \return Atmosphere settings
+ */
+inline std::shared_ptr< AtmosphereSettings > customConstantTemperatureAtmosphereSettingsFromCFunction(
+        const std::uintptr_t densityFunctionAddress,
+        const double constantTemperature,
+        const double specificGasConstant = physical_constants::SPECIFIC_GAS_CONSTANT_AIR,
+        const double ratioOfSpecificHeats = 1.4,
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return customConstantTemperatureAtmosphereSettings(
+                utilities::createFourDimensionalScalarFunctionFromCFunction(
+                    densityFunctionAddress, userDataAddress, "custom atmosphere density" ),
+                constantTemperature, specificGasConstant, ratioOfSpecificHeats );
+}
+
+//! Function to create custom aerodynamic coefficient settings, with the force coefficients computed by a C function
+/*!
+ *  Function to create custom aerodynamic coefficient settings, with the force coefficients computed by a C function
+ *  (see cFunctionPointers.h) with signature void(const double* independentVariables, int numberOfIndependentVariables,
+ *  double* coefficients, void* userData), writing the 3 force coefficients.
+ *  \param forceCoefficientFunctionAddress Address of the C function computing the force coefficients
+ *  \param referenceArea Reference area of the coefficients
+ *  \param independentVariableNames Independent variables of the coefficients (in the order passed to the C function)
+ *  \param areCoefficientsInAerodynamicFrame Boolean denoting whether the coefficients are in the aerodynamic frame
+ *  \param areCoefficientsInNegativeAxisDirection Boolean denoting whether the coefficients are in negative axis direction
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \return Aerodynamic coefficient settings
+ */
+inline std::shared_ptr< AerodynamicCoefficientSettings > customAerodynamicCoefficientSettingsFromCFunction(
+        const std::uintptr_t forceCoefficientFunctionAddress,
+        const double referenceArea,
+        const std::vector< aerodynamics::AerodynamicCoefficientsIndependentVariables > independentVariableNames,
+        const bool areCoefficientsInAerodynamicFrame = true,
+        const bool areCoefficientsInNegativeAxisDirection = true,
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return customAerodynamicCoefficientSettings(
+                utilities::createVectorFunctionOfVectorFromCFunction< 3 >(
+                    forceCoefficientFunctionAddress, userDataAddress, "custom aerodynamic force coefficients" ),
+                referenceArea, independentVariableNames,
+                areCoefficientsInAerodynamicFrame, areCoefficientsInNegativeAxisDirection );
+}
+
+//! Function to create scaled aerodynamic coefficient settings, with the scaling vectors computed by C functions
+/*!
+ *  Function to create scaled aerodynamic coefficient settings, with the force and moment scaling vectors computed by C
+ *  functions (see cFunctionPointers.h) with signature void(double time, double* scaling, void* userData), writing 3
+ *  elements each.
+ *  \param unscaledCoefficientSettings Settings of the coefficients that are to be scaled
+ *  \param forceScalingFunctionAddress Address of the C function computing the force coefficient scaling
+ *  \param momentScalingFunctionAddress Address of the C function computing the moment coefficient scaling
+ *  \param isScalingAbsolute Boolean denoting whether the scaling is absolute (added) or relative (multiplied)
+ *  \param userDataAddress Address of the user data passed to both C functions
+ *  \return Aerodynamic coefficient settings
+ */
+inline std::shared_ptr< AerodynamicCoefficientSettings > scaledAerodynamicCoefficientSettingsFromCFunction(
+        const std::shared_ptr< AerodynamicCoefficientSettings > unscaledCoefficientSettings,
+        const std::uintptr_t forceScalingFunctionAddress,
+        const std::uintptr_t momentScalingFunctionAddress,
+        const bool isScalingAbsolute = false,
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return scaledAerodynamicCoefficientSettings(
+                unscaledCoefficientSettings,
+                utilities::createVectorFunctionOfTimeFromCFunction< 3 >(
+                    forceScalingFunctionAddress, userDataAddress, "aerodynamic force coefficient scaling" ),
+                utilities::createVectorFunctionOfTimeFromCFunction< 3 >(
+                    momentScalingFunctionAddress, userDataAddress, "aerodynamic moment coefficient scaling" ),
+                isScalingAbsolute );
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_C_FUNCTION_ENVIRONMENT_SETTINGS_H
@@ -0,0 +1,230 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_CACHED_EPHEMERIS_H
+#define TUDATPY_CACHED_EPHEMERIS_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "tudat/astro/ephemerides/ephemeris.h"
+#include "tudat/astro/ephemerides/tabulatedEphemeris.h"
+#include "tudat/simulation/environment_setup/body.h"
+
+#include "tudatpy/numerical_simulation/environment/serializedSpiceAccess.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Ephemeris that stores the states computed by another ephemeris, and returns the stored state when it is requested again
+/*!
+ *  Ephemeris that stores the states computed by another ephemeris, and returns the stored state when it is requested
+ *  again at the exact same epoch. Observation models with common link ends (e.g. range and Doppler observables from
+ *  the same station to the same spacecraft) request the states of the link ends at identical epochs during their
+ *  light-time iterations, such that these requests are served from the cache. Since stored states are returned
+ *  unmodified, the results are identical to those obtained without the cache. The cache is safe for concurrent use:
+ *  lookups only take a shared (read) lock, such that concurrent requests that are served from the cache do not block
+ *  each other, while storing a new state takes an exclusive lock. The cache is cleared when it reaches its maximum
+ *  number of entries.
+ */
+class CachedEphemeris: public Ephemeris
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param originalEphemeris Ephemeris from which the states are computed
+     *  \param maximumNumberOfEntries Number of stored states at which the cache is cleared
+     */
+    CachedEphemeris( const std::shared_ptr< Ephemeris > originalEphemeris,
+                     const unsigned int maximumNumberOfEntries = 1000000 ):
+        Ephemeris( originalEphemeris->getReferenceFrameOrigin( ), originalEphemeris->getReferenceFrameOrientation( ) ),
+        originalEphemeris_( originalEphemeris ), maximumNumberOfEntries_( maximumNumberOfEntries ),
+        numberOfHits_( 0 ), numberOfMisses_( 0 ){ }
+
+    //! Function to retrieve the state at a given epoch, from the cache if available
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch )
+    {
+        {
+            std::shared_lock< std::shared_timed_mutex > cacheLock( cacheMutex_ );
+            auto cacheIterator = stateCache_.find( secondsSinceEpoch );
+            if( cacheIterator != stateCache_.end( ) )
+            {
+                numberOfHits_++;
+                return cacheIterator->second;
+            }
+        }
+
+        Eigen::Vector6d cartesianState = originalEphemeris_->getCartesianState( secondsSinceEpoch );
+
+        std::unique_lock< std::shared_timed_mutex > cacheLock( cacheMutex_ );
+        numberOfMisses_++;
+        if( stateCache_.size( ) >= maximumNumberOfEntries_ )
+        {
+            stateCache_.clear( );
+        }
+        stateCache_[ secondsSinceEpoch ] = cartesianState;
+        return cartesianState;
+    }
+
+    //! Function to retrieve the ephemeris from which the states are computed
+    std::shared_ptr< Ephemeris > getOriginalEphemeris( ){ return originalEphemeris_; }
+
+    //! Function to retrieve the number of requests that were served from the cache
+    unsigned long long getNumberOfHits( )
+    {
+        return numberOfHits_;
+    }
+
+    //! Function to retrieve the number of requests for which the state had to be computed
+    unsigned long long getNumberOfMisses( )
+    {
+        return numberOfMisses_;
+    }
+
+    //! Function to retrieve the fraction of requests that were served from the cache
+    double getHitRate( )
+    {
+        std::unique_lock< std::shared_timed_mutex > cacheLock( cacheMutex_ );
+        const unsigned long long numberOfHits = numberOfHits_;
+        const unsigned long long numberOfMisses = numberOfMisses_;
+        return ( numberOfHits + numberOfMisses ) == 0 ? 0.0 :
+                static_cast< double >( numberOfHits ) / static_cast< double >( numberOfHits + numberOfMisses );
+    }
+
+    //! Function to clear the cache and reset the hit/miss counters
+    void clearCache( )
+    {
+        std::unique_lock< std::shared_timed_mutex > cacheLock( cacheMutex_ );
+        stateCache_.clear( );
+        numberOfHits_ = 0;
+        numberOfMisses_ = 0;
+    }
+
+private:
+
+    //! Ephemeris from which the states are computed
+    std::shared_ptr< Ephemeris > originalEphemeris_;
+
+    //! Number of stored states at which the cache is cleared
+    unsigned int maximumNumberOfEntries_;
+
+    //! Stored states (key: epoch)
+    std::unordered_map< double, Eigen::Vector6d, std::hash< double >, std::equal_to< double >,
+    Eigen::aligned_allocator< std::pair< const double, Eigen::Vector6d > > > stateCache_;
+
+    //! Number of requests that were served from the cache (incremented under a shared lock)
+    std::atomic< unsigned long long > numberOfHits_;
+
+    //! Number of requests for which the state had to be computed
+    std::atomic< unsigned long long > numberOfMisses_;
+
+    //! Mutex protecting the cache (shared for lookups, exclusive for modifications)
+    std::shared_timed_mutex cacheMutex_;
+};
+
+} // namespace ephemerides
+
+namespace simulation_setup
+{
+
+//! Function to replace the ephemerides of a list of bodies by cached ephemerides
+/*!
+ *  Function to replace the ephemerides of a list of bodies by cached ephemerides (see CachedEphemeris). Tabulated
+ *  ephemerides cannot be cached, as they are reset during an estimation (when the dynamics is re-propagated). Since
+ *  cache misses of a single cache may be computed concurrently, Spice ephemerides are serialized (see
+ *  SerializedEphemeris) before they are cached.
+ *  \param bodies System of bodies
+ *  \param bodyNames Names of the bodies of which the ephemeris is to be cached
+ *  \param maximumNumberOfEntries Number of stored states at which each cache is cleared
+ *  \return Cached ephemerides (in the order of bodyNames)
+ */
+inline std::vector< std::shared_ptr< ephemerides::CachedEphemeris > > addEphemerisCaches(
+        const SystemOfBodies& bodies,
+        const std::vector< std::string >& bodyNames,
+        const unsigned int maximumNumberOfEntries = 1000000 )
+{
+    std::vector< std::shared_ptr< ephemerides::CachedEphemeris > > cachedEphemerides;
+    for( unsigned int i = 0; i < bodyNames.size( ); i++ )
+    {
+        std::shared_ptr< ephemerides::Ephemeris > currentEphemeris = bodies.at( bodyNames.at( i ) )->getEphemeris( );
+        if( currentEphemeris == nullptr )
+        {
+            throw std::runtime_error( "Error when adding ephemeris cache, body " + bodyNames.at( i ) + " has no ephemeris." );
+        }
+        else if( std::dynamic_pointer_cast< ephemerides::CachedEphemeris >( currentEphemeris ) != nullptr )
+        {
+            throw std::runtime_error( "Error when adding ephemeris cache, ephemeris of body " + bodyNames.at( i ) +
+                                      " is already cached." );
+        }
+        else if( std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< double, double > >( currentEphemeris ) != nullptr ||
+                 std::dynamic_pointer_cast< ephemerides::TabulatedCartesianEphemeris< long double, double > >( currentEphemeris ) != nullptr )
+        {
+            throw std::runtime_error( "Error when adding ephemeris cache, ephemeris of body " + bodyNames.at( i ) +
+                                      " is tabulated, and cannot be cached." );
+        }
+
+        if( ephemerides::isSpiceEphemeris( currentEphemeris ) )
+        {
+            currentEphemeris = std::make_shared< ephemerides::SerializedEphemeris >(
+                        currentEphemeris, ephemerides::getSpiceMutex( ) );
+        }
+        std::shared_ptr< ephemerides::CachedEphemeris > cachedEphemeris =
+                std::make_shared< ephemerides::CachedEphemeris >( currentEphemeris, maximumNumberOfEntries );
+        bodies.at( bodyNames.at( i ) )->setEphemeris( cachedEphemeris );
+        cachedEphemerides.push_back( cachedEphemeris );
+    }
+    return cachedEphemerides;
+}
+
+//! Function to restore the original ephemerides of a list of bodies, of which the ephemerides were cached (see
+//! addEphemerisCaches)
+inline void removeEphemerisCaches(
+        const SystemOfBodies& bodies,
+        const std::vector< std::string >& bodyNames )
+{
+    for( unsigned int i = 0; i < bodyNames.size( ); i++ )
+    {
+        std::shared_ptr< ephemerides::CachedEphemeris > cachedEphemeris =
+                std::dynamic_pointer_cast< ephemerides::CachedEphemeris >( bodies.at( bodyNames.at( i ) )->getEphemeris( ) );
+        if( cachedEphemeris == nullptr )
+        {
+            throw std::runtime_error( "Error when removing ephemeris cache, ephemeris of body " + bodyNames.at( i ) +
+                                      " is not cached." );
+        }
+        std::shared_ptr< ephemerides::Ephemeris > originalEphemeris = cachedEphemeris->getOriginalEphemeris( );
+        if( std::dynamic_pointer_cast< ephemerides::SerializedEphemeris >( originalEphemeris ) != nullptr )
+        {
+            originalEphemeris = std::dynamic_pointer_cast< ephemerides::SerializedEphemeris >(
+                        originalEphemeris )->getOriginalEphemeris( );
+        }
+        bodies.at( bodyNames.at( i ) )->setEphemeris( originalEphemeris );
+    }
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_CACHED_EPHEMERIS_H
@@ -0,0 +1,153 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_SERIALIZED_SPICE_ACCESS_H
+#define TUDATPY_SERIALIZED_SPICE_ACCESS_H
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/ephemerides/ephemeris.h"
+#include "tudat/interface/spice/spiceEphemeris.h"
+#include "tudat/interface/spice/spiceRotationalEphemeris.h"
+#include "tudat/simulation/environment_setup/body.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Function to retrieve the mutex with which calls to the Spice library from multiple threads are serialized
+inline std::mutex& getSpiceMutex( )
+{
+    static std::mutex spiceMutex;
+    return spiceMutex;
+}
+
+//! Ephemeris that serializes the calls to an ephemeris that is not thread-safe (such as a Spice ephemeris)
+/*!
+ *  Ephemeris that serializes the calls to an ephemeris that is not thread-safe (such as a Spice ephemeris), by locking
+ *  a mutex for each state that is retrieved. The states are those of the original ephemeris, unmodified.
+ */
+class SerializedEphemeris: public Ephemeris
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param originalEphemeris Ephemeris from which the states are computed
+     *  \param ephemerisMutex Mutex that is locked while the original ephemeris is called
+     */
+    SerializedEphemeris( const std::shared_ptr< Ephemeris > originalEphemeris,
+                         std::mutex& ephemerisMutex ):
+        Ephemeris( originalEphemeris->getReferenceFrameOrigin( ), originalEphemeris->getReferenceFrameOrientation( ) ),
+        originalEphemeris_( originalEphemeris ), ephemerisMutex_( ephemerisMutex ){ }
+
+    //! Function to retrieve the state at a given epoch from the original ephemeris
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch )
+    {
+        std::lock_guard< std::mutex > ephemerisLock( ephemerisMutex_ );
+        return originalEphemeris_->getCartesianState( secondsSinceEpoch );
+    }
+
+    //! Function to retrieve the ephemeris from which the states are computed
+    std::shared_ptr< Ephemeris > getOriginalEphemeris( ){ return originalEphemeris_; }
+
+private:
+
+    //! Ephemeris from which the states are computed
+    std::shared_ptr< Ephemeris > originalEphemeris_;
+
+    //! Mutex that is locked while the original ephemeris is called
+    std::mutex& ephemerisMutex_;
+};
+
+//! Function to check whether an ephemeris calls the Spice library
+inline bool isSpiceEphemeris( const std::shared_ptr< Ephemeris > ephemeris )
+{
+    return std::dynamic_pointer_cast< SpiceEphemeris >( ephemeris ) != nullptr;
+}
+
+} // namespace ephemerides
+
+namespace simulation_setup
+{
+
+//! Function to check whether any body in a system of bodies has a rotation model that calls the Spice library
+inline bool isSpiceRotationModelUsed( const SystemOfBodies& bodies )
+{
+    for( auto bodyIterator : bodies.getMap( ) )
+    {
+        if( std::dynamic_pointer_cast< ephemerides::SpiceRotationalEphemeris >(
+                    bodyIterator.second->getRotationalEphemeris( ) ) != nullptr )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Class that serializes the calls to the Spice ephemerides of a system of bodies during its lifetime
+/*!
+ *  Class that serializes the calls to the Spice ephemerides of a system of bodies during its lifetime, such that the
+ *  environment can be used from multiple threads (the Spice library is not thread-safe). On construction, each
+ *  ephemeris that calls the Spice library (see isSpiceEphemeris) is replaced by a SerializedEphemeris, locking a single
+ *  mutex for all bodies (see getSpiceMutex), and on destruction, the original ephemerides are restored. Spice rotation
+ *  models are not serialized (see isSpiceRotationModelUsed).
+ */
+class ScopedSpiceEphemerisSerialization
+{
+public:
+
+    //! Constructor, replacing the Spice ephemerides of the bodies by serialized ephemerides
+    ScopedSpiceEphemerisSerialization( const SystemOfBodies& bodies )
+    {
+        for( auto bodyIterator : bodies.getMap( ) )
+        {
+            std::shared_ptr< ephemerides::Ephemeris > originalEphemeris = bodyIterator.second->getEphemeris( );
+            if( ephemerides::isSpiceEphemeris( originalEphemeris ) )
+            {
+                bodyIterator.second->setEphemeris( std::make_shared< ephemerides::SerializedEphemeris >(
+                                                       originalEphemeris, ephemerides::getSpiceMutex( ) ) );
+                originalEphemerides_.push_back( std::make_pair( bodyIterator.second, originalEphemeris ) );
+            }
+        }
+    }
+
+    //! Destructor, restoring the original ephemerides of the bodies
+    ~ScopedSpiceEphemerisSerialization( )
+    {
+        for( unsigned int i = 0; i < originalEphemerides_.size( ); i++ )
+        {
+            originalEphemerides_.at( i ).first->setEphemeris( originalEphemerides_.at( i ).second );
+        }
+    }
+
+    ScopedSpiceEphemerisSerialization( const ScopedSpiceEphemerisSerialization& ) = delete;
+
+    ScopedSpiceEphemerisSerialization& operator=( const ScopedSpiceEphemerisSerialization& ) = delete;
+
+private:
+
+    //! Bodies of which the ephemeris is serialized, with their original ephemeris
+    std::vector< std::pair< std::shared_ptr< Body >, std::shared_ptr< ephemerides::Ephemeris > > > originalEphemerides_;
+};
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_SERIALIZED_SPICE_ACCESS_H
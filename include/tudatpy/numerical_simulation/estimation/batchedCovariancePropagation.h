@@ -0,0 +1,234 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_BATCHED_COVARIANCE_PROPAGATION_H
+#define TUDATPY_BATCHED_COVARIANCE_PROPAGATION_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/propagators/stateTransitionMatrixInterface.h"
+
+#include "tudatpy/basics/parallelFor.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Row-major matrix, used to map the matrices of a batch onto a contiguous (epoch x row x column) array
+typedef Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > RowMajorMatrixXd;
+
+//! Function to retrieve the size of the matrices returned by a state transition and sensitivity matrix interface
+/*!
+ *  Function to retrieve the size of the matrices returned by a state transition and sensitivity matrix interface
+ *  \param stateTransitionInterface Interface from which the matrices are retrieved
+ *  \param useFullParameterVector Boolean denoting whether the full matrix (getFullCombinedStateTransitionAndSensitivityMatrix)
+ *  or the combined matrix (getCombinedStateTransitionAndSensitivityMatrix) is retrieved
+ *  \return Number of rows and number of columns of the matrices
+ */
+inline std::pair< int, int > getCombinedStateTransitionAndSensitivityMatrixSize(
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const bool useFullParameterVector )
+{
+    const int numberOfRows = stateTransitionInterface->getStateTransitionMatrixSize( );
+    const int numberOfColumns = useFullParameterVector ? stateTransitionInterface->getFullParameterVectorSize( ) :
+                                                         ( stateTransitionInterface->getStateTransitionMatrixSize( ) +
+                                                           stateTransitionInterface->getSensitivityMatrixSize( ) );
+    return std::make_pair( numberOfRows, numberOfColumns );
+}
+
+//! Function to retrieve the state transition and sensitivity matrices at a list of epochs
+/*!
+ *  Function to retrieve the state transition and sensitivity matrices at a list of epochs, writing them into a
+ *  contiguous (row-major) array of size (epochs x rows x columns), with the number of rows and columns given by
+ *  getCombinedStateTransitionAndSensitivityMatrixSize.
+ *  \param stateTransitionInterface Interface from which the matrices are retrieved
+ *  \param evaluationTimes Epochs at which the matrices are to be retrieved
+ *  \param useFullParameterVector Boolean denoting whether the full or the combined matrix is retrieved
+ *  \param outputData Array to which the matrices are written (must have the size given above)
+ */
+inline void getCombinedStateTransitionAndSensitivityMatrices(
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        const bool useFullParameterVector,
+        double* outputData )
+{
+    const std::pair< int, int > matrixSize =
+            getCombinedStateTransitionAndSensitivityMatrixSize( stateTransitionInterface, useFullParameterVector );
+    const std::size_t numberOfMatrixEntries = matrixSize.first * matrixSize.second;
+
+    for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+    {
+        Eigen::MatrixXd currentMatrix = useFullParameterVector ?
+                    stateTransitionInterface->getFullCombinedStateTransitionAndSensitivityMatrix( evaluationTimes.at( i ) ) :
+                    stateTransitionInterface->getCombinedStateTransitionAndSensitivityMatrix( evaluationTimes.at( i ) );
+        if( currentMatrix.rows( ) != matrixSize.first || currentMatrix.cols( ) != matrixSize.second )
+        {
+            throw std::runtime_error( "Error when retrieving state transition matrices, matrix size is inconsistent." );
+        }
+        Eigen::Map< RowMajorMatrixXd >( outputData + i * numberOfMatrixEntries, matrixSize.first, matrixSize.second ) =
+                currentMatrix;
+    }
+}
+
+//! Function to process the full state transition and sensitivity matrices at a list of epochs on a number of threads
+/*!
+ *  Function to process the full state transition and sensitivity matrices at a list of epochs on a number of threads.
+ *  The epochs are processed in chunks, which are distributed over the threads. The matrices of a chunk are retrieved
+ *  from the interface by one thread at a time (the interface is not safe for concurrent use), after which the
+ *  processing function is called concurrently for each epoch in the chunk.
+ *  \param stateTransitionInterface Interface from which the state transition and sensitivity matrices are retrieved
+ *  \param evaluationTimes Epochs at which the matrices are to be processed
+ *  \param processingFunction Function called with the index of the epoch, and the matrix at that epoch
+ *  \param numberOfThreads Number of threads to use (<= 0 for hardware concurrency)
+ *  \param numberOfEpochsPerChunk Number of epochs that is processed as a single task
+ */
+template< typename ProcessingFunction >
+void processFullStateTransitionMatricesInParallel(
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        const ProcessingFunction& processingFunction,
+        const int numberOfThreads,
+        const unsigned int numberOfEpochsPerChunk )
+{
+    if( numberOfEpochsPerChunk == 0 )
+    {
+        throw std::runtime_error( "Error when processing state transition matrices, number of epochs per chunk must be positive." );
+    }
+
+    const std::pair< int, int > matrixSize =
+            getCombinedStateTransitionAndSensitivityMatrixSize( stateTransitionInterface, true );
+    const std::size_t numberOfMatrixEntries = matrixSize.first * matrixSize.second;
+    std::vector< std::pair< unsigned int, unsigned int > > chunkRanges =
+            utilities::getChunkRanges( evaluationTimes.size( ), numberOfEpochsPerChunk );
+    const unsigned int numberOfThreadsToUse =
+            utilities::getNumberOfThreadsToUse( numberOfThreads, chunkRanges.size( ) );
+
+    std::vector< std::vector< double > > stateTransitionBufferPerThread( numberOfThreadsToUse );
+    std::mutex interfaceMutex;
+    utilities::parallelFor(
+                chunkRanges.size( ), numberOfThreadsToUse,
+                [ & ]( const unsigned int chunkIndex, const unsigned int threadIndex )
+    {
+        const unsigned int startIndex = chunkRanges.at( chunkIndex ).first;
+        const unsigned int numberOfEpochs = chunkRanges.at( chunkIndex ).second;
+
+        std::vector< double >& stateTransitionBuffer = stateTransitionBufferPerThread.at( threadIndex );
+        stateTransitionBuffer.resize( numberOfEpochs * numberOfMatrixEntries );
+        {
+            std::lock_guard< std::mutex > interfaceLock( interfaceMutex );
+            getCombinedStateTransitionAndSensitivityMatrices(
+                        stateTransitionInterface,
+                        std::vector< double >( evaluationTimes.begin( ) + startIndex,
+                                               evaluationTimes.begin( ) + startIndex + numberOfEpochs ),
+                        true, stateTransitionBuffer.data( ) );
+        }
+
+        for( unsigned int i = 0; i < numberOfEpochs; i++ )
+        {
+            processingFunction( startIndex + i, Eigen::Map< const RowMajorMatrixXd >(
+                                    stateTransitionBuffer.data( ) + i * numberOfMatrixEntries,
+                                    matrixSize.first, matrixSize.second ) );
+        }
+    } );
+}
+
+//! Function to check whether a covariance matrix is consistent with a state transition and sensitivity matrix interface
+inline void checkInitialCovarianceSize(
+        const Eigen::MatrixXd& initialCovariance,
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface )
+{
+    const int numberOfParameters = stateTransitionInterface->getFullParameterVectorSize( );
+    if( initialCovariance.rows( ) != numberOfParameters || initialCovariance.cols( ) != numberOfParameters )
+    {
+        throw std::runtime_error( "Error when propagating covariance, initial covariance size is inconsistent with "
+                                  "state transition interface." );
+    }
+}
+
+//! Function to propagate a covariance matrix to a list of epochs, writing the result into a contiguous array
+/*!
+ *  Function to propagate a covariance matrix to a list of epochs, as done by propagateCovariance, but writing the
+ *  result into a contiguous (row-major) array of size (epochs x states x states), instead of a map of matrices. The
+ *  products Phi P Phi^T are computed concurrently (see processFullStateTransitionMatricesInParallel).
+ *  \param initialCovariance Covariance of the full parameter vector at the initial epoch
+ *  \param stateTransitionInterface Interface from which the state transition and sensitivity matrices are retrieved
+ *  \param evaluationTimes Epochs at which the covariance is to be computed
+ *  \param outputData Array to which the covariance matrices are written (must have the size given above)
+ *  \param numberOfThreads Number of threads to use (<= 0 for hardware concurrency)
+ *  \param numberOfEpochsPerChunk Number of epochs that is processed as a single task
+ */
+inline void propagateCovarianceToArray(
+        const Eigen::MatrixXd& initialCovariance,
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        double* outputData,
+        const int numberOfThreads = 0,
+        const unsigned int numberOfEpochsPerChunk = 1000 )
+{
+    checkInitialCovarianceSize( initialCovariance, stateTransitionInterface );
+    const std::size_t numberOfStates = stateTransitionInterface->getStateTransitionMatrixSize( );
+
+    processFullStateTransitionMatricesInParallel(
+                stateTransitionInterface, evaluationTimes,
+                [ & ]( const unsigned int epochIndex, const Eigen::Map< const RowMajorMatrixXd >& stateTransitionMatrix )
+    {
+        Eigen::Map< RowMajorMatrixXd > propagatedCovariance(
+                    outputData + epochIndex * numberOfStates * numberOfStates, numberOfStates, numberOfStates );
+        propagatedCovariance.noalias( ) = stateTransitionMatrix * initialCovariance * stateTransitionMatrix.transpose( );
+    }, numberOfThreads, numberOfEpochsPerChunk );
+}
+
+//! Function to propagate the formal errors to a list of epochs, writing the result into a contiguous array
+/*!
+ *  Function to propagate the formal errors to a list of epochs, as done by propagateFormalErrors, but writing the
+ *  result into a contiguous (row-major) array of size (epochs x states), instead of a map of vectors. Only the diagonal
+ *  of the propagated covariance is computed.
+ *  \param initialCovariance Covariance of the full parameter vector at the initial epoch
+ *  \param stateTransitionInterface Interface from which the state transition and sensitivity matrices are retrieved
+ *  \param evaluationTimes Epochs at which the formal errors are to be computed
+ *  \param outputData Array to which the formal errors are written (must have the size given above)
+ *  \param numberOfThreads Number of threads to use (<= 0 for hardware concurrency)
+ *  \param numberOfEpochsPerChunk Number of epochs that is processed as a single task
+ */
+inline void propagateFormalErrorsToArray(
+        const Eigen::MatrixXd& initialCovariance,
+        const std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        double* outputData,
+        const int numberOfThreads = 0,
+        const unsigned int numberOfEpochsPerChunk = 1000 )
+{
+    checkInitialCovarianceSize( initialCovariance, stateTransitionInterface );
+    const std::size_t numberOfStates = stateTransitionInterface->getStateTransitionMatrixSize( );
+
+    processFullStateTransitionMatricesInParallel(
+                stateTransitionInterface, evaluationTimes,
+                [ & ]( const unsigned int epochIndex, const Eigen::Map< const RowMajorMatrixXd >& stateTransitionMatrix )
+    {
+        Eigen::Map< Eigen::VectorXd > formalErrors( outputData + epochIndex * numberOfStates, numberOfStates );
+        formalErrors = ( stateTransitionMatrix * initialCovariance ).cwiseProduct( stateTransitionMatrix ).
+                rowwise( ).sum( ).cwiseSqrt( );
+    }, numberOfThreads, numberOfEpochsPerChunk );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_BATCHED_COVARIANCE_PROPAGATION_H
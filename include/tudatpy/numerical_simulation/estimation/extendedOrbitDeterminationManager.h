@@ -0,0 +1,995 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EXTENDED_ORBIT_DETERMINATION_MANAGER_H
+#define TUDATPY_EXTENDED_ORBIT_DETERMINATION_MANAGER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+
+#include "tudat/simulation/estimation_setup.h"
+
+#include "tudatpy/basics/eventTracing.h"
+#include "tudatpy/basics/parallelFor.h"
+#include "tudatpy/numerical_simulation/environment/serializedSpiceAccess.h"
+#include "tudatpy/numerical_simulation/estimation/extendedPodInputOutput.h"
+#include "tudatpy/numerical_simulation/propagation/reducedVariationalEquations.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Range of observations, within a single observation set, for which the partials are computed as a single task
+template< typename ObservationScalarType = double, typename TimeType = double >
+struct ObservationPartialTask
+{
+    //! Observation set from which the observations are taken
+    std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > observationSet_;
+
+    //! Index of first epoch (in observation set) of task
+    unsigned int startEpochIndex_;
+
+    //! Number of epochs in task
+    unsigned int numberOfEpochs_;
+
+    //! Index of first observation of task in the concatenated observation vector
+    unsigned int startObservationIndex_;
+};
+
+//! Interpolator that serializes the interpolation of the state transition or sensitivity matrix of an interface
+/*!
+ *  Interpolator that serializes the interpolation of the state transition or sensitivity matrix of an interface, by
+ *  locking a mutex for each interpolation. The interpolators of the interface store the state of their look-up scheme,
+ *  and can therefore not be used concurrently by multiple threads. The interpolator is retrieved from the interface in
+ *  each call, such that it remains valid when the variational equations are re-integrated.
+ */
+class SerializedVariationalMatrixInterpolator: public interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param originalInterface Interface of which the state transition or sensitivity matrix is interpolated
+     *  \param interpolatorMutex Mutex that is locked while the interpolator of the interface is called
+     *  \param returnSensitivityMatrix Boolean denoting whether the sensitivity matrix, or the state transition matrix is
+     *  returned
+     */
+    SerializedVariationalMatrixInterpolator(
+            const std::shared_ptr< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > originalInterface,
+            std::mutex& interpolatorMutex,
+            const bool returnSensitivityMatrix ):
+        originalInterface_( originalInterface ), interpolatorMutex_( interpolatorMutex ),
+        returnSensitivityMatrix_( returnSensitivityMatrix ){ }
+
+    using interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >::interpolate;
+
+    //! Function to interpolate the matrix at a given epoch
+    Eigen::MatrixXd interpolate( const double targetIndependentVariableValue )
+    {
+        std::lock_guard< std::mutex > interpolatorLock( interpolatorMutex_ );
+        return returnSensitivityMatrix_ ?
+                    originalInterface_->getSensitivityMatrixInterpolator( )->interpolate( targetIndependentVariableValue ) :
+                    originalInterface_->getStateTransitionMatrixInterpolator( )->interpolate( targetIndependentVariableValue );
+    }
+
+private:
+
+    //! Interface of which the state transition or sensitivity matrix is interpolated
+    std::shared_ptr< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > originalInterface_;
+
+    //! Mutex that is locked while the interpolator of the interface is called
+    std::mutex& interpolatorMutex_;
+
+    //! Boolean denoting whether the sensitivity matrix, or the state transition matrix is returned
+    bool returnSensitivityMatrix_;
+};
+
+//! Contribution of a subset of the observations to the normal equations of the (unnormalized) least-squares problem
+struct NormalEquationContribution
+{
+    NormalEquationContribution( const int numberOfParameters ):
+        normalMatrix_( Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters ) ),
+        rightHandSide_( Eigen::VectorXd::Zero( numberOfParameters ) ),
+        maximumAbsolutePartial_( Eigen::VectorXd::Zero( numberOfParameters ) ){ }
+
+    //! Function to add the contribution of a block of (weighted) observations to the normal equations
+    void addObservations( const Eigen::MatrixXd& partials,
+                          const Eigen::VectorXd& residuals,
+                          const Eigen::VectorXd& weights )
+    {
+        Eigen::MatrixXd weightedPartialsTranspose = partials.transpose( ) * weights.asDiagonal( );
+        normalMatrix_.noalias( ) += weightedPartialsTranspose * partials;
+        rightHandSide_.noalias( ) += weightedPartialsTranspose * residuals;
+        maximumAbsolutePartial_ = maximumAbsolutePartial_.cwiseMax( partials.cwiseAbs( ).colwise( ).maxCoeff( ).transpose( ) );
+    }
+
+    //! Function to add the contribution of another subset of the observations
+    void addContribution( const NormalEquationContribution& otherContribution )
+    {
+        normalMatrix_ += otherContribution.normalMatrix_;
+        rightHandSide_ += otherContribution.rightHandSide_;
+        maximumAbsolutePartial_ = maximumAbsolutePartial_.cwiseMax( otherContribution.maximumAbsolutePartial_ );
+    }
+
+    //! Normal matrix H^T W H
+    Eigen::MatrixXd normalMatrix_;
+
+    //! Right-hand side H^T W y
+    Eigen::VectorXd rightHandSide_;
+
+    //! Maximum absolute value of the partials, per parameter (used for normalization)
+    Eigen::VectorXd maximumAbsolutePartial_;
+};
+
+//! Contribution of a subset of the observations to the square-root information system of the least-squares problem
+/*!
+ *  Contribution of a subset of the observations to the square-root information system R x = z of the (unnormalized)
+ *  least-squares problem, with R upper triangular. Observations are added by Householder triangularization of the
+ *  current system stacked with the weighted observation rows, such that the normal matrix is never formed.
+ */
+struct SquareRootInformationContribution
+{
+    SquareRootInformationContribution( const int numberOfParameters ):
+        squareRootInformationMatrix_( Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters ) ),
+        transformedResiduals_( Eigen::VectorXd::Zero( numberOfParameters ) ),
+        maximumAbsolutePartial_( Eigen::VectorXd::Zero( numberOfParameters ) ){ }
+
+    //! Function to add the contribution of a block of (weighted) observations to the square-root information system
+    void addObservations( const Eigen::MatrixXd& partials,
+                          const Eigen::VectorXd& residuals,
+                          const Eigen::VectorXd& weights )
+    {
+        const Eigen::VectorXd squareRootWeights = weights.cwiseSqrt( );
+        addRows( squareRootWeights.asDiagonal( ) * partials, squareRootWeights.cwiseProduct( residuals ) );
+        maximumAbsolutePartial_ = maximumAbsolutePartial_.cwiseMax( partials.cwiseAbs( ).colwise( ).maxCoeff( ).transpose( ) );
+    }
+
+    //! Function to add the contribution of another subset of the observations
+    void addContribution( const SquareRootInformationContribution& otherContribution )
+    {
+        addRows( otherContribution.squareRootInformationMatrix_, otherContribution.transformedResiduals_ );
+        maximumAbsolutePartial_ = maximumAbsolutePartial_.cwiseMax( otherContribution.maximumAbsolutePartial_ );
+    }
+
+    //! Function to add rows A x = b to the system, and re-triangularize it
+    void addRows( const Eigen::MatrixXd& rowMatrix, const Eigen::VectorXd& rowRightHandSide )
+    {
+        const int numberOfParameters = squareRootInformationMatrix_.cols( );
+        Eigen::MatrixXd stackedSystem( numberOfParameters + rowMatrix.rows( ), numberOfParameters + 1 );
+        stackedSystem << squareRootInformationMatrix_, transformedResiduals_, rowMatrix, rowRightHandSide;
+
+        Eigen::HouseholderQR< Eigen::MatrixXd > stackedSystemDecomposition( stackedSystem );
+        Eigen::MatrixXd triangularSystem = stackedSystemDecomposition.matrixQR( ).topRows( numberOfParameters ).
+                template triangularView< Eigen::Upper >( );
+        squareRootInformationMatrix_ = triangularSystem.leftCols( numberOfParameters );
+        transformedResiduals_ = triangularSystem.col( numberOfParameters );
+    }
+
+    //! Upper triangular square-root information matrix R
+    Eigen::MatrixXd squareRootInformationMatrix_;
+
+    //! Transformed residuals z
+    Eigen::VectorXd transformedResiduals_;
+
+    //! Maximum absolute value of the partials, per parameter (used for normalization)
+    Eigen::VectorXd maximumAbsolutePartial_;
+};
+
+//! Function to compute a square root A (with A^T A equal to the input) of a symmetric positive semi-definite matrix
+inline Eigen::MatrixXd getSymmetricMatrixSquareRoot( const Eigen::MatrixXd& symmetricMatrix )
+{
+    Eigen::SelfAdjointEigenSolver< Eigen::MatrixXd > eigenDecomposition( symmetricMatrix );
+    return eigenDecomposition.eigenvalues( ).cwiseMax( 0.0 ).cwiseSqrt( ).asDiagonal( ) *
+            eigenDecomposition.eigenvectors( ).transpose( );
+}
+
+//! Function to create a reduced single-arc variational equations solver (only supported for double states and times)
+template< typename ObservationScalarType, typename TimeType >
+std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > >
+createReducedVariationalEquationsSolver(
+        const SystemOfBodies&,
+        const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > >,
+        const std::shared_ptr< propagators::PropagatorSettings< ObservationScalarType > >,
+        const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< ObservationScalarType > >,
+        const bool )
+{
+    throw std::runtime_error( "Error when creating reduced variational equations, only double states and times are supported." );
+}
+
+//! Function to create a reduced single-arc variational equations solver (see ReducedSingleArcVariationalEquationsSolver)
+inline std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< double, double > >
+createReducedVariationalEquationsSolver(
+        const SystemOfBodies& bodies,
+        const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< propagators::PropagatorSettings< double > > propagatorSettings,
+        const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate,
+        const bool integrateEquationsOnCreation )
+{
+    return std::make_shared< propagators::ReducedSingleArcVariationalEquationsSolver >(
+                bodies, integratorSettings, propagatorSettings, parametersToEstimate, true,
+                std::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ), false,
+                integrateEquationsOnCreation );
+}
+
+//! Orbit determination manager, extending the Tudat OrbitDeterminationManager with a multi-threaded computation of
+//! the observation partials.
+/*!
+ *  Orbit determination manager, extending the Tudat OrbitDeterminationManager with a multi-threaded computation of
+ *  the observation partials. In each iteration, the observations are split into chunks, which are distributed over a
+ *  pool of threads. Each thread uses its own observation managers (and its own copy of the state transition matrix
+ *  interface), and computes the residuals and partials of its chunks, and their contribution to the normal equations.
+ *  The contributions of the chunks are summed in chunk order (see OrderedReduction), such that the estimation result is
+ *  identical for any number of threads. The estimation
+ *  (normalization of the partials, a priori covariance and selection of the best iteration) is otherwise identical to
+ *  that of the Tudat OrbitDeterminationManager, which is used directly if the estimation input requires no extended
+ *  functionality. If the design matrix is not to be saved, it is never built: only the partials of the chunks that are
+ *  being processed are kept in memory, such that the memory use is independent of the number of observations (apart
+ *  from the residual vector). The multi-threaded computation is only supported for single-arc estimations, and the
+ *  extended estimation only for estimations without constraints.
+ *  If a linear update threshold is set in the estimation input, the dynamics is not necessarily re-propagated in each
+ *  iteration. Instead, the change of the propagated states due to the parameter correction is predicted with the
+ *  state transition and sensitivity matrices of the last propagation. If the largest predicted position correction
+ *  is below the threshold, the states of the last propagation are updated with this prediction, and the variational
+ *  equations of the last propagation are reused for the partials. Otherwise, the dynamics and variational equations
+ *  are re-propagated. The dependent variables are not updated by a linear update. Linear updates are only supported for
+ *  single-arc Cowell propagation of translational dynamics.
+ *  If requested on creation, the variational equations are only integrated for the parameters that influence the
+ *  dynamics (see ReducedSingleArcVariationalEquationsSolver), for both the extended and the Tudat estimation. The
+ *  sensitivity to the other parameters (such as observation biases) is identically zero.
+ *  Note that the environment models that are used by the observation models are evaluated concurrently, and must be
+ *  safe for concurrent read access (see simulateObservationsInParallel).
+ *  The linearized least-squares problem of each iteration is solved with the solver selected in the estimation input:
+ *  the normal equations (LDLT decomposition), a Householder QR decomposition of the weighted, normalized design matrix,
+ *  or a square-root information filter, in which each chunk of observations is triangularized into its own square-root
+ *  information system, after which the systems of all chunks are combined in chunk order. The QR-based solvers avoid
+ *  forming the normal matrix (squaring its condition number) for the solution; it is only formed for the output.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+class ExtendedOrbitDeterminationManager: public OrbitDeterminationManager< ObservationScalarType, TimeType >
+{
+public:
+
+    typedef Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > ParameterVectorType;
+
+    typedef std::map< observation_models::ObservableType,
+    std::shared_ptr< observation_models::ObservationManagerBase< ObservationScalarType, TimeType > > > ObservationManagerMap;
+
+    //! Constructor, see Tudat OrbitDeterminationManager
+    /*!
+     *  Constructor, see Tudat OrbitDeterminationManager.
+     *  \param reduceVariationalEquations Boolean denoting whether the variational equations are only integrated for the
+     *  parameters that influence the dynamics (single-arc estimation only), see class description
+     */
+    ExtendedOrbitDeterminationManager(
+            const SystemOfBodies& bodies,
+            const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< ObservationScalarType > > parametersToEstimate,
+            const std::vector< std::shared_ptr< observation_models::ObservationModelSettings > >& observationSettingsList,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+            const std::shared_ptr< propagators::PropagatorSettings< ObservationScalarType > > propagatorSettings,
+            const bool propagateOnCreation = true,
+            const bool reduceVariationalEquations = false ):
+        OrbitDeterminationManager< ObservationScalarType, TimeType >(
+            bodies, parametersToEstimate, observationSettingsList, integratorSettings, propagatorSettings,
+            propagateOnCreation && !reduceVariationalEquations ),
+        bodies_( bodies ), observationSettingsList_( observationSettingsList )
+    {
+        std::shared_ptr< propagators::TranslationalStatePropagatorSettings< ObservationScalarType > > translationalSettings =
+                std::dynamic_pointer_cast< propagators::TranslationalStatePropagatorSettings< ObservationScalarType > >(
+                    propagatorSettings );
+        isLinearUpdateSupported_ = ( translationalSettings != nullptr ) &&
+                ( translationalSettings->propagator_ == propagators::cowell );
+
+        // Replace the variational equations solver (which is not yet propagated), and the observation managers using it
+        if( reduceVariationalEquations )
+        {
+            if( std::dynamic_pointer_cast< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > >(
+                        this->variationalEquationsSolver_ ) == nullptr )
+            {
+                throw std::runtime_error( "Error when creating estimator, reduced variational equations are only supported for single-arc estimation." );
+            }
+            std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > > reducedSolver =
+                    createReducedVariationalEquationsSolver(
+                        bodies, integratorSettings, propagatorSettings, parametersToEstimate, propagateOnCreation );
+            reducedVariationalEquationsSolver_ =
+                    std::dynamic_pointer_cast< propagators::ReducedSingleArcVariationalEquationsSolver >( reducedSolver );
+            this->variationalEquationsSolver_ = reducedSolver;
+            this->stateTransitionAndSensitivityMatrixInterface_ =
+                    reducedVariationalEquationsSolver_->getFullStateTransitionInterface( );
+            this->observationManagers_ = createObservationManagers( this->stateTransitionAndSensitivityMatrixInterface_ );
+        }
+    }
+
+    //! Function to perform the estimation
+    /*!
+     *  Function to perform the estimation, using the Tudat OrbitDeterminationManager::estimateParameters if the
+     *  estimation input requires no extended functionality. Since constraints on the parameters are only supported by the
+     *  Tudat OrbitDeterminationManager, it is also used for constrained estimations that only request multiple threads
+     *  or not to save the design matrix (the partials are then computed on a single thread, and the full design matrix
+     *  is built in memory).
+     *  \param podInput Input for the estimation
+     *  \param convergenceChecker Object used to check whether the estimation has converged
+     *  \return Output of the estimation
+     */
+    std::shared_ptr< ExtendedPodOutput< ObservationScalarType, TimeType > > performEstimation(
+            const std::shared_ptr< ExtendedPodInput< ObservationScalarType, TimeType > >& podInput,
+            const std::shared_ptr< EstimationConvergenceChecker > convergenceChecker =
+            std::make_shared< EstimationConvergenceChecker >( ) )
+    {
+        utilities::ScopedTraceEvent traceEvent( "perform_estimation", "estimation" );
+        const bool useDefaultEstimationForConstraints =
+                ( this->parametersToEstimate_->getConstraintSize( ) > 0 ) &&
+                !( podInput->getLinearUpdateThreshold( ) > 0.0 ) && ( podInput->getSolverType( ) == normal_equations_solver );
+        if( podInput->useDefaultEstimation( ) || useDefaultEstimationForConstraints )
+        {
+            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+            std::shared_ptr< PodOutput< ObservationScalarType, TimeType > > defaultPodOutput =
+                    this->estimateParameters( podInput, convergenceChecker );
+
+            // The Tudat output is not used elsewhere, so its contents are moved into the extended output
+            std::shared_ptr< ExtendedPodOutput< ObservationScalarType, TimeType > > podOutput =
+                    std::make_shared< ExtendedPodOutput< ObservationScalarType, TimeType > >(
+                        std::move( *defaultPodOutput ) );
+            podOutput->addComputationTime( "total", getElapsedTime( startTime ) );
+            return podOutput;
+        }
+        else
+        {
+            return performExtendedEstimation( podInput, convergenceChecker );
+        }
+    }
+
+    //! Function to compute the residuals and (unnormalized) design matrix of a set of observations for the current parameters
+    /*!
+     *  Function to compute the residuals and (unnormalized) design matrix of a set of observations for the current
+     *  parameters, without propagating the dynamics. The rows are ordered as the concatenated observation vector of the
+     *  observation collection. The partials are computed in parallel, as in performEstimation.
+     *  \param observations Observations for which the residuals and partials are to be computed
+     *  \param numberOfThreads Number of threads used to compute the partials (<= 0 for hardware concurrency)
+     *  \param observationChunkSize Maximum number of observations for which the partials are computed at once
+     *  \return Pair of residual vector and design matrix
+     */
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > computeResidualsAndDesignMatrix(
+            const std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observations,
+            const int numberOfThreads = 1,
+            const unsigned int observationChunkSize = 10000 )
+    {
+        if( observationChunkSize == 0 )
+        {
+            throw std::runtime_error( "Error when computing design matrix, observation chunk size must be positive." );
+        }
+
+        utilities::ScopedTraceEvent traceEvent( "compute_residuals_and_design_matrix", "estimation" );
+        std::vector< ObservationPartialTask< ObservationScalarType, TimeType > > partialTasks =
+                createObservationPartialTasks( observations, observationChunkSize );
+        const unsigned int numberOfThreadsToUse = isSpiceRotationModelUsed( bodies_ ) ? 1 :
+                utilities::getNumberOfThreadsToUse( numberOfThreads, partialTasks.size( ) );
+        std::mutex interpolatorMutex;
+        std::vector< ObservationManagerMap > observationManagersPerThread =
+                createObservationManagersPerThread( numberOfThreadsToUse, interpolatorMutex );
+        std::unique_ptr< ScopedSpiceEphemerisSerialization > spiceSerialization;
+        if( numberOfThreadsToUse > 1 )
+        {
+            spiceSerialization.reset( new ScopedSpiceEphemerisSerialization( bodies_ ) );
+        }
+
+        const int numberOfObservations = observations->getObservationVector( ).rows( );
+        Eigen::VectorXd residuals = Eigen::VectorXd::Zero( numberOfObservations );
+        Eigen::MatrixXd designMatrix = Eigen::MatrixXd::Zero(
+                    numberOfObservations, this->parametersToEstimate_->getEstimatedParameterSetSize( ) );
+        utilities::parallelFor(
+                    partialTasks.size( ), numberOfThreadsToUse,
+                    [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+        {
+            utilities::ScopedTraceEvent taskTraceEvent( "observation_partials", "estimation" );
+            const ObservationPartialTask< ObservationScalarType, TimeType >& currentTask = partialTasks.at( taskIndex );
+            std::pair< Eigen::VectorXd, Eigen::MatrixXd > residualsAndPartials = computeResidualsAndPartials(
+                        currentTask, observationManagersPerThread.at( threadIndex ) );
+            residuals.segment( currentTask.startObservationIndex_, residualsAndPartials.first.rows( ) ) =
+                    residualsAndPartials.first;
+            designMatrix.block( currentTask.startObservationIndex_, 0, residualsAndPartials.second.rows( ),
+                                residualsAndPartials.second.cols( ) ) = residualsAndPartials.second;
+        } );
+        return std::make_pair( residuals, designMatrix );
+    }
+
+protected:
+
+    //! Function to compute the wall-clock time (in seconds) since a given time point
+    static double getElapsedTime( const std::chrono::steady_clock::time_point& startTime )
+    {
+        return std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime ).count( );
+    }
+
+    //! Function to retrieve the single-arc variational equations solver, throwing an error if the estimation is not single-arc
+    std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > >
+    getSingleArcVariationalEquationsSolver( )
+    {
+        std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > > singleArcSolver =
+                std::dynamic_pointer_cast< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > >(
+                    this->getVariationalEquationsSolver( ) );
+        if( singleArcSolver == nullptr )
+        {
+            throw std::runtime_error( "Error in extended estimation, linear state updates require a single-arc estimation." );
+        }
+        return singleArcSolver;
+    }
+
+    //! Function to store the states and dependent variables of the last propagation, as reference for linear updates
+    void saveReferenceSolution( const ParameterVectorType& parameterEstimate )
+    {
+        std::shared_ptr< propagators::SingleArcDynamicsSimulator< ObservationScalarType, TimeType > > dynamicsSimulator =
+                getSingleArcVariationalEquationsSolver( )->getDynamicsSimulator( );
+        referenceParameterEstimate_ = parameterEstimate;
+        referenceStateHistory_ = dynamicsSimulator->getEquationsOfMotionNumericalSolutionRaw( );
+        referenceDependentVariableHistory_ = dynamicsSimulator->getDependentVariableHistory( );
+    }
+
+    //! Function to update the propagated states linearly, if the predicted correction is below a threshold
+    /*!
+     *  Function to update the propagated states linearly, if the predicted correction is below a threshold. The
+     *  correction of the states of the last propagation is predicted from the change of the parameters w.r.t. the
+     *  parameters of the last propagation, using the state transition and sensitivity matrices of the last propagation.
+     *  If the largest predicted position correction of any propagated body is below the threshold, the corrected states
+     *  are set (and processed into the environment) in the dynamics simulator.
+     *  \param newParameterEstimate Parameters for which the states are to be updated
+     *  \param linearUpdateThreshold Maximum predicted position correction (in m) for which the states are updated
+     *  \param printOutput Boolean denoting whether to print the predicted correction to the terminal
+     *  \return True if the states are updated, false if the predicted correction is above the threshold
+     */
+    bool updateStatesLinearly( const ParameterVectorType& newParameterEstimate,
+                               const double linearUpdateThreshold,
+                               const bool printOutput )
+    {
+        std::shared_ptr< propagators::SingleArcVariationalEquationsSolver< ObservationScalarType, TimeType > > singleArcSolver =
+                getSingleArcVariationalEquationsSolver( );
+        const auto& stateTransitionMatrixHistory = singleArcSolver->getStateTransitionMatrixSolution( );
+        const auto& sensitivityMatrixHistory = singleArcSolver->getSensitivityMatrixSolution( );
+        if( stateTransitionMatrixHistory.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error in linear state update, no variational equations solution is available." );
+        }
+
+        // Only the parameters for which the variational equations are integrated can change the states
+        Eigen::VectorXd parameterDifference =
+                ( newParameterEstimate - referenceParameterEstimate_ ).template cast< double >( );
+        if( reducedVariationalEquationsSolver_ != nullptr )
+        {
+            parameterDifference = reducedVariationalEquationsSolver_->getReducedParameterVector( parameterDifference );
+        }
+        const int initialStateSize = stateTransitionMatrixHistory.begin( )->second.cols( );
+        const int sensitivityParameterSize = parameterDifference.rows( ) - initialStateSize;
+
+        std::map< TimeType, Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > updatedStateHistory;
+        double maximumPositionCorrection = 0.0;
+        for( auto stateIterator : referenceStateHistory_ )
+        {
+            auto stateTransitionIterator = stateTransitionMatrixHistory.find( stateIterator.first );
+            auto sensitivityIterator = sensitivityMatrixHistory.find( stateIterator.first );
+            if( stateTransitionIterator == stateTransitionMatrixHistory.end( ) ||
+                    sensitivityIterator == sensitivityMatrixHistory.end( ) )
+            {
+                throw std::runtime_error( "Error in linear state update, epochs of state and variational equations solution are not consistent." );
+            }
+
+            Eigen::VectorXd stateCorrection = stateTransitionIterator->second * parameterDifference.segment( 0, initialStateSize );
+            if( sensitivityParameterSize > 0 )
+            {
+                stateCorrection += sensitivityIterator->second * parameterDifference.segment(
+                            initialStateSize, sensitivityParameterSize );
+            }
+            for( int i = 0; i < stateCorrection.rows( ) / 6; i++ )
+            {
+                maximumPositionCorrection = std::max( maximumPositionCorrection, stateCorrection.segment( 6 * i, 3 ).norm( ) );
+            }
+            if( maximumPositionCorrection > linearUpdateThreshold )
+            {
+                if( printOutput )
+                {
+                    std::cout << "Predicted position correction above " << linearUpdateThreshold
+                              << " m, re-propagating dynamics" << std::endl;
+                }
+                return false;
+            }
+            updatedStateHistory[ stateIterator.first ] =
+                    stateIterator.second + stateCorrection.template cast< ObservationScalarType >( );
+        }
+
+        if( printOutput )
+        {
+            std::cout << "Updating states linearly, maximum predicted position correction: "
+                      << maximumPositionCorrection << " m" << std::endl;
+        }
+        std::map< TimeType, Eigen::VectorXd > dependentVariableHistory = referenceDependentVariableHistory_;
+        singleArcSolver->getDynamicsSimulator( )->manuallySetAndProcessRawNumericalEquationsOfMotionSolution(
+                    updatedStateHistory, dependentVariableHistory, true );
+        this->parametersToEstimate_->template resetParameterValues< ObservationScalarType >( newParameterEstimate );
+        return true;
+    }
+
+    //! Function to create the observation managers that are to be used by each thread
+    /*!
+     *  Function to create the observation managers that are to be used by each thread. For a single thread, the
+     *  observation managers of the orbit determination manager are used. For multiple threads, each thread uses newly
+     *  created observation managers, with their own copy of the state transition matrix interface (which stores the last
+     *  evaluated matrices, and can therefore not be shared between threads). The interpolators of the original interface
+     *  are shared by the copies, and are called through a SerializedVariationalMatrixInterpolator.
+     *  \param numberOfThreads Number of threads for which observation managers are created
+     *  \param interpolatorMutex Mutex with which the interpolation of the variational equations is serialized
+     *  \return Observation managers for each thread
+     */
+    std::vector< ObservationManagerMap > createObservationManagersPerThread( const unsigned int numberOfThreads,
+                                                                             std::mutex& interpolatorMutex )
+    {
+        std::vector< ObservationManagerMap > observationManagersPerThread;
+        if( numberOfThreads == 1 )
+        {
+            observationManagersPerThread.push_back( this->observationManagers_ );
+            return observationManagersPerThread;
+        }
+
+        std::shared_ptr< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > singleArcInterface =
+                std::dynamic_pointer_cast< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                    this->getStateTransitionAndSensitivityMatrixInterface( ) );
+        if( singleArcInterface == nullptr )
+        {
+            throw std::runtime_error( "Error in multi-threaded estimation, only single-arc estimation is supported." );
+        }
+
+        for( unsigned int i = 0; i < numberOfThreads; i++ )
+        {
+            std::shared_ptr< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > threadInterface =
+                    std::make_shared< propagators::SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                        *singleArcInterface );
+            threadInterface->updateMatrixInterpolators(
+                        std::make_shared< SerializedVariationalMatrixInterpolator >(
+                            singleArcInterface, interpolatorMutex, false ),
+                        std::make_shared< SerializedVariationalMatrixInterpolator >(
+                            singleArcInterface, interpolatorMutex, true ) );
+            observationManagersPerThread.push_back( createObservationManagers( threadInterface ) );
+        }
+        return observationManagersPerThread;
+    }
+
+    //! Function to create observation managers for all observables, using a given state transition matrix interface
+    ObservationManagerMap createObservationManagers(
+            const std::shared_ptr< propagators::CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface )
+    {
+        std::map< observation_models::ObservableType,
+                std::vector< std::shared_ptr< observation_models::ObservationModelSettings > > > settingsPerObservable;
+        for( unsigned int i = 0; i < observationSettingsList_.size( ); i++ )
+        {
+            settingsPerObservable[ observationSettingsList_.at( i )->observableType_ ].push_back(
+                        observationSettingsList_.at( i ) );
+        }
+
+        ObservationManagerMap observationManagers;
+        for( auto settingsIterator : settingsPerObservable )
+        {
+            observationManagers[ settingsIterator.first ] =
+                    observation_models::createObservationManagerBase< ObservationScalarType, TimeType >(
+                        settingsIterator.first, settingsIterator.second, bodies_, this->parametersToEstimate_,
+                        stateTransitionInterface );
+        }
+        return observationManagers;
+    }
+
+    //! Function to split the observations into tasks of (at most) a given number of observations
+    std::vector< ObservationPartialTask< ObservationScalarType, TimeType > > createObservationPartialTasks(
+            const std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observations,
+            const unsigned int observationChunkSize )
+    {
+        std::vector< ObservationPartialTask< ObservationScalarType, TimeType > > partialTasks;
+        unsigned int currentObservationIndex = 0;
+        for( auto observableIterator : observations->getObservations( ) )
+        {
+            for( auto linkEndIterator : observableIterator.second )
+            {
+                for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+                {
+                    std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > >
+                            observationSet = linkEndIterator.second.at( i );
+                    const unsigned int numberOfEpochs = observationSet->getObservationTimes( ).size( );
+                    if( numberOfEpochs == 0 )
+                    {
+                        continue;
+                    }
+                    const unsigned int observableSize = observationSet->getObservationVector( ).rows( ) / numberOfEpochs;
+                    const unsigned int epochsPerChunk = std::max( observationChunkSize / observableSize, 1u );
+
+                    std::vector< std::pair< unsigned int, unsigned int > > chunkRanges =
+                            utilities::getChunkRanges( numberOfEpochs, epochsPerChunk );
+                    for( unsigned int j = 0; j < chunkRanges.size( ); j++ )
+                    {
+                        ObservationPartialTask< ObservationScalarType, TimeType > currentTask;
+                        currentTask.observationSet_ = observationSet;
+                        currentTask.startEpochIndex_ = chunkRanges.at( j ).first;
+                        currentTask.numberOfEpochs_ = chunkRanges.at( j ).second;
+                        currentTask.startObservationIndex_ =
+                                currentObservationIndex + chunkRanges.at( j ).first * observableSize;
+                        partialTasks.push_back( currentTask );
+                    }
+                    currentObservationIndex += numberOfEpochs * observableSize;
+                }
+            }
+        }
+        return partialTasks;
+    }
+
+    //! Function to compute the residuals and partials of the observations in a single task
+    std::pair< Eigen::VectorXd, Eigen::MatrixXd > computeResidualsAndPartials(
+            const ObservationPartialTask< ObservationScalarType, TimeType >& partialTask,
+            const ObservationManagerMap& observationManagers )
+    {
+        const std::vector< TimeType >& observationTimes = partialTask.observationSet_->getObservationTimes( );
+        std::vector< TimeType > taskTimes(
+                    observationTimes.begin( ) + partialTask.startEpochIndex_,
+                    observationTimes.begin( ) + partialTask.startEpochIndex_ + partialTask.numberOfEpochs_ );
+
+        std::pair< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 >, Eigen::MatrixXd > observationsWithPartials =
+                observationManagers.at( partialTask.observationSet_->getObservableType( ) )->computeObservationsWithPartials(
+                    taskTimes, partialTask.observationSet_->getLinkEnds( ),
+                    partialTask.observationSet_->getReferenceLinkEnd( ) );
+
+        const int numberOfTaskObservations = observationsWithPartials.first.rows( );
+        const int startIndexInSet = partialTask.startEpochIndex_ * ( numberOfTaskObservations / partialTask.numberOfEpochs_ );
+        Eigen::VectorXd residuals = ( partialTask.observationSet_->getObservationVector( ).segment(
+                                          startIndexInSet, numberOfTaskObservations ) - observationsWithPartials.first ).
+                template cast< double >( );
+        return std::make_pair( residuals, observationsWithPartials.second );
+    }
+
+    //! Function to perform the estimation with the extended functionality (see class description)
+    std::shared_ptr< ExtendedPodOutput< ObservationScalarType, TimeType > > performExtendedEstimation(
+            const std::shared_ptr< ExtendedPodInput< ObservationScalarType, TimeType > >& podInput,
+            const std::shared_ptr< EstimationConvergenceChecker > convergenceChecker )
+    {
+        if( this->parametersToEstimate_->getConstraintSize( ) > 0 )
+        {
+            throw std::runtime_error( "Error in extended estimation, constraints are not supported for linear state updates or solvers other than the normal equations solver." );
+        }
+
+        const double linearUpdateThreshold = podInput->getLinearUpdateThreshold( );
+        if( linearUpdateThreshold > 0.0 && !isLinearUpdateSupported_ )
+        {
+            throw std::runtime_error( "Error in extended estimation, linear state updates are only supported for Cowell propagation of translational dynamics." );
+        }
+
+        const EstimationSolverTypes solverType = podInput->getSolverType( );
+        if( solverType == householder_qr_solver && !podInput->getSaveDesignMatrix( ) )
+        {
+            throw std::runtime_error( "Error in extended estimation, the Householder QR solver requires the design matrix to be saved." );
+        }
+
+        std::map< std::string, double > computationTimePerPhase;
+        int numberOfPropagations = 0;
+        int numberOfLinearUpdates = 0;
+
+        std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observations =
+                podInput->getObservationsAndTimes( );
+        const int numberOfObservations = observations->getObservationVector( ).rows( );
+        const int numberOfParameters = this->parametersToEstimate_->getEstimatedParameterSetSize( );
+        const Eigen::VectorXd weights = podInput->getWeightsMatrixDiagonals( );
+
+        std::vector< ObservationPartialTask< ObservationScalarType, TimeType > > partialTasks =
+                createObservationPartialTasks( observations, podInput->getObservationChunkSize( ) );
+        const unsigned int numberOfThreads = isSpiceRotationModelUsed( bodies_ ) ? 1 :
+                utilities::getNumberOfThreadsToUse( podInput->getNumberOfThreads( ), partialTasks.size( ) );
+        std::mutex interpolatorMutex;
+
+        ParameterVectorType newParameterEstimate =
+                this->parametersToEstimate_->template getFullParameterValues< ObservationScalarType >( );
+        ParameterVectorType oldParameterEstimate;
+
+        std::vector< double > rmsResidualHistory;
+        std::vector< Eigen::VectorXd > residualHistory;
+        std::vector< Eigen::VectorXd > parameterHistory;
+
+        double bestResidual = TUDAT_NAN;
+        ParameterVectorType bestParameterEstimate = newParameterEstimate;
+        Eigen::VectorXd bestResiduals, bestTransformationData;
+        Eigen::MatrixXd bestInformationMatrix, bestInverseNormalizedCovarianceMatrix;
+
+        if( linearUpdateThreshold > 0.0 && !podInput->getReintegrateEquationsOnFirstIteration( ) )
+        {
+            saveReferenceSolution( newParameterEstimate );
+        }
+
+        int numberOfIterations = 0;
+        do
+        {
+            utilities::ScopedTraceEvent iterationTraceEvent( "estimation_iteration", "estimation" );
+
+            // Re-integrate (or linearly update) equations of motion and variational equations
+            std::chrono::steady_clock::time_point phaseStartTime = std::chrono::steady_clock::now( );
+            bool isStateLinearlyUpdated = false;
+            if( ( numberOfIterations > 0 ) && ( linearUpdateThreshold > 0.0 ) )
+            {
+                utilities::ScopedTraceEvent traceEvent( "linear_state_update", "estimation" );
+                isStateLinearlyUpdated = updateStatesLinearly(
+                            newParameterEstimate, linearUpdateThreshold, podInput->getPrintOutput( ) );
+            }
+
+            if( isStateLinearlyUpdated )
+            {
+                numberOfLinearUpdates++;
+                computationTimePerPhase[ "linear_update" ] += getElapsedTime( phaseStartTime );
+            }
+            else if( ( numberOfIterations > 0 ) || ( podInput->getReintegrateEquationsOnFirstIteration( ) ) )
+            {
+                utilities::ScopedTraceEvent traceEvent(
+                            podInput->getReintegrateVariationalEquations( ) ?
+                                "propagation_with_variational_equations" : "propagation", "propagation" );
+                this->resetParameterEstimate( newParameterEstimate, podInput->getReintegrateVariationalEquations( ) );
+                if( linearUpdateThreshold > 0.0 )
+                {
+                    saveReferenceSolution( newParameterEstimate );
+                }
+                numberOfPropagations++;
+                computationTimePerPhase[ "propagation" ] += getElapsedTime( phaseStartTime );
+            }
+            oldParameterEstimate = newParameterEstimate;
+
+            if( podInput->getPrintOutput( ) )
+            {
+                std::cout << "Calculating residuals and partials " << numberOfObservations << " on "
+                          << numberOfThreads << " thread(s)" << std::endl;
+            }
+
+            // Compute residuals and partials, and combine the normal equations (or square-root information systems) of
+            // all chunks in chunk order
+            phaseStartTime = std::chrono::steady_clock::now( );
+            std::unique_ptr< utilities::ScopedTraceEvent > partialsTraceEvent(
+                        new utilities::ScopedTraceEvent( "residuals_and_partials", "estimation" ) );
+            std::vector< ObservationManagerMap > observationManagersPerThread =
+                    createObservationManagersPerThread( numberOfThreads, interpolatorMutex );
+            std::unique_ptr< ScopedSpiceEphemerisSerialization > spiceSerialization;
+            if( numberOfThreads > 1 )
+            {
+                spiceSerialization.reset( new ScopedSpiceEphemerisSerialization( bodies_ ) );
+            }
+            utilities::OrderedReduction< NormalEquationContribution > normalEquationReduction(
+                        NormalEquationContribution( ( solverType == normal_equations_solver ) ? numberOfParameters : 0 ),
+                        []( NormalEquationContribution& normalEquations, const NormalEquationContribution& taskContribution )
+            {
+                normalEquations.addContribution( taskContribution );
+            } );
+            utilities::OrderedReduction< SquareRootInformationContribution > squareRootSystemReduction(
+                        SquareRootInformationContribution(
+                            ( solverType == square_root_information_filter_solver ) ? numberOfParameters : 0 ),
+                        []( SquareRootInformationContribution& squareRootSystem,
+                            const SquareRootInformationContribution& taskContribution )
+            {
+                squareRootSystem.addContribution( taskContribution );
+            } );
+
+            Eigen::VectorXd residuals = Eigen::VectorXd::Zero( numberOfObservations );
+            Eigen::MatrixXd informationMatrix = Eigen::MatrixXd::Zero(
+                        podInput->getSaveDesignMatrix( ) ? numberOfObservations : 0, numberOfParameters );
+            utilities::parallelFor(
+                        partialTasks.size( ), numberOfThreads,
+                        [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+            {
+                utilities::ScopedTraceEvent taskTraceEvent( "observation_partials", "estimation" );
+                const ObservationPartialTask< ObservationScalarType, TimeType >& currentTask = partialTasks.at( taskIndex );
+                std::pair< Eigen::VectorXd, Eigen::MatrixXd > residualsAndPartials = computeResidualsAndPartials(
+                            currentTask, observationManagersPerThread.at( threadIndex ) );
+
+                const int numberOfTaskObservations = residualsAndPartials.first.rows( );
+                residuals.segment( currentTask.startObservationIndex_, numberOfTaskObservations ) =
+                        residualsAndPartials.first;
+                if( informationMatrix.rows( ) > 0 )
+                {
+                    informationMatrix.block( currentTask.startObservationIndex_, 0, numberOfTaskObservations, numberOfParameters ) =
+                            residualsAndPartials.second;
+                }
+                if( solverType == normal_equations_solver )
+                {
+                    NormalEquationContribution taskContribution( numberOfParameters );
+                    taskContribution.addObservations(
+                                residualsAndPartials.second, residualsAndPartials.first,
+                                weights.segment( currentTask.startObservationIndex_, numberOfTaskObservations ) );
+                    normalEquationReduction.addTaskResult( taskIndex, std::move( taskContribution ) );
+                }
+                else if( solverType == square_root_information_filter_solver )
+                {
+                    SquareRootInformationContribution taskContribution( numberOfParameters );
+                    taskContribution.addObservations(
+                                residualsAndPartials.second, residualsAndPartials.first,
+                                weights.segment( currentTask.startObservationIndex_, numberOfTaskObservations ) );
+                    squareRootSystemReduction.addTaskResult( taskIndex, std::move( taskContribution ) );
+                }
+            } );
+            spiceSerialization.reset( );
+
+            NormalEquationContribution normalEquations( numberOfParameters );
+            SquareRootInformationContribution squareRootSystem( numberOfParameters );
+            Eigen::VectorXd normalizationTerms;
+            if( solverType == normal_equations_solver )
+            {
+                normalEquations = normalEquationReduction.getReducedValue( partialTasks.size( ) );
+                normalizationTerms = normalEquations.maximumAbsolutePartial_;
+            }
+            else if( solverType == square_root_information_filter_solver )
+            {
+                squareRootSystem = squareRootSystemReduction.getReducedValue( partialTasks.size( ) );
+                normalizationTerms = squareRootSystem.maximumAbsolutePartial_;
+            }
+            else
+            {
+                normalizationTerms = informationMatrix.cwiseAbs( ).colwise( ).maxCoeff( ).transpose( );
+            }
+            computationTimePerPhase[ "partials" ] += getElapsedTime( phaseStartTime );
+            partialsTraceEvent.reset( );
+
+            // Normalize and solve least-squares problem
+            phaseStartTime = std::chrono::steady_clock::now( );
+            std::unique_ptr< utilities::ScopedTraceEvent > solutionTraceEvent(
+                        new utilities::ScopedTraceEvent( "least_squares_solution", "estimation" ) );
+            for( int i = 0; i < numberOfParameters; i++ )
+            {
+                if( normalizationTerms( i ) == 0.0 )
+                {
+                    normalizationTerms( i ) = 1.0;
+                }
+            }
+            const Eigen::VectorXd inverseNormalizationTerms = normalizationTerms.cwiseInverse( );
+            Eigen::MatrixXd normalizedInverseAprioriCovarianceMatrix = Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters );
+            if( podInput->getInverseOfAprioriCovariance( ).rows( ) > 0 )
+            {
+                normalizedInverseAprioriCovarianceMatrix = inverseNormalizationTerms.asDiagonal( ) *
+                        podInput->getInverseOfAprioriCovariance( ) * inverseNormalizationTerms.asDiagonal( );
+            }
+
+            Eigen::MatrixXd normalizedNormalMatrix;
+            Eigen::VectorXd normalizedParameterAddition;
+            switch( solverType )
+            {
+            case normal_equations_solver:
+            {
+                normalizedNormalMatrix = inverseNormalizationTerms.asDiagonal( ) * normalEquations.normalMatrix_ *
+                        inverseNormalizationTerms.asDiagonal( ) + normalizedInverseAprioriCovarianceMatrix;
+                normalizedParameterAddition = normalizedNormalMatrix.ldlt( ).solve(
+                            inverseNormalizationTerms.asDiagonal( ) * normalEquations.rightHandSide_ );
+                break;
+            }
+            case householder_qr_solver:
+            {
+                const Eigen::MatrixXd aprioriRows = ( podInput->getInverseOfAprioriCovariance( ).rows( ) > 0 ) ?
+                            getSymmetricMatrixSquareRoot( normalizedInverseAprioriCovarianceMatrix ) :
+                            Eigen::MatrixXd::Zero( 0, numberOfParameters );
+                const Eigen::VectorXd squareRootWeights = weights.cwiseSqrt( );
+
+                Eigen::MatrixXd weightedDesignMatrix( numberOfObservations + aprioriRows.rows( ), numberOfParameters );
+                weightedDesignMatrix.topRows( numberOfObservations ) =
+                        squareRootWeights.asDiagonal( ) * informationMatrix * inverseNormalizationTerms.asDiagonal( );
+                weightedDesignMatrix.bottomRows( aprioriRows.rows( ) ) = aprioriRows;
+                Eigen::VectorXd weightedResiduals = Eigen::VectorXd::Zero( numberOfObservations + aprioriRows.rows( ) );
+                weightedResiduals.topRows( numberOfObservations ) = squareRootWeights.cwiseProduct( residuals );
+
+                Eigen::HouseholderQR< Eigen::MatrixXd > designMatrixDecomposition( weightedDesignMatrix );
+                normalizedParameterAddition = designMatrixDecomposition.solve( weightedResiduals );
+                Eigen::MatrixXd squareRootInformationMatrix = designMatrixDecomposition.matrixQR( ).topRows( numberOfParameters ).
+                        template triangularView< Eigen::Upper >( );
+                normalizedNormalMatrix = squareRootInformationMatrix.transpose( ) * squareRootInformationMatrix;
+                break;
+            }
+            case square_root_information_filter_solver:
+            {
+                SquareRootInformationContribution normalizedSystem( numberOfParameters );
+                normalizedSystem.squareRootInformationMatrix_ =
+                        squareRootSystem.squareRootInformationMatrix_ * inverseNormalizationTerms.asDiagonal( );
+                normalizedSystem.transformedResiduals_ = squareRootSystem.transformedResiduals_;
+                if( podInput->getInverseOfAprioriCovariance( ).rows( ) > 0 )
+                {
+                    normalizedSystem.addRows( getSymmetricMatrixSquareRoot( normalizedInverseAprioriCovarianceMatrix ),
+                                              Eigen::VectorXd::Zero( numberOfParameters ) );
+                }
+                normalizedParameterAddition = normalizedSystem.squareRootInformationMatrix_.template
+                        triangularView< Eigen::Upper >( ).solve( normalizedSystem.transformedResiduals_ );
+                normalizedNormalMatrix = normalizedSystem.squareRootInformationMatrix_.transpose( ) *
+                        normalizedSystem.squareRootInformationMatrix_;
+                break;
+            }
+            default:
+                throw std::runtime_error( "Error in extended estimation, solver type not recognized." );
+            }
+
+            Eigen::VectorXd parameterAddition = normalizedParameterAddition.cwiseQuotient( normalizationTerms );
+            newParameterEstimate = oldParameterEstimate + parameterAddition.template cast< ObservationScalarType >( );
+            computationTimePerPhase[ "solution" ] += getElapsedTime( phaseStartTime );
+            solutionTraceEvent.reset( );
+
+            // Compute and save residual statistics
+            const double residualRms = std::sqrt( residuals.squaredNorm( ) / static_cast< double >( numberOfObservations ) );
+            rmsResidualHistory.push_back( residualRms );
+            if( podInput->getSaveResidualsAndParametersFromEachIteration( ) )
+            {
+                residualHistory.push_back( residuals );
+                parameterHistory.push_back( oldParameterEstimate.template cast< double >( ) );
+            }
+            if( podInput->getPrintOutput( ) )
+            {
+                std::cout << "Current residual: " << residualRms << std::endl;
+            }
+
+            if( numberOfIterations == 0 || residualRms < bestResidual )
+            {
+                bestResidual = residualRms;
+                bestParameterEstimate = oldParameterEstimate;
+                bestResiduals = residuals;
+                bestTransformationData = normalizationTerms;
+                bestInverseNormalizedCovarianceMatrix = normalizedNormalMatrix;
+                bestInformationMatrix = informationMatrix * normalizationTerms.cwiseInverse( ).asDiagonal( );
+            }
+
+            numberOfIterations++;
+        }
+        while( convergenceChecker->isEstimationConverged( numberOfIterations, rmsResidualHistory ) == false );
+
+        if( podInput->getSaveResidualsAndParametersFromEachIteration( ) )
+        {
+            parameterHistory.push_back( newParameterEstimate.template cast< double >( ) );
+        }
+        this->parametersToEstimate_->template resetParameterValues< ObservationScalarType >( bestParameterEstimate );
+
+        std::shared_ptr< ExtendedPodOutput< ObservationScalarType, TimeType > > podOutput =
+                std::make_shared< ExtendedPodOutput< ObservationScalarType, TimeType > >(
+                    bestParameterEstimate, bestResiduals, bestInformationMatrix, weights, bestTransformationData,
+                    bestInverseNormalizedCovarianceMatrix, bestResidual, residualHistory, parameterHistory );
+        for( auto phaseIterator : computationTimePerPhase )
+        {
+            podOutput->addComputationTime( phaseIterator.first, phaseIterator.second );
+        }
+        podOutput->setNumberOfStateUpdates( numberOfPropagations, numberOfLinearUpdates );
+        return podOutput;
+    }
+
+    //! System of bodies in which the estimation is performed
+    SystemOfBodies bodies_;
+
+    //! Settings for the observation models (used to create observation managers per thread)
+    std::vector< std::shared_ptr< observation_models::ObservationModelSettings > > observationSettingsList_;
+
+    //! Boolean denoting whether the propagated states can be updated linearly (Cowell propagation of translational dynamics)
+    bool isLinearUpdateSupported_;
+
+    //! Variational equations solver, if the variational equations are only integrated for the dynamical parameters
+    std::shared_ptr< propagators::ReducedSingleArcVariationalEquationsSolver > reducedVariationalEquationsSolver_;
+
+    //! Parameters for which the dynamics was last propagated
+    ParameterVectorType referenceParameterEstimate_;
+
+    //! Unprocessed states of the last propagation
+    std::map< TimeType, Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > referenceStateHistory_;
+
+    //! Dependent variables of the last propagation
+    std::map< TimeType, Eigen::VectorXd > referenceDependentVariableHistory_;
+};
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_EXTENDED_ORBIT_DETERMINATION_MANAGER_H
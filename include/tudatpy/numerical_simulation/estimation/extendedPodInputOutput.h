@@ -0,0 +1,194 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EXTENDED_POD_INPUT_OUTPUT_H
+#define TUDATPY_EXTENDED_POD_INPUT_OUTPUT_H
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "tudat/simulation/estimation_setup.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Types of solvers for the (linearized) least-squares problem in each iteration of the estimation
+enum EstimationSolverTypes
+{
+    //! Cholesky (LDLT) decomposition of the normal equations
+    normal_equations_solver,
+    //! Householder QR decomposition of the full weighted design matrix (requires the design matrix to be saved)
+    householder_qr_solver,
+    //! Square-root information filter, triangularizing the observations one chunk at a time (Householder QR)
+    square_root_information_filter_solver
+};
+
+//! Input for the estimation, extending the Tudat PodInput with settings for the computation of the partials.
+/*!
+ *  Input for the estimation, extending the Tudat PodInput with settings for the computation of the partials. When all
+ *  additional settings are at their default values, the estimation is performed by the Tudat OrbitDeterminationManager,
+ *  otherwise, by the ExtendedOrbitDeterminationManager (see there).
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+class ExtendedPodInput: public PodInput< ObservationScalarType, TimeType >
+{
+public:
+
+    using PodInput< ObservationScalarType, TimeType >::PodInput;
+
+    //! Function to define the settings of the estimation
+    /*!
+     *  Function to define the settings of the estimation, see Tudat PodInput::defineEstimationSettings for the settings
+     *  that are shared with Tudat.
+     *  \param numberOfThreads Number of threads used to compute the observation partials (<= 0 for hardware concurrency)
+     *  \param observationChunkSize Maximum number of observations for which the partials are computed at once. If the
+     *  design matrix is not saved, the memory used by the partials is bounded by this number times the number of
+     *  parameters.
+     *  \param linearUpdateThreshold Maximum predicted position correction (in m) for which the propagated states are
+     *  updated linearly, using the variational equations of the last propagation, instead of re-propagating the
+     *  dynamics (<= 0 to always re-propagate).
+     */
+    void defineEstimationSettings( const bool reintegrateEquationsOnFirstIteration = true,
+                                   const bool reintegrateVariationalEquations = true,
+                                   const bool saveDesignMatrix = true,
+                                   const bool printOutput = true,
+                                   const bool saveResidualsAndParametersFromEachIteration = true,
+                                   const bool saveStateHistoryForEachIteration = false,
+                                   const int numberOfThreads = 1,
+                                   const unsigned int observationChunkSize = 10000,
+                                   const double linearUpdateThreshold = 0.0 )
+    {
+        if( observationChunkSize == 0 )
+        {
+            throw std::runtime_error( "Error when defining estimation settings, observation chunk size must be positive." );
+        }
+
+        PodInput< ObservationScalarType, TimeType >::defineEstimationSettings(
+                    reintegrateEquationsOnFirstIteration, reintegrateVariationalEquations, saveDesignMatrix,
+                    printOutput, saveResidualsAndParametersFromEachIteration, saveStateHistoryForEachIteration );
+        numberOfThreads_ = numberOfThreads;
+        observationChunkSize_ = observationChunkSize;
+        linearUpdateThreshold_ = linearUpdateThreshold;
+    }
+
+    //! Function to retrieve the number of threads used to compute the observation partials
+    int getNumberOfThreads( ){ return numberOfThreads_; }
+
+    //! Function to retrieve the maximum number of observations for which the partials are computed at once
+    unsigned int getObservationChunkSize( ){ return observationChunkSize_; }
+
+    //! Function to retrieve the maximum predicted position correction for which the states are updated linearly
+    double getLinearUpdateThreshold( ){ return linearUpdateThreshold_; }
+
+    //! Function to retrieve the type of solver for the least-squares problem in each iteration
+    EstimationSolverTypes getSolverType( ){ return solverType_; }
+
+    //! Function to set the type of solver for the least-squares problem in each iteration
+    void setSolverType( const EstimationSolverTypes solverType ){ solverType_ = solverType; }
+
+    //! Function to check whether the estimation can be performed by the Tudat OrbitDeterminationManager
+    /*!
+     *  Function to check whether the estimation can be performed by the Tudat OrbitDeterminationManager. This is not the
+     *  case when multiple threads are used, when the states are to be updated linearly, when a solver other than the
+     *  normal equations solver is used, or when the design matrix is not saved. In the last case, the Tudat
+     *  OrbitDeterminationManager would still build the full design matrix in memory, whereas the
+     *  ExtendedOrbitDeterminationManager only accumulates the normal equations, one chunk of observations at a time.
+     */
+    bool useDefaultEstimation( )
+    {
+        return ( numberOfThreads_ == 1 ) && this->getSaveDesignMatrix( ) && !( linearUpdateThreshold_ > 0.0 ) &&
+                ( solverType_ == normal_equations_solver );
+    }
+
+protected:
+
+    //! Number of threads used to compute the observation partials (<= 0 for hardware concurrency)
+    int numberOfThreads_ = 1;
+
+    //! Maximum number of observations for which the partials are computed at once
+    unsigned int observationChunkSize_ = 10000;
+
+    //! Maximum predicted position correction (in m) for which the states are updated linearly (<= 0 to disable)
+    double linearUpdateThreshold_ = 0.0;
+
+    //! Type of solver for the least-squares problem in each iteration
+    EstimationSolverTypes solverType_ = normal_equations_solver;
+};
+
+//! Output of the estimation, extending the Tudat PodOutput with the computation time per phase of the estimation.
+/*!
+ *  Output of the estimation, extending the Tudat PodOutput with the computation time per phase of the estimation, and
+ *  with a function that returns the (potentially very large) normalized design matrix by reference. The matrices that
+ *  are derived from the output of the estimation (e.g. the weighted design matrix) are computed on each access, and are
+ *  not stored, such that no second copy of the design matrix is kept in memory.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+class ExtendedPodOutput: public PodOutput< ObservationScalarType, TimeType >
+{
+public:
+
+    using PodOutput< ObservationScalarType, TimeType >::PodOutput;
+
+    //! Constructor from Tudat PodOutput (for estimations performed by the Tudat OrbitDeterminationManager), taking
+    //! over its (potentially very large) matrices without copying them
+    ExtendedPodOutput( PodOutput< ObservationScalarType, TimeType >&& podOutput ):
+        PodOutput< ObservationScalarType, TimeType >( std::move( podOutput ) ){ }
+
+    //! Function to retrieve the wall-clock time (in seconds) spent per phase of the estimation, summed over iterations
+    std::map< std::string, double > getComputationTimePerPhase( ){ return computationTimePerPhase_; }
+
+    //! Function to add the wall-clock time (in seconds) spent in a phase of the estimation
+    void addComputationTime( const std::string& phaseName, const double computationTime )
+    {
+        computationTimePerPhase_[ phaseName ] += computationTime;
+    }
+
+    //! Function to retrieve the number of propagations of the dynamics during the estimation (-1 if not available)
+    int getNumberOfPropagations( ){ return numberOfPropagations_; }
+
+    //! Function to retrieve the number of linear updates of the propagated states during the estimation
+    int getNumberOfLinearUpdates( ){ return numberOfLinearUpdates_; }
+
+    //! Function to set the number of propagations and linear updates of the states during the estimation
+    void setNumberOfStateUpdates( const int numberOfPropagations, const int numberOfLinearUpdates )
+    {
+        numberOfPropagations_ = numberOfPropagations;
+        numberOfLinearUpdates_ = numberOfLinearUpdates;
+    }
+
+    //! Function to retrieve the normalized design matrix by reference
+    const Eigen::MatrixXd& getNormalizedInformationMatrixReference( )
+    {
+        return this->normalizedInformationMatrix_;
+    }
+
+protected:
+
+    //! Wall-clock time (in seconds) spent per phase of the estimation, summed over iterations
+    std::map< std::string, double > computationTimePerPhase_;
+
+    //! Number of propagations of the dynamics during the estimation (-1 if not available)
+    int numberOfPropagations_ = -1;
+
+    //! Number of linear updates of the propagated states during the estimation
+    int numberOfLinearUpdates_ = 0;
+};
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_EXTENDED_POD_INPUT_OUTPUT_H
@@ -0,0 +1,395 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_MONTE_CARLO_COVARIANCE_ANALYSIS_H
+#define TUDATPY_MONTE_CARLO_COVARIANCE_ANALYSIS_H
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+
+#include "tudat/simulation/estimation_setup.h"
+
+#include "tudatpy/basics/parallelFor.h"
+#include "tudatpy/numerical_simulation/estimation/extendedOrbitDeterminationManager.h"
+#include "tudatpy/numerical_simulation/estimation/observationNoiseModels.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Running mean and covariance of a set of vector samples (Welford's algorithm)
+/*!
+ *  Running mean and covariance of a set of vector samples, updated one sample at a time with Welford's algorithm, such
+ *  that the samples need not be stored. Statistics accumulated for different sets of samples are combined with
+ *  mergeStatistics.
+ */
+class OnlineSampleStatistics
+{
+public:
+
+    //! Constructor
+    OnlineSampleStatistics( const int sampleSize = 0 ):
+        numberOfSamples_( 0 ),
+        mean_( Eigen::VectorXd::Zero( sampleSize ) ),
+        sumOfSquaredDeviations_( Eigen::MatrixXd::Zero( sampleSize, sampleSize ) ){ }
+
+    //! Function to add a sample to the statistics
+    void addSample( const Eigen::VectorXd& sample )
+    {
+        numberOfSamples_++;
+        const Eigen::VectorXd deviationFromOldMean = sample - mean_;
+        mean_ += deviationFromOldMean / static_cast< double >( numberOfSamples_ );
+        sumOfSquaredDeviations_.noalias( ) += deviationFromOldMean * ( sample - mean_ ).transpose( );
+    }
+
+    //! Function to add the statistics of another set of samples (Chan's parallel algorithm)
+    void mergeStatistics( const OnlineSampleStatistics& otherStatistics )
+    {
+        if( otherStatistics.numberOfSamples_ == 0 )
+        {
+            return;
+        }
+        else if( numberOfSamples_ == 0 )
+        {
+            *this = otherStatistics;
+            return;
+        }
+
+        const double combinedNumberOfSamples = static_cast< double >( numberOfSamples_ + otherStatistics.numberOfSamples_ );
+        const Eigen::VectorXd meanDifference = otherStatistics.mean_ - mean_;
+        sumOfSquaredDeviations_ += otherStatistics.sumOfSquaredDeviations_ + meanDifference * meanDifference.transpose( ) *
+                static_cast< double >( numberOfSamples_ ) * static_cast< double >( otherStatistics.numberOfSamples_ ) /
+                combinedNumberOfSamples;
+        mean_ += meanDifference * static_cast< double >( otherStatistics.numberOfSamples_ ) / combinedNumberOfSamples;
+        numberOfSamples_ += otherStatistics.numberOfSamples_;
+    }
+
+    //! Function to retrieve the number of samples
+    unsigned long long getNumberOfSamples( ) const { return numberOfSamples_; }
+
+    //! Function to retrieve the sample mean
+    Eigen::VectorXd getMean( ) const { return mean_; }
+
+    //! Function to retrieve the (unbiased) sample covariance
+    Eigen::MatrixXd getCovariance( ) const
+    {
+        if( numberOfSamples_ < 2 )
+        {
+            return Eigen::MatrixXd::Constant( mean_.rows( ), mean_.rows( ), TUDAT_NAN );
+        }
+        return sumOfSquaredDeviations_ / static_cast< double >( numberOfSamples_ - 1 );
+    }
+
+private:
+
+    //! Number of samples
+    unsigned long long numberOfSamples_;
+
+    //! Sample mean
+    Eigen::VectorXd mean_;
+
+    //! Sum of the outer products of the deviations from the mean
+    Eigen::MatrixXd sumOfSquaredDeviations_;
+};
+
+//! Monte Carlo covariance analysis of an estimation, linearized about the current parameter values
+/*!
+ *  Monte Carlo covariance analysis of an estimation, linearized about the current parameter values (taken as the true
+ *  parameters). The residuals and design matrix of the observations are computed once, with the dynamics and
+ *  variational equations as currently propagated by the estimator, and the normal equations are factorized once. Each
+ *  sample then perturbs the residuals with Gaussian observation noise (with the standard deviation implied by the
+ *  observation weights) and, optionally, a constant bias per observation set, perturbs the a priori parameter values
+ *  with a sample from the a priori covariance, and solves the linearized estimation. The samples are processed in
+ *  parallel, in blocks of a fixed number of consecutive samples, and only the running statistics of the estimation
+ *  errors and post-fit residual RMS are kept. Random numbers are counter-based (see observationNoiseModels.h), and the
+ *  statistics of the blocks are merged in block order (see OrderedReduction), such that the results do not depend on
+ *  the number of threads.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+class MonteCarloCovarianceAnalysis
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, computes the residuals and design matrix of the observations for the current parameter values, and
+     *  factorizes the normal equations.
+     *  \param estimator Estimator (with dynamics propagated for the true parameter values)
+     *  \param podInput Input for the estimation, defining the observations, weights and inverse a priori covariance
+     *  \param numberOfThreads Number of threads used for the partials and samples (<= 0 for hardware concurrency)
+     */
+    MonteCarloCovarianceAnalysis(
+            const std::shared_ptr< ExtendedOrbitDeterminationManager< ObservationScalarType, TimeType > > estimator,
+            const std::shared_ptr< ExtendedPodInput< ObservationScalarType, TimeType > > podInput,
+            const int numberOfThreads = 1 ):
+        numberOfThreads_( numberOfThreads )
+    {
+        std::pair< Eigen::VectorXd, Eigen::MatrixXd > residualsAndDesignMatrix = estimator->computeResidualsAndDesignMatrix(
+                    podInput->getObservationsAndTimes( ), numberOfThreads, podInput->getObservationChunkSize( ) );
+        referenceResiduals_ = residualsAndDesignMatrix.first;
+        designMatrix_ = residualsAndDesignMatrix.second;
+        weights_ = podInput->getWeightsMatrixDiagonals( );
+        observationStandardDeviations_ = Eigen::VectorXd::Zero( weights_.rows( ) );
+        for( int i = 0; i < weights_.rows( ); i++ )
+        {
+            if( weights_( i ) > 0.0 )
+            {
+                observationStandardDeviations_( i ) = 1.0 / std::sqrt( weights_( i ) );
+            }
+        }
+
+        const int numberOfParameters = designMatrix_.cols( );
+        inverseAprioriCovariance_ = Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters );
+        if( podInput->getInverseOfAprioriCovariance( ).rows( ) > 0 )
+        {
+            inverseAprioriCovariance_ = podInput->getInverseOfAprioriCovariance( );
+        }
+
+        // Normalize, form and factorize normal equations
+        normalizationTerms_ = designMatrix_.cwiseAbs( ).colwise( ).maxCoeff( ).transpose( );
+        for( int i = 0; i < numberOfParameters; i++ )
+        {
+            if( normalizationTerms_( i ) == 0.0 )
+            {
+                normalizationTerms_( i ) = 1.0;
+            }
+        }
+        Eigen::MatrixXd normalizedNormalMatrix =
+                normalizationTerms_.cwiseInverse( ).asDiagonal( ) *
+                ( designMatrix_.transpose( ) * weights_.asDiagonal( ) * designMatrix_ + inverseAprioriCovariance_ ) *
+                normalizationTerms_.cwiseInverse( ).asDiagonal( );
+        normalMatrixDecomposition_ = normalizedNormalMatrix.ldlt( );
+        if( normalMatrixDecomposition_.info( ) != Eigen::Success )
+        {
+            throw std::runtime_error( "Error in Monte Carlo covariance analysis, normal equations could not be factorized." );
+        }
+        formalCovariance_ = normalizationTerms_.cwiseInverse( ).asDiagonal( ) *
+                normalMatrixDecomposition_.solve( Eigen::MatrixXd::Identity( numberOfParameters, numberOfParameters ) ) *
+                normalizationTerms_.cwiseInverse( ).asDiagonal( );
+
+        // Retrieve ranges of observation sets, for the observation biases
+        for( auto observableIterator : podInput->getObservationsAndTimes( )->getObservationSetStartAndSize( ) )
+        {
+            for( auto linkEndIterator : observableIterator.second )
+            {
+                observationSetRanges_.insert( observationSetRanges_.end( ), linkEndIterator.second.begin( ),
+                                              linkEndIterator.second.end( ) );
+            }
+        }
+
+        resetStatistics( );
+    }
+
+    //! Function to process a number of samples, adding their results to the statistics
+    /*!
+     *  Function to process a number of samples, adding their results to the statistics. Repeated calls continue the
+     *  sequence of samples (use a different seed, or call resetStatistics, to start a new sequence).
+     *  \param numberOfSamples Number of samples to process
+     *  \param seed Seed of the random number generator
+     *  \param perturbAprioriValues Boolean denoting whether the a priori parameter values are perturbed with a sample
+     *  from the a priori covariance (requires a positive definite inverse a priori covariance)
+     *  \param observationBiasStandardDeviation Standard deviation of the constant (unestimated) bias that is added to
+     *  each observation set (0 for no bias)
+     */
+    void runSamples( const unsigned int numberOfSamples,
+                     const uint64_t seed,
+                     const bool perturbAprioriValues = false,
+                     const double observationBiasStandardDeviation = 0.0 )
+    {
+        const int numberOfParameters = designMatrix_.cols( );
+
+        Eigen::MatrixXd inverseAprioriCholeskyFactor;
+        if( perturbAprioriValues )
+        {
+            Eigen::LLT< Eigen::MatrixXd > inverseAprioriDecomposition( inverseAprioriCovariance_ );
+            if( inverseAprioriDecomposition.info( ) != Eigen::Success )
+            {
+                throw std::runtime_error( "Error in Monte Carlo covariance analysis, a priori values can only be perturbed for a positive definite inverse a priori covariance." );
+            }
+            inverseAprioriCholeskyFactor = inverseAprioriDecomposition.matrixU( );
+        }
+
+        // Statistics (of estimation error and residual RMS) of each block of samples are merged in block order
+        typedef std::pair< OnlineSampleStatistics, OnlineSampleStatistics > SampleStatistics;
+        const std::vector< std::pair< unsigned int, unsigned int > > sampleBlocks =
+                utilities::getChunkRanges( numberOfSamples, samplesPerStatisticsBlock );
+        utilities::OrderedReduction< SampleStatistics > statisticsReduction(
+                    std::make_pair( estimationErrorStatistics_, residualRmsStatistics_ ),
+                    []( SampleStatistics& statistics, const SampleStatistics& blockStatistics )
+        {
+            statistics.first.mergeStatistics( blockStatistics.first );
+            statistics.second.mergeStatistics( blockStatistics.second );
+        } );
+
+        const uint64_t firstSampleIndex = numberOfProcessedSamples_;
+        utilities::parallelFor(
+                    sampleBlocks.size( ), numberOfThreads_,
+                    [ & ]( const unsigned int blockIndex, const unsigned int )
+        {
+            SampleStatistics blockStatistics =
+                    std::make_pair( OnlineSampleStatistics( numberOfParameters ), OnlineSampleStatistics( 1 ) );
+            for( unsigned int sampleIndex = sampleBlocks.at( blockIndex ).first;
+                 sampleIndex < sampleBlocks.at( blockIndex ).first + sampleBlocks.at( blockIndex ).second; sampleIndex++ )
+            {
+                addSampleToStatistics( firstSampleIndex + sampleIndex, seed, perturbAprioriValues,
+                                       observationBiasStandardDeviation, inverseAprioriCholeskyFactor, blockStatistics );
+            }
+            statisticsReduction.addTaskResult( blockIndex, std::move( blockStatistics ) );
+        } );
+
+        const SampleStatistics& statistics = statisticsReduction.getReducedValue( sampleBlocks.size( ) );
+        estimationErrorStatistics_ = statistics.first;
+        residualRmsStatistics_ = statistics.second;
+        numberOfProcessedSamples_ += numberOfSamples;
+    }
+
+    //! Function to reset the statistics, and restart the sequence of samples
+    void resetStatistics( )
+    {
+        estimationErrorStatistics_ = OnlineSampleStatistics( designMatrix_.cols( ) );
+        residualRmsStatistics_ = OnlineSampleStatistics( 1 );
+        numberOfProcessedSamples_ = 0;
+    }
+
+    //! Function to retrieve the number of processed samples
+    unsigned long long getNumberOfSamples( ){ return numberOfProcessedSamples_; }
+
+    //! Function to retrieve the mean estimation error over the samples
+    Eigen::VectorXd getMeanEstimationError( ){ return estimationErrorStatistics_.getMean( ); }
+
+    //! Function to retrieve the sample covariance of the estimation error
+    Eigen::MatrixXd getEstimationErrorCovariance( ){ return estimationErrorStatistics_.getCovariance( ); }
+
+    //! Function to retrieve the formal covariance of the (linearized) estimation, for comparison with the sample covariance
+    Eigen::MatrixXd getFormalCovariance( ){ return formalCovariance_; }
+
+    //! Function to retrieve the mean post-fit residual RMS over the samples
+    double getMeanResidualRms( ){ return residualRmsStatistics_.getMean( )( 0 ); }
+
+    //! Function to retrieve the standard deviation of the post-fit residual RMS over the samples
+    double getResidualRmsStandardDeviation( ){ return std::sqrt( residualRmsStatistics_.getCovariance( )( 0, 0 ) ); }
+
+    //! Function to retrieve the design matrix of the observations (unnormalized)
+    const Eigen::MatrixXd& getDesignMatrix( ){ return designMatrix_; }
+
+private:
+
+    //! Number of consecutive samples of which the statistics are accumulated by a single task
+    static const unsigned int samplesPerStatisticsBlock = 64;
+
+    //! Function to process a single sample, adding the estimation error and post-fit residual RMS to the statistics
+    void addSampleToStatistics( const uint64_t sampleIndex,
+                                const uint64_t seed,
+                                const bool perturbAprioriValues,
+                                const double observationBiasStandardDeviation,
+                                const Eigen::MatrixXd& inverseAprioriCholeskyFactor,
+                                std::pair< OnlineSampleStatistics, OnlineSampleStatistics >& statistics )
+    {
+        const int numberOfParameters = designMatrix_.cols( );
+        const int numberOfObservations = designMatrix_.rows( );
+        const uint64_t sampleStream = mixRandomBits( sampleIndex );
+
+        // Perturb residuals with noise and biases
+        Eigen::VectorXd sampleResiduals = referenceResiduals_;
+        for( int i = 0; i < numberOfObservations; i++ )
+        {
+            sampleResiduals( i ) += observationStandardDeviations_( i ) *
+                    getCounterBasedNormalRandomNumber( seed, sampleStream, i );
+        }
+        if( observationBiasStandardDeviation > 0.0 )
+        {
+            for( unsigned int i = 0; i < observationSetRanges_.size( ); i++ )
+            {
+                sampleResiduals.segment( observationSetRanges_.at( i ).first, observationSetRanges_.at( i ).second ).array( ) +=
+                        observationBiasStandardDeviation *
+                        getCounterBasedNormalRandomNumber( seed, sampleStream, numberOfObservations + i );
+            }
+        }
+
+        // Perturb a priori values
+        Eigen::VectorXd aprioriDeviation = Eigen::VectorXd::Zero( numberOfParameters );
+        if( perturbAprioriValues )
+        {
+            for( int i = 0; i < numberOfParameters; i++ )
+            {
+                aprioriDeviation( i ) = getCounterBasedNormalRandomNumber(
+                            seed, sampleStream, numberOfObservations + observationSetRanges_.size( ) + i );
+            }
+            aprioriDeviation = inverseAprioriCholeskyFactor.template triangularView< Eigen::Upper >( ).solve(
+                        aprioriDeviation );
+        }
+
+        // Solve linearized estimation, and add estimation error and post-fit residual RMS to statistics
+        Eigen::VectorXd normalizedRightHandSide = normalizationTerms_.cwiseInverse( ).asDiagonal( ) *
+                ( designMatrix_.transpose( ) * weights_.cwiseProduct( sampleResiduals ) +
+                  inverseAprioriCovariance_ * aprioriDeviation );
+        Eigen::VectorXd estimationError =
+                normalMatrixDecomposition_.solve( normalizedRightHandSide ).cwiseQuotient( normalizationTerms_ );
+        Eigen::VectorXd postFitResiduals = sampleResiduals - designMatrix_ * estimationError;
+        statistics.first.addSample( estimationError );
+        statistics.second.addSample(
+                    Eigen::VectorXd::Constant( 1, std::sqrt( postFitResiduals.squaredNorm( ) /
+                                                             static_cast< double >( numberOfObservations ) ) ) );
+    }
+
+    //! Number of threads used for the samples (<= 0 for hardware concurrency)
+    int numberOfThreads_;
+
+    //! Residuals of the observations for the current parameter values
+    Eigen::VectorXd referenceResiduals_;
+
+    //! Design matrix of the observations for the current parameter values
+    Eigen::MatrixXd designMatrix_;
+
+    //! Observation weights
+    Eigen::VectorXd weights_;
+
+    //! Observation noise standard deviations (inverse square root of the weights, zero for zero weights)
+    Eigen::VectorXd observationStandardDeviations_;
+
+    //! Inverse a priori covariance (zero if not provided)
+    Eigen::MatrixXd inverseAprioriCovariance_;
+
+    //! Normalization terms of the design matrix columns
+    Eigen::VectorXd normalizationTerms_;
+
+    //! Factorization of the normalized normal matrix
+    Eigen::LDLT< Eigen::MatrixXd > normalMatrixDecomposition_;
+
+    //! Formal covariance of the linearized estimation
+    Eigen::MatrixXd formalCovariance_;
+
+    //! Start index and size of each observation set in the concatenated observation vector
+    std::vector< std::pair< int, int > > observationSetRanges_;
+
+    //! Running statistics of the estimation error
+    OnlineSampleStatistics estimationErrorStatistics_;
+
+    //! Running statistics of the post-fit residual RMS
+    OnlineSampleStatistics residualRmsStatistics_;
+
+    //! Number of processed samples (since last reset)
+    unsigned long long numberOfProcessedSamples_;
+};
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_MONTE_CARLO_COVARIANCE_ANALYSIS_H
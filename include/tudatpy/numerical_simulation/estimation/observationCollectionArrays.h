@@ -0,0 +1,371 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_OBSERVATION_COLLECTION_ARRAYS_H
+#define TUDATPY_OBSERVATION_COLLECTION_ARRAYS_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/observation_models/observableTypes.h"
+#include "tudat/simulation/estimation_setup/observationCollection.h"
+
+namespace tudat
+{
+
+namespace observation_models
+{
+
+//! Function to create an observation collection, for a single observable and set of link ends, from arrays
+/*!
+ *  Function to create an observation collection, for a single observable and set of link ends, from arrays
+ *  \param observableType Type of observable
+ *  \param linkEnds Link ends of the observations
+ *  \param observationTimes Epochs of the observations (size N)
+ *  \param observationValues Values of the observations (size N x observable size)
+ *  \param referenceLinkEnd Reference link end of the observation epochs
+ *  \return Observation collection
+ */
+inline std::shared_ptr< ObservationCollection< double, double > > createObservationCollectionFromArrays(
+        const ObservableType observableType,
+        const LinkEnds& linkEnds,
+        const Eigen::VectorXd& observationTimes,
+        const Eigen::MatrixXd& observationValues,
+        const LinkEndType referenceLinkEnd = receiver )
+{
+    const int observableSize = getObservableSize( observableType );
+    if( observationValues.rows( ) != observationTimes.rows( ) || observationValues.cols( ) != observableSize )
+    {
+        throw std::runtime_error( "Error when creating observation collection from arrays, observation values must have "
+                                  "size ( number of times x " + std::to_string( observableSize ) + " )." );
+    }
+
+    std::vector< Eigen::VectorXd > observations;
+    observations.reserve( observationValues.rows( ) );
+    for( int i = 0; i < observationValues.rows( ); i++ )
+    {
+        observations.push_back( observationValues.row( i ).transpose( ) );
+    }
+    std::vector< double > times( observationTimes.data( ), observationTimes.data( ) + observationTimes.rows( ) );
+
+    typename ObservationCollection< double, double >::SortedObservationSets sortedObservationSets;
+    sortedObservationSets[ observableType ][ linkEnds ].push_back(
+                std::make_shared< SingleObservationSet< double, double > >(
+                    observableType, linkEnds, observations, times, referenceLinkEnd ) );
+    return std::make_shared< ObservationCollection< double, double > >( sortedObservationSets );
+}
+
+//! Function to merge a list of observation collections into a single collection
+inline std::shared_ptr< ObservationCollection< double, double > > mergeObservationCollections(
+        const std::vector< std::shared_ptr< ObservationCollection< double, double > > >& observationCollections )
+{
+    typename ObservationCollection< double, double >::SortedObservationSets sortedObservationSets;
+    for( unsigned int i = 0; i < observationCollections.size( ); i++ )
+    {
+        for( auto observableIterator : observationCollections.at( i )->getObservations( ) )
+        {
+            for( auto linkEndIterator : observableIterator.second )
+            {
+                std::vector< std::shared_ptr< SingleObservationSet< double, double > > >& currentSets =
+                        sortedObservationSets[ observableIterator.first ][ linkEndIterator.first ];
+                currentSets.insert( currentSets.end( ), linkEndIterator.second.begin( ), linkEndIterator.second.end( ) );
+            }
+        }
+    }
+    return std::make_shared< ObservationCollection< double, double > >( sortedObservationSets );
+}
+
+//! Function to retrieve the range (start index and size) in the concatenated observation vector of a set of observations
+/*!
+ *  Function to retrieve the range (start index and size) in the concatenated observation vector of the observations of
+ *  a single observable, and (optionally) a single set of link ends. The observations of a single observable (and set of
+ *  link ends) are stored contiguously in the concatenated observation vector.
+ */
+inline std::pair< int, int > getObservationRange(
+        const std::shared_ptr< ObservationCollection< double, double > > observationCollection,
+        const ObservableType observableType,
+        const LinkEnds& linkEnds = LinkEnds( ) )
+{
+    std::map< ObservableType, std::map< LinkEnds, std::vector< std::pair< int, int > > > > observationSetStartAndSize =
+            observationCollection->getObservationSetStartAndSize( );
+    if( observationSetStartAndSize.count( observableType ) == 0 )
+    {
+        throw std::runtime_error( "Error when retrieving observations from collection, observable type " +
+                                  getObservableName( observableType ) + " not found." );
+    }
+
+    int startIndex = -1, numberOfObservations = 0;
+    for( auto linkEndIterator : observationSetStartAndSize.at( observableType ) )
+    {
+        if( linkEnds.size( ) == 0 || linkEndIterator.first == linkEnds )
+        {
+            for( unsigned int i = 0; i < linkEndIterator.second.size( ); i++ )
+            {
+                if( startIndex < 0 )
+                {
+                    startIndex = linkEndIterator.second.at( i ).first;
+                }
+                numberOfObservations += linkEndIterator.second.at( i ).second;
+            }
+        }
+    }
+    if( startIndex < 0 )
+    {
+        throw std::runtime_error( "Error when retrieving observations from collection, link ends not found for observable " +
+                                  getObservableName( observableType ) + "." );
+    }
+    return std::make_pair( startIndex, numberOfObservations );
+}
+
+//! Function to retrieve the concatenated observation vector of a collection by reference
+inline const Eigen::VectorXd& getConcatenatedObservationsReference(
+        const std::shared_ptr< ObservationCollection< double, double > > observationCollection )
+{
+    return observationCollection->getObservationVectorReference( );
+}
+
+//! Function to retrieve (a reference to) the observations of a single observable (and optionally, set of link ends)
+inline Eigen::Ref< const Eigen::VectorXd > getObservationsReference(
+        const std::shared_ptr< ObservationCollection< double, double > > observationCollection,
+        const ObservableType observableType,
+        const LinkEnds& linkEnds = LinkEnds( ) )
+{
+    std::pair< int, int > observationRange = getObservationRange( observationCollection, observableType, linkEnds );
+    return observationCollection->getObservationVectorReference( ).segment(
+                observationRange.first, observationRange.second );
+}
+
+//! Function to retrieve the epochs of the observations of a single observable (and optionally, set of link ends)
+inline Eigen::VectorXd getObservationTimes(
+        const std::shared_ptr< ObservationCollection< double, double > > observationCollection,
+        const ObservableType observableType,
+        const LinkEnds& linkEnds = LinkEnds( ) )
+{
+    std::pair< int, int > observationRange = getObservationRange( observationCollection, observableType, linkEnds );
+    std::vector< double > concatenatedTimes = observationCollection->getConcatenatedTimeVector( );
+    return Eigen::Map< const Eigen::VectorXd >( concatenatedTimes.data( ) + observationRange.first,
+                                                observationRange.second );
+}
+
+//! Identifier at the start of binary observation collection files
+static const std::string observationCollectionFileIdentifier = "TUDATPY_OBSERVATION_COLLECTION";
+
+//! Version of the binary observation collection file format
+static const int32_t observationCollectionFileVersion = 1;
+
+//! Function to write a value to a binary file
+template< typename ValueType >
+void writeBinaryValue( std::ofstream& outputFile, const ValueType value )
+{
+    outputFile.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+}
+
+//! Function to write a string to a binary file
+inline void writeBinaryString( std::ofstream& outputFile, const std::string& value )
+{
+    writeBinaryValue< int32_t >( outputFile, static_cast< int32_t >( value.size( ) ) );
+    outputFile.write( value.data( ), value.size( ) );
+}
+
+//! Function to read a value from a binary file
+template< typename ValueType >
+ValueType readBinaryValue( std::ifstream& inputFile )
+{
+    ValueType value;
+    inputFile.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) );
+    if( !inputFile )
+    {
+        throw std::runtime_error( "Error when reading observation collection file, unexpected end of file." );
+    }
+    return value;
+}
+
+//! Function to compute the number of bytes between the current position and the end of a binary file
+inline int64_t getRemainingFileSize( std::ifstream& inputFile )
+{
+    const std::streampos currentPosition = inputFile.tellg( );
+    inputFile.seekg( 0, std::ios::end );
+    const std::streampos endPosition = inputFile.tellg( );
+    inputFile.seekg( currentPosition );
+    return static_cast< int64_t >( endPosition - currentPosition );
+}
+
+//! Function to read a string from a binary file
+inline std::string readBinaryString( std::ifstream& inputFile )
+{
+    const int32_t stringSize = readBinaryValue< int32_t >( inputFile );
+    if( stringSize < 0 || stringSize > getRemainingFileSize( inputFile ) )
+    {
+        throw std::runtime_error( "Error when reading observation collection file, invalid string size " +
+                                  std::to_string( stringSize ) + "." );
+    }
+    std::string value( stringSize, '\0' );
+    inputFile.read( &value[ 0 ], value.size( ) );
+    if( !inputFile )
+    {
+        throw std::runtime_error( "Error when reading observation collection file, unexpected end of file." );
+    }
+    return value;
+}
+
+//! Function to save an observation collection to a binary file
+/*!
+ *  Function to save an observation collection to a binary file, storing for each observation set its observable type,
+ *  link ends, reference link end, epochs and observations (in native byte order). Observation dependent variables are
+ *  not saved.
+ *  \param observationCollection Observation collection to save
+ *  \param fileName Name of the file to which the collection is saved
+ */
+inline void saveObservationCollectionToBinaryFile(
+        const std::shared_ptr< ObservationCollection< double, double > > observationCollection,
+        const std::string& fileName )
+{
+    std::ofstream outputFile( fileName, std::ios::binary );
+    if( !outputFile )
+    {
+        throw std::runtime_error( "Error when saving observation collection, could not open file " + fileName );
+    }
+
+    std::vector< std::shared_ptr< SingleObservationSet< double, double > > > observationSets;
+    for( auto observableIterator : observationCollection->getObservations( ) )
+    {
+        for( auto linkEndIterator : observableIterator.second )
+        {
+            observationSets.insert( observationSets.end( ), linkEndIterator.second.begin( ), linkEndIterator.second.end( ) );
+        }
+    }
+
+    outputFile.write( observationCollectionFileIdentifier.data( ), observationCollectionFileIdentifier.size( ) );
+    writeBinaryValue< int32_t >( outputFile, observationCollectionFileVersion );
+    writeBinaryValue< int64_t >( outputFile, static_cast< int64_t >( observationSets.size( ) ) );
+    for( unsigned int i = 0; i < observationSets.size( ); i++ )
+    {
+        std::shared_ptr< SingleObservationSet< double, double > > currentSet = observationSets.at( i );
+        const std::vector< double >& times = currentSet->getObservationTimes( );
+        const std::vector< Eigen::VectorXd >& observations = currentSet->getObservations( );
+        const int32_t observableSize = getObservableSize( currentSet->getObservableType( ) );
+
+        writeBinaryValue< int32_t >( outputFile, static_cast< int32_t >( currentSet->getObservableType( ) ) );
+        writeBinaryValue< int32_t >( outputFile, static_cast< int32_t >( currentSet->getReferenceLinkEnd( ) ) );
+        writeBinaryValue< int32_t >( outputFile, static_cast< int32_t >( currentSet->getLinkEnds( ).size( ) ) );
+        for( auto linkEndIterator : currentSet->getLinkEnds( ) )
+        {
+            writeBinaryValue< int32_t >( outputFile, static_cast< int32_t >( linkEndIterator.first ) );
+            writeBinaryString( outputFile, linkEndIterator.second.first );
+            writeBinaryString( outputFile, linkEndIterator.second.second );
+        }
+
+        writeBinaryValue< int32_t >( outputFile, observableSize );
+        writeBinaryValue< int64_t >( outputFile, static_cast< int64_t >( times.size( ) ) );
+        outputFile.write( reinterpret_cast< const char* >( times.data( ) ), times.size( ) * sizeof( double ) );
+        for( unsigned int j = 0; j < observations.size( ); j++ )
+        {
+            outputFile.write( reinterpret_cast< const char* >( observations.at( j ).data( ) ),
+                              observableSize * sizeof( double ) );
+        }
+    }
+
+    if( !outputFile )
+    {
+        throw std::runtime_error( "Error when saving observation collection, could not write to file " + fileName );
+    }
+}
+
+//! Function to load an observation collection from a binary file (see saveObservationCollectionToBinaryFile)
+inline std::shared_ptr< ObservationCollection< double, double > > loadObservationCollectionFromBinaryFile(
+        const std::string& fileName )
+{
+    std::ifstream inputFile( fileName, std::ios::binary );
+    if( !inputFile )
+    {
+        throw std::runtime_error( "Error when loading observation collection, could not open file " + fileName );
+    }
+
+    std::string fileIdentifier( observationCollectionFileIdentifier.size( ), '\0' );
+    inputFile.read( &fileIdentifier[ 0 ], fileIdentifier.size( ) );
+    if( !inputFile || fileIdentifier != observationCollectionFileIdentifier )
+    {
+        throw std::runtime_error( "Error when loading observation collection, file " + fileName +
+                                  " is not an observation collection file." );
+    }
+    const int32_t fileVersion = readBinaryValue< int32_t >( inputFile );
+    if( fileVersion != observationCollectionFileVersion )
+    {
+        throw std::runtime_error( "Error when loading observation collection, file version " +
+                                  std::to_string( fileVersion ) + " not supported." );
+    }
+
+    typename ObservationCollection< double, double >::SortedObservationSets sortedObservationSets;
+    const int64_t numberOfObservationSets = readBinaryValue< int64_t >( inputFile );
+    for( int64_t i = 0; i < numberOfObservationSets; i++ )
+    {
+        const ObservableType observableType = static_cast< ObservableType >( readBinaryValue< int32_t >( inputFile ) );
+        const LinkEndType referenceLinkEnd = static_cast< LinkEndType >( readBinaryValue< int32_t >( inputFile ) );
+        const int32_t numberOfLinkEnds = readBinaryValue< int32_t >( inputFile );
+        LinkEnds linkEnds;
+        for( int32_t j = 0; j < numberOfLinkEnds; j++ )
+        {
+            const LinkEndType linkEndType = static_cast< LinkEndType >( readBinaryValue< int32_t >( inputFile ) );
+            const std::string bodyName = readBinaryString( inputFile );
+            const std::string stationName = readBinaryString( inputFile );
+            linkEnds[ linkEndType ] = std::make_pair( bodyName, stationName );
+        }
+
+        const int32_t observableSize = readBinaryValue< int32_t >( inputFile );
+        if( observableSize != getObservableSize( observableType ) )
+        {
+            throw std::runtime_error( "Error when loading observation collection, observable size " +
+                                      std::to_string( observableSize ) + " of observable " +
+                                      getObservableName( observableType ) + " in file " + fileName +
+                                      " is inconsistent, expected " +
+                                      std::to_string( getObservableSize( observableType ) ) + "." );
+        }
+
+        // Check the number of epochs against the file size, before allocating the observations
+        const int64_t numberOfEpochs = readBinaryValue< int64_t >( inputFile );
+        if( numberOfEpochs < 0 || numberOfEpochs > getRemainingFileSize( inputFile ) /
+                static_cast< int64_t >( ( observableSize + 1 ) * sizeof( double ) ) )
+        {
+            throw std::runtime_error( "Error when loading observation collection, number of epochs " +
+                                      std::to_string( numberOfEpochs ) + " is inconsistent with the size of file " +
+                                      fileName );
+        }
+        std::vector< double > times( numberOfEpochs );
+        inputFile.read( reinterpret_cast< char* >( times.data( ) ), numberOfEpochs * sizeof( double ) );
+        std::vector< Eigen::VectorXd > observations( numberOfEpochs, Eigen::VectorXd( observableSize ) );
+        for( int64_t j = 0; j < numberOfEpochs; j++ )
+        {
+            inputFile.read( reinterpret_cast< char* >( observations.at( j ).data( ) ), observableSize * sizeof( double ) );
+        }
+        if( !inputFile )
+        {
+            throw std::runtime_error( "Error when loading observation collection, unexpected end of file " + fileName );
+        }
+
+        sortedObservationSets[ observableType ][ linkEnds ].push_back(
+                    std::make_shared< SingleObservationSet< double, double > >(
+                        observableType, linkEnds, observations, times, referenceLinkEnd ) );
+    }
+    return std::make_shared< ObservationCollection< double, double > >( sortedObservationSets );
+}
+
+} // namespace observation_models
+
+} // namespace tudat
+
+#endif // TUDATPY_OBSERVATION_COLLECTION_ARRAYS_H
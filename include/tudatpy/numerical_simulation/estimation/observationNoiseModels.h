@@ -0,0 +1,461 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_OBSERVATION_NOISE_MODELS_H
+#define TUDATPY_OBSERVATION_NOISE_MODELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/observation_models/observableTypes.h"
+#include "tudat/math/basic/mathematicalConstants.h"
+#include "tudat/simulation/estimation_setup/observationSimulationSettings.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Function to mix a 64-bit integer into a (statistically) uniformly distributed 64-bit integer (SplitMix64 finalizer)
+inline uint64_t mixRandomBits( uint64_t value )
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+    return value ^ ( value >> 31 );
+}
+
+//! Function to compute a uniformly distributed random number in (0,1) from a seed, stream and counter
+/*!
+ *  Function to compute a uniformly distributed random number in (0,1) from a seed, stream and counter. The random
+ *  number is a pure function of its input (counter-based generation), such that random numbers can be drawn in any
+ *  order, and from any thread, with reproducible results.
+ *  \param seed Seed of the random number generator
+ *  \param stream Identifier of the random number stream
+ *  \param counter Index of the random number in the stream
+ *  \return Random number, uniformly distributed in (0,1)
+ */
+inline double getCounterBasedUniformRandomNumber( const uint64_t seed, const uint64_t stream, const uint64_t counter )
+{
+    const uint64_t randomBits = mixRandomBits( seed ^ mixRandomBits( stream ^ mixRandomBits( counter ) ) );
+    return ( static_cast< double >( randomBits >> 11 ) + 0.5 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+//! Function to compute a normally distributed random number (zero mean, unit variance) from a seed, stream and counter
+/*!
+ *  Function to compute a normally distributed random number (zero mean, unit variance) from a seed, stream and counter,
+ *  using the Box-Muller transform of two counter-based uniform random numbers.
+ */
+inline double getCounterBasedNormalRandomNumber( const uint64_t seed, const uint64_t stream, const uint64_t counter )
+{
+    const double firstUniform = getCounterBasedUniformRandomNumber( seed, stream, 2 * counter );
+    const double secondUniform = getCounterBasedUniformRandomNumber( seed, stream, 2 * counter + 1 );
+    return std::sqrt( -2.0 * std::log( firstUniform ) ) * std::cos( 2.0 * mathematical_constants::PI * secondUniform );
+}
+
+//! Function to compute the counter of a random number from an epoch and an index (e.g. of the observable entry)
+inline uint64_t getEpochRandomNumberCounter( const double epoch, const unsigned int index )
+{
+    uint64_t epochBits;
+    std::memcpy( &epochBits, &epoch, sizeof( double ) );
+    return mixRandomBits( epochBits ) ^ static_cast< uint64_t >( index );
+}
+
+//! Types of native observation noise models
+enum ObservationNoiseModelTypes
+{
+    gaussian_observation_noise,
+    uniform_observation_noise,
+    first_order_autoregressive_observation_noise,
+    bias_drift_observation_noise
+};
+
+//! Function to compute the identifier of the random number stream of a noise model of an observable and its link ends
+/*!
+ *  Function to compute the identifier of the random number stream of a noise model of an observable and its link ends
+ *  (using FNV-1a hashing of the link end names, such that the identifier does not depend on the platform). The type of
+ *  the noise model and its index in the list of noise models of the observable are included, such that noise models
+ *  that are combined on a single observable (with the same seed) draw independent random numbers.
+ *  \param observableType Type of observable to which the noise is added
+ *  \param linkEnds Link ends of the observable to which the noise is added
+ *  \param noiseModelType Type of the noise model
+ *  \param noiseModelIndex Index of the noise model in the list of noise models that is added to the observable
+ *  \return Identifier of the random number stream
+ */
+inline uint64_t getObservationRandomNumberStream( const observation_models::ObservableType observableType,
+                                                  const observation_models::LinkEnds& linkEnds,
+                                                  const ObservationNoiseModelTypes noiseModelType,
+                                                  const unsigned int noiseModelIndex )
+{
+    uint64_t streamHash = 14695981039346656037ULL;
+    auto addToHash = [ &streamHash ]( const std::string& hashInput )
+    {
+        for( unsigned int i = 0; i < hashInput.size( ); i++ )
+        {
+            streamHash = ( streamHash ^ static_cast< unsigned char >( hashInput.at( i ) ) ) * 1099511628211ULL;
+        }
+        streamHash = ( streamHash ^ 0xFFULL ) * 1099511628211ULL;
+    };
+
+    addToHash( std::to_string( static_cast< int >( observableType ) ) );
+    for( auto linkEndIterator : linkEnds )
+    {
+        addToHash( std::to_string( static_cast< int >( linkEndIterator.first ) ) );
+        addToHash( linkEndIterator.second.first );
+        addToHash( linkEndIterator.second.second );
+    }
+    addToHash( std::to_string( static_cast< int >( noiseModelType ) ) );
+    addToHash( std::to_string( noiseModelIndex ) );
+    return streamHash;
+}
+
+//! Base class for the settings of a native observation noise model
+/*!
+ *  Base class for the settings of a native observation noise model. The noise is generated from counter-based random
+ *  numbers, with a separate stream for each observable, set of link ends and noise model (see
+ *  getObservationRandomNumberStream), and (for white noise) the epoch as counter.
+ *  The noise of each observation is therefore independent of the order in which (and the thread on which) the
+ *  observations are simulated.
+ */
+class ObservationNoiseModelSettings
+{
+public:
+
+    //! Constructor
+    ObservationNoiseModelSettings( const ObservationNoiseModelTypes noiseModelType,
+                                   const uint64_t seed ):
+        noiseModelType_( noiseModelType ), seed_( seed ){ }
+
+    //! Destructor
+    virtual ~ObservationNoiseModelSettings( ){ }
+
+    //! Type of noise model
+    ObservationNoiseModelTypes noiseModelType_;
+
+    //! Seed of the random number generator
+    uint64_t seed_;
+};
+
+//! Settings for white Gaussian observation noise
+class GaussianObservationNoiseSettings: public ObservationNoiseModelSettings
+{
+public:
+
+    GaussianObservationNoiseSettings( const double standardDeviation, const double mean, const uint64_t seed ):
+        ObservationNoiseModelSettings( gaussian_observation_noise, seed ),
+        standardDeviation_( standardDeviation ), mean_( mean ){ }
+
+    //! Standard deviation of the noise
+    double standardDeviation_;
+
+    //! Mean of the noise
+    double mean_;
+};
+
+//! Settings for white, uniformly distributed observation noise
+class UniformObservationNoiseSettings: public ObservationNoiseModelSettings
+{
+public:
+
+    UniformObservationNoiseSettings( const double lowerBound, const double upperBound, const uint64_t seed ):
+        ObservationNoiseModelSettings( uniform_observation_noise, seed ),
+        lowerBound_( lowerBound ), upperBound_( upperBound ){ }
+
+    //! Lower bound of the noise
+    double lowerBound_;
+
+    //! Upper bound of the noise
+    double upperBound_;
+};
+
+//! Settings for colored observation noise, modelled as a first-order autoregressive (Gauss-Markov) process
+/*!
+ *  Settings for colored observation noise, modelled as a first-order autoregressive (Gauss-Markov) process with a
+ *  given steady-state standard deviation and correlation time. For observation epochs t_k, the noise is computed as
+ *  x_k = phi_k x_{k-1} + sigma sqrt( 1 - phi_k^2 ) w_k, with phi_k = exp( -( t_k - t_{k-1} ) / tau ), and w_k white
+ *  Gaussian noise with unit variance. The process is evaluated on the (tabulated) simulation epochs of each observation
+ *  simulation settings object, and can only be added to tabulated settings.
+ */
+class AutoregressiveObservationNoiseSettings: public ObservationNoiseModelSettings
+{
+public:
+
+    AutoregressiveObservationNoiseSettings( const double standardDeviation, const double correlationTime,
+                                            const uint64_t seed ):
+        ObservationNoiseModelSettings( first_order_autoregressive_observation_noise, seed ),
+        standardDeviation_( standardDeviation ), correlationTime_( correlationTime )
+    {
+        if( !( correlationTime_ > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating autoregressive noise settings, correlation time must be positive." );
+        }
+    }
+
+    //! Steady-state standard deviation of the noise
+    double standardDeviation_;
+
+    //! Correlation time of the noise
+    double correlationTime_;
+};
+
+//! Settings for an observation bias that drifts linearly in time, drawn randomly per observable and set of link ends
+/*!
+ *  Settings for an observation bias that drifts linearly in time, drawn randomly per observable and set of link ends.
+ *  The noise is computed as b + d ( t - t_0 ), with b and d drawn from zero-mean Gaussian distributions with the given
+ *  standard deviations (once for each observable, set of link ends and observable entry).
+ */
+class BiasDriftObservationNoiseSettings: public ObservationNoiseModelSettings
+{
+public:
+
+    BiasDriftObservationNoiseSettings( const double biasStandardDeviation, const double driftStandardDeviation,
+                                       const double referenceEpoch, const uint64_t seed ):
+        ObservationNoiseModelSettings( bias_drift_observation_noise, seed ),
+        biasStandardDeviation_( biasStandardDeviation ), driftStandardDeviation_( driftStandardDeviation ),
+        referenceEpoch_( referenceEpoch ){ }
+
+    //! Standard deviation of the bias (at the reference epoch)
+    double biasStandardDeviation_;
+
+    //! Standard deviation of the drift rate of the bias
+    double driftStandardDeviation_;
+
+    //! Reference epoch t_0 of the bias
+    double referenceEpoch_;
+};
+
+inline std::shared_ptr< ObservationNoiseModelSettings > gaussianObservationNoise(
+        const double standardDeviation, const double mean = 0.0, const uint64_t seed = 0 )
+{
+    return std::make_shared< GaussianObservationNoiseSettings >( standardDeviation, mean, seed );
+}
+
+inline std::shared_ptr< ObservationNoiseModelSettings > uniformObservationNoise(
+        const double lowerBound, const double upperBound, const uint64_t seed = 0 )
+{
+    return std::make_shared< UniformObservationNoiseSettings >( lowerBound, upperBound, seed );
+}
+
+inline std::shared_ptr< ObservationNoiseModelSettings > autoregressiveObservationNoise(
+        const double standardDeviation, const double correlationTime, const uint64_t seed = 0 )
+{
+    return std::make_shared< AutoregressiveObservationNoiseSettings >( standardDeviation, correlationTime, seed );
+}
+
+inline std::shared_ptr< ObservationNoiseModelSettings > biasDriftObservationNoise(
+        const double biasStandardDeviation, const double driftStandardDeviation,
+        const double referenceEpoch = 0.0, const uint64_t seed = 0 )
+{
+    return std::make_shared< BiasDriftObservationNoiseSettings >(
+                biasStandardDeviation, driftStandardDeviation, referenceEpoch, seed );
+}
+
+//! Function to create the noise function of a native observation noise model
+/*!
+ *  Function to create the noise function of a native observation noise model, for a single observation simulation
+ *  settings object.
+ *  \param noiseModelSettings Settings of the noise model
+ *  \param observableType Type of observable to which the noise is added
+ *  \param linkEnds Link ends of the observable to which the noise is added
+ *  \param simulationTimes Epochs at which the observations are simulated (required for autoregressive noise only)
+ *  \param noiseModelIndex Index of the noise model in the list of noise models that is added to the observable
+ *  \return Function returning the noise as a function of observation epoch
+ */
+inline std::function< Eigen::VectorXd( const double ) > createObservationNoiseFunction(
+        const std::shared_ptr< ObservationNoiseModelSettings > noiseModelSettings,
+        const observation_models::ObservableType observableType,
+        const observation_models::LinkEnds& linkEnds,
+        const std::vector< double >& simulationTimes,
+        const unsigned int noiseModelIndex = 0 )
+{
+    const int observableSize = observation_models::getObservableSize( observableType );
+    const uint64_t seed = noiseModelSettings->seed_;
+    const uint64_t stream = getObservationRandomNumberStream(
+                observableType, linkEnds, noiseModelSettings->noiseModelType_, noiseModelIndex );
+
+    std::function< Eigen::VectorXd( const double ) > noiseFunction;
+    switch( noiseModelSettings->noiseModelType_ )
+    {
+    case gaussian_observation_noise:
+    {
+        std::shared_ptr< GaussianObservationNoiseSettings > gaussianSettings =
+                std::dynamic_pointer_cast< GaussianObservationNoiseSettings >( noiseModelSettings );
+        if( gaussianSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when creating Gaussian observation noise, settings type is inconsistent." );
+        }
+        const double standardDeviation = gaussianSettings->standardDeviation_;
+        const double mean = gaussianSettings->mean_;
+        noiseFunction = [ = ]( const double epoch )
+        {
+            Eigen::VectorXd noise = Eigen::VectorXd( observableSize );
+            for( int i = 0; i < observableSize; i++ )
+            {
+                noise( i ) = mean + standardDeviation * getCounterBasedNormalRandomNumber(
+                            seed, stream, getEpochRandomNumberCounter( epoch, i ) );
+            }
+            return noise;
+        };
+        break;
+    }
+    case uniform_observation_noise:
+    {
+        std::shared_ptr< UniformObservationNoiseSettings > uniformSettings =
+                std::dynamic_pointer_cast< UniformObservationNoiseSettings >( noiseModelSettings );
+        if( uniformSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when creating uniform observation noise, settings type is inconsistent." );
+        }
+        const double lowerBound = uniformSettings->lowerBound_;
+        const double upperBound = uniformSettings->upperBound_;
+        noiseFunction = [ = ]( const double epoch )
+        {
+            Eigen::VectorXd noise = Eigen::VectorXd( observableSize );
+            for( int i = 0; i < observableSize; i++ )
+            {
+                noise( i ) = lowerBound + ( upperBound - lowerBound ) * getCounterBasedUniformRandomNumber(
+                            seed, stream, getEpochRandomNumberCounter( epoch, i ) );
+            }
+            return noise;
+        };
+        break;
+    }
+    case first_order_autoregressive_observation_noise:
+    {
+        std::shared_ptr< AutoregressiveObservationNoiseSettings > autoregressiveSettings =
+                std::dynamic_pointer_cast< AutoregressiveObservationNoiseSettings >( noiseModelSettings );
+        if( autoregressiveSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when creating autoregressive observation noise, settings type is inconsistent." );
+        }
+        if( simulationTimes.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when creating autoregressive observation noise, no simulation times provided." );
+        }
+
+        // Evaluate process on sorted simulation epochs
+        std::vector< double > sortedTimes = simulationTimes;
+        std::sort( sortedTimes.begin( ), sortedTimes.end( ) );
+        std::map< double, Eigen::VectorXd > noiseHistory;
+        Eigen::VectorXd currentNoise = Eigen::VectorXd( observableSize );
+        for( unsigned int j = 0; j < sortedTimes.size( ); j++ )
+        {
+            const double correlation = ( j == 0 ) ? 0.0 :
+                    std::exp( -( sortedTimes.at( j ) - sortedTimes.at( j - 1 ) ) / autoregressiveSettings->correlationTime_ );
+            for( int i = 0; i < observableSize; i++ )
+            {
+                currentNoise( i ) = correlation * ( ( j == 0 ) ? 0.0 : currentNoise( i ) ) +
+                        autoregressiveSettings->standardDeviation_ * std::sqrt( 1.0 - correlation * correlation ) *
+                        getCounterBasedNormalRandomNumber( seed, stream, getEpochRandomNumberCounter( sortedTimes.at( j ), i ) );
+            }
+            noiseHistory[ sortedTimes.at( j ) ] = currentNoise;
+        }
+
+        noiseFunction = [ = ]( const double epoch )
+        {
+            auto noiseIterator = noiseHistory.find( epoch );
+            if( noiseIterator == noiseHistory.end( ) )
+            {
+                throw std::runtime_error( "Error when evaluating autoregressive observation noise, epoch " +
+                                          std::to_string( epoch ) + " is not a simulation epoch." );
+            }
+            return noiseIterator->second;
+        };
+        break;
+    }
+    case bias_drift_observation_noise:
+    {
+        std::shared_ptr< BiasDriftObservationNoiseSettings > biasDriftSettings =
+                std::dynamic_pointer_cast< BiasDriftObservationNoiseSettings >( noiseModelSettings );
+        if( biasDriftSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when creating bias drift observation noise, settings type is inconsistent." );
+        }
+        Eigen::VectorXd bias = Eigen::VectorXd( observableSize );
+        Eigen::VectorXd drift = Eigen::VectorXd( observableSize );
+        for( int i = 0; i < observableSize; i++ )
+        {
+            bias( i ) = biasDriftSettings->biasStandardDeviation_ *
+                    getCounterBasedNormalRandomNumber( seed, stream, 2 * static_cast< uint64_t >( i ) );
+            drift( i ) = biasDriftSettings->driftStandardDeviation_ *
+                    getCounterBasedNormalRandomNumber( seed, stream, 2 * static_cast< uint64_t >( i ) + 1 );
+        }
+        const double referenceEpoch = biasDriftSettings->referenceEpoch_;
+        noiseFunction = [ = ]( const double epoch )
+        {
+            return Eigen::VectorXd( bias + drift * ( epoch - referenceEpoch ) );
+        };
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error when creating observation noise function, noise model type " +
+                                  std::to_string( static_cast< int >( noiseModelSettings->noiseModelType_ ) ) +
+                                  " not recognized." );
+    }
+    return noiseFunction;
+}
+
+//! Function to add native observation noise models to a list of observation simulation settings
+/*!
+ *  Function to add native observation noise models to a list of observation simulation settings. The noise of all
+ *  models in the list is summed, and replaces any existing noise function of the settings.
+ *  \param observationSimulationSettings Observation simulation settings to which the noise is to be added
+ *  \param noiseModelSettingsList Settings of the noise models
+ */
+inline void addNoiseModelsToObservationSimulationSettings(
+        const std::vector< std::shared_ptr< ObservationSimulationSettings< double > > >& observationSimulationSettings,
+        const std::vector< std::shared_ptr< ObservationNoiseModelSettings > >& noiseModelSettingsList )
+{
+    for( unsigned int i = 0; i < observationSimulationSettings.size( ); i++ )
+    {
+        std::shared_ptr< ObservationSimulationSettings< double > > currentSettings = observationSimulationSettings.at( i );
+        std::shared_ptr< TabulatedObservationSimulationSettings< double > > tabulatedSettings =
+                std::dynamic_pointer_cast< TabulatedObservationSimulationSettings< double > >( currentSettings );
+        const std::vector< double > simulationTimes =
+                ( tabulatedSettings != nullptr ) ? tabulatedSettings->simulationTimes_ : std::vector< double >( );
+
+        std::vector< std::function< Eigen::VectorXd( const double ) > > noiseFunctions;
+        for( unsigned int j = 0; j < noiseModelSettingsList.size( ); j++ )
+        {
+            noiseFunctions.push_back( createObservationNoiseFunction(
+                                          noiseModelSettingsList.at( j ), currentSettings->getObservableType( ),
+                                          currentSettings->getLinkEnds( ), simulationTimes, j ) );
+        }
+
+        const int observableSize = observation_models::getObservableSize( currentSettings->getObservableType( ) );
+        currentSettings->setObservationNoiseFunction(
+                    std::function< Eigen::VectorXd( const double ) >( [ = ]( const double epoch )
+        {
+            Eigen::VectorXd totalNoise = Eigen::VectorXd::Zero( observableSize );
+            for( unsigned int j = 0; j < noiseFunctions.size( ); j++ )
+            {
+                totalNoise += noiseFunctions.at( j )( epoch );
+            }
+            return totalNoise;
+        } ) );
+    }
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_OBSERVATION_NOISE_MODELS_H
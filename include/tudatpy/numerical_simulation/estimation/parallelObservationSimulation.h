@@ -0,0 +1,268 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PARALLEL_OBSERVATION_SIMULATION_H
+#define TUDATPY_PARALLEL_OBSERVATION_SIMULATION_H
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tudat/simulation/estimation_setup.h"
+
+#include "tudatpy/basics/eventTracing.h"
+#include "tudatpy/basics/parallelFor.h"
+#include "tudatpy/numerical_simulation/environment/serializedSpiceAccess.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Single unit of work for the parallel observation simulation: a time chunk of a single observation simulation setting
+template< typename TimeType = double >
+struct ObservationSimulationTask
+{
+    ObservationSimulationTask( const unsigned int settingsIndex,
+                               const std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > chunkSettings ):
+        settingsIndex_( settingsIndex ), chunkSettings_( chunkSettings ){ }
+
+    //! Index of the original observation simulation settings from which this task was created
+    unsigned int settingsIndex_;
+
+    //! Settings for the simulation of the observations in this time chunk (without noise)
+    std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > chunkSettings_;
+};
+
+//! Function to split a list of observation simulation settings into tasks per link end, observable and time chunk.
+/*!
+ *  Function to split a list of observation simulation settings into tasks per link end, observable and time chunk. Each
+ *  task gets a copy of the original settings with only the epochs of its chunk, and with the noise function removed (noise
+ *  is added after all tasks are completed, see simulateObservationsInParallel).
+ *  \param observationsToSimulate Settings for the observations that are to be simulated
+ *  \param numberOfEpochsPerChunk Maximum number of epochs that is simulated in a single task
+ *  \return List of tasks, ordered by settings index and (within each settings) by epoch
+ */
+template< typename TimeType = double >
+std::vector< ObservationSimulationTask< TimeType > > createObservationSimulationTasks(
+        const std::vector< std::shared_ptr< ObservationSimulationSettings< TimeType > > >& observationsToSimulate,
+        const unsigned int numberOfEpochsPerChunk )
+{
+    if( numberOfEpochsPerChunk == 0 )
+    {
+        throw std::runtime_error( "Error when simulating observations in parallel, number of epochs per chunk must be positive." );
+    }
+
+    std::vector< ObservationSimulationTask< TimeType > > simulationTasks;
+    for( unsigned int i = 0; i < observationsToSimulate.size( ); i++ )
+    {
+        std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > tabulatedSettings =
+                std::dynamic_pointer_cast< TabulatedObservationSimulationSettings< TimeType > >( observationsToSimulate.at( i ) );
+        if( tabulatedSettings == nullptr )
+        {
+            throw std::runtime_error( "Error when simulating observations in parallel, only tabulated observation simulation settings are supported." );
+        }
+
+        const std::vector< TimeType >& simulationTimes = tabulatedSettings->simulationTimes_;
+        std::vector< std::pair< unsigned int, unsigned int > > chunkRanges =
+                utilities::getChunkRanges( simulationTimes.size( ), numberOfEpochsPerChunk );
+        if( chunkRanges.size( ) == 0 )
+        {
+            chunkRanges.push_back( std::make_pair( 0, 0 ) );
+        }
+
+        for( unsigned int j = 0; j < chunkRanges.size( ); j++ )
+        {
+            std::shared_ptr< TabulatedObservationSimulationSettings< TimeType > > chunkSettings =
+                    std::make_shared< TabulatedObservationSimulationSettings< TimeType > >( *tabulatedSettings );
+            chunkSettings->simulationTimes_ = std::vector< TimeType >(
+                        simulationTimes.begin( ) + chunkRanges.at( j ).first,
+                        simulationTimes.begin( ) + chunkRanges.at( j ).first + chunkRanges.at( j ).second );
+            chunkSettings->setObservationNoiseFunction( std::function< Eigen::VectorXd( const double ) >( ) );
+            simulationTasks.push_back( ObservationSimulationTask< TimeType >( i, chunkSettings ) );
+        }
+    }
+    return simulationTasks;
+}
+
+//! Function to retrieve the (single) observation set from an observation collection that was simulated from one setting
+template< typename ObservationScalarType = double, typename TimeType = double >
+std::shared_ptr< observation_models::SingleObservationSet< ObservationScalarType, TimeType > > getSingleSimulatedObservationSet(
+        const std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > observationCollection )
+{
+    typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets
+            sortedObservations = observationCollection->getObservations( );
+    if( sortedObservations.size( ) == 0 || sortedObservations.begin( )->second.size( ) == 0 ||
+            sortedObservations.begin( )->second.begin( )->second.size( ) == 0 )
+    {
+        return nullptr;
+    }
+    return sortedObservations.begin( )->second.begin( )->second.at( 0 );
+}
+
+//! Function to simulate observations with a single set of observation simulators, recording a trace event
+/*!
+ *  Function to simulate observations with a single set of observation simulators (as the Tudat simulateObservations),
+ *  recording the simulation as a trace event (see utilities::EventTracer).
+ *  \param observationsToSimulate Settings for the observations that are to be simulated
+ *  \param observationSimulators Simulators with which the observations are simulated
+ *  \param bodies System of bodies in which the observations are simulated
+ *  \return Collection of simulated observations
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > simulateObservationsWithTracing(
+        const std::vector< std::shared_ptr< ObservationSimulationSettings< TimeType > > >& observationsToSimulate,
+        const std::vector< std::shared_ptr< observation_models::ObservationSimulatorBase< ObservationScalarType, TimeType > > >&
+        observationSimulators,
+        const SystemOfBodies& bodies )
+{
+    utilities::ScopedTraceEvent traceEvent( "simulate_observations", "observation_simulation" );
+    return simulateObservations< ObservationScalarType, TimeType >( observationsToSimulate, observationSimulators, bodies );
+}
+
+//! Function to simulate observations, distributing the work over a number of threads.
+/*!
+ *  Function to simulate observations, distributing the work over a number of threads. The observation simulation
+ *  settings are split into tasks per link end, observable and time chunk (see createObservationSimulationTasks), which
+ *  are executed on a pool of threads. Each thread uses its own set of observation simulators, created from the
+ *  observation model settings, so that no light-time calculator is shared between threads. The results of all chunks
+ *  are concatenated in the original order, after which the noise functions are evaluated sequentially, in the same order
+ *  as in the serial simulation (simulateObservations). The resulting observation collection is therefore identical,
+ *  regardless of the number of threads. Note that the environment models that are used by the observation models
+ *  (ephemerides, rotation models, etc.) are evaluated concurrently, and must be safe for concurrent read access. As the
+ *  Spice library is not thread-safe, the calls to Spice ephemerides are serialized while the observations are simulated
+ *  on multiple threads (see ScopedSpiceEphemerisSerialization), and the observations are simulated on a single thread
+ *  if any body has a Spice rotation model.
+ *  \param observationsToSimulate Settings for the observations that are to be simulated (tabulated settings only)
+ *  \param observationModelSettings Settings for the observation models used to simulate the observations
+ *  \param bodies System of bodies in which the observations are simulated
+ *  \param numberOfThreads Number of threads that is to be used (<= 0 for hardware concurrency)
+ *  \param numberOfEpochsPerChunk Maximum number of epochs that is simulated in a single task
+ *  \return Collection of simulated observations
+ */
+template< typename ObservationScalarType = double, typename TimeType = double >
+std::shared_ptr< observation_models::ObservationCollection< ObservationScalarType, TimeType > > simulateObservationsInParallel(
+        const std::vector< std::shared_ptr< ObservationSimulationSettings< TimeType > > >& observationsToSimulate,
+        const std::vector< std::shared_ptr< observation_models::ObservationModelSettings > >& observationModelSettings,
+        const SystemOfBodies& bodies,
+        const int numberOfThreads = 0,
+        const unsigned int numberOfEpochsPerChunk = 1000 )
+{
+    typedef observation_models::SingleObservationSet< ObservationScalarType, TimeType > ObservationSet;
+    typedef std::vector< std::shared_ptr< observation_models::ObservationSimulatorBase< ObservationScalarType, TimeType > > >
+            ObservationSimulatorList;
+
+    utilities::ScopedTraceEvent traceEvent( "simulate_observations", "observation_simulation" );
+    std::vector< ObservationSimulationTask< TimeType > > simulationTasks =
+            createObservationSimulationTasks( observationsToSimulate, numberOfEpochsPerChunk );
+
+    // Serialize Spice ephemerides for multi-threaded simulation (Spice rotation models cannot be serialized)
+    const unsigned int numberOfThreadsToUse = isSpiceRotationModelUsed( bodies ) ? 1 :
+            utilities::getNumberOfThreadsToUse( numberOfThreads, simulationTasks.size( ) );
+    std::unique_ptr< ScopedSpiceEphemerisSerialization > spiceSerialization;
+    if( numberOfThreadsToUse > 1 )
+    {
+        spiceSerialization = std::unique_ptr< ScopedSpiceEphemerisSerialization >(
+                    new ScopedSpiceEphemerisSerialization( bodies ) );
+    }
+
+    // Create observation simulators for each thread
+    std::vector< ObservationSimulatorList > observationSimulatorsPerThread;
+    for( unsigned int i = 0; i < numberOfThreadsToUse; i++ )
+    {
+        observationSimulatorsPerThread.push_back(
+                    observation_models::createObservationSimulators< ObservationScalarType, TimeType >(
+                        observationModelSettings, bodies ) );
+    }
+
+    // Simulate noise-free observations per task
+    std::vector< std::shared_ptr< ObservationSet > > observationSetPerTask( simulationTasks.size( ) );
+    utilities::parallelFor(
+                simulationTasks.size( ), numberOfThreadsToUse,
+                [ & ]( const unsigned int taskIndex, const unsigned int threadIndex )
+    {
+        utilities::ScopedTraceEvent taskTraceEvent( "simulate_observation_chunk", "observation_simulation" );
+        std::vector< std::shared_ptr< ObservationSimulationSettings< TimeType > > > taskSettings;
+        taskSettings.push_back( simulationTasks.at( taskIndex ).chunkSettings_ );
+        observationSetPerTask[ taskIndex ] = getSingleSimulatedObservationSet(
+                    simulateObservations< ObservationScalarType, TimeType >(
+                        taskSettings, observationSimulatorsPerThread.at( threadIndex ), bodies ) );
+    } );
+    spiceSerialization.reset( );
+
+    // Concatenate chunks per settings (in original order), and add noise
+    typename observation_models::ObservationCollection< ObservationScalarType, TimeType >::SortedObservationSets
+            sortedObservations;
+    unsigned int taskIndex = 0;
+    for( unsigned int i = 0; i < observationsToSimulate.size( ); i++ )
+    {
+        std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > > observations;
+        std::vector< TimeType > observationTimes;
+        std::vector< Eigen::VectorXd > dependentVariables;
+        std::shared_ptr< ObservationSet > firstChunkObservationSet;
+        for( ; taskIndex < simulationTasks.size( ) && simulationTasks.at( taskIndex ).settingsIndex_ == i; taskIndex++ )
+        {
+            std::shared_ptr< ObservationSet > chunkObservationSet = observationSetPerTask.at( taskIndex );
+            if( chunkObservationSet == nullptr )
+            {
+                continue;
+            }
+            if( firstChunkObservationSet == nullptr )
+            {
+                firstChunkObservationSet = chunkObservationSet;
+            }
+
+            const std::vector< Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > >& chunkObservations =
+                    chunkObservationSet->getObservations( );
+            const std::vector< TimeType >& chunkTimes = chunkObservationSet->getObservationTimes( );
+            const std::vector< Eigen::VectorXd >& chunkDependentVariables =
+                    chunkObservationSet->getObservationsDependentVariables( );
+            observations.insert( observations.end( ), chunkObservations.begin( ), chunkObservations.end( ) );
+            observationTimes.insert( observationTimes.end( ), chunkTimes.begin( ), chunkTimes.end( ) );
+            dependentVariables.insert( dependentVariables.end( ), chunkDependentVariables.begin( ),
+                                       chunkDependentVariables.end( ) );
+        }
+
+        if( firstChunkObservationSet == nullptr )
+        {
+            continue;
+        }
+
+        std::function< Eigen::VectorXd( const double ) > noiseFunction =
+                observationsToSimulate.at( i )->getObservationNoiseFunction( );
+        if( noiseFunction != nullptr )
+        {
+            for( unsigned int j = 0; j < observations.size( ); j++ )
+            {
+                observations[ j ] += noiseFunction( static_cast< double >( observationTimes.at( j ) ) ).
+                        template cast< ObservationScalarType >( );
+            }
+        }
+
+        sortedObservations[ firstChunkObservationSet->getObservableType( ) ][ firstChunkObservationSet->getLinkEnds( ) ].push_back(
+                    std::make_shared< ObservationSet >(
+                        firstChunkObservationSet->getObservableType( ),
+                        firstChunkObservationSet->getLinkEnds( ),
+                        observations, observationTimes,
+                        firstChunkObservationSet->getReferenceLinkEnd( ),
+                        dependentVariables,
+                        firstChunkObservationSet->getDependentVariableCalculator( ) ) );
+    }
+
+    return std::make_shared< observation_models::ObservationCollection< ObservationScalarType, TimeType > >(
+                sortedObservations );
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_PARALLEL_OBSERVATION_SIMULATION_H
@@ -0,0 +1,365 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_VISIBILITY_WINDOWS_H
+#define TUDATPY_VISIBILITY_WINDOWS_H
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/basic/functionProxy.h"
+#include "tudat/math/root_finders/createRootFinder.h"
+#include "tudat/simulation/estimation_setup/createLightTimeCalculator.h"
+#include "tudat/simulation/estimation_setup/observationSimulationSettings.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Function to check whether a viability setting applies to a given link end
+/*!
+ *  Function to check whether a viability setting applies to a given link end, which is the case if the link end is
+ *  the associated link end of the setting, or if the associated link end of the setting has no station name, and the
+ *  link end is a station on (or the centre of mass of) the associated body.
+ */
+inline bool isViabilitySettingApplicableToLinkEnd(
+        const std::shared_ptr< observation_models::ObservationViabilitySettings > viabilitySettings,
+        const observation_models::LinkEndId& linkEndId )
+{
+    return ( viabilitySettings->associatedLinkEnd_ == linkEndId ) ||
+            ( viabilitySettings->associatedLinkEnd_.second == "" &&
+              viabilitySettings->associatedLinkEnd_.first == linkEndId.first );
+}
+
+//! Function to create the viability margin of a single leg of a link, for a single viability setting
+/*!
+ *  Function to create the viability margin of a single leg of a link, for a single viability setting. The margin is a
+ *  continuous function of time that is non-negative if (and only if) the leg is viable according to the setting:
+ *   - minimum_elevation_angle: elevation angle of the other link end, as seen from the associated link end (which must be
+ *     a ground station), minus the minimum elevation angle.
+ *   - body_avoidance_angle: angle between the other link end and the avoided body, as seen from the associated link end,
+ *     minus the avoidance angle.
+ *   - body_occultation: distance between the centre of the occulting body and the line segment connecting the link ends,
+ *     minus the average radius of the occulting body.
+ *  The margins are evaluated geometrically, at the same epoch for both link ends (without light-time correction).
+ *  \param viabilitySettings Viability setting for which the margin is computed
+ *  \param associatedLinkEnd Link end of the leg to which the setting applies
+ *  \param otherLinkEnd Other link end of the leg
+ *  \param bodies System of bodies
+ *  \return Viability margin as a function of time
+ */
+inline std::function< double( const double ) > createLegViabilityMarginFunction(
+        const std::shared_ptr< observation_models::ObservationViabilitySettings > viabilitySettings,
+        const observation_models::LinkEndId& associatedLinkEnd,
+        const observation_models::LinkEndId& otherLinkEnd,
+        const SystemOfBodies& bodies )
+{
+    std::function< Eigen::Vector6d( const double ) > associatedStateFunction =
+            observation_models::getLinkEndCompleteEphemerisFunction< double, double >( associatedLinkEnd, bodies );
+    std::function< Eigen::Vector6d( const double ) > otherStateFunction =
+            observation_models::getLinkEndCompleteEphemerisFunction< double, double >( otherLinkEnd, bodies );
+
+    std::function< double( const double ) > marginFunction;
+    switch( viabilitySettings->observationViabilityType_ )
+    {
+    case observation_models::minimum_elevation_angle:
+    {
+        if( associatedLinkEnd.second == "" )
+        {
+            throw std::runtime_error( "Error when creating elevation angle visibility margin, link end " +
+                                      associatedLinkEnd.first + " is not a ground station." );
+        }
+        std::shared_ptr< ground_stations::PointingAnglesCalculator > pointingAnglesCalculator =
+                bodies.at( associatedLinkEnd.first )->getGroundStation( associatedLinkEnd.second )->
+                getPointingAnglesCalculator( );
+        const double minimumElevationAngle = viabilitySettings->doubleParameter_;
+        marginFunction = [ = ]( const double time )
+        {
+            Eigen::Vector3d vectorAwayFromStation =
+                    ( otherStateFunction( time ) - associatedStateFunction( time ) ).segment( 0, 3 );
+            return pointingAnglesCalculator->calculateElevationAngle( vectorAwayFromStation, time ) -
+                    minimumElevationAngle;
+        };
+        break;
+    }
+    case observation_models::body_avoidance_angle:
+    {
+        std::function< Eigen::Vector6d( const double ) > avoidedBodyStateFunction =
+                observation_models::getLinkEndCompleteEphemerisFunction< double, double >(
+                    std::make_pair( viabilitySettings->stringParameter_, "" ), bodies );
+        const double avoidanceAngle = viabilitySettings->doubleParameter_;
+        marginFunction = [ = ]( const double time )
+        {
+            Eigen::Vector3d associatedPosition = associatedStateFunction( time ).segment( 0, 3 );
+            Eigen::Vector3d vectorToOtherLinkEnd = otherStateFunction( time ).segment( 0, 3 ) - associatedPosition;
+            Eigen::Vector3d vectorToAvoidedBody = avoidedBodyStateFunction( time ).segment( 0, 3 ) - associatedPosition;
+            const double cosineOfAngle = vectorToOtherLinkEnd.normalized( ).dot( vectorToAvoidedBody.normalized( ) );
+            return std::acos( std::max( -1.0, std::min( 1.0, cosineOfAngle ) ) ) - avoidanceAngle;
+        };
+        break;
+    }
+    case observation_models::body_occultation:
+    {
+        std::function< Eigen::Vector6d( const double ) > occultingBodyStateFunction =
+                observation_models::getLinkEndCompleteEphemerisFunction< double, double >(
+                    std::make_pair( viabilitySettings->stringParameter_, "" ), bodies );
+        if( bodies.at( viabilitySettings->stringParameter_ )->getShapeModel( ) == nullptr )
+        {
+            throw std::runtime_error( "Error when creating occultation visibility margin, body " +
+                                      viabilitySettings->stringParameter_ + " has no shape model." );
+        }
+        const double occultingBodyRadius =
+                bodies.at( viabilitySettings->stringParameter_ )->getShapeModel( )->getAverageRadius( );
+        marginFunction = [ = ]( const double time )
+        {
+            Eigen::Vector3d associatedPosition = associatedStateFunction( time ).segment( 0, 3 );
+            Eigen::Vector3d linkVector = otherStateFunction( time ).segment( 0, 3 ) - associatedPosition;
+            Eigen::Vector3d vectorToOccultingBody =
+                    occultingBodyStateFunction( time ).segment( 0, 3 ) - associatedPosition;
+            const double fractionOfLink = std::max(
+                        0.0, std::min( 1.0, vectorToOccultingBody.dot( linkVector ) / linkVector.squaredNorm( ) ) );
+            return ( fractionOfLink * linkVector - vectorToOccultingBody ).norm( ) - occultingBodyRadius;
+        };
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error when creating visibility margin, viability type " +
+                                  std::to_string( static_cast< int >( viabilitySettings->observationViabilityType_ ) ) +
+                                  " not recognized." );
+    }
+    return marginFunction;
+}
+
+//! Function to create the combined viability margin of a link, for a list of viability settings
+/*!
+ *  Function to create the combined viability margin of a link, for a list of viability settings. The link is split into
+ *  legs between consecutive link ends (ignoring the observed body link end), and the margin of each applicable setting is
+ *  computed for each leg (see createLegViabilityMarginFunction). The combined margin is the minimum of all margins, such
+ *  that it is non-negative if (and only if) the link is viable. If no settings apply, the margin is constant and positive.
+ *  \param linkEnds Link ends of the link
+ *  \param viabilitySettingsList List of viability settings
+ *  \param bodies System of bodies
+ *  \return Combined viability margin as a function of time
+ */
+inline std::function< double( const double ) > createLinkViabilityMarginFunction(
+        const observation_models::LinkEnds& linkEnds,
+        const std::vector< std::shared_ptr< observation_models::ObservationViabilitySettings > >& viabilitySettingsList,
+        const SystemOfBodies& bodies )
+{
+    std::vector< observation_models::LinkEndId > orderedLinkEnds;
+    for( auto linkEndIterator : linkEnds )
+    {
+        if( linkEndIterator.first != observation_models::observed_body )
+        {
+            orderedLinkEnds.push_back( linkEndIterator.second );
+        }
+    }
+
+    std::vector< std::function< double( const double ) > > marginFunctions;
+    for( unsigned int i = 1; i < orderedLinkEnds.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < viabilitySettingsList.size( ); j++ )
+        {
+            if( isViabilitySettingApplicableToLinkEnd( viabilitySettingsList.at( j ), orderedLinkEnds.at( i - 1 ) ) )
+            {
+                marginFunctions.push_back( createLegViabilityMarginFunction(
+                                               viabilitySettingsList.at( j ), orderedLinkEnds.at( i - 1 ),
+                                               orderedLinkEnds.at( i ), bodies ) );
+            }
+            if( isViabilitySettingApplicableToLinkEnd( viabilitySettingsList.at( j ), orderedLinkEnds.at( i ) ) )
+            {
+                marginFunctions.push_back( createLegViabilityMarginFunction(
+                                               viabilitySettingsList.at( j ), orderedLinkEnds.at( i ),
+                                               orderedLinkEnds.at( i - 1 ), bodies ) );
+            }
+        }
+    }
+
+    return [ = ]( const double time )
+    {
+        double minimumMargin = 1.0;
+        for( unsigned int i = 0; i < marginFunctions.size( ); i++ )
+        {
+            minimumMargin = std::min( minimumMargin, marginFunctions.at( i )( time ) );
+        }
+        return minimumMargin;
+    };
+}
+
+//! Function to compute the visibility windows of a link, by root finding on its viability margin
+/*!
+ *  Function to compute the visibility windows of a link. The combined viability margin of the link (see
+ *  createLinkViabilityMarginFunction) is evaluated on a coarse grid, and each change of sign on the grid is refined to
+ *  a rise/set epoch with a root finder. Windows that start and end between two consecutive grid points are not detected,
+ *  so the grid step should be smaller than the shortest window (and shortest gap) of interest.
+ *  \param linkEnds Link ends of the link
+ *  \param viabilitySettingsList List of viability settings
+ *  \param bodies System of bodies
+ *  \param startTime Start of the interval in which windows are computed
+ *  \param endTime End of the interval in which windows are computed
+ *  \param gridStep Step of the coarse grid
+ *  \param rootFinderSettings Settings of the root finder used to refine the rise/set epochs (bisection with 1 ms
+ *  absolute tolerance if nullptr)
+ *  \return List of visibility windows (start and end epoch), in chronological order
+ */
+inline std::vector< std::pair< double, double > > computeVisibilityWindows(
+        const observation_models::LinkEnds& linkEnds,
+        const std::vector< std::shared_ptr< observation_models::ObservationViabilitySettings > >& viabilitySettingsList,
+        const SystemOfBodies& bodies,
+        const double startTime,
+        const double endTime,
+        const double gridStep,
+        std::shared_ptr< root_finders::RootFinderSettings > rootFinderSettings = nullptr )
+{
+    if( !( gridStep > 0.0 ) || !( endTime > startTime ) )
+    {
+        throw std::runtime_error( "Error when computing visibility windows, grid step must be positive, and end time "
+                                  "must be larger than start time." );
+    }
+    if( rootFinderSettings == nullptr )
+    {
+        rootFinderSettings = root_finders::bisectionRootFinderSettings( TUDAT_NAN, 1.0E-3, TUDAT_NAN, 100 );
+    }
+
+    std::function< double( const double ) > marginFunction =
+            createLinkViabilityMarginFunction( linkEnds, viabilitySettingsList, bodies );
+    std::shared_ptr< basic_mathematics::Function< double, double > > rootFunction =
+            std::make_shared< basic_mathematics::FunctionProxy< double, double > >( marginFunction );
+
+    std::vector< std::pair< double, double > > visibilityWindows;
+    double previousTime = startTime;
+    bool isPreviousEpochVisible = ( marginFunction( startTime ) >= 0.0 );
+    double currentWindowStart = startTime;
+
+    while( previousTime < endTime )
+    {
+        const double currentTime = std::min( previousTime + gridStep, endTime );
+        const bool isCurrentEpochVisible = ( marginFunction( currentTime ) >= 0.0 );
+        if( isCurrentEpochVisible != isPreviousEpochVisible )
+        {
+            std::shared_ptr< root_finders::RootFinder< double > > rootFinder = root_finders::createRootFinder< double >(
+                        rootFinderSettings, previousTime, currentTime, 0.5 * ( previousTime + currentTime ) );
+            const double eventTime = std::max(
+                        previousTime, std::min( currentTime, rootFinder->execute(
+                                                    rootFunction, 0.5 * ( previousTime + currentTime ) ) ) );
+            if( isCurrentEpochVisible )
+            {
+                currentWindowStart = eventTime;
+            }
+            else
+            {
+                visibilityWindows.push_back( std::make_pair( currentWindowStart, eventTime ) );
+            }
+        }
+        isPreviousEpochVisible = isCurrentEpochVisible;
+        previousTime = currentTime;
+    }
+
+    if( isPreviousEpochVisible )
+    {
+        visibilityWindows.push_back( std::make_pair( currentWindowStart, endTime ) );
+    }
+    return visibilityWindows;
+}
+
+//! Function to compute the visibility windows of a list of links (see computeVisibilityWindows)
+inline std::vector< std::vector< std::pair< double, double > > > computeVisibilityWindowsForLinks(
+        const std::vector< observation_models::LinkEnds >& linkEndsList,
+        const std::vector< std::shared_ptr< observation_models::ObservationViabilitySettings > >& viabilitySettingsList,
+        const SystemOfBodies& bodies,
+        const double startTime,
+        const double endTime,
+        const double gridStep,
+        const std::shared_ptr< root_finders::RootFinderSettings > rootFinderSettings = nullptr )
+{
+    std::vector< std::vector< std::pair< double, double > > > visibilityWindowsPerLink;
+    for( unsigned int i = 0; i < linkEndsList.size( ); i++ )
+    {
+        visibilityWindowsPerLink.push_back(
+                    computeVisibilityWindows( linkEndsList.at( i ), viabilitySettingsList, bodies,
+                                              startTime, endTime, gridStep, rootFinderSettings ) );
+    }
+    return visibilityWindowsPerLink;
+}
+
+//! Function to create tabulated observation simulation settings with simulation epochs inside visibility windows only
+/*!
+ *  Function to create tabulated observation simulation settings, for a list of links, with simulation epochs inside the
+ *  visibility windows of each link only. The epochs lie on a regular grid (referenceEpoch + k * samplingInterval), such
+ *  that the sampling is consistent between links and windows.
+ *  \param observableType Type of observable to simulate
+ *  \param linkEndsList List of link ends for which observations are simulated
+ *  \param visibilityWindowsPerLink Visibility windows of each link (see computeVisibilityWindowsForLinks)
+ *  \param samplingInterval Interval between observation epochs
+ *  \param referenceEpoch Reference epoch of the grid of observation epochs
+ *  \param referenceLinkEndType Reference link end type of the observations
+ *  \param viabilitySettingsList Viability settings that are added to the simulation settings (to check viability at the
+ *  simulated epochs, including light-time effects)
+ *  \return Tabulated observation simulation settings (one per link)
+ */
+inline std::vector< std::shared_ptr< ObservationSimulationSettings< double > > >
+createTabulatedObservationSimulationSettingsInWindows(
+        const observation_models::ObservableType observableType,
+        const std::vector< observation_models::LinkEnds >& linkEndsList,
+        const std::vector< std::vector< std::pair< double, double > > >& visibilityWindowsPerLink,
+        const double samplingInterval,
+        const double referenceEpoch = 0.0,
+        const observation_models::LinkEndType referenceLinkEndType = observation_models::receiver,
+        const std::vector< std::shared_ptr< observation_models::ObservationViabilitySettings > >& viabilitySettingsList =
+        std::vector< std::shared_ptr< observation_models::ObservationViabilitySettings > >( ) )
+{
+    if( linkEndsList.size( ) != visibilityWindowsPerLink.size( ) )
+    {
+        throw std::runtime_error( "Error when creating observation simulation settings in visibility windows, number of "
+                                  "links and number of window lists are inconsistent." );
+    }
+    if( !( samplingInterval > 0.0 ) )
+    {
+        throw std::runtime_error( "Error when creating observation simulation settings in visibility windows, sampling "
+                                  "interval must be positive." );
+    }
+
+    std::vector< std::shared_ptr< ObservationSimulationSettings< double > > > simulationSettingsList;
+    for( unsigned int i = 0; i < linkEndsList.size( ); i++ )
+    {
+        std::vector< double > simulationTimes;
+        for( unsigned int j = 0; j < visibilityWindowsPerLink.at( i ).size( ); j++ )
+        {
+            const double windowStart = visibilityWindowsPerLink.at( i ).at( j ).first;
+            const double windowEnd = visibilityWindowsPerLink.at( i ).at( j ).second;
+            for( double currentIndex = std::ceil( ( windowStart - referenceEpoch ) / samplingInterval );
+                 referenceEpoch + currentIndex * samplingInterval <= windowEnd; currentIndex += 1.0 )
+            {
+                simulationTimes.push_back( referenceEpoch + currentIndex * samplingInterval );
+            }
+        }
+        simulationSettingsList.push_back(
+                    tabulatedObservationSimulationSettings< double >(
+                        observableType, linkEndsList.at( i ), simulationTimes, referenceLinkEndType,
+                        viabilitySettingsList ) );
+    }
+    return simulationSettingsList;
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_VISIBILITY_WINDOWS_H
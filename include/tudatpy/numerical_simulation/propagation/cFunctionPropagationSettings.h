@@ -0,0 +1,78 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_C_FUNCTION_PROPAGATION_SETTINGS_H
+#define TUDATPY_C_FUNCTION_PROPAGATION_SETTINGS_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <Eigen/Core>
+
+#include "tudat/simulation/propagation_setup.h"
+
+#include "tudatpy/basics/cFunctionPointers.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Function to create custom acceleration settings, with the acceleration computed by a C function
+/*!
+ *  Function to create custom acceleration settings, with the acceleration computed by a C function (see
+ *  cFunctionPointers.h) with signature void(double time, double* acceleration, void* userData), writing the 3
+ *  acceleration elements.
+ *  \param accelerationFunctionAddress Address of the C function computing the acceleration
+ *  \param userDataAddress Address of the user data passed to the C function
+ *  \return Acceleration settings
+ */
+inline std::shared_ptr< AccelerationSettings > customAccelerationSettingsFromCFunction(
+        const std::uintptr_t accelerationFunctionAddress,
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return customAccelerationSettings(
+                utilities::createVectorFunctionOfTimeFromCFunction< 3 >(
+                    accelerationFunctionAddress, userDataAddress, "custom acceleration" ) );
+}
+
+//! Function to create thrust magnitude settings, with the magnitude and specific impulse computed by C functions
+/*!
+ *  Function to create thrust magnitude settings, with the thrust magnitude and specific impulse computed by C functions
+ *  (see cFunctionPointers.h) with signature double(double time, void* userData). The engine is always on, and the
+ *  thrust direction is constant in the body-fixed frame.
+ *  \param thrustMagnitudeFunctionAddress Address of the C function computing the thrust magnitude
+ *  \param specificImpulseFunctionAddress Address of the C function computing the specific impulse
+ *  \param bodyFixedThrustDirection Thrust direction in the body-fixed frame
+ *  \param userDataAddress Address of the user data passed to both C functions
+ *  \return Thrust magnitude settings
+ */
+inline std::shared_ptr< ThrustMagnitudeSettings > fromCFunctionThrustMagnitudeSettings(
+        const std::uintptr_t thrustMagnitudeFunctionAddress,
+        const std::uintptr_t specificImpulseFunctionAddress,
+        const Eigen::Vector3d& bodyFixedThrustDirection = Eigen::Vector3d::UnitX( ),
+        const std::uintptr_t userDataAddress = 0 )
+{
+    return fromFunctionThrustMagnitudeSettings(
+                utilities::createScalarFunctionOfTimeFromCFunction(
+                    thrustMagnitudeFunctionAddress, userDataAddress, "thrust magnitude" ),
+                utilities::createScalarFunctionOfTimeFromCFunction(
+                    specificImpulseFunctionAddress, userDataAddress, "specific impulse" ),
+                [ ]( const double ){ return true; },
+                [ = ]( ){ return bodyFixedThrustDirection; } );
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_C_FUNCTION_PROPAGATION_SETTINGS_H
@@ -0,0 +1,308 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_COMPACT_VARIATIONAL_HISTORY_H
+#define TUDATPY_COMPACT_VARIATIONAL_HISTORY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/interpolators/oneDimensionalInterpolator.h"
+#include "tudat/simulation/propagation_setup/variationalEquationsSolver.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Interpolator for a matrix history that is stored contiguously, at a given (floating point) precision
+/*!
+ *  Interpolator for a matrix history that is stored contiguously, at a given (floating point) precision. The matrices
+ *  are stored in a single buffer (instead of a vector of individually allocated matrices), and may be stored in single
+ *  precision to further reduce the memory use. Interpolation is performed with a Lagrange polynomial of a given order,
+ *  using the nodes closest to the requested epoch (in double precision). Outside of the node range, the polynomial of
+ *  the first/last nodes is extrapolated.
+ */
+template< typename StorageScalarType >
+class CompactMatrixHistoryInterpolator: public interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param nodeTimes Epochs at which the matrices are stored (must be strictly increasing)
+     *  \param nodeMatrices Matrices at the node epochs (all of equal size)
+     *  \param interpolationOrder Number of nodes used by the Lagrange interpolation
+     */
+    CompactMatrixHistoryInterpolator( const std::vector< double >& nodeTimes,
+                                      const std::vector< Eigen::MatrixXd >& nodeMatrices,
+                                      const int interpolationOrder ):
+        nodeTimes_( nodeTimes ), interpolationOrder_( interpolationOrder )
+    {
+        if( nodeTimes.size( ) != nodeMatrices.size( ) || nodeTimes.size( ) < 2 )
+        {
+            throw std::runtime_error( "Error when creating compact matrix history, at least two nodes required, "
+                                      "and number of times and matrices must be equal." );
+        }
+        if( interpolationOrder_ < 2 )
+        {
+            throw std::runtime_error( "Error when creating compact matrix history, interpolation order must be at least 2." );
+        }
+        for( unsigned int i = 1; i < nodeTimes_.size( ); i++ )
+        {
+            if( !( nodeTimes_.at( i ) > nodeTimes_.at( i - 1 ) ) )
+            {
+                throw std::runtime_error( "Error when creating compact matrix history, node times must be strictly increasing." );
+            }
+        }
+        interpolationOrder_ = std::min( interpolationOrder_, static_cast< int >( nodeTimes_.size( ) ) );
+
+        numberOfRows_ = nodeMatrices.at( 0 ).rows( );
+        numberOfColumns_ = nodeMatrices.at( 0 ).cols( );
+        const std::size_t numberOfMatrixEntries = numberOfRows_ * numberOfColumns_;
+        matrixData_.resize( nodeMatrices.size( ) * numberOfMatrixEntries );
+        for( unsigned int i = 0; i < nodeMatrices.size( ); i++ )
+        {
+            if( nodeMatrices.at( i ).rows( ) != numberOfRows_ || nodeMatrices.at( i ).cols( ) != numberOfColumns_ )
+            {
+                throw std::runtime_error( "Error when creating compact matrix history, matrix sizes are inconsistent." );
+            }
+            Eigen::Map< Eigen::Matrix< StorageScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                        matrixData_.data( ) + i * numberOfMatrixEntries, numberOfRows_, numberOfColumns_ ) =
+                    nodeMatrices.at( i ).template cast< StorageScalarType >( );
+        }
+    }
+
+    using interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >::interpolate;
+
+    //! Function to interpolate the matrix history at a given epoch
+    Eigen::MatrixXd interpolate( const double targetIndependentVariableValue )
+    {
+        const int numberOfNodes = nodeTimes_.size( );
+        const int upperIndex = std::upper_bound( nodeTimes_.begin( ), nodeTimes_.end( ), targetIndependentVariableValue ) -
+                nodeTimes_.begin( );
+        const int startIndex = std::max( 0, std::min( upperIndex - interpolationOrder_ / 2,
+                                                      numberOfNodes - interpolationOrder_ ) );
+
+        const std::size_t numberOfMatrixEntries = numberOfRows_ * numberOfColumns_;
+        Eigen::MatrixXd interpolatedMatrix = Eigen::MatrixXd::Zero( numberOfRows_, numberOfColumns_ );
+        for( int i = startIndex; i < startIndex + interpolationOrder_; i++ )
+        {
+            double lagrangeWeight = 1.0;
+            for( int j = startIndex; j < startIndex + interpolationOrder_; j++ )
+            {
+                if( j != i )
+                {
+                    lagrangeWeight *= ( targetIndependentVariableValue - nodeTimes_.at( j ) ) /
+                            ( nodeTimes_.at( i ) - nodeTimes_.at( j ) );
+                }
+            }
+            interpolatedMatrix += lagrangeWeight *
+                    Eigen::Map< const Eigen::Matrix< StorageScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                        matrixData_.data( ) + i * numberOfMatrixEntries, numberOfRows_, numberOfColumns_ ).
+                    template cast< double >( );
+        }
+        return interpolatedMatrix;
+    }
+
+    //! Function to retrieve the memory (in bytes) used to store the matrices
+    std::size_t getStorageSize( )
+    {
+        return matrixData_.size( ) * sizeof( StorageScalarType ) + nodeTimes_.size( ) * sizeof( double );
+    }
+
+private:
+
+    //! Epochs at which the matrices are stored
+    std::vector< double > nodeTimes_;
+
+    //! Number of nodes used by the Lagrange interpolation
+    int interpolationOrder_;
+
+    //! Number of rows of the matrices
+    int numberOfRows_;
+
+    //! Number of columns of the matrices
+    int numberOfColumns_;
+
+    //! Contiguous (column-major) storage of the matrices at the node epochs
+    std::vector< StorageScalarType > matrixData_;
+};
+
+//! Compact representation of the solution of the single-arc variational equations
+/*!
+ *  Compact representation of the solution of the single-arc variational equations. The state transition and sensitivity
+ *  matrices are decimated to a user-defined output grid (by interpolation of the full solution), stored contiguously,
+ *  and optionally (for the sensitivity matrix) in single precision. A CombinedStateTransitionAndSensitivityMatrixInterface
+ *  is created that interpolates the compact history, and can be used wherever the interface of the variational equations
+ *  solver is used. The memory use of the full and compact histories, and the error of the compact history (evaluated at
+ *  the epochs of the full solution inside the output grid), are computed on creation. By default, the full solution is
+ *  then released: the numerical solution of the solver is cleared, and the interface of the solver is set to
+ *  interpolate the compact history, such that only the compact history remains in memory.
+ */
+class CompactVariationalEquationsHistory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param variationalEquationsSolver Solver from which the full solution of the variational equations is taken
+     *  \param outputTimes Epochs at which the solution is to be stored (must be strictly increasing)
+     *  \param useSinglePrecisionSensitivity Boolean denoting whether the sensitivity matrix is stored in single precision
+     *  \param interpolationOrder Number of nodes used by the Lagrange interpolation of the compact history
+     *  \param clearFullSolution Boolean denoting whether the full solution of the solver is released once the compact
+     *  history is created (the solver then interpolates the compact history)
+     */
+    CompactVariationalEquationsHistory(
+            const std::shared_ptr< SingleArcVariationalEquationsSolver< double, double > > variationalEquationsSolver,
+            const std::vector< double >& outputTimes,
+            const bool useSinglePrecisionSensitivity = true,
+            const int interpolationOrder = 8,
+            const bool clearFullSolution = true )
+    {
+        std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > fullInterface =
+                variationalEquationsSolver->getStateTransitionMatrixInterface( );
+        const int stateTransitionMatrixSize = fullInterface->getStateTransitionMatrixSize( );
+        const int sensitivityMatrixSize = fullInterface->getSensitivityMatrixSize( );
+
+        // Decimate full solution to output grid
+        std::vector< Eigen::MatrixXd > stateTransitionMatrices, sensitivityMatrices;
+        for( unsigned int i = 0; i < outputTimes.size( ); i++ )
+        {
+            Eigen::MatrixXd combinedMatrix = fullInterface->getCombinedStateTransitionAndSensitivityMatrix( outputTimes.at( i ) );
+            stateTransitionMatrices.push_back( combinedMatrix.leftCols( stateTransitionMatrixSize ) );
+            sensitivityMatrices.push_back( combinedMatrix.rightCols( sensitivityMatrixSize ) );
+        }
+
+        std::shared_ptr< CompactMatrixHistoryInterpolator< double > > stateTransitionInterpolator =
+                std::make_shared< CompactMatrixHistoryInterpolator< double > >(
+                    outputTimes, stateTransitionMatrices, interpolationOrder );
+        std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > sensitivityInterpolator;
+        if( useSinglePrecisionSensitivity )
+        {
+            std::shared_ptr< CompactMatrixHistoryInterpolator< float > > singlePrecisionInterpolator =
+                    std::make_shared< CompactMatrixHistoryInterpolator< float > >(
+                        outputTimes, sensitivityMatrices, interpolationOrder );
+            compactStorageSize_ = singlePrecisionInterpolator->getStorageSize( );
+            sensitivityInterpolator = singlePrecisionInterpolator;
+        }
+        else
+        {
+            std::shared_ptr< CompactMatrixHistoryInterpolator< double > > doublePrecisionInterpolator =
+                    std::make_shared< CompactMatrixHistoryInterpolator< double > >(
+                        outputTimes, sensitivityMatrices, interpolationOrder );
+            compactStorageSize_ = doublePrecisionInterpolator->getStorageSize( );
+            sensitivityInterpolator = doublePrecisionInterpolator;
+        }
+        compactStorageSize_ += stateTransitionInterpolator->getStorageSize( );
+
+        stateTransitionInterface_ = std::make_shared< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                    stateTransitionInterpolator, sensitivityInterpolator,
+                    stateTransitionMatrixSize, stateTransitionMatrixSize + sensitivityMatrixSize );
+
+        // Compare compact and full solution
+        computeStorageSizeAndError( variationalEquationsSolver->getStateTransitionMatrixSolution( ),
+                                    stateTransitionInterpolator, outputTimes, fullStorageSize_,
+                                    maximumStateTransitionMatrixError_ );
+        computeStorageSizeAndError( variationalEquationsSolver->getSensitivityMatrixSolution( ),
+                                    sensitivityInterpolator, outputTimes, fullStorageSize_,
+                                    maximumSensitivityMatrixError_ );
+
+        // Release full solution, and its interpolators
+        if( clearFullSolution )
+        {
+            variationalEquationsSolver->getStateTransitionMatrixSolution( ).clear( );
+            variationalEquationsSolver->getSensitivityMatrixSolution( ).clear( );
+
+            std::shared_ptr< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > singleArcInterface =
+                    std::dynamic_pointer_cast< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >( fullInterface );
+            if( singleArcInterface == nullptr )
+            {
+                throw std::runtime_error( "Error when clearing full variational equations solution, single-arc state transition interface expected." );
+            }
+            singleArcInterface->updateMatrixInterpolators( stateTransitionInterpolator, sensitivityInterpolator );
+        }
+    }
+
+    //! Function to retrieve the interface that interpolates the compact history
+    std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > getStateTransitionInterface( )
+    {
+        return stateTransitionInterface_;
+    }
+
+    //! Function to retrieve the memory (in bytes) used by the matrices of the full solution
+    std::size_t getFullStorageSize( ){ return fullStorageSize_; }
+
+    //! Function to retrieve the memory (in bytes) used by the matrices of the compact history
+    std::size_t getCompactStorageSize( ){ return compactStorageSize_; }
+
+    //! Function to retrieve the maximum absolute error of the compact state transition matrix history
+    double getMaximumStateTransitionMatrixError( ){ return maximumStateTransitionMatrixError_; }
+
+    //! Function to retrieve the maximum absolute error of the compact sensitivity matrix history
+    double getMaximumSensitivityMatrixError( ){ return maximumSensitivityMatrixError_; }
+
+private:
+
+    //! Function to compute the memory used by a full matrix history, and the maximum error of its compact history
+    static void computeStorageSizeAndError(
+            const std::map< double, Eigen::MatrixXd >& fullHistory,
+            const std::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > compactInterpolator,
+            const std::vector< double >& outputTimes,
+            std::size_t& fullStorageSize,
+            double& maximumError )
+    {
+        maximumError = 0.0;
+        for( const auto& historyIterator : fullHistory )
+        {
+            fullStorageSize += historyIterator.second.size( ) * sizeof( double ) + sizeof( double );
+
+            // Empty matrices (sensitivity matrix without estimated non-state parameters) are represented exactly
+            if( historyIterator.second.size( ) > 0 &&
+                    historyIterator.first >= outputTimes.front( ) && historyIterator.first <= outputTimes.back( ) )
+            {
+                maximumError = std::max(
+                            maximumError, ( compactInterpolator->interpolate( historyIterator.first ) -
+                                            historyIterator.second ).cwiseAbs( ).maxCoeff( ) );
+            }
+        }
+    }
+
+    //! Interface that interpolates the compact history
+    std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface_;
+
+    //! Memory (in bytes) used by the matrices of the full solution
+    std::size_t fullStorageSize_ = 0;
+
+    //! Memory (in bytes) used by the matrices of the compact history
+    std::size_t compactStorageSize_ = 0;
+
+    //! Maximum absolute error of the compact state transition matrix history, w.r.t. the full solution
+    double maximumStateTransitionMatrixError_ = 0.0;
+
+    //! Maximum absolute error of the compact sensitivity matrix history, w.r.t. the full solution
+    double maximumSensitivityMatrixError_ = 0.0;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_COMPACT_VARIATIONAL_HISTORY_H
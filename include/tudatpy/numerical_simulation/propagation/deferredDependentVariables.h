@@ -0,0 +1,201 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DEFERRED_DEPENDENT_VARIABLES_H
+#define TUDATPY_DEFERRED_DEPENDENT_VARIABLES_H
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/interpolators/lagrangeInterpolator.h"
+#include "tudat/simulation/propagation_setup/createEnvironmentUpdater.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+#include "tudat/simulation/propagation_setup/propagationOutput.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to retrieve the epochs at which deferred dependent variables are to be evaluated
+/*!
+ *  Function to retrieve the epochs at which deferred dependent variables are to be evaluated: the given evaluation
+ *  epochs if not empty, and every evaluationStride-th epoch of the state history (starting at the first, and always
+ *  including the last) otherwise.
+ */
+template< typename TimeType = double >
+std::vector< TimeType > getDeferredDependentVariableEpochs(
+        const std::map< TimeType, Eigen::VectorXd >& stateHistory,
+        const std::vector< TimeType >& evaluationEpochs,
+        const unsigned int evaluationStride )
+{
+    if( evaluationEpochs.size( ) > 0 )
+    {
+        return evaluationEpochs;
+    }
+    else if( evaluationStride == 0 )
+    {
+        throw std::runtime_error( "Error when evaluating deferred dependent variables, evaluation stride must be positive." );
+    }
+
+    std::vector< TimeType > strideEpochs;
+    unsigned int currentIndex = 0;
+    for( auto stateIterator : stateHistory )
+    {
+        if( ( currentIndex % evaluationStride == 0 ) || ( currentIndex + 1 == stateHistory.size( ) ) )
+        {
+            strideEpochs.push_back( stateIterator.first );
+        }
+        currentIndex++;
+    }
+    return strideEpochs;
+}
+
+//! Function to check that the environment models required by deferred dependent variables are updated by the propagation
+/*!
+ *  Function to check that the environment models required by deferred dependent variables are updated by the
+ *  environment updater of the propagation (which is determined from the propagator settings, including the dependent
+ *  variables saved during the propagation). Deferred dependent variables are computed after evaluating the state
+ *  derivative, which only updates the models that the propagation requires, such that a dependent variable that
+ *  requires any other model would be computed from stale environment values.
+ *  \param dynamicsSimulator Dynamics simulator with which the equations of motion were integrated
+ *  \param bodies System of bodies used by the dynamics simulator
+ *  \param dependentVariables Settings of the dependent variables that are to be evaluated
+ */
+template< typename TimeType = double >
+void checkDeferredDependentVariableEnvironmentUpdates(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >& dependentVariables )
+{
+    std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings = dynamicsSimulator->getPropagatorSettings( );
+    const std::map< IntegratedStateType, std::vector< std::pair< std::string, std::string > > > integratedStateList =
+            getIntegratedTypeAndBodyList< double >( propagatorSettings );
+    const std::map< EnvironmentModelsToUpdate, std::vector< std::string > > propagationUpdates =
+            createEnvironmentUpdaterSettings< double >( propagatorSettings, bodies );
+
+    for( unsigned int i = 0; i < dependentVariables.size( ); i++ )
+    {
+        std::map< EnvironmentModelsToUpdate, std::vector< std::string > > requiredUpdates =
+                createEnvironmentUpdaterSettings( createDependentVariableSaveSettings( { dependentVariables.at( i ) }, false ),
+                                                  bodies );
+        removePropagatedStatesFomEnvironmentUpdates< double >( requiredUpdates, integratedStateList );
+
+        for( auto updateIterator : requiredUpdates )
+        {
+            for( unsigned int j = 0; j < updateIterator.second.size( ); j++ )
+            {
+                auto propagationUpdateIterator = propagationUpdates.find( updateIterator.first );
+                if( propagationUpdateIterator == propagationUpdates.end( ) ||
+                        std::find( propagationUpdateIterator->second.begin( ), propagationUpdateIterator->second.end( ),
+                                   updateIterator.second.at( j ) ) == propagationUpdateIterator->second.end( ) )
+                {
+                    throw std::runtime_error(
+                                "Error when evaluating deferred dependent variables, dependent variable " +
+                                getDependentVariableId( dependentVariables.at( i ) ) + " requires an environment model of "
+                                "body " + updateIterator.second.at( j ) + " that is not updated during the propagation. "
+                                "Add the dependent variable to the propagator settings instead." );
+                }
+            }
+        }
+    }
+}
+
+//! Function to evaluate dependent variables after a propagation, from the saved state history
+/*!
+ *  Function to evaluate dependent variables after a propagation, from the saved state history, instead of at every
+ *  step of the propagation. This allows expensive dependent variables to be evaluated at a subset of the epochs only.
+ *  For each evaluation epoch, the environment is reconstructed by evaluating the state derivative of the dynamics
+ *  simulator at the saved (unprocessed) state, after which the dependent variables are computed, identically to their
+ *  evaluation during the propagation. States at evaluation epochs that are not in the state history are obtained by
+ *  8th order Lagrange interpolation of the state history. Since the environment is shared, the evaluation is
+ *  sequential. Since the state derivative evaluation only updates the environment models that the propagation
+ *  requires, dependent variables that require any other model are rejected (see
+ *  checkDeferredDependentVariableEnvironmentUpdates).
+ *  \param dynamicsSimulator Dynamics simulator with which the equations of motion were integrated
+ *  \param bodies System of bodies used by the dynamics simulator
+ *  \param dependentVariables Settings of the dependent variables that are to be evaluated
+ *  \param evaluationEpochs Epochs at which the dependent variables are to be evaluated (empty to use evaluationStride)
+ *  \param evaluationStride Interval (in saved steps) at which the dependent variables are to be evaluated
+ *  \return Pair of dependent variable history and dependent variable ids (start index and name of each variable)
+ */
+template< typename TimeType = double >
+std::pair< std::map< TimeType, Eigen::VectorXd >, std::map< int, std::string > > computeDeferredDependentVariables(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >& dependentVariables,
+        const std::vector< TimeType >& evaluationEpochs = std::vector< TimeType >( ),
+        const unsigned int evaluationStride = 1 )
+{
+    const std::map< TimeType, Eigen::VectorXd >& stateHistory =
+            dynamicsSimulator->getEquationsOfMotionNumericalSolutionRaw( );
+    if( stateHistory.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when evaluating deferred dependent variables, no state history is available." );
+    }
+
+    checkDeferredDependentVariableEnvironmentUpdates( dynamicsSimulator, bodies, dependentVariables );
+
+    std::shared_ptr< DynamicsStateDerivativeModel< TimeType, double > > stateDerivativeModel =
+            dynamicsSimulator->getDynamicsStateDerivative( );
+    std::pair< std::function< Eigen::VectorXd( ) >, std::map< int, std::string > > dependentVariableFunction =
+            createDependentVariableListFunction< TimeType, double >(
+                createDependentVariableSaveSettings( dependentVariables, false ), bodies,
+                stateDerivativeModel->getStateDerivativeModels( ) );
+
+    std::shared_ptr< interpolators::LagrangeInterpolator< TimeType, Eigen::VectorXd > > stateInterpolator;
+    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+    std::vector< TimeType > epochsToEvaluate = getDeferredDependentVariableEpochs(
+                stateHistory, evaluationEpochs, evaluationStride );
+    for( unsigned int i = 0; i < epochsToEvaluate.size( ); i++ )
+    {
+        const TimeType currentTime = epochsToEvaluate.at( i );
+        Eigen::VectorXd currentState;
+        auto stateIterator = stateHistory.find( currentTime );
+        if( stateIterator != stateHistory.end( ) )
+        {
+            currentState = stateIterator->second;
+        }
+        else
+        {
+            if( currentTime < stateHistory.begin( )->first || currentTime > stateHistory.rbegin( )->first )
+            {
+                throw std::runtime_error( "Error when evaluating deferred dependent variables, epoch " +
+                                          std::to_string( static_cast< double >( currentTime ) ) +
+                                          " is outside of the propagated interval." );
+            }
+            if( stateInterpolator == nullptr )
+            {
+                stateInterpolator = std::make_shared< interpolators::LagrangeInterpolator< TimeType, Eigen::VectorXd > >(
+                            stateHistory, 8 );
+            }
+            currentState = stateInterpolator->interpolate( currentTime );
+        }
+
+        stateDerivativeModel->computeStateDerivative( currentTime, currentState );
+        dependentVariableHistory[ currentTime ] = dependentVariableFunction.first( );
+    }
+    return std::make_pair( dependentVariableHistory, dependentVariableFunction.second );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_DEFERRED_DEPENDENT_VARIABLES_H
@@ -0,0 +1,534 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_DENSE_OUTPUT_PROPAGATION_H
+#define TUDATPY_DENSE_OUTPUT_PROPAGATION_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+#include "tudat/simulation/propagation_setup/propagationOutput.h"
+
+#include "tudatpy/basics/eventTracing.h"
+#include "tudatpy/math/denseOutputIntegrator.h"
+#include "tudatpy/numerical_simulation/propagation/propagationCheckpoint.h"
+
+namespace tudat
+{
+
+namespace numerical_integrators
+{
+
+//! Settings for the variable step-size Dormand-Prince 5(4) integrator with dense output at a list of output epochs
+/*!
+ *  Settings for the variable step-size Dormand-Prince 5(4) integrator with dense output (see
+ *  DormandPrinceDenseOutputIntegrator). The integration runs from the initial time to the last output epoch, and the
+ *  saved state history contains exactly the output epochs, evaluated with the continuous extension of the integrator.
+ *  The propagation must be terminated by a time termination condition, at or beyond the last output epoch (see
+ *  checkDenseOutputPropagatorSettings). Optionally, a checkpoint of the integration is periodically written to a file,
+ *  from which an interrupted propagation can be resumed (see resumeEquationsOfMotionFromCheckpoint).
+ *  The settings carry the integrator type of the Tudat variable step-size Runge-Kutta integrator, but are not
+ *  RungeKuttaVariableStepSizeSettings, so they must never be passed to Tudat to create an integrator: they are only
+ *  supported by createSingleArcDynamicsSimulator (see checkIntegratorSettingsWithoutDenseOutput).
+ */
+template< typename TimeType = double >
+class DenseOutputIntegratorSettings: public IntegratorSettings< TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param initialTime Initial epoch of the integration
+     *  \param initialTimeStep Initial (absolute) step size
+     *  \param outputEpochs Epochs at which the state is to be saved (monotonic, in the direction of integration)
+     *  \param minimumStepSize Minimum (absolute) step size
+     *  \param maximumStepSize Maximum (absolute) step size
+     *  \param relativeErrorTolerance Relative error tolerance per state element
+     *  \param absoluteErrorTolerance Absolute error tolerance per state element
+     *  \param safetyFactorForNextStepSize Safety factor for the step size control
+     *  \param maximumFactorIncreaseForNextStepSize Maximum factor by which the step size is increased after a step
+     *  \param minimumFactorDecreaseForNextStepSize Minimum factor by which the step size is decreased after a rejected step
+     *  \param throwExceptionIfMinimumStepExceeded Boolean denoting whether an exception is thrown if the minimum step
+     *  size does not meet the tolerances
+     *  \param checkpointFilePath Path of the file to which checkpoints are written (no checkpoints if empty)
+     *  \param checkpointInterval Minimum (wall-clock) time in seconds between two checkpoints
+     */
+    DenseOutputIntegratorSettings( const TimeType initialTime,
+                                   const TimeType initialTimeStep,
+                                   const std::vector< TimeType >& outputEpochs,
+                                   const TimeType minimumStepSize,
+                                   const TimeType maximumStepSize,
+                                   const double relativeErrorTolerance,
+                                   const double absoluteErrorTolerance,
+                                   const double safetyFactorForNextStepSize = 0.8,
+                                   const double maximumFactorIncreaseForNextStepSize = 4.0,
+                                   const double minimumFactorDecreaseForNextStepSize = 0.1,
+                                   const bool throwExceptionIfMinimumStepExceeded = true,
+                                   const std::string& checkpointFilePath = "",
+                                   const double checkpointInterval = 600.0 ):
+        IntegratorSettings< TimeType >( rungeKuttaVariableStepSize, initialTime, initialTimeStep ),
+        outputEpochs_( outputEpochs ), minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        safetyFactorForNextStepSize_( safetyFactorForNextStepSize ),
+        maximumFactorIncreaseForNextStepSize_( maximumFactorIncreaseForNextStepSize ),
+        minimumFactorDecreaseForNextStepSize_( minimumFactorDecreaseForNextStepSize ),
+        throwExceptionIfMinimumStepExceeded_( throwExceptionIfMinimumStepExceeded ),
+        checkpointFilePath_( checkpointFilePath ), checkpointInterval_( checkpointInterval ){ }
+
+    //! Epochs at which the state is to be saved
+    std::vector< TimeType > outputEpochs_;
+
+    //! Minimum (absolute) step size
+    TimeType minimumStepSize_;
+
+    //! Maximum (absolute) step size
+    TimeType maximumStepSize_;
+
+    //! Relative error tolerance per state element
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance per state element
+    double absoluteErrorTolerance_;
+
+    //! Safety factor for the step size control
+    double safetyFactorForNextStepSize_;
+
+    //! Maximum factor by which the step size is increased after a step
+    double maximumFactorIncreaseForNextStepSize_;
+
+    //! Minimum factor by which the step size is decreased after a rejected step
+    double minimumFactorDecreaseForNextStepSize_;
+
+    //! Boolean denoting whether an exception is thrown if the minimum step size does not meet the tolerances
+    bool throwExceptionIfMinimumStepExceeded_;
+
+    //! Path of the file to which checkpoints are written (no checkpoints if empty)
+    std::string checkpointFilePath_;
+
+    //! Minimum (wall-clock) time in seconds between two checkpoints
+    double checkpointInterval_;
+};
+
+//! Function to create settings for the variable step-size Dormand-Prince 5(4) integrator with dense output
+template< typename TimeType = double >
+inline std::shared_ptr< IntegratorSettings< TimeType > > denseOutputRungeKuttaSettings(
+        const TimeType initialTime,
+        const TimeType initialTimeStep,
+        const std::vector< TimeType >& outputEpochs,
+        const TimeType minimumStepSize,
+        const TimeType maximumStepSize,
+        const double relativeErrorTolerance,
+        const double absoluteErrorTolerance,
+        const double safetyFactorForNextStepSize = 0.8,
+        const double maximumFactorIncreaseForNextStepSize = 4.0,
+        const double minimumFactorDecreaseForNextStepSize = 0.1,
+        const bool throwExceptionIfMinimumStepExceeded = true,
+        const std::string& checkpointFilePath = "",
+        const double checkpointInterval = 600.0 )
+{
+    return std::make_shared< DenseOutputIntegratorSettings< TimeType > >(
+                initialTime, initialTimeStep, outputEpochs, minimumStepSize, maximumStepSize,
+                relativeErrorTolerance, absoluteErrorTolerance, safetyFactorForNextStepSize,
+                maximumFactorIncreaseForNextStepSize, minimumFactorDecreaseForNextStepSize,
+                throwExceptionIfMinimumStepExceeded, checkpointFilePath, checkpointInterval );
+}
+
+//! Function to check that integrator settings are not dense output integrator settings
+/*!
+ *  Function to check that integrator settings are not dense output integrator settings (see
+ *  DenseOutputIntegratorSettings), for a simulation in which the integrator is created by Tudat.
+ *  \param integratorSettings Integrator settings that are to be checked
+ *  \param simulationName Name of the simulation that is created, used in the error message
+ */
+template< typename TimeType = double >
+void checkIntegratorSettingsWithoutDenseOutput(
+        const std::shared_ptr< IntegratorSettings< TimeType > > integratorSettings,
+        const std::string& simulationName )
+{
+    if( std::dynamic_pointer_cast< DenseOutputIntegratorSettings< TimeType > >( integratorSettings ) != nullptr )
+    {
+        throw std::runtime_error( "Error when creating " + simulationName +
+                                  ", dense output integrator settings are only supported by the single-arc simulator." );
+    }
+}
+
+} // namespace numerical_integrators
+
+namespace propagators
+{
+
+//! Function to create the dense output integrator for the state derivative model of a dynamics simulator
+/*!
+ *  Function to create the dense output integrator for the state derivative model of a dynamics simulator, with a
+ *  fixed- or dynamic-size state type. The state derivative model works on dynamic-size states, to and from which the
+ *  state is converted in each state derivative evaluation (i.e. at each stage), such that a fixed-size state type only
+ *  avoids the allocations in the integrator itself (stages, error estimate and continuous extension).
+ *  \param stateDerivativeModel State derivative model of the dynamics simulator
+ *  \param integratorSettings Settings of the dense output integrator
+ *  \return Dense output integrator
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, TimeType > createDenseOutputIntegrator(
+        const std::shared_ptr< DynamicsStateDerivativeModel< TimeType, double > > stateDerivativeModel,
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings )
+{
+    return numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, TimeType >(
+                [ = ]( const TimeType time, const StateType& state )
+    {
+        return StateType( stateDerivativeModel->computeStateDerivative( time, state ) );
+    },
+    integratorSettings->relativeErrorTolerance_, integratorSettings->absoluteErrorTolerance_,
+    integratorSettings->minimumStepSize_, integratorSettings->maximumStepSize_,
+    integratorSettings->safetyFactorForNextStepSize_, integratorSettings->maximumFactorIncreaseForNextStepSize_,
+    integratorSettings->minimumFactorDecreaseForNextStepSize_, integratorSettings->throwExceptionIfMinimumStepExceeded_ );
+}
+
+//! Function to check that propagator settings are supported by a propagation with the dense output integrator
+/*!
+ *  Function to check that propagator settings are supported by a propagation with the dense output integrator, which
+ *  integrates up to the last output epoch, and does not evaluate termination conditions: the propagation must be
+ *  terminated by a time termination condition, at or beyond the last output epoch.
+ *  \param propagatorSettings Propagator settings that are to be checked
+ *  \param integratorSettings Settings of the dense output integrator
+ */
+template< typename TimeType = double >
+void checkDenseOutputPropagatorSettings(
+        const std::shared_ptr< SingleArcPropagatorSettings< double > > propagatorSettings,
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings )
+{
+    std::shared_ptr< PropagationTimeTerminationSettings > timeTerminationSettings =
+            std::dynamic_pointer_cast< PropagationTimeTerminationSettings >( propagatorSettings->getTerminationSettings( ) );
+    if( timeTerminationSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when propagating with the dense output integrator, only time termination settings "
+                                  "are supported." );
+    }
+
+    if( integratorSettings->outputEpochs_.size( ) > 0 )
+    {
+        const double lastOutputEpoch = static_cast< double >( integratorSettings->outputEpochs_.back( ) );
+        const double propagationDirection = lastOutputEpoch - static_cast< double >( integratorSettings->initialTime_ );
+        if( ( lastOutputEpoch - timeTerminationSettings->terminationTime_ ) * propagationDirection > 0.0 )
+        {
+            throw std::runtime_error( "Error when propagating with the dense output integrator, the last output epoch is "
+                                      "beyond the termination time." );
+        }
+    }
+}
+
+//! Function to compute the dependent variables of a dense output propagation at the output epochs
+/*!
+ *  Function to compute the dependent variables (defined in the propagator settings) of a dense output propagation at
+ *  the output epochs. For each output epoch, the environment is updated by evaluating the state derivative at the
+ *  (raw) state at that epoch, after which the dependent variables are computed, identically to their evaluation during a
+ *  propagation with a Tudat integrator.
+ *  \param dynamicsSimulator Dynamics simulator with which the equations of motion were integrated
+ *  \param rawStateHistory (Raw) states at the output epochs
+ *  \return Dependent variables at the output epochs (empty if no dependent variables are to be saved)
+ */
+template< typename TimeType = double >
+std::map< TimeType, Eigen::VectorXd > computeDenseOutputDependentVariables(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const std::map< TimeType, Eigen::VectorXd >& rawStateHistory )
+{
+    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+    std::shared_ptr< DependentVariableSaveSettings > dependentVariablesToSave =
+            dynamicsSimulator->getPropagatorSettings( )->getDependentVariablesToSave( );
+    if( dependentVariablesToSave == nullptr || dependentVariablesToSave->dependentVariables_.size( ) == 0 )
+    {
+        return dependentVariableHistory;
+    }
+
+    std::shared_ptr< DynamicsStateDerivativeModel< TimeType, double > > stateDerivativeModel =
+            dynamicsSimulator->getDynamicsStateDerivative( );
+    std::function< Eigen::VectorXd( ) > dependentVariableFunction =
+            createDependentVariableListFunction< TimeType, double >(
+                dependentVariablesToSave, dynamicsSimulator->getSystemOfBodies( ),
+                stateDerivativeModel->getStateDerivativeModels( ) ).first;
+    for( auto stateIterator : rawStateHistory )
+    {
+        stateDerivativeModel->computeStateDerivative( stateIterator.first, stateIterator.second );
+        dependentVariableHistory[ stateIterator.first ] = dependentVariableFunction( );
+    }
+    return dependentVariableHistory;
+}
+
+//! Function to create the function writing checkpoints of a dense output integration (empty if no checkpoints are requested)
+/*!
+ *  Function to create the function writing checkpoints of a dense output integration (see PropagationCheckpointWriter),
+ *  which is called after each step, and writes a checkpoint if the checkpoint interval has passed since the previous one,
+ *  and after the final step.
+ *  \param integratorSettings Settings of the dense output integrator
+ *  \param rawStateHistory (Raw) states at the output epochs reached so far (updated during the integration)
+ *  \return Function writing checkpoints
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+typename numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, TimeType >::CheckpointFunction
+createDenseOutputCheckpointFunction(
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings,
+        const std::map< TimeType, Eigen::VectorXd >& rawStateHistory )
+{
+    typedef numerical_integrators::DenseOutputIntegratorState< StateType, TimeType > IntegratorState;
+    if( integratorSettings->checkpointFilePath_.empty( ) )
+    {
+        return std::function< void( const IntegratorState& ) >( );
+    }
+
+    std::shared_ptr< PropagationCheckpointWriter< StateType, TimeType > > checkpointWriter =
+            std::make_shared< PropagationCheckpointWriter< StateType, TimeType > >(
+                integratorSettings->checkpointFilePath_, integratorSettings->initialTime_, integratorSettings->outputEpochs_ );
+    std::shared_ptr< std::chrono::steady_clock::time_point > lastCheckpointTime =
+            std::make_shared< std::chrono::steady_clock::time_point >( std::chrono::steady_clock::now( ) );
+    return [ =, &rawStateHistory ]( const IntegratorState& integratorState )
+    {
+        const std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now( );
+        if( integratorState.outputIndex_ == integratorSettings->outputEpochs_.size( ) ||
+                std::chrono::duration< double >( currentTime - *lastCheckpointTime ).count( ) >=
+                integratorSettings->checkpointInterval_ )
+        {
+            utilities::ScopedTraceEvent traceEvent( "write_checkpoint", "propagation" );
+            checkpointWriter->writeCheckpoint( integratorState, rawStateHistory );
+            *lastCheckpointTime = currentTime;
+        }
+    };
+}
+
+//! Function to integrate (or resume the integration of) the equations of motion with a given integrator state type
+/*!
+ *  Function to integrate the equations of motion of a dynamics simulator with the dense output integrator, with a
+ *  fixed- or dynamic-size integrator state type, from the initial state or (if a checkpoint file is given) from a
+ *  checkpoint. See integrateEquationsOfMotionWithDenseOutput and resumeEquationsOfMotionFromCheckpoint.
+ *  \param dynamicsSimulator Dynamics simulator (created without integrating the equations of motion)
+ *  \param integratorSettings Settings of the dense output integrator
+ *  \param initialRawState Initial (raw) state of the propagation (not used if resuming from a checkpoint)
+ *  \param checkpointFilePath Path of the checkpoint file from which to resume (integration from the initial state if empty)
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+void integrateEquationsOfMotionWithDenseOutputStateType(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings,
+        const Eigen::VectorXd& initialRawState,
+        const std::string& checkpointFilePath = "" )
+{
+    checkDenseOutputPropagatorSettings( dynamicsSimulator->getPropagatorSettings( ), integratorSettings );
+
+    std::shared_ptr< DynamicsStateDerivativeModel< TimeType, double > > stateDerivativeModel =
+            dynamicsSimulator->getDynamicsStateDerivative( );
+    numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, TimeType > integrator =
+            createDenseOutputIntegrator< StateType >( stateDerivativeModel, integratorSettings );
+
+    std::map< TimeType, Eigen::Matrix< double, Eigen::Dynamic, 1 > > rawStateHistory;
+    typename numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, TimeType >::OutputFunction
+            outputFunction = [ &rawStateHistory ]( const unsigned int, const TimeType time, const StateType& state )
+    {
+        rawStateHistory[ time ] = state;
+    };
+
+    if( checkpointFilePath.empty( ) )
+    {
+        integrator.integrateToOutputEpochs(
+                    integratorSettings->initialTime_, StateType( initialRawState ), integratorSettings->initialTimeStep_,
+                    integratorSettings->outputEpochs_, outputFunction,
+                    createDenseOutputCheckpointFunction< StateType >( integratorSettings, rawStateHistory ) );
+    }
+    else
+    {
+        numerical_integrators::DenseOutputIntegratorState< StateType, TimeType > integratorState;
+        readPropagationCheckpoint( checkpointFilePath, integratorSettings->initialTime_, integratorSettings->outputEpochs_,
+                                   stateDerivativeModel->getStateDerivativeSize( ), integratorState, rawStateHistory );
+        integrator.resumeIntegrationToOutputEpochs(
+                    integratorState, integratorSettings->outputEpochs_, outputFunction,
+                    createDenseOutputCheckpointFunction< StateType >( integratorSettings, rawStateHistory ) );
+    }
+
+    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory =
+            computeDenseOutputDependentVariables( dynamicsSimulator, rawStateHistory );
+    dynamicsSimulator->manuallySetAndProcessRawNumericalEquationsOfMotionSolution(
+                rawStateHistory, dependentVariableHistory, true );
+}
+
+//! Function to integrate (or resume the integration of) the equations of motion, selecting the integrator state type
+/*!
+ *  Function to integrate (or resume the integration of) the equations of motion of a dynamics simulator with the dense
+ *  output integrator, selecting the integrator state type from the size of the propagated state: fixed-size states for
+ *  6-element states (translational state of a single body) and 7-element states (translational state and mass, or
+ *  rotational state, of a single body), and dynamic-size states otherwise. With fixed-size states, the integrator
+ *  internals do not allocate memory, but the state is still converted to and from a dynamic-size vector in each state
+ *  derivative evaluation (see createDenseOutputIntegrator). The gain is therefore limited to the integrator internals,
+ *  which are typically a small part of the cost of a step compared to the environment and acceleration models.
+ *  \param dynamicsSimulator Dynamics simulator (created without integrating the equations of motion)
+ *  \param integratorSettings Settings of the dense output integrator
+ *  \param initialRawState Initial (raw) state of the propagation (not used if resuming from a checkpoint)
+ *  \param checkpointFilePath Path of the checkpoint file from which to resume (integration from the initial state if empty)
+ */
+template< typename TimeType = double >
+void integrateEquationsOfMotionWithDenseOutputForStateSize(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings,
+        const Eigen::VectorXd& initialRawState,
+        const std::string& checkpointFilePath = "" )
+{
+    switch( dynamicsSimulator->getDynamicsStateDerivative( )->getStateDerivativeSize( ) )
+    {
+    case 6:
+        integrateEquationsOfMotionWithDenseOutputStateType< Eigen::Matrix< double, 6, 1 > >(
+                    dynamicsSimulator, integratorSettings, initialRawState, checkpointFilePath );
+        break;
+    case 7:
+        integrateEquationsOfMotionWithDenseOutputStateType< Eigen::Matrix< double, 7, 1 > >(
+                    dynamicsSimulator, integratorSettings, initialRawState, checkpointFilePath );
+        break;
+    default:
+        integrateEquationsOfMotionWithDenseOutputStateType< Eigen::VectorXd >(
+                    dynamicsSimulator, integratorSettings, initialRawState, checkpointFilePath );
+        break;
+    }
+}
+
+//! Function to integrate the equations of motion of a dynamics simulator with the dense output integrator
+/*!
+ *  Function to integrate the equations of motion of a dynamics simulator with the dense output integrator, using the
+ *  state derivative model of the dynamics simulator. The states at the output epochs are set (and processed into the
+ *  environment) as the numerical solution of the dynamics simulator, with the dependent variables at the output epochs
+ *  (see computeDenseOutputDependentVariables). If a
+ *  checkpoint file is defined in the integrator settings, checkpoints are written during the integration. For 6- and
+ *  7-element states, the integrator internals use fixed-size states (see
+ *  integrateEquationsOfMotionWithDenseOutputForStateSize).
+ *  \param dynamicsSimulator Dynamics simulator (created without integrating the equations of motion)
+ *  \param integratorSettings Settings of the dense output integrator
+ *  \param initialStates Initial (conventional) states of the propagation
+ */
+template< typename TimeType = double >
+void integrateEquationsOfMotionWithDenseOutput(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings,
+        const Eigen::VectorXd& initialStates )
+{
+    integrateEquationsOfMotionWithDenseOutputForStateSize(
+                dynamicsSimulator, integratorSettings,
+                dynamicsSimulator->getDynamicsStateDerivative( )->convertFromOutputSolution(
+                    initialStates, integratorSettings->initialTime_ ) );
+}
+
+//! Function to integrate the equations of motion of a dynamics simulator, supporting the dense output integrator
+/*!
+ *  Function to integrate the equations of motion of a dynamics simulator from given initial states, with
+ *  integrateEquationsOfMotionWithDenseOutput if the integrator settings of the dynamics simulator are dense output
+ *  integrator settings, and with the Tudat integrator otherwise.
+ *  \param dynamicsSimulator Dynamics simulator
+ *  \param initialStates Initial (conventional) states of the propagation
+ */
+template< typename TimeType = double >
+void integrateSingleArcEquationsOfMotion(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const Eigen::VectorXd& initialStates )
+{
+    std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > denseOutputSettings =
+            std::dynamic_pointer_cast< numerical_integrators::DenseOutputIntegratorSettings< TimeType > >(
+                dynamicsSimulator->getIntegratorSettings( ) );
+    if( denseOutputSettings == nullptr )
+    {
+        dynamicsSimulator->integrateEquationsOfMotion( initialStates );
+    }
+    else
+    {
+        integrateEquationsOfMotionWithDenseOutput( dynamicsSimulator, denseOutputSettings, initialStates );
+    }
+}
+
+//! Function to resume the integration of the equations of motion of a dynamics simulator from a checkpoint
+/*!
+ *  Function to resume the integration of the equations of motion of a dynamics simulator from a checkpoint written by
+ *  integrateEquationsOfMotionWithDenseOutput (or a previous resumed integration). The integration continues from the
+ *  saved integrator state, such that the result is identical to that of an uninterrupted integration, and new
+ *  checkpoints are written as defined in the integrator settings. The dynamics simulator must have been created (without
+ *  integrating the equations of motion) with the same dense output integrator settings and propagator settings as the
+ *  interrupted propagation.
+ *  \param dynamicsSimulator Dynamics simulator (created without integrating the equations of motion)
+ *  \param checkpointFilePath Path of the checkpoint file (if empty, the checkpoint file of the integrator settings)
+ */
+template< typename TimeType = double >
+void resumeEquationsOfMotionFromCheckpoint(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const std::string& checkpointFilePath = "" )
+{
+    std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > integratorSettings =
+            std::dynamic_pointer_cast< numerical_integrators::DenseOutputIntegratorSettings< TimeType > >(
+                dynamicsSimulator->getIntegratorSettings( ) );
+    if( integratorSettings == nullptr )
+    {
+        throw std::runtime_error( "Error when resuming propagation from checkpoint, only the dense output integrator supports checkpoints." );
+    }
+
+    const std::string checkpointFileToRead = checkpointFilePath.empty( ) ?
+                integratorSettings->checkpointFilePath_ : checkpointFilePath;
+    if( checkpointFileToRead.empty( ) )
+    {
+        throw std::runtime_error( "Error when resuming propagation from checkpoint, no checkpoint file is defined." );
+    }
+
+    integrateEquationsOfMotionWithDenseOutputForStateSize(
+                dynamicsSimulator, integratorSettings, Eigen::VectorXd( ), checkpointFileToRead );
+}
+
+//! Function to create a single-arc dynamics simulator, supporting the dense output integrator
+/*!
+ *  Function to create a single-arc dynamics simulator (see Tudat SingleArcDynamicsSimulator for the arguments). If the
+ *  integrator settings are dense output integrator settings, the dynamics simulator is created without integrating the
+ *  equations of motion, which are then (if requested) integrated with integrateEquationsOfMotionWithDenseOutput.
+ */
+template< typename TimeType = double >
+std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > createSingleArcDynamicsSimulator(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const bool areEquationsOfMotionToBeIntegrated = true,
+        const bool clearNumericalSolutions = false,
+        const bool setIntegratedResult = false,
+        const bool printNumberOfFunctionEvaluations = false,
+        const bool printDependentVariableData = true,
+        const bool printStateData = true )
+{
+    utilities::ScopedTraceEvent traceEvent( "single_arc_simulation", "propagation" );
+    std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > denseOutputSettings =
+            std::dynamic_pointer_cast< numerical_integrators::DenseOutputIntegratorSettings< TimeType > >( integratorSettings );
+    if( denseOutputSettings == nullptr )
+    {
+        return std::make_shared< SingleArcDynamicsSimulator< double, TimeType > >(
+                    bodies, integratorSettings, propagatorSettings, areEquationsOfMotionToBeIntegrated,
+                    clearNumericalSolutions, setIntegratedResult, printNumberOfFunctionEvaluations,
+                    printDependentVariableData, printStateData );
+    }
+
+    std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator =
+            std::make_shared< SingleArcDynamicsSimulator< double, TimeType > >(
+                bodies, integratorSettings, propagatorSettings, false, clearNumericalSolutions, setIntegratedResult,
+                printNumberOfFunctionEvaluations, printDependentVariableData, printStateData );
+    if( areEquationsOfMotionToBeIntegrated )
+    {
+        integrateEquationsOfMotionWithDenseOutput(
+                    dynamicsSimulator, denseOutputSettings, propagatorSettings->getInitialStates( ) );
+    }
+    return dynamicsSimulator;
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_DENSE_OUTPUT_PROPAGATION_H
@@ -0,0 +1,146 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_ENSEMBLE_PROPAGATION_H
+#define TUDATPY_ENSEMBLE_PROPAGATION_H
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "tudat/astro/gravitation/sphericalHarmonicsGravityField.h"
+#include "tudat/simulation/environment_setup/body.h"
+
+#include "tudatpy/numerical_simulation/propagation/ensembleStateDerivative.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to create the state derivative of an ensemble of particles moving in the environment of a system of bodies
+/*!
+ *  Function to create the state derivative of an ensemble of particles (see EnsembleStateDerivative) moving in the
+ *  environment of a system of bodies. The gravitational parameter (and, if requested, the J2 coefficient) are taken
+ *  from the gravity field of the central body, the rotation axis and angular velocity from its rotation model (if any)
+ *  and the third-body positions from the ephemerides of the bodies. The calls to these environment models are
+ *  serialized by a mutex, as not all of them are thread-safe (e.g. Spice ephemerides), such that the particles may be
+ *  propagated on multiple threads (see propagateEnsemble).
+ *  \param bodies System of bodies
+ *  \param centralBody Name of the central body
+ *  \param numberOfParticles Number of particles in the ensemble
+ *  \param includeJ2 Boolean denoting whether the J2 acceleration of the central body is included (which requires a
+ *  spherical harmonic gravity field)
+ *  \param thirdBodies Names of the bodies of which the point-mass gravity is included
+ *  \param ballisticCoefficients Ballistic coefficient (C_D A / m) of each particle (no drag if empty)
+ *  \param referenceDensity Density at the reference altitude of the exponential atmosphere
+ *  \param referenceAltitude Reference altitude of the exponential atmosphere (above the average radius of the shape
+ *  model of the central body)
+ *  \param scaleHeight Scale height of the exponential atmosphere
+ *  \return State derivative of the ensemble
+ */
+inline std::shared_ptr< EnsembleStateDerivative > createEnsembleStateDerivative(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::string& centralBody,
+        const unsigned int numberOfParticles,
+        const bool includeJ2 = true,
+        const std::vector< std::string >& thirdBodies = std::vector< std::string >( ),
+        const Eigen::VectorXd& ballisticCoefficients = Eigen::VectorXd( ),
+        const double referenceDensity = 0.0,
+        const double referenceAltitude = 0.0,
+        const double scaleHeight = 0.0 )
+{
+    if( bodies.count( centralBody ) == 0 )
+    {
+        throw std::runtime_error( "Error when creating ensemble state derivative, central body " + centralBody + " not found." );
+    }
+    std::shared_ptr< simulation_setup::Body > centralBodyObject = bodies.at( centralBody );
+    if( centralBodyObject->getGravityFieldModel( ) == nullptr )
+    {
+        throw std::runtime_error( "Error when creating ensemble state derivative, central body " + centralBody +
+                                  " has no gravity field." );
+    }
+
+    std::shared_ptr< EnsembleStateDerivative > stateDerivative = std::make_shared< EnsembleStateDerivative >(
+                numberOfParticles, centralBodyObject->getGravityFieldModel( )->getGravitationalParameter( ) );
+
+    std::shared_ptr< std::mutex > environmentMutex = std::make_shared< std::mutex >( );
+    std::shared_ptr< ephemerides::RotationalEphemeris > rotationModel = centralBodyObject->getRotationalEphemeris( );
+    if( rotationModel != nullptr )
+    {
+        stateDerivative->setCentralBodyRotation(
+                    [ = ]( const double currentTime, Eigen::Vector3d& rotationAxis, Eigen::Vector3d& angularVelocity )
+        {
+            std::lock_guard< std::mutex > environmentLock( *environmentMutex );
+            rotationAxis = rotationModel->getRotationToBaseFrame( currentTime ) * Eigen::Vector3d::UnitZ( );
+            angularVelocity = rotationModel->getRotationalVelocityVectorInBaseFrame( currentTime );
+        } );
+    }
+
+    if( includeJ2 )
+    {
+        std::shared_ptr< gravitation::SphericalHarmonicsGravityField > sphericalHarmonicsField =
+                std::dynamic_pointer_cast< gravitation::SphericalHarmonicsGravityField >(
+                    centralBodyObject->getGravityFieldModel( ) );
+        if( sphericalHarmonicsField == nullptr || sphericalHarmonicsField->getCosineCoefficients( ).rows( ) < 3 )
+        {
+            throw std::runtime_error( "Error when creating ensemble state derivative, J2 requires a spherical harmonic "
+                                      "gravity field (of at least degree 2) for " + centralBody + "." );
+        }
+        stateDerivative->setJ2Acceleration(
+                    -sphericalHarmonicsField->getCosineCoefficients( )( 2, 0 ) * std::sqrt( 5.0 ),
+                    sphericalHarmonicsField->getReferenceRadius( ) );
+    }
+
+    for( const std::string& thirdBody : thirdBodies )
+    {
+        if( bodies.count( thirdBody ) == 0 || bodies.at( thirdBody )->getGravityFieldModel( ) == nullptr )
+        {
+            throw std::runtime_error( "Error when creating ensemble state derivative, third body " + thirdBody +
+                                      " not found, or has no gravity field." );
+        }
+        std::shared_ptr< simulation_setup::Body > thirdBodyObject = bodies.at( thirdBody );
+        stateDerivative->addThirdBody(
+                    thirdBodyObject->getGravityFieldModel( )->getGravitationalParameter( ),
+                    [ = ]( const double currentTime )
+        {
+            std::lock_guard< std::mutex > environmentLock( *environmentMutex );
+            return Eigen::Vector3d( ( thirdBodyObject->getStateInBaseFrameFromEphemeris< double, double >( currentTime ) -
+                                      centralBodyObject->getStateInBaseFrameFromEphemeris< double, double >( currentTime ) ).
+                                    segment( 0, 3 ) );
+        } );
+    }
+
+    if( ballisticCoefficients.rows( ) > 0 )
+    {
+        if( centralBodyObject->getShapeModel( ) == nullptr )
+        {
+            throw std::runtime_error( "Error when creating ensemble state derivative, drag requires a shape model for " +
+                                      centralBody + "." );
+        }
+        stateDerivative->setDrag( ballisticCoefficients.array( ), referenceDensity, referenceAltitude, scaleHeight,
+                                  centralBodyObject->getShapeModel( )->getAverageRadius( ) );
+    }
+
+    return stateDerivative;
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_ENSEMBLE_PROPAGATION_H
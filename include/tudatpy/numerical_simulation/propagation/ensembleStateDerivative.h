@@ -0,0 +1,442 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_ENSEMBLE_STATE_DERIVATIVE_H
+#define TUDATPY_ENSEMBLE_STATE_DERIVATIVE_H
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudatpy/basics/parallelFor.h"
+#include "tudatpy/math/denseOutputIntegrator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Types of step size control for the propagation of an ensemble of particles
+enum EnsembleStepSizeControl
+{
+    common_ensemble_step_size,
+    per_particle_step_size
+};
+
+//! Types of the (structure-of-arrays) state and per-particle quantities of a subset of an ensemble of particles
+/*!
+ *  Types of the (structure-of-arrays) state and per-particle quantities of a subset of an ensemble of particles, which
+ *  are fixed-size if the number of particles in the subset is known at compile time (Eigen::Dynamic otherwise).
+ */
+template< int NumberOfParticles >
+struct EnsembleStateTypes
+{
+    //! Type of the state of the particles in the subset, in structure-of-arrays layout
+    typedef Eigen::Matrix< double, ( NumberOfParticles == Eigen::Dynamic ) ? Eigen::Dynamic : 6 * NumberOfParticles, 1 > StateType;
+
+    //! Type of a per-particle quantity of the particles in the subset
+    typedef Eigen::Array< double, NumberOfParticles, 1 > ParticleArrayType;
+};
+
+//! Translational state derivative of an ensemble of particles of negligible mass, in structure-of-arrays layout
+/*!
+ *  Translational state derivative of an ensemble of particles of negligible mass, moving in the same environment. The
+ *  states of N particles are stored in structure-of-arrays layout, as a single vector of size 6N with the x-positions
+ *  of all particles, followed by the y-positions, ..., followed by the z-velocities. The positions and velocities are
+ *  relative to a central body, in the (inertial) global frame orientation. The accelerations are evaluated for all
+ *  particles at once with array operations (which are vectorized across particles). The supported accelerations are:
+ *  - point-mass gravity of the central body
+ *  - J2 of the central body, about its (time-dependent) rotation axis
+ *  - point-mass (third-body) gravity of other bodies
+ *  - drag in an exponential atmosphere co-rotating with the central body, with a ballistic coefficient (C_D A / m) per
+ *    particle
+ *  The environment (orientation and rotation of the central body, positions of the third bodies) is evaluated once per
+ *  state derivative evaluation, and shared by all particles.
+ */
+class EnsembleStateDerivative
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfParticles Number of particles in the ensemble
+     *  \param gravitationalParameter Gravitational parameter of the central body
+     */
+    EnsembleStateDerivative( const unsigned int numberOfParticles,
+                             const double gravitationalParameter ):
+        numberOfParticles_( numberOfParticles ), gravitationalParameter_( gravitationalParameter ),
+        j2Coefficient_( 0.0 ), referenceRadius_( 0.0 ), isDragIncluded_( false ),
+        referenceDensity_( 0.0 ), referenceAltitude_( 0.0 ), scaleHeight_( 0.0 ), bodyRadius_( 0.0 )
+    {
+        if( numberOfParticles == 0 )
+        {
+            throw std::runtime_error( "Error when creating ensemble state derivative, number of particles must be positive." );
+        }
+        rotationFunction_ = [ ]( const double, Eigen::Vector3d& rotationAxis, Eigen::Vector3d& angularVelocity )
+        {
+            rotationAxis = Eigen::Vector3d::UnitZ( );
+            angularVelocity = Eigen::Vector3d::Zero( );
+        };
+    }
+
+    //! Function to set the rotation of the central body (used for J2 and drag)
+    /*!
+     *  Function to set the rotation of the central body (used for J2 and drag)
+     *  \param rotationFunction Function computing the (unit) rotation axis and the angular velocity vector of the
+     *  central body, in the global frame orientation, as a function of time
+     */
+    void setCentralBodyRotation(
+            const std::function< void( const double, Eigen::Vector3d&, Eigen::Vector3d& ) >& rotationFunction )
+    {
+        rotationFunction_ = rotationFunction;
+    }
+
+    //! Function to include the J2 acceleration of the central body
+    void setJ2Acceleration( const double j2Coefficient, const double referenceRadius )
+    {
+        j2Coefficient_ = j2Coefficient;
+        referenceRadius_ = referenceRadius;
+    }
+
+    //! Function to add the point-mass gravity of a third body
+    /*!
+     *  Function to add the point-mass gravity of a third body
+     *  \param gravitationalParameter Gravitational parameter of the third body
+     *  \param positionFunction Function returning the position of the third body w.r.t. the central body, as a function
+     *  of time
+     */
+    void addThirdBody( const double gravitationalParameter,
+                       const std::function< Eigen::Vector3d( const double ) >& positionFunction )
+    {
+        thirdBodies_.push_back( std::make_pair( gravitationalParameter, positionFunction ) );
+    }
+
+    //! Function to include drag in an exponential atmosphere, co-rotating with the central body
+    /*!
+     *  Function to include drag in an exponential atmosphere, co-rotating with the central body
+     *  \param ballisticCoefficients Ballistic coefficient (C_D A / m) of each particle
+     *  \param referenceDensity Density at the reference altitude
+     *  \param referenceAltitude Reference altitude (above the sphere with the given body radius)
+     *  \param scaleHeight Scale height of the atmosphere
+     *  \param bodyRadius Radius of the sphere above which the altitude is computed
+     */
+    void setDrag( const Eigen::ArrayXd& ballisticCoefficients,
+                  const double referenceDensity,
+                  const double referenceAltitude,
+                  const double scaleHeight,
+                  const double bodyRadius )
+    {
+        if( ballisticCoefficients.rows( ) != static_cast< int >( numberOfParticles_ ) )
+        {
+            throw std::runtime_error( "Error when setting ensemble drag, " + std::to_string( ballisticCoefficients.rows( ) ) +
+                                      " ballistic coefficients given for " + std::to_string( numberOfParticles_ ) +
+                                      " particles." );
+        }
+        if( !( scaleHeight > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when setting ensemble drag, scale height must be positive." );
+        }
+        isDragIncluded_ = true;
+        ballisticCoefficients_ = ballisticCoefficients;
+        referenceDensity_ = referenceDensity;
+        referenceAltitude_ = referenceAltitude;
+        scaleHeight_ = scaleHeight;
+        bodyRadius_ = bodyRadius;
+    }
+
+    //! Function to retrieve the number of particles in the ensemble
+    unsigned int getNumberOfParticles( ){ return numberOfParticles_; }
+
+    //! Function to compute the state derivative of a (contiguous) subset of the particles
+    /*!
+     *  Function to compute the state derivative of a contiguous subset of the particles, starting at a given particle
+     *  index, with the number of particles in the subset defined by the size of the state (6 times the number of
+     *  particles, in structure-of-arrays layout). If the number of particles is fixed at compile time (template
+     *  argument), all intermediate quantities are fixed-size, and no memory is allocated.
+     *  \param currentTime Current time
+     *  \param state States of the particles in the subset, in structure-of-arrays layout
+     *  \param firstParticleIndex Index of the first particle of the subset in the ensemble
+     *  \return State derivatives of the particles in the subset, in structure-of-arrays layout
+     */
+    template< int NumberOfParticles = Eigen::Dynamic >
+    typename EnsembleStateTypes< NumberOfParticles >::StateType computeStateDerivative(
+            const double currentTime,
+            const typename EnsembleStateTypes< NumberOfParticles >::StateType& state,
+            const unsigned int firstParticleIndex = 0 )
+    {
+        typedef typename EnsembleStateTypes< NumberOfParticles >::ParticleArrayType ParticleArrayType;
+
+        const int n = static_cast< int >( state.rows( ) / 6 );
+        typename EnsembleStateTypes< NumberOfParticles >::StateType stateDerivative( 6 * n );
+
+        // Velocities
+        stateDerivative.segment( 0, 3 * n ) = state.segment( 3 * n, 3 * n );
+
+        const auto x = state.template segment< NumberOfParticles >( 0, n ).array( );
+        const auto y = state.template segment< NumberOfParticles >( n, n ).array( );
+        const auto z = state.template segment< NumberOfParticles >( 2 * n, n ).array( );
+        auto ax = stateDerivative.template segment< NumberOfParticles >( 3 * n, n ).array( );
+        auto ay = stateDerivative.template segment< NumberOfParticles >( 4 * n, n ).array( );
+        auto az = stateDerivative.template segment< NumberOfParticles >( 5 * n, n ).array( );
+
+        // Central body point mass
+        const ParticleArrayType radiusSquared = x.square( ) + y.square( ) + z.square( );
+        const ParticleArrayType radius = radiusSquared.sqrt( );
+        const ParticleArrayType inverseRadiusCubed = ( radiusSquared * radius ).inverse( );
+        ax = -gravitationalParameter_ * x * inverseRadiusCubed;
+        ay = -gravitationalParameter_ * y * inverseRadiusCubed;
+        az = -gravitationalParameter_ * z * inverseRadiusCubed;
+
+        Eigen::Vector3d rotationAxis, angularVelocity;
+        if( j2Coefficient_ != 0.0 || isDragIncluded_ )
+        {
+            rotationFunction_( currentTime, rotationAxis, angularVelocity );
+        }
+
+        // Central body J2, about rotation axis
+        if( j2Coefficient_ != 0.0 )
+        {
+            const ParticleArrayType axialPosition = rotationAxis.x( ) * x + rotationAxis.y( ) * y + rotationAxis.z( ) * z;
+            const ParticleArrayType j2Factor = ( -1.5 * j2Coefficient_ * gravitationalParameter_ * referenceRadius_ *
+                                                 referenceRadius_ ) * inverseRadiusCubed / radiusSquared;
+            const ParticleArrayType radialFactor = j2Factor * ( 1.0 - 5.0 * axialPosition.square( ) / radiusSquared );
+            const ParticleArrayType axialFactor = 2.0 * j2Factor * axialPosition;
+            ax += radialFactor * x + axialFactor * rotationAxis.x( );
+            ay += radialFactor * y + axialFactor * rotationAxis.y( );
+            az += radialFactor * z + axialFactor * rotationAxis.z( );
+        }
+
+        // Third bodies (position w.r.t. central body evaluated once for all particles)
+        for( unsigned int i = 0; i < thirdBodies_.size( ); i++ )
+        {
+            const double thirdBodyGravitationalParameter = thirdBodies_.at( i ).first;
+            const Eigen::Vector3d thirdBodyPosition = thirdBodies_.at( i ).second( currentTime );
+            const Eigen::Vector3d centralBodyAcceleration =
+                    thirdBodyGravitationalParameter * thirdBodyPosition / std::pow( thirdBodyPosition.norm( ), 3 );
+
+            const ParticleArrayType dx = thirdBodyPosition.x( ) - x;
+            const ParticleArrayType dy = thirdBodyPosition.y( ) - y;
+            const ParticleArrayType dz = thirdBodyPosition.z( ) - z;
+            const ParticleArrayType distanceSquared = dx.square( ) + dy.square( ) + dz.square( );
+            const ParticleArrayType factor =
+                    thirdBodyGravitationalParameter * ( distanceSquared * distanceSquared.sqrt( ) ).inverse( );
+            ax += factor * dx - centralBodyAcceleration.x( );
+            ay += factor * dy - centralBodyAcceleration.y( );
+            az += factor * dz - centralBodyAcceleration.z( );
+        }
+
+        // Drag in co-rotating exponential atmosphere
+        if( isDragIncluded_ )
+        {
+            const auto vx = state.template segment< NumberOfParticles >( 3 * n, n ).array( );
+            const auto vy = state.template segment< NumberOfParticles >( 4 * n, n ).array( );
+            const auto vz = state.template segment< NumberOfParticles >( 5 * n, n ).array( );
+            const ParticleArrayType relativeVx = vx - ( angularVelocity.y( ) * z - angularVelocity.z( ) * y );
+            const ParticleArrayType relativeVy = vy - ( angularVelocity.z( ) * x - angularVelocity.x( ) * z );
+            const ParticleArrayType relativeVz = vz - ( angularVelocity.x( ) * y - angularVelocity.y( ) * x );
+            const ParticleArrayType relativeSpeed =
+                    ( relativeVx.square( ) + relativeVy.square( ) + relativeVz.square( ) ).sqrt( );
+            const ParticleArrayType density =
+                    referenceDensity_ * ( -( radius - bodyRadius_ - referenceAltitude_ ) / scaleHeight_ ).exp( );
+            const ParticleArrayType dragFactor = -0.5 * density * relativeSpeed *
+                    ballisticCoefficients_.template segment< NumberOfParticles >( firstParticleIndex, n );
+            ax += dragFactor * relativeVx;
+            ay += dragFactor * relativeVy;
+            az += dragFactor * relativeVz;
+        }
+
+        return stateDerivative;
+    }
+
+private:
+
+    //! Number of particles in the ensemble
+    unsigned int numberOfParticles_;
+
+    //! Gravitational parameter of the central body
+    double gravitationalParameter_;
+
+    //! J2 coefficient of the central body (0 if not included)
+    double j2Coefficient_;
+
+    //! Reference radius of the J2 coefficient
+    double referenceRadius_;
+
+    //! Function computing the rotation axis and angular velocity of the central body
+    std::function< void( const double, Eigen::Vector3d&, Eigen::Vector3d& ) > rotationFunction_;
+
+    //! Gravitational parameters and position functions of the third bodies
+    std::vector< std::pair< double, std::function< Eigen::Vector3d( const double ) > > > thirdBodies_;
+
+    //! Boolean denoting whether drag is included
+    bool isDragIncluded_;
+
+    //! Ballistic coefficient (C_D A / m) of each particle
+    Eigen::ArrayXd ballisticCoefficients_;
+
+    //! Density at the reference altitude
+    double referenceDensity_;
+
+    //! Reference altitude of the atmosphere
+    double referenceAltitude_;
+
+    //! Scale height of the atmosphere
+    double scaleHeight_;
+
+    //! Radius of the sphere above which the altitude is computed
+    double bodyRadius_;
+};
+
+//! Function to propagate a (contiguous) subset of an ensemble of particles, and evaluate their states at output epochs
+/*!
+ *  Function to propagate a contiguous subset of an ensemble of particles as a single structure-of-arrays state (see
+ *  propagateEnsemble). If the number of particles in the subset is fixed at compile time (template argument), the
+ *  integrator and state derivative use fixed-size states, and do not allocate memory during the integration.
+ *  \param stateDerivative State derivative of the ensemble
+ *  \param initialStates Initial Cartesian states of all particles w.r.t. the central body (one row per particle)
+ *  \param firstParticleIndex Index of the first particle of the subset in the ensemble
+ *  \param numberOfParticles Number of particles in the subset
+ *  \param initialTime Initial epoch
+ *  \param outputEpochs Epochs at which the states are to be evaluated (monotonic, in the direction of integration)
+ *  \param initialTimeStep Initial (absolute) step size
+ *  \param minimumStepSize Minimum (absolute) step size
+ *  \param maximumStepSize Maximum (absolute) step size
+ *  \param relativeErrorTolerance Relative error tolerance per state element
+ *  \param absoluteErrorTolerance Absolute error tolerance per state element
+ *  \param outputStates Pointer to the (particles x output epochs x 6, row-major) array to which the states of the
+ *  particles at the output epochs are written
+ */
+template< int NumberOfParticles = Eigen::Dynamic >
+void propagateEnsembleSubset(
+        const std::shared_ptr< EnsembleStateDerivative > stateDerivative,
+        const Eigen::MatrixXd& initialStates,
+        const int firstParticleIndex,
+        const int numberOfParticles,
+        const double initialTime,
+        const std::vector< double >& outputEpochs,
+        const double initialTimeStep,
+        const double minimumStepSize,
+        const double maximumStepSize,
+        const double relativeErrorTolerance,
+        const double absoluteErrorTolerance,
+        double* outputStates )
+{
+    typedef typename EnsembleStateTypes< NumberOfParticles >::StateType StateType;
+
+    const std::size_t numberOfOutputEpochs = outputEpochs.size( );
+    numerical_integrators::DormandPrinceDenseOutputIntegrator< StateType, double > integrator(
+                [ = ]( const double time, const StateType& state )
+    {
+        return stateDerivative->template computeStateDerivative< NumberOfParticles >( time, state, firstParticleIndex );
+    }, relativeErrorTolerance, absoluteErrorTolerance, minimumStepSize, maximumStepSize );
+
+    StateType initialSubsetState( 6 * numberOfParticles );
+    for( int i = 0; i < 6; i++ )
+    {
+        initialSubsetState.segment( i * numberOfParticles, numberOfParticles ) =
+                initialStates.block( firstParticleIndex, i, numberOfParticles, 1 );
+    }
+
+    integrator.integrateToOutputEpochs(
+                initialTime, initialSubsetState, initialTimeStep, outputEpochs,
+                [ & ]( const unsigned int outputIndex, const double, const StateType& state )
+    {
+        for( int j = 0; j < numberOfParticles; j++ )
+        {
+            for( int i = 0; i < 6; i++ )
+            {
+                outputStates[ ( static_cast< std::size_t >( firstParticleIndex + j ) * numberOfOutputEpochs +
+                                outputIndex ) * 6 + i ] = state( i * numberOfParticles + j );
+            }
+        }
+    } );
+}
+
+//! Function to propagate an ensemble of particles, and evaluate their states at a list of output epochs
+/*!
+ *  Function to propagate an ensemble of particles with the variable step-size Dormand-Prince 5(4) integrator with
+ *  dense output (see DormandPrinceDenseOutputIntegrator), and evaluate their states at a list of output epochs. With a
+ *  common step size, all particles are integrated as a single structure-of-arrays state, such that each state
+ *  derivative evaluation (and environment update) is shared by all particles, and the step size is limited by the
+ *  particle with the largest error. With per-particle step sizes, each particle is integrated separately with its own
+ *  step size control (and environment updates), using fixed-size states, and the particles are distributed over a pool
+ *  of threads (see parallelFor). The functions of the state derivative that retrieve the environment (central body
+ *  rotation, third-body positions) must then be safe for concurrent use (see createEnsembleStateDerivative). The
+ *  output states do not depend on the number of threads.
+ *  \param stateDerivative State derivative of the ensemble
+ *  \param initialStates Initial Cartesian states of the particles w.r.t. the central body (one row per particle)
+ *  \param initialTime Initial epoch
+ *  \param outputEpochs Epochs at which the states are to be evaluated (monotonic, in the direction of integration)
+ *  \param initialTimeStep Initial (absolute) step size
+ *  \param minimumStepSize Minimum (absolute) step size
+ *  \param maximumStepSize Maximum (absolute) step size
+ *  \param relativeErrorTolerance Relative error tolerance per state element
+ *  \param absoluteErrorTolerance Absolute error tolerance per state element
+ *  \param stepSizeControl Type of step size control
+ *  \param outputStates Pointer to the (particles x output epochs x 6, row-major) array to which the states of the
+ *  particles at the output epochs are written
+ *  \param numberOfThreads Number of threads used with per-particle step sizes (<= 0 for hardware concurrency)
+ */
+inline void propagateEnsemble(
+        const std::shared_ptr< EnsembleStateDerivative > stateDerivative,
+        const Eigen::MatrixXd& initialStates,
+        const double initialTime,
+        const std::vector< double >& outputEpochs,
+        const double initialTimeStep,
+        const double minimumStepSize,
+        const double maximumStepSize,
+        const double relativeErrorTolerance,
+        const double absoluteErrorTolerance,
+        const EnsembleStepSizeControl stepSizeControl,
+        double* outputStates,
+        const int numberOfThreads = 0 )
+{
+    const int numberOfParticles = static_cast< int >( stateDerivative->getNumberOfParticles( ) );
+    if( initialStates.rows( ) != numberOfParticles || initialStates.cols( ) != 6 )
+    {
+        throw std::runtime_error( "Error when propagating ensemble, initial states must be of size " +
+                                  std::to_string( numberOfParticles ) + " x 6." );
+    }
+
+    if( stepSizeControl == common_ensemble_step_size )
+    {
+        propagateEnsembleSubset( stateDerivative, initialStates, 0, numberOfParticles, initialTime, outputEpochs,
+                                 initialTimeStep, minimumStepSize, maximumStepSize, relativeErrorTolerance,
+                                 absoluteErrorTolerance, outputStates );
+    }
+    else
+    {
+        // Single-particle states are integrated with fixed-size (allocation-free) kernels, each writing only the
+        // output states of its own particle
+        utilities::parallelFor(
+                    static_cast< unsigned int >( numberOfParticles ), numberOfThreads,
+                    [ & ]( const unsigned int particleIndex, const unsigned int )
+        {
+            propagateEnsembleSubset< 1 >( stateDerivative, initialStates, static_cast< int >( particleIndex ), 1,
+                                          initialTime, outputEpochs, initialTimeStep, minimumStepSize, maximumStepSize,
+                                          relativeErrorTolerance, absoluteErrorTolerance, outputStates );
+        } );
+    }
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_ENSEMBLE_STATE_DERIVATIVE_H
@@ -0,0 +1,282 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EXPRESSION_CONDITIONS_H
+#define TUDATPY_EXPRESSION_CONDITIONS_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/aerodynamics/aerodynamicGuidance.h"
+#include "tudat/simulation/propagation_setup/propagationOutput.h"
+#include "tudat/simulation/propagation_setup/propagationTerminationSettings.h"
+
+#include "tudatpy/math/compiledExpression.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Expressions over dependent variables, evaluated natively during the propagation
+/*!
+ *  Expressions over dependent variables (see CompiledExpression for the syntax), evaluated natively during the
+ *  propagation. Each variable name that can be used in the expressions is linked to dependent variable settings. The
+ *  dependent variable functions are created at the first evaluation (when the environment models, such as the flight
+ *  conditions, have been created), from the system of bodies only. Consequently, dependent variables that require the
+ *  state derivative models (e.g. single acceleration norms) cannot be used, and the variables are evaluated from the
+ *  environment as last updated by the propagation.
+ */
+class DependentVariableExpressions
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param bodies System of bodies from which the dependent variables are computed
+     *  \param variableSettings Dependent variable settings of the variables (key: name in the expressions)
+     *  \param tables Tables that can be used in the expressions (key: name; value: independent and dependent values)
+     */
+    DependentVariableExpressions(
+            const simulation_setup::SystemOfBodies& bodies,
+            const std::map< std::string, std::shared_ptr< SingleDependentVariableSaveSettings > >& variableSettings,
+            const std::map< std::string, std::pair< std::vector< double >, std::vector< double > > >& tables ):
+        bodies_( bodies )
+    {
+        std::vector< std::string > variableNames;
+        for( auto variableIterator : variableSettings )
+        {
+            variableNames.push_back( variableIterator.first );
+            variableSettings_.push_back( variableIterator.second );
+        }
+        variableSet_ = std::make_shared< expressions::ExpressionVariableSet >( variableNames );
+
+        for( auto tableIterator : tables )
+        {
+            if( variableSettings.count( tableIterator.first ) > 0 )
+            {
+                throw std::runtime_error( "Error when creating expressions, name " + tableIterator.first +
+                                          " is used for both a variable and a table." );
+            }
+            tables_[ tableIterator.first ] = std::make_shared< expressions::ExpressionTable >(
+                        tableIterator.second.first, tableIterator.second.second );
+        }
+    }
+
+    //! Function to compile an expression over the variables and tables
+    std::shared_ptr< expressions::CompiledExpression > compileExpression( const std::string& expression )
+    {
+        if( variableSet_->areVariableFunctionsSet( ) )
+        {
+            throw std::runtime_error( "Error when compiling expression " + expression +
+                                      ", expressions have already been evaluated." );
+        }
+        return std::make_shared< expressions::CompiledExpression >( expression, variableSet_, tables_ );
+    }
+
+    //! Function to update the values of the variables (creating the dependent variable functions if needed)
+    void updateVariables( const double currentTime )
+    {
+        if( !variableSet_->areVariableFunctionsSet( ) )
+        {
+            createVariableFunctions( );
+        }
+        variableSet_->updateVariables( currentTime );
+    }
+
+private:
+
+    //! Function to create the dependent variable functions of all variables used in the compiled expressions
+    void createVariableFunctions( )
+    {
+        std::vector< std::function< Eigen::VectorXd( ) > > variableFunctions;
+        for( unsigned int i = 0; i < variableSettings_.size( ); i++ )
+        {
+            if( variableSet_->getIsVariableUsed( ).at( i ) )
+            {
+                variableFunctions.push_back(
+                            createDependentVariableListFunction< double, double >(
+                                createDependentVariableSaveSettings( { variableSettings_.at( i ) }, false ), bodies_,
+                                std::unordered_map< IntegratedStateType, std::vector< std::shared_ptr<
+                                SingleStateTypeDerivative< double, double > > > >( ) ).first );
+            }
+            else
+            {
+                variableFunctions.push_back( [ ]( ){ return Eigen::VectorXd( ); } );
+            }
+        }
+        variableSet_->setVariableFunctions( variableFunctions );
+    }
+
+    //! System of bodies from which the dependent variables are computed
+    simulation_setup::SystemOfBodies bodies_;
+
+    //! Dependent variable settings of the variables (in the order of the variable set)
+    std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > > variableSettings_;
+
+    //! Variables that can be used in the expressions
+    std::shared_ptr< expressions::ExpressionVariableSet > variableSet_;
+
+    //! Tables that can be used in the expressions (key: name)
+    std::map< std::string, std::shared_ptr< expressions::ExpressionTable > > tables_;
+};
+
+//! Termination settings, with the propagation terminated when an expression over dependent variables is true (non-zero)
+class PropagationExpressionTerminationSettings: public PropagationCustomTerminationSettings
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param dependentVariableExpressions Dependent variable expressions with which the condition was compiled
+     *  \param condition Compiled condition, terminating the propagation when non-zero
+     */
+    PropagationExpressionTerminationSettings(
+            const std::shared_ptr< DependentVariableExpressions > dependentVariableExpressions,
+            const std::shared_ptr< expressions::CompiledExpression > condition ):
+        PropagationCustomTerminationSettings( [ = ]( const double currentTime )
+    {
+        dependentVariableExpressions->updateVariables( currentTime );
+        return ( condition->evaluate( ) != 0.0 );
+    } ), condition_( condition ){ }
+
+    //! Function to retrieve the (uncompiled) condition
+    std::string getCondition( ){ return condition_->getExpression( ); }
+
+private:
+
+    //! Compiled condition, terminating the propagation when non-zero
+    std::shared_ptr< expressions::CompiledExpression > condition_;
+};
+
+//! Function to create termination settings from an expression over dependent variables
+/*!
+ *  Function to create termination settings from an expression over dependent variables (see CompiledExpression for the
+ *  syntax, and DependentVariableExpressions for the evaluation), terminating the propagation when the expression is
+ *  true (non-zero). The condition is evaluated natively after each step, e.g. "altitude < 120.0E3 and mach > 5".
+ *  \param bodies System of bodies from which the dependent variables are computed
+ *  \param condition Expression terminating the propagation when true
+ *  \param variableSettings Dependent variable settings of the variables (key: name in the expression)
+ *  \param tables Tables that can be used in the expression (key: name; value: independent and dependent values)
+ *  \return Termination settings
+ */
+inline std::shared_ptr< PropagationExpressionTerminationSettings > propagationExpressionTerminationSettings(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::string& condition,
+        const std::map< std::string, std::shared_ptr< SingleDependentVariableSaveSettings > >& variableSettings,
+        const std::map< std::string, std::pair< std::vector< double >, std::vector< double > > >& tables =
+        std::map< std::string, std::pair< std::vector< double >, std::vector< double > > >( ) )
+{
+    std::shared_ptr< DependentVariableExpressions > dependentVariableExpressions =
+            std::make_shared< DependentVariableExpressions >( bodies, variableSettings, tables );
+    return std::make_shared< PropagationExpressionTerminationSettings >(
+                dependentVariableExpressions, dependentVariableExpressions->compileExpression( condition ) );
+}
+
+} // namespace propagators
+
+namespace aerodynamics
+{
+
+//! Aerodynamic guidance, with the aerodynamic angles computed from expressions over dependent variables
+/*!
+ *  Aerodynamic guidance, with the aerodynamic angles computed from expressions over dependent variables (see
+ *  CompiledExpression for the syntax, and DependentVariableExpressions for the evaluation). Angles without an
+ *  expression are zero.
+ */
+class ExpressionAerodynamicGuidance: public AerodynamicGuidance
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param dependentVariableExpressions Dependent variable expressions with which the angles were compiled
+     *  \param angleOfAttack Compiled angle of attack (nullptr if zero)
+     *  \param bankAngle Compiled bank angle (nullptr if zero)
+     *  \param sideslipAngle Compiled sideslip angle (nullptr if zero)
+     */
+    ExpressionAerodynamicGuidance(
+            const std::shared_ptr< propagators::DependentVariableExpressions > dependentVariableExpressions,
+            const std::shared_ptr< expressions::CompiledExpression > angleOfAttack,
+            const std::shared_ptr< expressions::CompiledExpression > bankAngle,
+            const std::shared_ptr< expressions::CompiledExpression > sideslipAngle ):
+        AerodynamicGuidance( ), dependentVariableExpressions_( dependentVariableExpressions ),
+        angleOfAttack_( angleOfAttack ), bankAngle_( bankAngle ), sideslipAngle_( sideslipAngle ){ }
+
+    //! Function to update the aerodynamic angles to the current time
+    void updateGuidance( const double currentTime )
+    {
+        dependentVariableExpressions_->updateVariables( currentTime );
+        currentAngleOfAttack_ = ( angleOfAttack_ == nullptr ) ? 0.0 : angleOfAttack_->evaluate( );
+        currentBankAngle_ = ( bankAngle_ == nullptr ) ? 0.0 : bankAngle_->evaluate( );
+        currentAngleOfSideslip_ = ( sideslipAngle_ == nullptr ) ? 0.0 : sideslipAngle_->evaluate( );
+    }
+
+private:
+
+    //! Dependent variable expressions with which the angles were compiled
+    std::shared_ptr< propagators::DependentVariableExpressions > dependentVariableExpressions_;
+
+    //! Compiled angle of attack (nullptr if zero)
+    std::shared_ptr< expressions::CompiledExpression > angleOfAttack_;
+
+    //! Compiled bank angle (nullptr if zero)
+    std::shared_ptr< expressions::CompiledExpression > bankAngle_;
+
+    //! Compiled sideslip angle (nullptr if zero)
+    std::shared_ptr< expressions::CompiledExpression > sideslipAngle_;
+};
+
+//! Function to create an aerodynamic guidance from expressions over dependent variables
+/*!
+ *  Function to create an aerodynamic guidance from expressions over dependent variables (see
+ *  ExpressionAerodynamicGuidance), e.g. a bank angle schedule as a function of energy, given by a table.
+ *  \param bodies System of bodies from which the dependent variables are computed
+ *  \param angleOfAttack Expression for the angle of attack (empty if zero)
+ *  \param bankAngle Expression for the bank angle (empty if zero)
+ *  \param sideslipAngle Expression for the sideslip angle (empty if zero)
+ *  \param variableSettings Dependent variable settings of the variables (key: name in the expressions)
+ *  \param tables Tables that can be used in the expressions (key: name; value: independent and dependent values)
+ *  \return Aerodynamic guidance
+ */
+inline std::shared_ptr< ExpressionAerodynamicGuidance > expressionAerodynamicGuidance(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::string& angleOfAttack,
+        const std::string& bankAngle,
+        const std::string& sideslipAngle,
+        const std::map< std::string, std::shared_ptr< propagators::SingleDependentVariableSaveSettings > >& variableSettings,
+        const std::map< std::string, std::pair< std::vector< double >, std::vector< double > > >& tables =
+        std::map< std::string, std::pair< std::vector< double >, std::vector< double > > >( ) )
+{
+    std::shared_ptr< propagators::DependentVariableExpressions > dependentVariableExpressions =
+            std::make_shared< propagators::DependentVariableExpressions >( bodies, variableSettings, tables );
+    return std::make_shared< ExpressionAerodynamicGuidance >(
+                dependentVariableExpressions,
+                angleOfAttack.empty( ) ? nullptr : dependentVariableExpressions->compileExpression( angleOfAttack ),
+                bankAngle.empty( ) ? nullptr : dependentVariableExpressions->compileExpression( bankAngle ),
+                sideslipAngle.empty( ) ? nullptr : dependentVariableExpressions->compileExpression( sideslipAngle ) );
+}
+
+} // namespace aerodynamics
+
+} // namespace tudat
+
+#endif // TUDATPY_EXPRESSION_CONDITIONS_H
@@ -0,0 +1,159 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PLUGIN_MODEL_SETTINGS_H
+#define TUDATPY_PLUGIN_MODEL_SETTINGS_H
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "tudat/simulation/propagation_setup.h"
+
+#include "tudatpy/plugins/modelPluginLoader.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Function to retrieve the current environment of a plugin model, updating the environment it requires
+/*!
+ *  Function to retrieve the current environment of a plugin model (see modelPluginAbi.h). The plugin model is used as a
+ *  custom acceleration/torque, for which the Tudat environment updater does not update any part of the environment, so
+ *  the environment that the model requires is computed here from the environment models at the current time, unless it
+ *  is set by the propagation:
+ *  - the state of the body undergoing the acceleration/torque is that of the propagation (the body is propagated)
+ *  - the state of the body exerting the acceleration/torque is that of the propagation if the body is propagated, and
+ *    is computed from its ephemeris otherwise
+ *  - the rotational state of the body undergoing the acceleration/torque is that of the propagation if its rotation is
+ *    propagated (for torques), and is computed from its rotation model (if any) otherwise
+ *  - the mass of the body undergoing the acceleration/torque is updated from its mass function (which returns the
+ *    propagated mass if the mass is propagated)
+ *  \param currentTime Current time
+ *  \param bodyUndergoing Body undergoing the acceleration/torque
+ *  \param bodyExerting Body exerting the acceleration/torque
+ *  \param isRotationPropagated Boolean denoting whether the rotation of the body undergoing the acceleration/torque is
+ *  propagated
+ *  \return Current environment of the plugin model
+ */
+inline TudatpyPluginModelInput getPluginModelInput(
+        const double currentTime,
+        const std::shared_ptr< Body > bodyUndergoing,
+        const std::shared_ptr< Body > bodyExerting,
+        const bool isRotationPropagated )
+{
+    TudatpyPluginModelInput modelInput;
+    modelInput.time = currentTime;
+    Eigen::Map< Eigen::Vector6d >( modelInput.stateOfBodyUndergoing ) = bodyUndergoing->getState( );
+    if( bodyExerting->getIsBodyInPropagation( ) )
+    {
+        Eigen::Map< Eigen::Vector6d >( modelInput.stateOfBodyExerting ) = bodyExerting->getState( );
+    }
+    else if( bodyExerting->getEphemeris( ) != nullptr )
+    {
+        Eigen::Map< Eigen::Vector6d >( modelInput.stateOfBodyExerting ) =
+                bodyExerting->getStateInBaseFrameFromEphemeris< double, double >( currentTime );
+    }
+    else
+    {
+        throw std::runtime_error( "Error when evaluating plugin model, state of exerting body is neither propagated nor given by an ephemeris." );
+    }
+
+    std::shared_ptr< ephemerides::RotationalEphemeris > rotationModel = bodyUndergoing->getRotationalEphemeris( );
+    if( !isRotationPropagated && rotationModel != nullptr )
+    {
+        bodyUndergoing->setCurrentRotationalStateToLocalFrameFromEphemeris( currentTime );
+    }
+    const Eigen::Quaterniond rotationToBodyFixedFrame = bodyUndergoing->getCurrentRotationToLocalFrame( );
+    modelInput.rotationToBodyFixedFrame[ 0 ] = rotationToBodyFixedFrame.w( );
+    modelInput.rotationToBodyFixedFrame[ 1 ] = rotationToBodyFixedFrame.x( );
+    modelInput.rotationToBodyFixedFrame[ 2 ] = rotationToBodyFixedFrame.y( );
+    modelInput.rotationToBodyFixedFrame[ 3 ] = rotationToBodyFixedFrame.z( );
+    Eigen::Map< Eigen::Vector3d >( modelInput.angularVelocityInBodyFixedFrame ) =
+            bodyUndergoing->getCurrentAngularVelocityVectorInLocalFrame( );
+
+    bodyUndergoing->updateMass( currentTime );
+    modelInput.massOfBodyUndergoing = bodyUndergoing->getBodyMass( );
+    return modelInput;
+}
+
+//! Function to create acceleration settings for an acceleration model provided by a loaded plugin
+/*!
+ *  Function to create acceleration settings for an acceleration model provided by a loaded plugin (see
+ *  plugins::loadModelPlugin). A new instance of the model is created from the given parameters, and is evaluated with
+ *  the current environment of the bodies involved (see getPluginModelInput, with the rotation of the body undergoing the
+ *  acceleration computed from its rotation model).
+ *  \param bodies System of bodies
+ *  \param modelName Name with which the model was registered
+ *  \param bodyUndergoingAcceleration Name of the body undergoing the acceleration
+ *  \param bodyExertingAcceleration Name of the body exerting the acceleration
+ *  \param modelParameters Parameters from which the model instance is created
+ *  \return Acceleration settings
+ */
+inline std::shared_ptr< AccelerationSettings > pluginAccelerationSettings(
+        const SystemOfBodies& bodies,
+        const std::string& modelName,
+        const std::string& bodyUndergoingAcceleration,
+        const std::string& bodyExertingAcceleration,
+        const std::vector< double >& modelParameters = std::vector< double >( ) )
+{
+    std::shared_ptr< plugins::PluginModelInstance > modelInstance =
+            plugins::getModelPluginRegistry( ).createModelInstance(
+                modelName, TUDATPY_PLUGIN_ACCELERATION, modelParameters );
+    std::shared_ptr< Body > bodyUndergoing = bodies.at( bodyUndergoingAcceleration );
+    std::shared_ptr< Body > bodyExerting = bodies.at( bodyExertingAcceleration );
+    return customAccelerationSettings( [ = ]( const double currentTime )
+    {
+        return modelInstance->evaluate( getPluginModelInput( currentTime, bodyUndergoing, bodyExerting, false ) );
+    } );
+}
+
+//! Function to create torque settings for a torque model provided by a loaded plugin
+/*!
+ *  Function to create torque settings for a torque model provided by a loaded plugin (see plugins::loadModelPlugin),
+ *  with the torque computed in the body-fixed frame of the body undergoing it. See pluginAccelerationSettings for the
+ *  evaluation of the model, with the rotation of the body undergoing the torque taken from the (rotational)
+ *  propagation.
+ *  \param bodies System of bodies
+ *  \param modelName Name with which the model was registered
+ *  \param bodyUndergoingTorque Name of the body undergoing the torque
+ *  \param bodyExertingTorque Name of the body exerting the torque
+ *  \param modelParameters Parameters from which the model instance is created
+ *  \return Torque settings
+ */
+inline std::shared_ptr< TorqueSettings > pluginTorqueSettings(
+        const SystemOfBodies& bodies,
+        const std::string& modelName,
+        const std::string& bodyUndergoingTorque,
+        const std::string& bodyExertingTorque,
+        const std::vector< double >& modelParameters = std::vector< double >( ) )
+{
+    std::shared_ptr< plugins::PluginModelInstance > modelInstance =
+            plugins::getModelPluginRegistry( ).createModelInstance(
+                modelName, TUDATPY_PLUGIN_TORQUE, modelParameters );
+    std::shared_ptr< Body > bodyUndergoing = bodies.at( bodyUndergoingTorque );
+    std::shared_ptr< Body > bodyExerting = bodies.at( bodyExertingTorque );
+    return customTorqueSettings( [ = ]( const double currentTime )
+    {
+        return modelInstance->evaluate( getPluginModelInput( currentTime, bodyUndergoing, bodyExerting, true ) );
+    }, nullptr );
+}
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDATPY_PLUGIN_MODEL_SETTINGS_H
@@ -0,0 +1,378 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_PROPAGATION_CHECKPOINT_H
+#define TUDATPY_PROPAGATION_CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudatpy/math/denseOutputIntegrator.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Identifier at the start of each propagation checkpoint file
+static const char propagationCheckpointIdentifier[ 8 ] = { 'T', 'P', 'Y', 'C', 'K', 'P', 'T', '\0' };
+
+//! Identifier at the end of each (complete) checkpoint record in a propagation checkpoint file
+static const char propagationCheckpointRecordEnd[ 8 ] = { 'T', 'P', 'Y', 'R', 'E', 'C', 'E', '\0' };
+
+//! Version of the propagation checkpoint file format
+static const std::uint32_t propagationCheckpointVersion = 2;
+
+//! Function to write a single (trivially copyable) value to a binary checkpoint file
+template< typename ValueType >
+void writeCheckpointValue( std::ofstream& checkpointFile, const ValueType& value )
+{
+    checkpointFile.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+}
+
+//! Function to read a single (trivially copyable) value from a binary checkpoint file (returning false if truncated)
+template< typename ValueType >
+bool readCheckpointValue( std::ifstream& checkpointFile, ValueType& value )
+{
+    return static_cast< bool >( checkpointFile.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) ) );
+}
+
+//! Function to read a single (trivially copyable) value from the header of a binary checkpoint file
+template< typename ValueType >
+ValueType readCheckpointHeaderValue( std::ifstream& checkpointFile )
+{
+    ValueType value;
+    if( !readCheckpointValue( checkpointFile, value ) )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, file is truncated." );
+    }
+    return value;
+}
+
+//! Function to write a (fixed- or dynamic-size) vector to a binary checkpoint file (without its size)
+template< typename VectorType >
+void writeCheckpointVector( std::ofstream& checkpointFile, const VectorType& vector )
+{
+    checkpointFile.write( reinterpret_cast< const char* >( vector.data( ) ), vector.rows( ) * sizeof( double ) );
+}
+
+//! Function to read a vector of known size from a binary checkpoint file (returning false if truncated)
+inline bool readCheckpointVector( std::ifstream& checkpointFile, const std::uint32_t vectorSize, Eigen::VectorXd& vector )
+{
+    vector.resize( vectorSize );
+    return static_cast< bool >(
+                checkpointFile.read( reinterpret_cast< char* >( vector.data( ) ), vectorSize * sizeof( double ) ) );
+}
+
+//! Class to write checkpoints of a propagation with the dense output integrator to a binary file
+/*!
+ *  Class to write checkpoints of a propagation with the dense output integrator to a binary file, from which the
+ *  propagation can be resumed exactly (see readPropagationCheckpoint). The file starts with a header, containing the
+ *  state size and the initial epoch and output epochs of the propagation (which are verified when resuming), followed
+ *  by one record per checkpoint. Each record contains the (raw) states at the output epochs reached since the previous
+ *  record, and the integrator state (epoch, state, state derivative, step size and step control data), such that the
+ *  cost of writing a checkpoint does not grow with the length of the propagation. The first checkpoint (with the full
+ *  state history so far, e.g. when resuming) is written under a temporary name and then renamed, so that an
+ *  interruption while writing does not corrupt an existing checkpoint; subsequent records are appended, and a record
+ *  that was only partially written when the propagation was interrupted is ignored when reading.
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+class PropagationCheckpointWriter
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param checkpointFilePath Path of the checkpoint file
+     *  \param initialTime Initial epoch of the propagation
+     *  \param outputEpochs Output epochs of the propagation
+     */
+    PropagationCheckpointWriter( const std::string& checkpointFilePath,
+                                 const TimeType initialTime,
+                                 const std::vector< TimeType >& outputEpochs ):
+        checkpointFilePath_( checkpointFilePath ), initialTime_( initialTime ), outputEpochs_( outputEpochs ),
+        isFileCreated_( false ), numberOfWrittenOutputs_( 0 ){ }
+
+    //! Function to write a checkpoint
+    /*!
+     *  Function to write a checkpoint, creating the checkpoint file (with the states at all output epochs reached so far)
+     *  on the first call, and appending a record with the states at the output epochs reached since the previous call
+     *  otherwise.
+     *  \param integratorState Current state of the integrator
+     *  \param rawStateHistory (Raw) states at the output epochs reached so far
+     */
+    void writeCheckpoint( const numerical_integrators::DenseOutputIntegratorState< StateType, TimeType >& integratorState,
+                          const std::map< TimeType, Eigen::VectorXd >& rawStateHistory )
+    {
+        if( !isFileCreated_ )
+        {
+            const std::string temporaryFilePath = checkpointFilePath_ + ".tmp";
+            {
+                std::ofstream checkpointFile( temporaryFilePath, std::ios::binary | std::ios::trunc );
+                if( !checkpointFile.is_open( ) )
+                {
+                    throw std::runtime_error( "Error when writing propagation checkpoint, could not open file " +
+                                              temporaryFilePath + "." );
+                }
+                writeHeader( checkpointFile, static_cast< std::uint32_t >( integratorState.currentState_.rows( ) ) );
+                writeRecord( checkpointFile, integratorState, rawStateHistory, 0 );
+                if( !checkpointFile.good( ) )
+                {
+                    throw std::runtime_error( "Error when writing propagation checkpoint to file " + temporaryFilePath + "." );
+                }
+            }
+
+            if( std::rename( temporaryFilePath.c_str( ), checkpointFilePath_.c_str( ) ) != 0 )
+            {
+                // Renaming onto an existing file fails on some platforms
+                std::remove( checkpointFilePath_.c_str( ) );
+                if( std::rename( temporaryFilePath.c_str( ), checkpointFilePath_.c_str( ) ) != 0 )
+                {
+                    throw std::runtime_error( "Error when writing propagation checkpoint, could not rename " +
+                                              temporaryFilePath + " to " + checkpointFilePath_ + "." );
+                }
+            }
+            isFileCreated_ = true;
+        }
+        else
+        {
+            std::ofstream checkpointFile( checkpointFilePath_, std::ios::binary | std::ios::app );
+            if( !checkpointFile.is_open( ) )
+            {
+                throw std::runtime_error( "Error when writing propagation checkpoint, could not open file " +
+                                          checkpointFilePath_ + "." );
+            }
+            writeRecord( checkpointFile, integratorState, rawStateHistory, numberOfWrittenOutputs_ );
+            checkpointFile.flush( );
+            if( !checkpointFile.good( ) )
+            {
+                throw std::runtime_error( "Error when writing propagation checkpoint to file " + checkpointFilePath_ + "." );
+            }
+        }
+        numberOfWrittenOutputs_ = integratorState.outputIndex_;
+    }
+
+private:
+
+    //! Function to write the header of the checkpoint file
+    void writeHeader( std::ofstream& checkpointFile, const std::uint32_t stateSize )
+    {
+        checkpointFile.write( propagationCheckpointIdentifier, sizeof( propagationCheckpointIdentifier ) );
+        writeCheckpointValue( checkpointFile, propagationCheckpointVersion );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint32_t >( sizeof( TimeType ) ) );
+        writeCheckpointValue( checkpointFile, stateSize );
+
+        writeCheckpointValue( checkpointFile, initialTime_ );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint64_t >( outputEpochs_.size( ) ) );
+        writeCheckpointValue( checkpointFile, outputEpochs_.size( ) > 0 ? outputEpochs_.back( ) : initialTime_ );
+    }
+
+    //! Function to write a record, with the states at the output epochs from the given index up to the current one
+    void writeRecord( std::ofstream& checkpointFile,
+                      const numerical_integrators::DenseOutputIntegratorState< StateType, TimeType >& integratorState,
+                      const std::map< TimeType, Eigen::VectorXd >& rawStateHistory,
+                      const unsigned int firstOutputIndex )
+    {
+        std::vector< TimeType > newOutputEpochs;
+        for( unsigned int i = firstOutputIndex; i < integratorState.outputIndex_; i++ )
+        {
+            if( rawStateHistory.count( outputEpochs_.at( i ) ) > 0 )
+            {
+                newOutputEpochs.push_back( outputEpochs_.at( i ) );
+            }
+        }
+        writeCheckpointValue( checkpointFile, static_cast< std::uint64_t >( newOutputEpochs.size( ) ) );
+        for( const TimeType outputEpoch : newOutputEpochs )
+        {
+            writeCheckpointValue( checkpointFile, outputEpoch );
+            writeCheckpointVector( checkpointFile, rawStateHistory.at( outputEpoch ) );
+        }
+
+        writeCheckpointValue( checkpointFile, integratorState.currentTime_ );
+        writeCheckpointValue( checkpointFile, integratorState.stepSize_ );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint8_t >( integratorState.lastStepRejected_ ) );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint32_t >( integratorState.outputIndex_ ) );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint32_t >( integratorState.numberOfAcceptedSteps_ ) );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint32_t >( integratorState.numberOfRejectedSteps_ ) );
+        writeCheckpointValue( checkpointFile, static_cast< std::uint32_t >( integratorState.numberOfFunctionEvaluations_ ) );
+        writeCheckpointVector( checkpointFile, integratorState.currentState_ );
+        writeCheckpointVector( checkpointFile, integratorState.currentStateDerivative_ );
+        checkpointFile.write( propagationCheckpointRecordEnd, sizeof( propagationCheckpointRecordEnd ) );
+    }
+
+    //! Path of the checkpoint file
+    std::string checkpointFilePath_;
+
+    //! Initial epoch of the propagation
+    TimeType initialTime_;
+
+    //! Output epochs of the propagation
+    std::vector< TimeType > outputEpochs_;
+
+    //! Boolean denoting whether the checkpoint file has been created (after which records are appended)
+    bool isFileCreated_;
+
+    //! Number of output epochs of which the states have been written
+    unsigned int numberOfWrittenOutputs_;
+};
+
+//! Function to read a single checkpoint record from a binary file (returning false if the record is incomplete)
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+bool readPropagationCheckpointRecord(
+        std::ifstream& checkpointFile,
+        const std::uint32_t stateSize,
+        numerical_integrators::DenseOutputIntegratorState< StateType, TimeType >& integratorState,
+        std::map< TimeType, Eigen::VectorXd >& newRawStates )
+{
+    std::uint64_t numberOfStates;
+    if( !readCheckpointValue( checkpointFile, numberOfStates ) )
+    {
+        return false;
+    }
+    for( std::uint64_t i = 0; i < numberOfStates; i++ )
+    {
+        TimeType currentTime;
+        Eigen::VectorXd currentState;
+        if( !readCheckpointValue( checkpointFile, currentTime ) ||
+                !readCheckpointVector( checkpointFile, stateSize, currentState ) )
+        {
+            return false;
+        }
+        newRawStates[ currentTime ] = currentState;
+    }
+
+    std::uint8_t lastStepRejected;
+    std::uint32_t outputIndex, numberOfAcceptedSteps, numberOfRejectedSteps, numberOfFunctionEvaluations;
+    Eigen::VectorXd currentState, currentStateDerivative;
+    char recordEnd[ sizeof( propagationCheckpointRecordEnd ) ];
+    if( !readCheckpointValue( checkpointFile, integratorState.currentTime_ ) ||
+            !readCheckpointValue( checkpointFile, integratorState.stepSize_ ) ||
+            !readCheckpointValue( checkpointFile, lastStepRejected ) ||
+            !readCheckpointValue( checkpointFile, outputIndex ) ||
+            !readCheckpointValue( checkpointFile, numberOfAcceptedSteps ) ||
+            !readCheckpointValue( checkpointFile, numberOfRejectedSteps ) ||
+            !readCheckpointValue( checkpointFile, numberOfFunctionEvaluations ) ||
+            !readCheckpointVector( checkpointFile, stateSize, currentState ) ||
+            !readCheckpointVector( checkpointFile, stateSize, currentStateDerivative ) ||
+            !checkpointFile.read( recordEnd, sizeof( recordEnd ) ) ||
+            std::memcmp( recordEnd, propagationCheckpointRecordEnd, sizeof( recordEnd ) ) != 0 )
+    {
+        return false;
+    }
+    integratorState.lastStepRejected_ = ( lastStepRejected != 0 );
+    integratorState.outputIndex_ = outputIndex;
+    integratorState.numberOfAcceptedSteps_ = numberOfAcceptedSteps;
+    integratorState.numberOfRejectedSteps_ = numberOfRejectedSteps;
+    integratorState.numberOfFunctionEvaluations_ = numberOfFunctionEvaluations;
+    integratorState.currentState_ = currentState;
+    integratorState.currentStateDerivative_ = currentStateDerivative;
+    return true;
+}
+
+//! Function to read a checkpoint of a propagation with the dense output integrator from a binary file
+/*!
+ *  Function to read a checkpoint of a propagation with the dense output integrator from a binary file (see
+ *  PropagationCheckpointWriter), verifying that it was written for a propagation with the same initial epoch, output
+ *  epochs and state size. The integrator state of the last complete record is returned, with the states of all
+ *  complete records; an incomplete record at the end of the file (written when the propagation was interrupted) is
+ *  ignored.
+ *  \param checkpointFilePath Path of the checkpoint file
+ *  \param initialTime Initial epoch of the propagation
+ *  \param outputEpochs Output epochs of the propagation
+ *  \param stateSize Size of the (raw) propagated state
+ *  \param integratorState Saved state of the integrator (returned by reference)
+ *  \param rawStateHistory (Raw) states at the output epochs reached before the checkpoint (returned by reference)
+ */
+template< typename StateType = Eigen::VectorXd, typename TimeType = double >
+void readPropagationCheckpoint(
+        const std::string& checkpointFilePath,
+        const TimeType initialTime,
+        const std::vector< TimeType >& outputEpochs,
+        const unsigned int stateSize,
+        numerical_integrators::DenseOutputIntegratorState< StateType, TimeType >& integratorState,
+        std::map< TimeType, Eigen::VectorXd >& rawStateHistory )
+{
+    std::ifstream checkpointFile( checkpointFilePath, std::ios::binary );
+    if( !checkpointFile.is_open( ) )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, could not open file " + checkpointFilePath + "." );
+    }
+
+    char identifier[ sizeof( propagationCheckpointIdentifier ) ];
+    if( !checkpointFile.read( identifier, sizeof( identifier ) ) ||
+            std::memcmp( identifier, propagationCheckpointIdentifier, sizeof( identifier ) ) != 0 )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, " + checkpointFilePath +
+                                  " is not a checkpoint file." );
+    }
+    const std::uint32_t version = readCheckpointHeaderValue< std::uint32_t >( checkpointFile );
+    if( version != propagationCheckpointVersion )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, file version " + std::to_string( version ) +
+                                  " is not supported." );
+    }
+    if( readCheckpointHeaderValue< std::uint32_t >( checkpointFile ) != sizeof( TimeType ) )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, file was written with a different time type." );
+    }
+    if( readCheckpointHeaderValue< std::uint32_t >( checkpointFile ) != stateSize )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, file was written for a different state size." );
+    }
+
+    const TimeType checkpointInitialTime = readCheckpointHeaderValue< TimeType >( checkpointFile );
+    const std::uint64_t checkpointNumberOfOutputEpochs = readCheckpointHeaderValue< std::uint64_t >( checkpointFile );
+    const TimeType checkpointFinalEpoch = readCheckpointHeaderValue< TimeType >( checkpointFile );
+    if( !( checkpointInitialTime == initialTime ) || checkpointNumberOfOutputEpochs != outputEpochs.size( ) ||
+            !( checkpointFinalEpoch == ( outputEpochs.size( ) > 0 ? outputEpochs.back( ) : initialTime ) ) )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, file was written for a propagation with "
+                                  "different initial epoch or output epochs." );
+    }
+
+    // Read all complete records, of which the states are accumulated, and the last integrator state is kept
+    rawStateHistory.clear( );
+    bool isRecordRead = false;
+    numerical_integrators::DenseOutputIntegratorState< StateType, TimeType > recordIntegratorState;
+    std::map< TimeType, Eigen::VectorXd > newRawStates;
+    while( readPropagationCheckpointRecord( checkpointFile, stateSize, recordIntegratorState, newRawStates ) )
+    {
+        integratorState = recordIntegratorState;
+        rawStateHistory.insert( newRawStates.begin( ), newRawStates.end( ) );
+        newRawStates.clear( );
+        isRecordRead = true;
+    }
+    if( !isRecordRead )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, " + checkpointFilePath +
+                                  " contains no complete checkpoint." );
+    }
+
+    if( integratorState.outputIndex_ > outputEpochs.size( ) || rawStateHistory.size( ) > integratorState.outputIndex_ )
+    {
+        throw std::runtime_error( "Error when reading propagation checkpoint, saved states are inconsistent with output epochs." );
+    }
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_PROPAGATION_CHECKPOINT_H
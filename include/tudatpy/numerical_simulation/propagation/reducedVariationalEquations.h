@@ -0,0 +1,367 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_REDUCED_VARIATIONAL_EQUATIONS_H
+#define TUDATPY_REDUCED_VARIATIONAL_EQUATIONS_H
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/math/interpolators/oneDimensionalInterpolator.h"
+#include "tudat/simulation/estimation_setup/createStateDerivativePartials.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+#include "tudat/simulation/propagation_setup/variationalEquationsSolver.h"
+
+#include "tudatpy/numerical_simulation/propagation/denseOutputPropagation.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to check whether a parameter influences the dynamics, according to the state derivative partials
+/*!
+ *  Function to check whether a parameter influences the dynamics, according to the state derivative partials. The
+ *  sensitivity matrix column of a parameter is only non-zero if at least one of the state derivative partials (as
+ *  used by the variational equations) depends on the parameter. The column of any other parameter (such as an
+ *  observation bias or ground station position) is identically zero, and need not be integrated.
+ *  \param parameter Parameter that is to be checked
+ *  \param stateDerivativePartials State derivative partials of the propagated dynamics, per propagated state type
+ *  \return True if the parameter influences the dynamics
+ */
+template< typename ParameterType >
+bool isParameterDynamical(
+        const std::shared_ptr< estimatable_parameters::EstimatableParameter< ParameterType > > parameter,
+        const std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap >& stateDerivativePartials )
+{
+    for( auto stateTypeIterator : stateDerivativePartials )
+    {
+        for( unsigned int i = 0; i < stateTypeIterator.second.size( ); i++ )
+        {
+            for( unsigned int j = 0; j < stateTypeIterator.second.at( i ).size( ); j++ )
+            {
+                if( stateTypeIterator.second.at( i ).at( j )->getParameterPartialFunction( parameter ).second > 0 )
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+//! Function to create the subset of a parameter set that can influence the dynamics
+/*!
+ *  Function to create the subset of a parameter set that can influence the dynamics (see isParameterDynamical). The
+ *  state derivative partials are created for the state derivative models of the propagator settings (without
+ *  propagating the dynamics). The parameter objects are shared between the full and reduced set, and their order is
+ *  retained.
+ *  \param bodies System of bodies in which the dynamics is propagated
+ *  \param integratorSettings Settings for the numerical integrator
+ *  \param propagatorSettings Settings for the propagation of the dynamics
+ *  \param parametersToEstimate Full parameter set
+ *  \return Parameter set containing only the initial state parameters, and the parameters that influence the dynamics
+ */
+inline std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > createDynamicalParameterSet(
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
+        const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+        const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate )
+{
+    numerical_integrators::checkIntegratorSettingsWithoutDenseOutput(
+                integratorSettings, "reduced variational equations solver" );
+    SingleArcDynamicsSimulator< double, double > dynamicsSimulator(
+                bodies, integratorSettings, propagatorSettings, false );
+    std::map< IntegratedStateType, orbit_determination::StateDerivativePartialsMap > stateDerivativePartials =
+            simulation_setup::createStateDerivativePartials< double, double >(
+                dynamicsSimulator.getDynamicsStateDerivative( )->getStateDerivativeModels( ), bodies,
+                parametersToEstimate );
+
+    std::vector< std::shared_ptr< estimatable_parameters::EstimatableParameter< double > > > dynamicalDoubleParameters;
+    for( auto parameter : parametersToEstimate->getEstimatedDoubleParameters( ) )
+    {
+        if( isParameterDynamical( parameter, stateDerivativePartials ) )
+        {
+            dynamicalDoubleParameters.push_back( parameter );
+        }
+    }
+
+    std::vector< std::shared_ptr< estimatable_parameters::EstimatableParameter< Eigen::VectorXd > > > dynamicalVectorParameters;
+    for( auto parameter : parametersToEstimate->getEstimatedVectorParameters( ) )
+    {
+        if( isParameterDynamical( parameter, stateDerivativePartials ) )
+        {
+            dynamicalVectorParameters.push_back( parameter );
+        }
+    }
+
+    return std::make_shared< estimatable_parameters::EstimatableParameterSet< double > >(
+                dynamicalDoubleParameters, dynamicalVectorParameters,
+                parametersToEstimate->getEstimatedInitialStateParameters( ) );
+}
+
+//! Function to retrieve the indices in the full parameter vector of the entries of the reduced parameter vector
+/*!
+ *  Function to retrieve the indices in the full parameter vector of the entries of the parameter vector of a reduced
+ *  parameter set, created by createDynamicalParameterSet.
+ *  \param parametersToEstimate Full parameter set
+ *  \param dynamicalParametersToEstimate Reduced parameter set, sharing its parameter objects with the full set
+ *  \return Index in the full parameter vector of each entry of the reduced parameter vector
+ */
+inline std::vector< int > getDynamicalParameterIndices(
+        const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate,
+        const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > dynamicalParametersToEstimate )
+{
+    std::vector< int > dynamicalParameterIndices;
+    int currentIndex = 0;
+    for( ; currentIndex < parametersToEstimate->getInitialDynamicalStateParameterSize( ); currentIndex++ )
+    {
+        dynamicalParameterIndices.push_back( currentIndex );
+    }
+
+    const auto& dynamicalDoubleParameters = dynamicalParametersToEstimate->getEstimatedDoubleParameters( );
+    for( auto parameter : parametersToEstimate->getEstimatedDoubleParameters( ) )
+    {
+        if( std::find( dynamicalDoubleParameters.begin( ), dynamicalDoubleParameters.end( ), parameter ) !=
+                dynamicalDoubleParameters.end( ) )
+        {
+            dynamicalParameterIndices.push_back( currentIndex );
+        }
+        currentIndex++;
+    }
+
+    const auto& dynamicalVectorParameters = dynamicalParametersToEstimate->getEstimatedVectorParameters( );
+    for( auto parameter : parametersToEstimate->getEstimatedVectorParameters( ) )
+    {
+        const int parameterSize = parameter->getParameterSize( );
+        if( std::find( dynamicalVectorParameters.begin( ), dynamicalVectorParameters.end( ), parameter ) !=
+                dynamicalVectorParameters.end( ) )
+        {
+            for( int i = 0; i < parameterSize; i++ )
+            {
+                dynamicalParameterIndices.push_back( currentIndex + i );
+            }
+        }
+        currentIndex += parameterSize;
+    }
+    return dynamicalParameterIndices;
+}
+
+//! Interpolator that returns the state transition or (expanded) sensitivity matrix of a reduced parameter set
+/*!
+ *  Interpolator that returns the state transition matrix of a reduced parameter set, or its sensitivity matrix
+ *  expanded to the full parameter set (with zero columns for the parameters that are not in the reduced set). Only
+ *  the requested matrix is interpolated. The interpolators are retrieved from the interface of the reduced set in each
+ *  call, such that they remain valid when the variational equations are re-integrated. No data is stored between
+ *  calls, such that the interpolator can be used concurrently (if the interpolators of the reduced set can).
+ */
+class ExpandedVariationalMatrixInterpolator: public interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param reducedInterface Interface of the variational equations of the reduced parameter set
+     *  \param dynamicalParameterIndices Index in the full parameter vector of each entry of the reduced parameter vector
+     *  \param fullParameterSize Size of the full parameter vector
+     *  \param returnSensitivityMatrix Boolean denoting whether the (expanded) sensitivity matrix, or the state transition
+     *  matrix is returned
+     */
+    ExpandedVariationalMatrixInterpolator(
+            const std::shared_ptr< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > reducedInterface,
+            const std::vector< int >& dynamicalParameterIndices,
+            const int fullParameterSize,
+            const bool returnSensitivityMatrix ):
+        reducedInterface_( reducedInterface ), dynamicalParameterIndices_( dynamicalParameterIndices ),
+        fullParameterSize_( fullParameterSize ), returnSensitivityMatrix_( returnSensitivityMatrix ){ }
+
+    using interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd >::interpolate;
+
+    //! Function to interpolate the (expanded) matrix at a given epoch
+    Eigen::MatrixXd interpolate( const double targetIndependentVariableValue )
+    {
+        if( !returnSensitivityMatrix_ )
+        {
+            return reducedInterface_->getStateTransitionMatrixInterpolator( )->interpolate( targetIndependentVariableValue );
+        }
+
+        const int stateTransitionMatrixSize = reducedInterface_->getStateTransitionMatrixSize( );
+        Eigen::MatrixXd expandedSensitivityMatrix =
+                Eigen::MatrixXd::Zero( stateTransitionMatrixSize, fullParameterSize_ - stateTransitionMatrixSize );
+        if( dynamicalParameterIndices_.size( ) > static_cast< unsigned int >( stateTransitionMatrixSize ) )
+        {
+            const Eigen::MatrixXd reducedSensitivityMatrix =
+                    reducedInterface_->getSensitivityMatrixInterpolator( )->interpolate( targetIndependentVariableValue );
+            for( unsigned int i = stateTransitionMatrixSize; i < dynamicalParameterIndices_.size( ); i++ )
+            {
+                expandedSensitivityMatrix.col( dynamicalParameterIndices_.at( i ) - stateTransitionMatrixSize ) =
+                        reducedSensitivityMatrix.col( i - stateTransitionMatrixSize );
+            }
+        }
+        return expandedSensitivityMatrix;
+    }
+
+private:
+
+    //! Interface of the variational equations of the reduced parameter set
+    std::shared_ptr< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > reducedInterface_;
+
+    //! Index in the full parameter vector of each entry of the reduced parameter vector
+    std::vector< int > dynamicalParameterIndices_;
+
+    //! Size of the full parameter vector
+    int fullParameterSize_;
+
+    //! Boolean denoting whether the (expanded) sensitivity matrix, or the state transition matrix is returned
+    bool returnSensitivityMatrix_;
+};
+
+//! Single-arc variational equations solver that only integrates the sensitivity to parameters that influence the dynamics
+/*!
+ *  Single-arc variational equations solver that only integrates the sensitivity to parameters that influence the
+ *  dynamics (see isParameterDynamical). The variational equations are solved for the reduced parameter set, while the
+ *  interface returned by getFullStateTransitionInterface provides the state transition and sensitivity matrices for the
+ *  full parameter set (with zero sensitivity to the parameters that were removed). The parameter vector passed to
+ *  resetParameterEstimate is that of the full parameter set, such that the solver can replace a solver for the full
+ *  parameter set (as done by the ExtendedOrbitDeterminationManager).
+ */
+class ReducedSingleArcVariationalEquationsSolver: public SingleArcVariationalEquationsSolver< double, double >
+{
+public:
+
+    //! Constructor, see SingleArcVariationalEquationsSolver (with parametersToEstimate the full parameter set)
+    ReducedSingleArcVariationalEquationsSolver(
+            const simulation_setup::SystemOfBodies& bodies,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+            const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate,
+            const bool integrateDynamicalAndVariationalEquationsConcurrently = true,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > variationalOnlyIntegratorSettings =
+            std::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ),
+            const bool clearNumericalSolution = false,
+            const bool integrateEquationsOnCreation = true,
+            const bool setIntegratedResult = false ):
+        ReducedSingleArcVariationalEquationsSolver(
+            bodies, integratorSettings, propagatorSettings, parametersToEstimate,
+            createDynamicalParameterSet( bodies, integratorSettings, propagatorSettings, parametersToEstimate ),
+            integrateDynamicalAndVariationalEquationsConcurrently, variationalOnlyIntegratorSettings,
+            clearNumericalSolution, integrateEquationsOnCreation, setIntegratedResult ){ }
+
+    //! Function to retrieve the full parameter set
+    std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > getFullParametersToEstimate( )
+    {
+        return fullParametersToEstimate_;
+    }
+
+    //! Function to reset the values of the full parameter set, and re-integrate the (reduced) equations
+    /*!
+     *  Function to reset the values of the full parameter set, and re-integrate the dynamics and (if requested) the
+     *  variational equations of the reduced parameter set.
+     *  \param newParameterEstimate New values of the full parameter vector
+     *  \param areVariationalEquationsToBeIntegrated Boolean denoting whether the variational equations are integrated
+     */
+    void resetParameterEstimate( const Eigen::VectorXd newParameterEstimate,
+                                 const bool areVariationalEquationsToBeIntegrated = true )
+    {
+        fullParametersToEstimate_->template resetParameterValues< double >( newParameterEstimate );
+        SingleArcVariationalEquationsSolver< double, double >::resetParameterEstimate(
+                    getReducedParameterVector( newParameterEstimate ), areVariationalEquationsToBeIntegrated );
+    }
+
+    //! Function to reset the values of the full parameter set, and re-integrate the (reduced) variational equations
+    void resetFullParameterEstimate( const Eigen::VectorXd& newParameterEstimate )
+    {
+        resetParameterEstimate( newParameterEstimate );
+    }
+
+    //! Function to select the entries of the reduced parameter vector from a full parameter vector
+    Eigen::VectorXd getReducedParameterVector( const Eigen::VectorXd& fullParameterVector )
+    {
+        Eigen::VectorXd reducedParameterVector( dynamicalParameterIndices_.size( ) );
+        for( unsigned int i = 0; i < dynamicalParameterIndices_.size( ); i++ )
+        {
+            reducedParameterVector( i ) = fullParameterVector( dynamicalParameterIndices_.at( i ) );
+        }
+        return reducedParameterVector;
+    }
+
+    //! Function to retrieve the interface providing the state transition and sensitivity matrices for the full parameter set
+    std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > getFullStateTransitionInterface( )
+    {
+        return fullStateTransitionInterface_;
+    }
+
+    //! Function to retrieve the number of parameters for which the sensitivity is not integrated
+    int getNumberOfRemovedParameters( )
+    {
+        return fullParametersToEstimate_->getEstimatedParameterSetSize( ) - static_cast< int >( dynamicalParameterIndices_.size( ) );
+    }
+
+private:
+
+    //! Constructor, with the reduced parameter set created by createDynamicalParameterSet
+    ReducedSingleArcVariationalEquationsSolver(
+            const simulation_setup::SystemOfBodies& bodies,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > integratorSettings,
+            const std::shared_ptr< PropagatorSettings< double > > propagatorSettings,
+            const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate,
+            const std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > dynamicalParametersToEstimate,
+            const bool integrateDynamicalAndVariationalEquationsConcurrently,
+            const std::shared_ptr< numerical_integrators::IntegratorSettings< double > > variationalOnlyIntegratorSettings,
+            const bool clearNumericalSolution,
+            const bool integrateEquationsOnCreation,
+            const bool setIntegratedResult ):
+        SingleArcVariationalEquationsSolver< double, double >(
+            bodies, integratorSettings, propagatorSettings, dynamicalParametersToEstimate,
+            integrateDynamicalAndVariationalEquationsConcurrently, variationalOnlyIntegratorSettings,
+            clearNumericalSolution, integrateEquationsOnCreation, setIntegratedResult ),
+        fullParametersToEstimate_( parametersToEstimate ),
+        dynamicalParameterIndices_( getDynamicalParameterIndices( parametersToEstimate, dynamicalParametersToEstimate ) )
+    {
+        std::shared_ptr< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface > reducedInterface =
+                std::dynamic_pointer_cast< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                    this->getStateTransitionMatrixInterface( ) );
+        if( reducedInterface == nullptr )
+        {
+            throw std::runtime_error( "Error when creating reduced variational equations solver, single-arc state transition interface expected." );
+        }
+
+        const int fullParameterSize = fullParametersToEstimate_->getEstimatedParameterSetSize( );
+        fullStateTransitionInterface_ = std::make_shared< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                    std::make_shared< ExpandedVariationalMatrixInterpolator >(
+                        reducedInterface, dynamicalParameterIndices_, fullParameterSize, false ),
+                    std::make_shared< ExpandedVariationalMatrixInterpolator >(
+                        reducedInterface, dynamicalParameterIndices_, fullParameterSize, true ),
+                    fullParametersToEstimate_->getInitialDynamicalStateParameterSize( ), fullParameterSize );
+    }
+
+    //! Full parameter set
+    std::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > fullParametersToEstimate_;
+
+    //! Index in the full parameter vector of each entry of the reduced parameter vector
+    std::vector< int > dynamicalParameterIndices_;
+
+    //! Interface providing the state transition and sensitivity matrices for the full parameter set
+    std::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > fullStateTransitionInterface_;
+};
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_REDUCED_VARIATIONAL_EQUATIONS_H
@@ -0,0 +1,422 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_STATE_DERIVATIVE_PROFILING_H
+#define TUDATPY_STATE_DERIVATIVE_PROFILING_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "tudat/astro/aerodynamics/flightConditions.h"
+#include "tudat/simulation/propagation_setup/dynamicsSimulator.h"
+#include "tudat/simulation/propagation_setup/propagationOutput.h"
+
+#include "tudatpy/numerical_simulation/propagation/denseOutputPropagation.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Timing of a single component of the state derivative (acceleration model, environment model, dependent variable)
+class StateDerivativeProfileEntry
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param category Category of the component (e.g. acceleration, ephemeris, dependent_variable)
+     *  \param name Name of the component
+     */
+    StateDerivativeProfileEntry( const std::string& category,
+                                 const std::string& name ):
+        category_( category ), name_( name ), numberOfCalls_( 0 ), totalTime_( 0.0 ){ }
+
+    //! Function to add the (wall-clock) duration of a single call
+    void addCall( const double callDuration )
+    {
+        numberOfCalls_++;
+        totalTime_ += callDuration;
+    }
+
+    //! Function to retrieve the category of the component
+    std::string getCategory( ) const { return category_; }
+
+    //! Function to retrieve the name of the component
+    std::string getName( ) const { return name_; }
+
+    //! Function to retrieve the number of timed calls
+    unsigned long long getNumberOfCalls( ) const { return numberOfCalls_; }
+
+    //! Function to retrieve the total duration of the timed calls
+    double getTotalTime( ) const { return totalTime_; }
+
+    //! Function to retrieve the mean duration of a call
+    double getMeanTime( ) const { return ( numberOfCalls_ == 0 ) ? 0.0 : totalTime_ / static_cast< double >( numberOfCalls_ ); }
+
+private:
+
+    //! Category of the component
+    std::string category_;
+
+    //! Name of the component
+    std::string name_;
+
+    //! Number of timed calls
+    unsigned long long numberOfCalls_;
+
+    //! Total duration of the timed calls
+    double totalTime_;
+};
+
+//! Profile of the computational cost of the components of the state derivative of a propagation
+class StateDerivativeProfile
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param entries Timings of the profiled components
+     *  \param numberOfFunctionEvaluations Number of state derivative evaluations during the profiled propagation
+     *  \param numberOfSteps Number of (accepted) integration steps during the profiled propagation
+     */
+    StateDerivativeProfile( const std::vector< StateDerivativeProfileEntry >& entries,
+                            const unsigned long long numberOfFunctionEvaluations,
+                            const unsigned long long numberOfSteps ):
+        entries_( entries ), numberOfFunctionEvaluations_( numberOfFunctionEvaluations ),
+        numberOfSteps_( numberOfSteps ){ }
+
+    //! Function to retrieve the timings of the profiled components
+    std::vector< StateDerivativeProfileEntry > getEntries( ){ return entries_; }
+
+    //! Function to retrieve the number of state derivative evaluations during the profiled propagation
+    unsigned long long getNumberOfFunctionEvaluations( ){ return numberOfFunctionEvaluations_; }
+
+    //! Function to retrieve the number of (accepted) integration steps during the profiled propagation
+    unsigned long long getNumberOfSteps( ){ return numberOfSteps_; }
+
+    //! Function to retrieve a table of the profiled components, sorted by total time
+    std::string getReport( )
+    {
+        std::vector< StateDerivativeProfileEntry > sortedEntries = entries_;
+        std::stable_sort( sortedEntries.begin( ), sortedEntries.end( ),
+                          [ ]( const StateDerivativeProfileEntry& first, const StateDerivativeProfileEntry& second )
+        {
+            return first.getTotalTime( ) > second.getTotalTime( );
+        } );
+
+        std::ostringstream report;
+        report << "State derivative profile (" << numberOfFunctionEvaluations_ << " function evaluations, "
+               << numberOfSteps_ << " steps)" << std::endl;
+        report << std::left << std::setw( 20 ) << "category" << std::setw( 60 ) << "name"
+               << std::right << std::setw( 14 ) << "calls" << std::setw( 14 ) << "mean [us]"
+               << std::setw( 16 ) << "total [s]" << std::endl;
+        for( const StateDerivativeProfileEntry& entry : sortedEntries )
+        {
+            report << std::left << std::setw( 20 ) << entry.getCategory( ) << std::setw( 60 ) << entry.getName( )
+                   << std::right << std::setw( 14 ) << entry.getNumberOfCalls( )
+                   << std::setw( 14 ) << std::fixed << std::setprecision( 3 ) << entry.getMeanTime( ) * 1.0E6
+                   << std::setw( 16 ) << std::setprecision( 6 ) << entry.getTotalTime( ) << std::endl;
+        }
+        return report.str( );
+    }
+
+private:
+
+    //! Timings of the profiled components
+    std::vector< StateDerivativeProfileEntry > entries_;
+
+    //! Number of state derivative evaluations during the profiled propagation
+    unsigned long long numberOfFunctionEvaluations_;
+
+    //! Number of (accepted) integration steps during the profiled propagation
+    unsigned long long numberOfSteps_;
+};
+
+//! Function to time a single call to a function, and add it to a profile entry
+template< typename ProfiledFunction >
+void addProfiledCall( StateDerivativeProfileEntry& entry, const ProfiledFunction& profiledFunction )
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now( );
+    profiledFunction( );
+    entry.addCall( std::chrono::duration< double >( std::chrono::steady_clock::now( ) - startTime ).count( ) );
+}
+
+//! Function to profile the computational cost of the components of the state derivative of a single-arc propagation
+/*!
+ *  Function to profile the computational cost of the components of the state derivative of a single-arc propagation.
+ *  The equations of motion are integrated again, from the first to the last epoch of the saved state history, with
+ *  the integrator settings of the dynamics simulator, using an instrumented state derivative function (the saved
+ *  results of the dynamics simulator are not modified). Each state derivative evaluation of this propagation is
+ *  timed, after which each model that it evaluated is re-evaluated and timed, at the same time and in the same
+ *  environment (with the time of the acceleration models and flight conditions reset, such that they are recomputed):
+ *  - each acceleration model (translational dynamics)
+ *  - the ephemeris and rotation model of each body involved in the accelerations (except the propagated bodies)
+ *  - the flight conditions (including aerodynamic guidance) and atmosphere of each propagated body
+ *  The given dependent variables are evaluated and timed after each step, as during the propagation. All numbers of
+ *  calls are those measured during the profiled propagation. Models that cache intermediate results for an unchanged
+ *  input (such as the spherical harmonic terms of a gravity field) may be faster on re-evaluation than in the state
+ *  derivative evaluation, the timing of which includes all models and the environment update.
+ *  \param dynamicsSimulator Dynamics simulator with which the equations of motion were integrated
+ *  \param bodies System of bodies used by the dynamics simulator
+ *  \param dependentVariables Settings of the dependent variables that are to be profiled
+ *  \return Profile of the components of the state derivative
+ */
+template< typename TimeType = double >
+StateDerivativeProfile profileStateDerivative(
+        const std::shared_ptr< SingleArcDynamicsSimulator< double, TimeType > > dynamicsSimulator,
+        const simulation_setup::SystemOfBodies& bodies,
+        const std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >& dependentVariables =
+        std::vector< std::shared_ptr< SingleDependentVariableSaveSettings > >( ) )
+{
+    const std::map< TimeType, Eigen::VectorXd >& stateHistory =
+            dynamicsSimulator->getEquationsOfMotionNumericalSolutionRaw( );
+    if( stateHistory.size( ) < 2 )
+    {
+        throw std::runtime_error( "Error when profiling state derivative, no state history is available." );
+    }
+
+    std::shared_ptr< DynamicsStateDerivativeModel< TimeType, double > > stateDerivativeModel =
+            dynamicsSimulator->getDynamicsStateDerivative( );
+
+    // Retrieve acceleration models
+    basic_astrodynamics::AccelerationMap accelerationModels;
+    auto stateDerivativeModels = stateDerivativeModel->getStateDerivativeModels( );
+    if( stateDerivativeModels.count( translational_state ) > 0 )
+    {
+        for( auto singleStateDerivativeModel : stateDerivativeModels.at( translational_state ) )
+        {
+            std::shared_ptr< NBodyStateDerivative< double, TimeType > > nBodyStateDerivative =
+                    std::dynamic_pointer_cast< NBodyStateDerivative< double, TimeType > >( singleStateDerivativeModel );
+            if( nBodyStateDerivative != nullptr )
+            {
+                basic_astrodynamics::AccelerationMap currentAccelerationModels = nBodyStateDerivative->getAccelerationsMap( );
+                accelerationModels.insert( currentAccelerationModels.begin( ), currentAccelerationModels.end( ) );
+            }
+        }
+    }
+
+    // Create profile entries, and the functions re-evaluating the models after each state derivative evaluation
+    std::vector< StateDerivativeProfileEntry > entries;
+    std::vector< std::function< void( const TimeType ) > > profiledFunctions;
+
+    entries.push_back( StateDerivativeProfileEntry( "state_derivative", "full state derivative" ) );
+    profiledFunctions.push_back( nullptr );
+
+    std::set< std::string > bodiesExertingAccelerations;
+    for( auto bodyUndergoingIterator : accelerationModels )
+    {
+        for( auto bodyExertingIterator : bodyUndergoingIterator.second )
+        {
+            bodiesExertingAccelerations.insert( bodyExertingIterator.first );
+            for( unsigned int i = 0; i < bodyExertingIterator.second.size( ); i++ )
+            {
+                std::shared_ptr< basic_astrodynamics::AccelerationModel3d > accelerationModel = bodyExertingIterator.second.at( i );
+                entries.push_back( StateDerivativeProfileEntry(
+                                       "acceleration",
+                                       basic_astrodynamics::getAccelerationModelName(
+                                           basic_astrodynamics::getAccelerationModelType( accelerationModel ) ) +
+                                       " of " + bodyExertingIterator.first + " on " + bodyUndergoingIterator.first ) );
+                profiledFunctions.push_back( [ = ]( const TimeType currentTime )
+                {
+                    accelerationModel->resetTime( TUDAT_NAN );
+                    accelerationModel->updateMembers( static_cast< double >( currentTime ) );
+                    Eigen::Vector3d acceleration = accelerationModel->getAcceleration( );
+                    static_cast< void >( acceleration );
+                } );
+            }
+        }
+    }
+
+    for( const std::string& bodyName : bodiesExertingAccelerations )
+    {
+        if( accelerationModels.count( bodyName ) > 0 || bodies.count( bodyName ) == 0 )
+        {
+            continue;
+        }
+
+        std::shared_ptr< ephemerides::Ephemeris > ephemeris = bodies.at( bodyName )->getEphemeris( );
+        if( ephemeris != nullptr )
+        {
+            entries.push_back( StateDerivativeProfileEntry( "ephemeris", bodyName ) );
+            profiledFunctions.push_back( [ = ]( const TimeType currentTime )
+            {
+                Eigen::Vector6d state = ephemeris->getCartesianState( static_cast< double >( currentTime ) );
+                static_cast< void >( state );
+            } );
+        }
+
+        std::shared_ptr< ephemerides::RotationalEphemeris > rotationModel = bodies.at( bodyName )->getRotationalEphemeris( );
+        if( rotationModel != nullptr )
+        {
+            entries.push_back( StateDerivativeProfileEntry( "rotation", bodyName ) );
+            profiledFunctions.push_back( [ = ]( const TimeType currentTime )
+            {
+                Eigen::Quaterniond rotation = rotationModel->getRotationToTargetFrame( static_cast< double >( currentTime ) );
+                Eigen::Matrix3d rotationDerivative =
+                        rotationModel->getDerivativeOfRotationToTargetFrame( static_cast< double >( currentTime ) );
+                static_cast< void >( rotation );
+                static_cast< void >( rotationDerivative );
+            } );
+        }
+    }
+
+    for( auto bodyUndergoingIterator : accelerationModels )
+    {
+        std::shared_ptr< aerodynamics::FlightConditions > flightConditions =
+                bodies.at( bodyUndergoingIterator.first )->getFlightConditions( );
+        if( flightConditions == nullptr )
+        {
+            continue;
+        }
+
+        entries.push_back( StateDerivativeProfileEntry( "flight_conditions", bodyUndergoingIterator.first ) );
+        profiledFunctions.push_back( [ = ]( const TimeType currentTime )
+        {
+            flightConditions->resetCurrentTime( );
+            flightConditions->updateConditions( static_cast< double >( currentTime ) );
+        } );
+
+        std::shared_ptr< aerodynamics::AtmosphericFlightConditions > atmosphericFlightConditions =
+                std::dynamic_pointer_cast< aerodynamics::AtmosphericFlightConditions >( flightConditions );
+        if( atmosphericFlightConditions != nullptr && atmosphericFlightConditions->getAtmosphereModel( ) != nullptr )
+        {
+            std::shared_ptr< aerodynamics::AtmosphereModel > atmosphereModel = atmosphericFlightConditions->getAtmosphereModel( );
+            entries.push_back( StateDerivativeProfileEntry(
+                                   "atmosphere", flightConditions->getCentralBodyName( ) + " (for " +
+                                   bodyUndergoingIterator.first + ")" ) );
+            profiledFunctions.push_back( [ = ]( const TimeType currentTime )
+            {
+                const double density = atmosphereModel->getDensity(
+                            atmosphericFlightConditions->getCurrentAltitude( ),
+                            atmosphericFlightConditions->getCurrentLongitude( ),
+                            atmosphericFlightConditions->getCurrentGeodeticLatitude( ),
+                            static_cast< double >( currentTime ) );
+                static_cast< void >( density );
+            } );
+        }
+    }
+
+    const unsigned int numberOfModelEntries = static_cast< unsigned int >( entries.size( ) );
+    std::vector< std::function< Eigen::VectorXd( ) > > dependentVariableFunctions;
+    for( unsigned int i = 0; i < dependentVariables.size( ); i++ )
+    {
+        dependentVariableFunctions.push_back(
+                    createDependentVariableListFunction< TimeType, double >(
+                        createDependentVariableSaveSettings( { dependentVariables.at( i ) }, false ), bodies,
+                        stateDerivativeModels ).first );
+        entries.push_back( StateDerivativeProfileEntry(
+                               "dependent_variable", getDependentVariableId( dependentVariables.at( i ) ) ) );
+    }
+
+    // Instrumented state derivative function, timing the state derivative and re-evaluating the models it evaluated
+    unsigned long long numberOfFunctionEvaluations = 0;
+    std::function< Eigen::VectorXd( const TimeType, const Eigen::VectorXd& ) > profiledStateDerivativeFunction =
+            [ & ]( const TimeType currentTime, const Eigen::VectorXd& currentState )
+    {
+        Eigen::VectorXd stateDerivative;
+        addProfiledCall( entries.at( 0 ), [ & ]( )
+        {
+            stateDerivative = stateDerivativeModel->computeStateDerivative( currentTime, currentState );
+        } );
+        numberOfFunctionEvaluations++;
+
+        for( unsigned int i = 1; i < numberOfModelEntries; i++ )
+        {
+            addProfiledCall( entries.at( i ), [ & ]( ){ profiledFunctions.at( i )( currentTime ); } );
+        }
+        return stateDerivative;
+    };
+
+    // Function evaluating the dependent variables after each step, in the environment at the end of the step
+    unsigned long long numberOfSteps = 0;
+    std::function< void( const TimeType, const Eigen::VectorXd& ) > stepFunction =
+            [ & ]( const TimeType currentTime, const Eigen::VectorXd& currentState )
+    {
+        numberOfSteps++;
+        if( dependentVariableFunctions.size( ) > 0 )
+        {
+            stateDerivativeModel->computeStateDerivative( currentTime, currentState );
+            for( unsigned int i = 0; i < dependentVariableFunctions.size( ); i++ )
+            {
+                addProfiledCall( entries.at( numberOfModelEntries + i ), [ & ]( )
+                {
+                    Eigen::VectorXd dependentVariable = dependentVariableFunctions.at( i )( );
+                    static_cast< void >( dependentVariable );
+                } );
+            }
+        }
+    };
+
+    // Integrate the equations of motion with the instrumented state derivative function
+    const TimeType initialTime = stateHistory.begin( )->first;
+    const TimeType finalTime = stateHistory.rbegin( )->first;
+    std::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings =
+            dynamicsSimulator->getIntegratorSettings( );
+    std::shared_ptr< numerical_integrators::DenseOutputIntegratorSettings< TimeType > > denseOutputSettings =
+            std::dynamic_pointer_cast< numerical_integrators::DenseOutputIntegratorSettings< TimeType > >( integratorSettings );
+    if( denseOutputSettings != nullptr )
+    {
+        numerical_integrators::DormandPrinceDenseOutputIntegrator< Eigen::VectorXd, TimeType > integrator(
+                    profiledStateDerivativeFunction,
+                    denseOutputSettings->relativeErrorTolerance_, denseOutputSettings->absoluteErrorTolerance_,
+                    denseOutputSettings->minimumStepSize_, denseOutputSettings->maximumStepSize_,
+                    denseOutputSettings->safetyFactorForNextStepSize_,
+                    denseOutputSettings->maximumFactorIncreaseForNextStepSize_,
+                    denseOutputSettings->minimumFactorDecreaseForNextStepSize_,
+                    denseOutputSettings->throwExceptionIfMinimumStepExceeded_ );
+        integrator.integrateToOutputEpochs(
+                    initialTime, stateHistory.begin( )->second, denseOutputSettings->initialTimeStep_, { finalTime },
+                    [ ]( const unsigned int, const TimeType, const Eigen::VectorXd& ){ },
+                    [ & ]( const numerical_integrators::DenseOutputIntegratorState< Eigen::VectorXd, TimeType >& integratorState )
+        {
+            stepFunction( integratorState.currentTime_, integratorState.currentState_ );
+        } );
+    }
+    else
+    {
+        std::shared_ptr< numerical_integrators::NumericalIntegrator< TimeType, Eigen::VectorXd, Eigen::VectorXd, TimeType > >
+                integrator = numerical_integrators::createIntegrator< TimeType, Eigen::VectorXd >(
+                    profiledStateDerivativeFunction, stateHistory.begin( )->second, integratorSettings );
+        const double direction = ( finalTime < initialTime ) ? -1.0 : 1.0;
+        TimeType stepSize = integratorSettings->initialTimeStep_;
+        while( direction * static_cast< double >( finalTime - integrator->getCurrentIndependentVariable( ) ) > 0.0 )
+        {
+            integrator->performIntegrationStep( stepSize );
+            stepFunction( integrator->getCurrentIndependentVariable( ), integrator->getCurrentState( ) );
+            stepSize = integrator->getNextStepSize( );
+        }
+    }
+
+    // Restore the environment at the final state
+    stateDerivativeModel->computeStateDerivative( stateHistory.rbegin( )->first, stateHistory.rbegin( )->second );
+
+    return StateDerivativeProfile( entries, numberOfFunctionEvaluations, numberOfSteps );
+}
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDATPY_STATE_DERIVATIVE_PROFILING_H
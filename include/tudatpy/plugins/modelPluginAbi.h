@@ -0,0 +1,132 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_MODEL_PLUGIN_ABI_H
+#define TUDATPY_MODEL_PLUGIN_ABI_H
+
+/*
+ *  C interface of shared libraries (plugins) providing natively compiled acceleration and torque models, which are
+ *  loaded at runtime with propagation_setup.load_model_plugin, and used with propagation_setup.acceleration.plugin and
+ *  propagation_setup.torque.plugin. The interface only uses C types, so that plugins do not depend on the compiler,
+ *  standard library or Tudat version with which tudatpy was built. A plugin exports the entry point
+ *
+ *      extern "C" const TudatpyModelPlugin* tudatpy_get_model_plugin( void );
+ *
+ *  returning a pointer to a static description of the models it provides, e.g.:
+ *
+ *      static void* createDrag( const double* parameters, int numberOfParameters )
+ *      { return numberOfParameters == 1 ? new double( parameters[ 0 ] ) : NULL; }
+ *
+ *      static int evaluateDrag( void* instance, const TudatpyPluginModelInput* input, double* acceleration )
+ *      {
+ *          for( int i = 0; i < 3; i++ )
+ *          {
+ *              acceleration[ i ] = -*static_cast< double* >( instance ) * input->stateOfBodyUndergoing[ i + 3 ];
+ *          }
+ *          return 0;
+ *      }
+ *
+ *      static void destroyDrag( void* instance ){ delete static_cast< double* >( instance ); }
+ *
+ *      static const TudatpyPluginModel models[ ] = {
+ *          { "linear_drag", TUDATPY_PLUGIN_ACCELERATION, createDrag, evaluateDrag, destroyDrag } };
+ *      static const TudatpyModelPlugin plugin = { TUDATPY_MODEL_PLUGIN_ABI_VERSION, 1, models };
+ *
+ *      extern "C" TUDATPY_PLUGIN_EXPORT const TudatpyModelPlugin* tudatpy_get_model_plugin( void ){ return &plugin; }
+ *
+ *  The version of the interface is increased whenever any of the types below changes; plugins built for a different
+ *  version are rejected when loading.
+ */
+
+#define TUDATPY_MODEL_PLUGIN_ABI_VERSION 1
+
+#define TUDATPY_MODEL_PLUGIN_ENTRY_POINT "tudatpy_get_model_plugin"
+
+#if defined( _WIN32 )
+#define TUDATPY_PLUGIN_EXPORT __declspec( dllexport )
+#else
+#define TUDATPY_PLUGIN_EXPORT __attribute__( ( visibility( "default" ) ) )
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Types of models that a plugin can provide */
+enum TudatpyPluginModelTypes
+{
+    TUDATPY_PLUGIN_ACCELERATION = 0,
+    TUDATPY_PLUGIN_TORQUE = 1
+};
+
+/* Current environment, passed to a model when it is evaluated */
+typedef struct TudatpyPluginModelInput
+{
+    /* Current time (seconds since J2000) */
+    double time;
+
+    /* Cartesian state of the body undergoing the acceleration/torque, in the global frame */
+    double stateOfBodyUndergoing[ 6 ];
+
+    /* Cartesian state of the body exerting the acceleration/torque, in the global frame */
+    double stateOfBodyExerting[ 6 ];
+
+    /* Quaternion (w, x, y, z) of the rotation from the global frame to the body-fixed frame of the body undergoing */
+    double rotationToBodyFixedFrame[ 4 ];
+
+    /* Angular velocity of the body undergoing, in its body-fixed frame */
+    double angularVelocityInBodyFixedFrame[ 3 ];
+
+    /* Mass of the body undergoing */
+    double massOfBodyUndergoing;
+} TudatpyPluginModelInput;
+
+/* Description of a single model provided by a plugin */
+typedef struct TudatpyPluginModel
+{
+    /* Name with which the model is registered (must be unique over all loaded plugins) */
+    const char* name;
+
+    /* Type of the model (TudatpyPluginModelTypes) */
+    int type;
+
+    /* Function creating an instance of the model from its parameters, returning NULL if the parameters are invalid */
+    void* ( *create )( const double* parameters, int numberOfParameters );
+
+    /* Function computing the acceleration (global frame) or torque (body-fixed frame) of an instance in result (3
+     * elements), returning 0 on success and a non-zero error code otherwise */
+    int ( *evaluate )( void* instance, const TudatpyPluginModelInput* input, double* result );
+
+    /* Function destroying an instance of the model */
+    void ( *destroy )( void* instance );
+} TudatpyPluginModel;
+
+/* Description of all models provided by a plugin */
+typedef struct TudatpyModelPlugin
+{
+    /* Version of the interface with which the plugin was built (TUDATPY_MODEL_PLUGIN_ABI_VERSION) */
+    int abiVersion;
+
+    /* Number of models provided by the plugin */
+    int numberOfModels;
+
+    /* Models provided by the plugin */
+    const TudatpyPluginModel* models;
+} TudatpyModelPlugin;
+
+/* Signature of the entry point of a plugin */
+typedef const TudatpyModelPlugin* ( *TudatpyModelPluginEntryPoint )( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TUDATPY_MODEL_PLUGIN_ABI_H */
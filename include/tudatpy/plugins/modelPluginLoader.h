@@ -0,0 +1,325 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_MODEL_PLUGIN_LOADER_H
+#define TUDATPY_MODEL_PLUGIN_LOADER_H
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "tudatpy/plugins/modelPluginAbi.h"
+
+namespace tudat
+{
+
+namespace plugins
+{
+
+//! Shared library providing acceleration/torque models through the plugin interface (see modelPluginAbi.h)
+/*!
+ *  Shared library providing acceleration/torque models through the plugin interface (see modelPluginAbi.h). The library
+ *  is loaded in the constructor, and unloaded in the destructor; model instances keep a pointer to the library, so that
+ *  it is only unloaded once all instances have been destroyed.
+ */
+class ModelPluginLibrary
+{
+public:
+
+    //! Constructor, loading the library and retrieving its models
+    /*!
+     *  Constructor, loading the library and retrieving its models
+     *  \param libraryPath Path of the shared library
+     */
+    ModelPluginLibrary( const std::string& libraryPath ):
+        libraryPath_( libraryPath )
+    {
+#if defined( _WIN32 )
+        libraryHandle_ = LoadLibraryA( libraryPath.c_str( ) );
+        if( libraryHandle_ == nullptr )
+        {
+            throw std::runtime_error( "Error when loading model plugin " + libraryPath + ", library could not be loaded." );
+        }
+        TudatpyModelPluginEntryPoint entryPoint = reinterpret_cast< TudatpyModelPluginEntryPoint >(
+                    GetProcAddress( libraryHandle_, TUDATPY_MODEL_PLUGIN_ENTRY_POINT ) );
+#else
+        libraryHandle_ = dlopen( libraryPath.c_str( ), RTLD_NOW | RTLD_LOCAL );
+        if( libraryHandle_ == nullptr )
+        {
+            throw std::runtime_error( "Error when loading model plugin " + libraryPath + ", " + std::string( dlerror( ) ) );
+        }
+        TudatpyModelPluginEntryPoint entryPoint = reinterpret_cast< TudatpyModelPluginEntryPoint >(
+                    dlsym( libraryHandle_, TUDATPY_MODEL_PLUGIN_ENTRY_POINT ) );
+#endif
+
+        const TudatpyModelPlugin* plugin = ( entryPoint == nullptr ) ? nullptr : entryPoint( );
+        std::string errorMessage;
+        if( entryPoint == nullptr )
+        {
+            errorMessage = "entry point " + std::string( TUDATPY_MODEL_PLUGIN_ENTRY_POINT ) + " not found.";
+        }
+        else if( plugin == nullptr )
+        {
+            errorMessage = "entry point returned no plugin.";
+        }
+        else if( plugin->abiVersion != TUDATPY_MODEL_PLUGIN_ABI_VERSION )
+        {
+            errorMessage = "plugin was built for interface version " + std::to_string( plugin->abiVersion ) +
+                    ", but version " + std::to_string( TUDATPY_MODEL_PLUGIN_ABI_VERSION ) + " is required.";
+        }
+        else if( plugin->numberOfModels < 0 || ( plugin->numberOfModels > 0 && plugin->models == nullptr ) )
+        {
+            errorMessage = "plugin model list is invalid.";
+        }
+        else
+        {
+            for( int i = 0; i < plugin->numberOfModels; i++ )
+            {
+                const TudatpyPluginModel& currentModel = plugin->models[ i ];
+                if( currentModel.name == nullptr || currentModel.create == nullptr ||
+                        currentModel.evaluate == nullptr || currentModel.destroy == nullptr )
+                {
+                    errorMessage = "model " + std::to_string( i ) + " is incomplete.";
+                    break;
+                }
+                else if( currentModel.type != TUDATPY_PLUGIN_ACCELERATION && currentModel.type != TUDATPY_PLUGIN_TORQUE )
+                {
+                    errorMessage = "model " + std::string( currentModel.name ) + " has unknown type " +
+                            std::to_string( currentModel.type ) + ".";
+                    break;
+                }
+                models_.push_back( currentModel );
+            }
+        }
+
+        if( !errorMessage.empty( ) )
+        {
+            unloadLibrary( );
+            throw std::runtime_error( "Error when loading model plugin " + libraryPath + ", " + errorMessage );
+        }
+    }
+
+    //! Destructor, unloading the library
+    ~ModelPluginLibrary( )
+    {
+        unloadLibrary( );
+    }
+
+    // The library handle is owned by this object
+    ModelPluginLibrary( const ModelPluginLibrary& ) = delete;
+    ModelPluginLibrary& operator=( const ModelPluginLibrary& ) = delete;
+
+    //! Function to retrieve the path of the shared library
+    std::string getLibraryPath( ){ return libraryPath_; }
+
+    //! Function to retrieve the models provided by the library
+    const std::vector< TudatpyPluginModel >& getModels( ){ return models_; }
+
+private:
+
+    void unloadLibrary( )
+    {
+        if( libraryHandle_ != nullptr )
+        {
+#if defined( _WIN32 )
+            FreeLibrary( libraryHandle_ );
+#else
+            dlclose( libraryHandle_ );
+#endif
+            libraryHandle_ = nullptr;
+        }
+    }
+
+    //! Path of the shared library
+    std::string libraryPath_;
+
+    //! Handle of the loaded library
+#if defined( _WIN32 )
+    HMODULE libraryHandle_;
+#else
+    void* libraryHandle_;
+#endif
+
+    //! Models provided by the library
+    std::vector< TudatpyPluginModel > models_;
+};
+
+//! Instance of a plugin model, created from a list of parameters
+class PluginModelInstance
+{
+public:
+
+    //! Constructor, creating the instance
+    /*!
+     *  Constructor, creating the instance
+     *  \param library Library providing the model
+     *  \param model Model of which an instance is to be created
+     *  \param parameters Parameters from which the instance is created
+     */
+    PluginModelInstance( const std::shared_ptr< ModelPluginLibrary > library,
+                         const TudatpyPluginModel& model,
+                         const std::vector< double >& parameters ):
+        library_( library ), model_( model )
+    {
+        instance_ = model_.create( parameters.data( ), static_cast< int >( parameters.size( ) ) );
+        if( instance_ == nullptr )
+        {
+            throw std::runtime_error( "Error when creating plugin model " + std::string( model_.name ) +
+                                      ", model could not be created from the " + std::to_string( parameters.size( ) ) +
+                                      " given parameters." );
+        }
+    }
+
+    //! Destructor, destroying the instance
+    ~PluginModelInstance( )
+    {
+        model_.destroy( instance_ );
+    }
+
+    // The model instance is owned by this object
+    PluginModelInstance( const PluginModelInstance& ) = delete;
+    PluginModelInstance& operator=( const PluginModelInstance& ) = delete;
+
+    //! Function to evaluate the model (acceleration or torque) for the given environment
+    Eigen::Vector3d evaluate( const TudatpyPluginModelInput& input )
+    {
+        Eigen::Vector3d result = Eigen::Vector3d::Zero( );
+        const int errorCode = model_.evaluate( instance_, &input, result.data( ) );
+        if( errorCode != 0 )
+        {
+            throw std::runtime_error( "Error when evaluating plugin model " + std::string( model_.name ) + " at t=" +
+                                      std::to_string( input.time ) + ", model returned error code " +
+                                      std::to_string( errorCode ) + "." );
+        }
+        return result;
+    }
+
+private:
+
+    //! Library providing the model (kept loaded as long as the instance exists)
+    std::shared_ptr< ModelPluginLibrary > library_;
+
+    //! Model of which this is an instance
+    TudatpyPluginModel model_;
+
+    //! Instance created by the model
+    void* instance_;
+};
+
+//! Registry of the models of all loaded plugins
+class ModelPluginRegistry
+{
+public:
+
+    //! Function to load a plugin, and register its models (returning their names)
+    std::vector< std::string > loadPlugin( const std::string& libraryPath )
+    {
+        std::shared_ptr< ModelPluginLibrary > library = std::make_shared< ModelPluginLibrary >( libraryPath );
+
+        std::lock_guard< std::mutex > registryLock( registryMutex_ );
+        std::vector< std::string > modelNames;
+        for( const TudatpyPluginModel& model : library->getModels( ) )
+        {
+            if( registeredModels_.count( model.name ) > 0 ||
+                    std::find( modelNames.begin( ), modelNames.end( ), model.name ) != modelNames.end( ) )
+            {
+                throw std::runtime_error( "Error when loading model plugin " + libraryPath + ", model " +
+                                          std::string( model.name ) + " is already registered." );
+            }
+            modelNames.push_back( model.name );
+        }
+        for( const TudatpyPluginModel& model : library->getModels( ) )
+        {
+            registeredModels_[ model.name ] = std::make_pair( library, model );
+        }
+        return modelNames;
+    }
+
+    //! Function to create an instance of a registered model of the given type
+    std::shared_ptr< PluginModelInstance > createModelInstance(
+            const std::string& modelName,
+            const int modelType,
+            const std::vector< double >& parameters )
+    {
+        std::lock_guard< std::mutex > registryLock( registryMutex_ );
+        auto modelIterator = registeredModels_.find( modelName );
+        if( modelIterator == registeredModels_.end( ) )
+        {
+            throw std::runtime_error( "Error when creating plugin model " + modelName + ", no such model is registered." );
+        }
+        else if( modelIterator->second.second.type != modelType )
+        {
+            throw std::runtime_error( "Error when creating plugin model " + modelName + ", model is not of the requested type." );
+        }
+        return std::make_shared< PluginModelInstance >(
+                    modelIterator->second.first, modelIterator->second.second, parameters );
+    }
+
+    //! Function to retrieve the names of all registered models, with the path of the library providing them
+    std::map< std::string, std::string > getRegisteredModels( )
+    {
+        std::lock_guard< std::mutex > registryLock( registryMutex_ );
+        std::map< std::string, std::string > registeredModelPaths;
+        for( auto modelIterator : registeredModels_ )
+        {
+            registeredModelPaths[ modelIterator.first ] = modelIterator.second.first->getLibraryPath( );
+        }
+        return registeredModelPaths;
+    }
+
+private:
+
+    //! Registered models, with the library providing them (key: model name)
+    std::map< std::string, std::pair< std::shared_ptr< ModelPluginLibrary >, TudatpyPluginModel > > registeredModels_;
+
+    //! Mutex protecting the registered models
+    std::mutex registryMutex_;
+};
+
+//! Function to retrieve the (global) registry of plugin models
+inline ModelPluginRegistry& getModelPluginRegistry( )
+{
+    static ModelPluginRegistry modelPluginRegistry;
+    return modelPluginRegistry;
+}
+
+//! Function to load a plugin, and register its models in the global registry (returning their names)
+inline std::vector< std::string > loadModelPlugin( const std::string& libraryPath )
+{
+    return getModelPluginRegistry( ).loadPlugin( libraryPath );
+}
+
+//! Function to retrieve the names of all models in the global registry, with the path of the library providing them
+inline std::map< std::string, std::string > getRegisteredPluginModels( )
+{
+    return getModelPluginRegistry( ).getRegisteredModels( );
+}
+
+} // namespace plugins
+
+} // namespace tudat
+
+#endif // TUDATPY_MODEL_PLUGIN_LOADER_H
@@ -0,0 +1,63 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+/*
+ *  Model plugin used by tests/test_model_plugins.py. It is built twice: once for the current interface version, and
+ *  once (with TEST_MODEL_PLUGIN_ABI_VERSION defined) for a different version, which tudatpy must reject.
+ */
+
+#include "tudatpy/plugins/modelPluginAbi.h"
+
+#ifndef TEST_MODEL_PLUGIN_ABI_VERSION
+#define TEST_MODEL_PLUGIN_ABI_VERSION TUDATPY_MODEL_PLUGIN_ABI_VERSION
+#endif
+
+namespace
+{
+
+//! Creates an instance holding a constant vector, given as three parameters
+void* createConstantVector( const double* parameters, int numberOfParameters )
+{
+    if( numberOfParameters != 3 )
+    {
+        return nullptr;
+    }
+    return new double[ 3 ]{ parameters[ 0 ], parameters[ 1 ], parameters[ 2 ] };
+}
+
+//! Returns the constant vector
+int evaluateConstantVector( void* instance, const TudatpyPluginModelInput*, double* result )
+{
+    for( int i = 0; i < 3; i++ )
+    {
+        result[ i ] = static_cast< double* >( instance )[ i ];
+    }
+    return 0;
+}
+
+void destroyConstantVector( void* instance )
+{
+    delete[ ] static_cast< double* >( instance );
+}
+
+const TudatpyPluginModel models[ ] = {
+    { "test_constant_acceleration", TUDATPY_PLUGIN_ACCELERATION,
+      createConstantVector, evaluateConstantVector, destroyConstantVector },
+    { "test_constant_torque", TUDATPY_PLUGIN_TORQUE,
+      createConstantVector, evaluateConstantVector, destroyConstantVector } };
+
+const TudatpyModelPlugin plugin = { TEST_MODEL_PLUGIN_ABI_VERSION, 2, models };
+
+}
+
+extern "C" TUDATPY_PLUGIN_EXPORT const TudatpyModelPlugin* tudatpy_get_model_plugin( void )
+{
+    return &plugin;
+}
@@ -0,0 +1,103 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup
+import ctypes
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_end_epoch = 3.0 * 3600.0
+
+c_vector_function_of_time = ctypes.CFUNCTYPE(None, ctypes.c_double, ctypes.POINTER(ctypes.c_double), ctypes.c_void_p)
+c_density_function = ctypes.CFUNCTYPE(
+    ctypes.c_double, ctypes.c_double, ctypes.c_double, ctypes.c_double, ctypes.c_double, ctypes.c_void_p)
+
+reference_density = 1.225
+scale_height = 7.2E3
+
+
+def get_address(c_function):
+    return ctypes.cast(c_function, ctypes.c_void_p).value
+
+
+def python_acceleration(time):
+    return np.array([1.0E-6 * np.cos(1.0E-3 * time), 2.0E-6, -1.0E-6 * np.sin(1.0E-3 * time)])
+
+
+@c_vector_function_of_time
+def c_acceleration(time, acceleration, user_data):
+    # The user data holds the scaling factor of the acceleration
+    scaling_factor = ctypes.cast(user_data, ctypes.POINTER(ctypes.c_double))[0]
+    for i, value in enumerate(python_acceleration(time)):
+        acceleration[i] = scaling_factor * value
+
+
+@c_density_function
+def c_density(altitude, longitude, latitude, time, user_data):
+    return reference_density * np.exp(-altitude / scale_height)
+
+
+def propagate_orbit(body_settings, custom_acceleration, output_variables=None):
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()],
+                                           "Satellite": [custom_acceleration]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([6800.0E3, 0.01, np.deg2rad(50.0), 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(simulation_end_epoch),
+        output_variables=[] if output_variables is None else output_variables)
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(0.0, 10.0)
+    return numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def test_c_function_acceleration_matches_python_acceleration():
+    """ A custom acceleration computed by a C function (with user data) must match the same Python acceleration.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    python_simulator = propagate_orbit(body_settings, propagation_setup.acceleration.custom(python_acceleration))
+
+    # The scaling factor in the user data must be applied by the C function
+    user_data = ctypes.c_double(1.0)
+    c_simulator = propagate_orbit(body_settings, propagation_setup.acceleration.custom(
+        get_address(c_acceleration), user_data=ctypes.addressof(user_data)))
+    python_states = python_simulator.state_history
+    c_states = c_simulator.state_history
+    assert list(c_states.keys()) == list(python_states.keys())
+    for epoch, state in c_states.items():
+        assert np.allclose(state, python_states[epoch], rtol=1.0E-14, atol=1.0E-8)
+
+    user_data.value = 0.0
+    unperturbed_simulator = propagate_orbit(body_settings, propagation_setup.acceleration.custom(
+        get_address(c_acceleration), user_data=ctypes.addressof(user_data)))
+    final_state_difference = unperturbed_simulator.state_history[simulation_end_epoch] - c_states[simulation_end_epoch]
+    assert np.linalg.norm(final_state_difference[:3]) > 1.0
+
+
+def test_c_function_density():
+    """ The density of an atmosphere computed by a C function must match the density function, at the altitudes reached
+    during the propagation.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    body_settings.get("Earth").atmosphere_settings = \
+        environment_setup.atmosphere.custom_four_dimensional_constant_temperature(get_address(c_density), 250.0)
+    dynamics_simulator = propagate_orbit(
+        body_settings, propagation_setup.acceleration.custom(python_acceleration),
+        [propagation_setup.dependent_variable.altitude("Satellite", "Earth"),
+         propagation_setup.dependent_variable.density("Satellite", "Earth")])
+
+    for altitude, density in dynamics_simulator.dependent_variable_history.values():
+        assert density == pytest.approx(reference_density * np.exp(-altitude / scale_height), rel=1.0E-14)
+
+
+def test_null_c_function_address():
+    with pytest.raises(RuntimeError, match="address is null"):
+        propagation_setup.acceleration.custom(0)
+    with pytest.raises(RuntimeError, match="address is null"):
+        environment_setup.atmosphere.custom_four_dimensional_constant_temperature(0, 250.0)
@@ -0,0 +1,77 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup, propagation
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_start_epoch = 0.0
+simulation_end_epoch = 6.0 * 3600.0
+
+
+def propagate_point_mass_orbit(output_variables):
+    """ Propagation of an Earth orbiter under point mass gravity, saving the given dependent variables.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([7000.0E3, 0.01, np.deg2rad(60.0), 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(simulation_end_epoch), output_variables=output_variables)
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(simulation_start_epoch, 30.0)
+    return bodies, numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def create_dependent_variables():
+    return [propagation_setup.dependent_variable.relative_distance("Satellite", "Earth"),
+            propagation_setup.dependent_variable.keplerian_state("Satellite", "Earth"),
+            propagation_setup.dependent_variable.total_acceleration_norm("Satellite")]
+
+
+def test_deferred_dependent_variables_match_propagation():
+    """ Dependent variables evaluated after the propagation must match those computed during the propagation.
+    """
+    bodies, dynamics_simulator = propagate_point_mass_orbit(create_dependent_variables())
+    propagated_history = dynamics_simulator.dependent_variable_history
+
+    deferred_history, deferred_ids = propagation.compute_deferred_dependent_variables(
+        dynamics_simulator, bodies, create_dependent_variables())
+    assert list(deferred_history.keys()) == list(propagated_history.keys())
+    assert sorted(deferred_ids.keys()) == [0, 1, 7]
+    for epoch, dependent_variables in deferred_history.items():
+        assert np.allclose(dependent_variables, propagated_history[epoch], rtol=1.0E-12, atol=1.0E-12)
+
+    strided_history, _ = propagation.compute_deferred_dependent_variables(
+        dynamics_simulator, bodies, create_dependent_variables(), evaluation_stride=10)
+    propagated_epochs = list(propagated_history.keys())
+    expected_epochs = propagated_epochs[::10]
+    if expected_epochs[-1] != propagated_epochs[-1]:
+        expected_epochs.append(propagated_epochs[-1])
+    assert list(strided_history.keys()) == expected_epochs
+    for epoch, dependent_variables in strided_history.items():
+        assert np.allclose(dependent_variables, propagated_history[epoch], rtol=1.0E-12, atol=1.0E-12)
+
+
+def test_deferred_dependent_variables_require_updated_environment():
+    """ A dependent variable requiring environment models that the propagation does not update must be rejected, and
+    accepted when it is also saved during the propagation.
+    """
+    altitude = propagation_setup.dependent_variable.altitude("Satellite", "Earth")
+    bodies, dynamics_simulator = propagate_point_mass_orbit([])
+    with pytest.raises(RuntimeError, match="not updated during the propagation"):
+        propagation.compute_deferred_dependent_variables(dynamics_simulator, bodies, [altitude])
+
+    bodies, dynamics_simulator = propagate_point_mass_orbit([altitude])
+    deferred_history, _ = propagation.compute_deferred_dependent_variables(dynamics_simulator, bodies, [altitude])
+    propagated_history = dynamics_simulator.dependent_variable_history
+    for epoch, dependent_variables in deferred_history.items():
+        assert np.allclose(dependent_variables, propagated_history[epoch], rtol=1.0E-12, atol=0.0)
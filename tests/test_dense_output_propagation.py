@@ -0,0 +1,151 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion, two_body_dynamics
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_start_epoch = 0.0
+output_epochs = [60.0 * i for i in range(1, 24 * 60 + 1)]
+
+
+def create_point_mass_setup(custom_acceleration_function=None, output_variables=None, termination_settings=None):
+    """ Dynamics of an eccentric Earth orbiter under point mass gravity only, for which the solution is a Kepler orbit
+    (unless a custom acceleration is added).
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()]}}
+    if custom_acceleration_function is not None:
+        acceleration_settings["Satellite"]["Satellite"] = [
+            propagation_setup.acceleration.custom(custom_acceleration_function)]
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+
+    gravitational_parameter = bodies.get("Earth").gravitational_parameter
+    initial_kepler_elements = np.array([8000.0E3, 0.1, np.deg2rad(50.0), np.deg2rad(20.0), np.deg2rad(30.0), 0.0])
+    initial_state = element_conversion.keplerian_to_cartesian(initial_kepler_elements, gravitational_parameter)
+    if output_variables is None:
+        output_variables = []
+    if termination_settings is None:
+        termination_settings = propagation_setup.propagator.time_termination(output_epochs[-1])
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state, termination_settings,
+        output_variables=output_variables)
+    return bodies, propagator_settings, initial_kepler_elements, gravitational_parameter
+
+
+def test_dense_output_kepler_orbit_accuracy():
+    """ The states at the output epochs (evaluated with the continuous extension) must match the analytic Kepler orbit.
+    """
+    bodies, propagator_settings, initial_kepler_elements, gravitational_parameter = create_point_mass_setup()
+    integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+        simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12)
+    dynamics_simulator = numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+    state_history = dynamics_simulator.state_history
+    assert list(state_history.keys()) == output_epochs
+    for epoch, state in state_history.items():
+        kepler_elements = two_body_dynamics.propagate_kepler_orbit(
+            initial_kepler_elements, epoch - simulation_start_epoch, gravitational_parameter)
+        expected_state = element_conversion.keplerian_to_cartesian(kepler_elements, gravitational_parameter)
+        assert np.max(np.abs(state[:3] - expected_state[:3])) < 1.0E-2
+        assert np.max(np.abs(state[3:] - expected_state[3:])) < 1.0E-5
+
+
+def test_dense_output_dependent_variables():
+    """ The dependent variables must be computed at the output epochs, from the states at those epochs.
+    """
+    output_variables = [propagation_setup.dependent_variable.relative_distance("Satellite", "Earth"),
+                        propagation_setup.dependent_variable.total_acceleration_norm("Satellite")]
+    bodies, propagator_settings, _, gravitational_parameter = create_point_mass_setup(
+        output_variables=output_variables)
+    integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+        simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12)
+    dynamics_simulator = numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+    state_history = dynamics_simulator.state_history
+    dependent_variable_history = dynamics_simulator.dependent_variable_history
+    assert list(dependent_variable_history.keys()) == output_epochs
+    for epoch, dependent_variables in dependent_variable_history.items():
+        distance = np.linalg.norm(state_history[epoch][:3])
+        assert dependent_variables[0] == pytest.approx(distance, rel=1.0E-12)
+        assert dependent_variables[1] == pytest.approx(gravitational_parameter / distance ** 2, rel=1.0E-12)
+
+
+def test_dense_output_unsupported_termination_settings():
+    """ Termination settings that the dense output integrator cannot honour must be rejected.
+    """
+    integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+        simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12)
+
+    distance_termination = propagation_setup.propagator.dependent_variable_termination(
+        propagation_setup.dependent_variable.relative_distance("Satellite", "Earth"), 7500.0E3, True)
+    bodies, propagator_settings, _, _ = create_point_mass_setup(termination_settings=distance_termination)
+    with pytest.raises(RuntimeError, match="only time termination settings"):
+        numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+    early_termination = propagation_setup.propagator.time_termination(0.5 * output_epochs[-1])
+    bodies, propagator_settings, _, _ = create_point_mass_setup(termination_settings=early_termination)
+    with pytest.raises(RuntimeError, match="beyond the termination time"):
+        numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def test_dense_output_settings_rejected_by_tudat_integrators():
+    """ Dense output integrator settings must be rejected where the integrator is created by Tudat.
+    """
+    bodies, propagator_settings, _, _ = create_point_mass_setup()
+    integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+        simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12)
+    with pytest.raises(RuntimeError, match="dense output integrator settings"):
+        numerical_simulation.SingleArcVariationalSimulator(
+            bodies, integrator_settings, propagator_settings, None)
+
+
+def test_dense_output_resume_from_checkpoint(tmp_path):
+    """ A propagation resumed from the checkpoint of an interrupted propagation must match an uninterrupted propagation.
+    """
+    checkpoint_file_path = str(tmp_path / "propagation.checkpoint")
+    interruption_epoch = 0.5 * output_epochs[-1]
+    is_interrupted = [True]
+
+    def interrupting_acceleration(epoch):
+        if is_interrupted[0] and epoch > interruption_epoch:
+            raise RuntimeError("propagation interrupted")
+        return np.zeros(3)
+
+    def create_simulator(checkpoint_file_path, are_equations_of_motion_to_be_integrated):
+        bodies, propagator_settings, _, _ = create_point_mass_setup(interrupting_acceleration)
+        integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+            simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12,
+            checkpoint_file_path=checkpoint_file_path, checkpoint_interval=0.0)
+        return numerical_simulation.SingleArcSimulator(
+            bodies, integrator_settings, propagator_settings,
+            are_equations_of_motion_to_be_integrated=are_equations_of_motion_to_be_integrated)
+
+    # Interrupted propagation, of which a checkpoint is written after each step
+    with pytest.raises(RuntimeError, match="propagation interrupted"):
+        create_simulator(checkpoint_file_path, True)
+
+    # Copy of the checkpoint file, of which the last record is incomplete (as if interrupted while writing)
+    truncated_checkpoint_file_path = str(tmp_path / "truncated_propagation.checkpoint")
+    with open(checkpoint_file_path, "rb") as checkpoint_file:
+        checkpoint_data = checkpoint_file.read()
+    with open(truncated_checkpoint_file_path, "wb") as truncated_checkpoint_file:
+        truncated_checkpoint_file.write(checkpoint_data[:-5])
+
+    is_interrupted[0] = False
+    uninterrupted_state_history = create_simulator("", True).state_history
+    for resumed_checkpoint_file_path in [checkpoint_file_path, truncated_checkpoint_file_path]:
+        resumed_simulator = create_simulator(resumed_checkpoint_file_path, False)
+        resumed_simulator.resume_from_checkpoint()
+        resumed_state_history = resumed_simulator.state_history
+
+        assert list(resumed_state_history.keys()) == output_epochs
+        for epoch in output_epochs:
+            assert np.array_equal(resumed_state_history[epoch], uninterrupted_state_history[epoch])
@@ -0,0 +1,77 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup, propagation
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_start_epoch = 0.0
+output_epochs = [60.0 * i for i in range(1, 12 * 60 + 1)]
+
+
+def create_bodies():
+    body_settings = environment_setup.get_default_body_settings(["Earth", "Moon"], "Earth", "J2000")
+    return environment_setup.create_system_of_bodies(body_settings)
+
+
+def create_initial_states(gravitational_parameter):
+    kepler_elements = [[7000.0E3, 0.001, np.deg2rad(98.0), 0.0, 0.0, 0.0],
+                       [8000.0E3, 0.1, np.deg2rad(50.0), np.deg2rad(20.0), np.deg2rad(30.0), 0.0],
+                       [12000.0E3, 0.3, np.deg2rad(10.0), np.deg2rad(120.0), np.deg2rad(60.0), np.deg2rad(90.0)]]
+    return np.array([element_conversion.keplerian_to_cartesian(np.array(elements), gravitational_parameter)
+                     for elements in kepler_elements])
+
+
+def propagate_single_body(initial_state):
+    """ Propagation of a single body with the same dynamics as the ensemble (J2 of the Earth and point mass of the Moon).
+    """
+    bodies = create_bodies()
+    bodies.create_empty_body("Satellite")
+    acceleration_settings = {"Satellite": {
+        "Earth": [propagation_setup.acceleration.spherical_harmonic_gravity(2, 0)],
+        "Moon": [propagation_setup.acceleration.point_mass_gravity()]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(output_epochs[-1]))
+    integrator_settings = propagation_setup.integrator.runge_kutta_dense_output(
+        simulation_start_epoch, 10.0, output_epochs, 1.0E-3, 600.0, 1.0E-12, 1.0E-12)
+    return numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings).state_history
+
+
+def propagate_ensemble(bodies, initial_states, step_size_control, number_of_threads=0):
+    return propagation.propagate_ensemble(
+        bodies, "Earth", initial_states, simulation_start_epoch, output_epochs, 10.0, 1.0E-3, 600.0, 1.0E-12, 1.0E-12,
+        include_j2=True, third_bodies=["Moon"], step_size_control=step_size_control,
+        number_of_threads=number_of_threads)
+
+
+@pytest.mark.parametrize("step_size_control", [
+    propagation.common_ensemble_step_size,
+    propagation.per_particle_step_size])
+def test_ensemble_matches_single_body_propagation(step_size_control):
+    """ The states of each particle must match those of a propagation of the particle with the Tudat acceleration models.
+    """
+    bodies = create_bodies()
+    initial_states = create_initial_states(bodies.get("Earth").gravitational_parameter)
+    ensemble_states = propagate_ensemble(bodies, initial_states, step_size_control)
+    assert ensemble_states.shape == (len(initial_states), len(output_epochs), 6)
+
+    for particle_index, initial_state in enumerate(initial_states):
+        state_history = propagate_single_body(initial_state)
+        for output_index, epoch in enumerate(output_epochs):
+            state = ensemble_states[particle_index, output_index]
+            assert np.max(np.abs(state[:3] - state_history[epoch][:3])) < 1.0E-2
+            assert np.max(np.abs(state[3:] - state_history[epoch][3:])) < 1.0E-5
+
+
+def test_ensemble_per_particle_thread_count_invariance():
+    bodies = create_bodies()
+    initial_states = create_initial_states(bodies.get("Earth").gravitational_parameter)
+    single_thread_states = propagate_ensemble(bodies, initial_states, propagation.per_particle_step_size, 1)
+    multi_thread_states = propagate_ensemble(bodies, initial_states, propagation.per_particle_step_size, 4)
+    assert np.array_equal(single_thread_states, multi_thread_states)
@@ -0,0 +1,67 @@
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, environment
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+
+def create_bodies():
+    body_settings = environment_setup.get_default_body_settings(["Earth", "Moon"], "Earth", "J2000")
+    return environment_setup.create_system_of_bodies(body_settings)
+
+
+def test_cache_hits_return_original_states():
+    bodies = create_bodies()
+    original_ephemeris = bodies.get("Moon").ephemeris
+    epochs = [0.0, 3600.0, 7200.0]
+    original_states = [original_ephemeris.cartesian_state(epoch) for epoch in epochs]
+
+    cached_ephemeris = environment.add_ephemeris_caches(bodies, ["Moon"])[0]
+    assert bodies.get("Moon").ephemeris is cached_ephemeris
+    assert cached_ephemeris.number_of_hits == 0
+    assert cached_ephemeris.number_of_misses == 0
+    assert cached_ephemeris.hit_rate == 0.0
+
+    # The first request at each epoch is computed, subsequent requests at the same epoch are served from the cache
+    for repetition in range(3):
+        for epoch, original_state in zip(epochs, original_states):
+            assert np.array_equal(cached_ephemeris.cartesian_state(epoch), original_state)
+    assert cached_ephemeris.number_of_misses == len(epochs)
+    assert cached_ephemeris.number_of_hits == 2 * len(epochs)
+    assert cached_ephemeris.hit_rate == pytest.approx(2.0 / 3.0)
+
+    # A request at a different epoch is not served from the cache
+    cached_ephemeris.cartesian_state(epochs[0] + 1.0E-3)
+    assert cached_ephemeris.number_of_misses == len(epochs) + 1
+
+    cached_ephemeris.clear()
+    assert cached_ephemeris.number_of_hits == 0
+    assert cached_ephemeris.number_of_misses == 0
+    assert np.array_equal(cached_ephemeris.cartesian_state(epochs[0]), original_states[0])
+    assert cached_ephemeris.number_of_misses == 1
+
+
+def test_cache_is_cleared_at_maximum_number_of_entries():
+    bodies = create_bodies()
+    cached_ephemeris = environment.add_ephemeris_caches(bodies, ["Moon"], maximum_number_of_entries=2)[0]
+    for epoch in [0.0, 60.0, 120.0, 0.0]:
+        cached_ephemeris.cartesian_state(epoch)
+    assert cached_ephemeris.number_of_hits == 0
+    assert cached_ephemeris.number_of_misses == 4
+    cached_ephemeris.cartesian_state(0.0)
+    assert cached_ephemeris.number_of_hits == 1
+
+
+def test_add_and_remove_caches():
+    bodies = create_bodies()
+    original_ephemeris = bodies.get("Moon").ephemeris
+    environment.add_ephemeris_caches(bodies, ["Moon"])
+    with pytest.raises(RuntimeError):
+        environment.add_ephemeris_caches(bodies, ["Moon"])
+
+    environment.remove_ephemeris_caches(bodies, ["Moon"])
+    assert bodies.get("Moon").ephemeris is original_ephemeris
+    with pytest.raises(RuntimeError):
+        environment.remove_ephemeris_caches(bodies, ["Moon"])
@@ -0,0 +1,410 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup, estimation_setup, estimation
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_start_epoch = 0.0
+simulation_end_epoch = 6.0 * 3600.0
+
+
+def create_dynamics_setup():
+    """ Dynamics of an Earth orbiter (point mass and J2 of the Earth), propagated with a fixed step size.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Delfi")
+
+    acceleration_settings = {"Delfi": {"Earth": [propagation_setup.acceleration.spherical_harmonic_gravity(2, 0)]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Delfi"], ["Earth"])
+
+    orbit_radius = 7000.0E3
+    circular_velocity = np.sqrt(3.986004418E14 / orbit_radius)
+    initial_state = np.array([orbit_radius, 0.0, 0.0, 0.0, 0.6 * circular_velocity, 0.8 * circular_velocity])
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Delfi"], initial_state,
+        propagation_setup.propagator.time_termination(simulation_end_epoch))
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(simulation_start_epoch, 30.0)
+    return bodies, integrator_settings, propagator_settings
+
+
+def create_estimation_setup(number_of_observation_epochs=200):
+    """ Estimation of the initial state of the Earth orbiter from simulated position observations.
+    """
+    bodies, integrator_settings, propagator_settings = create_dynamics_setup()
+
+    parameter_settings = estimation_setup.parameter.initial_states(propagator_settings, bodies)
+    parameters_to_estimate = estimation_setup.create_parameter_set(parameter_settings, bodies)
+
+    link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+    observation_settings = [estimation_setup.observation.cartesian_position(link_ends)]
+    estimator = numerical_simulation.Estimator(
+        bodies, parameters_to_estimate, observation_settings, integrator_settings, propagator_settings)
+
+    observation_times = np.linspace(simulation_start_epoch + 600.0, simulation_end_epoch - 600.0,
+                                    number_of_observation_epochs)
+    simulation_settings = [estimation_setup.observation.tabulated_simulation_settings(
+        estimation_setup.observation.position_observable_type, link_ends, observation_times,
+        estimation_setup.observation.observed_body)]
+    estimation_setup.observation.add_noise_models_to_settings(
+        simulation_settings, [estimation_setup.observation.gaussian_noise(5.0, seed=1)])
+    observations = estimation.simulate_observations(simulation_settings, estimator.observation_simulators, bodies)
+
+    true_parameters = parameters_to_estimate.parameter_vector
+    return bodies, estimator, parameters_to_estimate, observations, true_parameters
+
+
+@pytest.fixture(scope="module")
+def estimation_setup_fixture():
+    return create_estimation_setup()
+
+
+def perform_estimation(estimation_setup_fixture, number_of_threads, solver_type, save_design_matrix,
+                       initial_perturbation=np.array([100.0, -50.0, 20.0, 0.1, -0.05, 0.02]),
+                       linear_update_threshold=0.0):
+    """ Estimate the initial state from a fixed perturbed initial guess, returning the estimation output.
+    """
+    bodies, estimator, parameters_to_estimate, observations, true_parameters = estimation_setup_fixture
+    parameters_to_estimate.parameter_vector = true_parameters + initial_perturbation
+
+    pod_input = estimation.PodInput(observations, parameters_to_estimate.parameter_set_size)
+    pod_input.define_estimation_settings(
+        save_design_matrix=save_design_matrix, print_output_to_terminal=False,
+        number_of_threads=number_of_threads, observation_chunk_size=30,
+        linear_update_threshold=linear_update_threshold)
+    pod_input.solver_type = solver_type
+    return estimator.perform_estimation(
+        pod_input, estimation.estimation_convergence_checker(maximum_iterations=3))
+
+
+def test_parallel_observation_simulation_thread_count_invariance(estimation_setup_fixture):
+    """ Observations simulated in parallel (in chunks) must be bit-identical for any number of threads, and identical
+    to the serial simulation, also with noise and with Spice ephemerides in the environment.
+    """
+    bodies, estimator, parameters_to_estimate, observations, true_parameters = estimation_setup_fixture
+    link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+    observation_settings = [estimation_setup.observation.cartesian_position(link_ends)]
+
+    def create_simulation_settings():
+        observation_times = np.linspace(simulation_start_epoch + 600.0, simulation_end_epoch - 600.0, 500)
+        simulation_settings = [estimation_setup.observation.tabulated_simulation_settings(
+            estimation_setup.observation.position_observable_type, link_ends, observation_times,
+            estimation_setup.observation.observed_body)]
+        estimation_setup.observation.add_noise_models_to_settings(
+            simulation_settings, [estimation_setup.observation.gaussian_noise(5.0, seed=2)])
+        return simulation_settings
+
+    serial_observations = estimation.simulate_observations(
+        create_simulation_settings(), estimator.observation_simulators, bodies)
+    for number_of_threads in [1, 3, 8]:
+        parallel_observations = estimation.simulate_observations_parallel(
+            create_simulation_settings(), observation_settings, bodies,
+            number_of_threads=number_of_threads, epochs_per_chunk=37)
+        assert np.array_equal(parallel_observations.concatenated_times, serial_observations.concatenated_times)
+        assert np.array_equal(parallel_observations.concatenated_observations,
+                              serial_observations.concatenated_observations)
+
+
+@pytest.mark.parametrize("solver_type", [estimation.normal_equations_solver,
+                                         estimation.square_root_information_filter_solver])
+def test_estimation_thread_count_invariance(estimation_setup_fixture, solver_type):
+    """ Estimated parameters and covariance must be bit-identical for any number of threads.
+    """
+    single_thread_output = perform_estimation(estimation_setup_fixture, 1, solver_type, False)
+    for number_of_threads in [2, 3, 8]:
+        multi_thread_output = perform_estimation(estimation_setup_fixture, number_of_threads, solver_type, False)
+        assert np.array_equal(multi_thread_output.parameter_history, single_thread_output.parameter_history)
+        assert np.array_equal(multi_thread_output.inverse_covariance, single_thread_output.inverse_covariance)
+        assert np.array_equal(multi_thread_output.final_residuals, single_thread_output.final_residuals)
+
+
+def test_batched_covariance_propagation(estimation_setup_fixture):
+    """ Array-epoch matrix lookups and batched covariance propagation must match the per-epoch Tudat functions, for any
+    number of threads.
+    """
+    bodies, estimator, parameters_to_estimate, observations, true_parameters = estimation_setup_fixture
+    state_transition_interface = estimator.state_transition_interface
+    output_times = np.linspace(simulation_start_epoch + 60.0, simulation_end_epoch - 60.0, 257)
+
+    matrix_array = state_transition_interface.state_transition_sensitivity_at_epochs(output_times)
+    assert matrix_array.shape == (len(output_times), 6, parameters_to_estimate.parameter_set_size)
+    for time_index in [0, 100, len(output_times) - 1]:
+        assert np.array_equal(matrix_array[time_index], state_transition_interface.state_transition_sensitivity_at_epoch(
+            output_times[time_index]))
+
+    random_matrix = np.random.default_rng(3).normal(size=(6, 6))
+    initial_covariance = random_matrix @ random_matrix.T + np.diag([1.0E2, 1.0E2, 1.0E2, 1.0E-2, 1.0E-2, 1.0E-2])
+    covariance_history = estimation.propagate_covariance(
+        initial_covariance, state_transition_interface, list(output_times))
+    formal_error_history = estimation.propagate_formal_errors(
+        initial_covariance, state_transition_interface, list(output_times))
+    for number_of_threads in [1, 3]:
+        covariance_array = estimation.propagate_covariance_array(
+            initial_covariance, state_transition_interface, output_times, number_of_threads=number_of_threads)
+        formal_error_array = estimation.propagate_formal_errors_array(
+            initial_covariance, state_transition_interface, output_times, number_of_threads=number_of_threads)
+        assert covariance_array.shape == (len(output_times), 6, 6)
+        assert formal_error_array.shape == (len(output_times), 6)
+        for time_index, time in enumerate(output_times):
+            assert np.allclose(covariance_array[time_index], covariance_history[time], rtol=1.0E-12, atol=0.0)
+            assert np.allclose(formal_error_array[time_index], formal_error_history[time], rtol=1.0E-12, atol=0.0)
+
+
+def test_extended_estimation_matches_default_estimation(estimation_setup_fixture):
+    """ The multi-threaded estimation, accumulating the normal equations per chunk of observations, must reproduce the
+    estimation of the Tudat orbit determination manager (used for a single thread when the design matrix is saved).
+    """
+    default_output = perform_estimation(estimation_setup_fixture, 1, estimation.normal_equations_solver, True)
+    extended_output = perform_estimation(estimation_setup_fixture, 4, estimation.normal_equations_solver, False)
+    assert np.allclose(extended_output.parameter_history, default_output.parameter_history, rtol=1.0E-10, atol=1.0E-6)
+    assert np.allclose(extended_output.inverse_covariance, default_output.inverse_covariance, rtol=1.0E-8, atol=0.0)
+    assert np.allclose(extended_output.final_residuals, default_output.final_residuals, rtol=0.0, atol=1.0E-6)
+
+
+@pytest.mark.parametrize("solver_type, save_design_matrix",
+                         [(estimation.householder_qr_solver, True),
+                          (estimation.square_root_information_filter_solver, False)])
+def test_orthogonal_solvers_match_normal_equations(estimation_setup_fixture, solver_type, save_design_matrix):
+    """ On a well-conditioned problem, the solutions and covariances of the orthogonal-factorization solvers must match
+    those of the normal equations.
+    """
+    normal_equations_output = perform_estimation(
+        estimation_setup_fixture, 1, estimation.normal_equations_solver, False)
+    solver_output = perform_estimation(estimation_setup_fixture, 1, solver_type, save_design_matrix)
+    assert np.allclose(solver_output.parameter_history, normal_equations_output.parameter_history,
+                       rtol=0.0, atol=1.0E-6)
+    covariance = normal_equations_output.covariance
+    assert np.allclose(solver_output.covariance, covariance, rtol=0.0, atol=1.0E-8 * np.max(np.abs(covariance)))
+    assert np.allclose(solver_output.formal_errors, normal_equations_output.formal_errors, rtol=1.0E-8, atol=0.0)
+
+
+def test_linear_update_matches_re_estimation(estimation_setup_fixture):
+    """ For a small initial perturbation, updating the states linearly after the first propagation must reproduce the
+    estimation in which the dynamics is re-propagated in each iteration.
+    """
+    initial_perturbation = np.array([1.0, -0.5, 0.2, 1.0E-3, -5.0E-4, 2.0E-4])
+    propagated_output = perform_estimation(
+        estimation_setup_fixture, 1, estimation.normal_equations_solver, False, initial_perturbation)
+    linearly_updated_output = perform_estimation(
+        estimation_setup_fixture, 1, estimation.normal_equations_solver, False, initial_perturbation,
+        linear_update_threshold=100.0)
+
+    assert propagated_output.number_of_linear_updates == 0
+    assert linearly_updated_output.number_of_propagations == 1
+    assert linearly_updated_output.number_of_linear_updates == propagated_output.number_of_propagations - 1
+    assert np.allclose(linearly_updated_output.parameter_history, propagated_output.parameter_history,
+                       rtol=0.0, atol=1.0E-4)
+    assert np.allclose(linearly_updated_output.formal_errors, propagated_output.formal_errors, rtol=1.0E-6, atol=0.0)
+    assert np.allclose(linearly_updated_output.final_residuals, propagated_output.final_residuals, rtol=0.0, atol=1.0E-4)
+
+
+def test_constrained_estimation_without_saved_design_matrix():
+    """ A constrained estimation (the PPN parameters, with the Nordtvedt constraint) that is not to save the design
+    matrix must fall back to the Tudat orbit determination manager, and match the estimation that saves it.
+    """
+    estimation_outputs = []
+    for save_design_matrix, number_of_threads in [(True, 1), (False, 4)]:
+        bodies, integrator_settings, propagator_settings = create_dynamics_setup()
+        acceleration_settings = {"Delfi": {"Earth": [
+            propagation_setup.acceleration.spherical_harmonic_gravity(2, 0),
+            propagation_setup.acceleration.relativistic_correction(use_schwarzschild=True)]}}
+        acceleration_models = propagation_setup.create_acceleration_models(
+            bodies, acceleration_settings, ["Delfi"], ["Earth"])
+        propagator_settings = propagation_setup.propagator.translational(
+            ["Earth"], acceleration_models, ["Delfi"], propagator_settings.initial_states,
+            propagation_setup.propagator.time_termination(simulation_end_epoch))
+
+        parameter_settings = estimation_setup.parameter.initial_states(propagator_settings, bodies)
+        parameter_settings.append(estimation_setup.parameter.ppn_parameter_gamma())
+        parameter_settings.append(estimation_setup.parameter.ppn_parameter_beta())
+        parameters_to_estimate = estimation_setup.create_parameter_set(parameter_settings, bodies)
+        assert parameters_to_estimate.constraints_size > 0
+
+        link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+        observation_settings = [estimation_setup.observation.cartesian_position(link_ends)]
+        estimator = numerical_simulation.Estimator(
+            bodies, parameters_to_estimate, observation_settings, integrator_settings, propagator_settings)
+        observation_times = np.linspace(simulation_start_epoch + 600.0, simulation_end_epoch - 600.0, 100)
+        simulation_settings = [estimation_setup.observation.tabulated_simulation_settings(
+            estimation_setup.observation.position_observable_type, link_ends, observation_times,
+            estimation_setup.observation.observed_body)]
+        observations = estimation.simulate_observations(simulation_settings, estimator.observation_simulators, bodies)
+
+        parameters_to_estimate.parameter_vector = parameters_to_estimate.parameter_vector + np.array(
+            [100.0, -50.0, 20.0, 0.1, -0.05, 0.02, 0.0, 0.0])
+        pod_input = estimation.PodInput(observations, parameters_to_estimate.parameter_set_size)
+        pod_input.define_estimation_settings(
+            save_design_matrix=save_design_matrix, print_output_to_terminal=False,
+            number_of_threads=number_of_threads, observation_chunk_size=30)
+        estimation_outputs.append(estimator.perform_estimation(
+            pod_input, estimation.estimation_convergence_checker(maximum_iterations=3)))
+
+    saved_output, streamed_output = estimation_outputs
+    assert np.array_equal(streamed_output.parameter_history, saved_output.parameter_history)
+    assert np.array_equal(streamed_output.inverse_covariance, saved_output.inverse_covariance)
+
+
+@pytest.mark.parametrize("estimate_gravitational_parameter", [False, True])
+def test_compact_variational_history(estimate_gravitational_parameter):
+    """ The compact variational history must reproduce the full history, also if the sensitivity matrix is empty, and
+    the full history of the solver must be released once the compact history is created.
+    """
+    bodies, integrator_settings, propagator_settings = create_dynamics_setup()
+    parameter_settings = estimation_setup.parameter.initial_states(propagator_settings, bodies)
+    if estimate_gravitational_parameter:
+        parameter_settings.append(estimation_setup.parameter.gravitational_parameter("Earth"))
+    parameters_to_estimate = estimation_setup.create_parameter_set(parameter_settings, bodies)
+    variational_solver = numerical_simulation.SingleArcVariationalSimulator(
+        bodies, integrator_settings, propagator_settings, parameters_to_estimate)
+    full_state_transition_history = variational_solver.state_transition_matrix_history
+    full_sensitivity_history = variational_solver.sensitivity_matrix_history
+    assert len(full_state_transition_history) > 0
+
+    output_times = np.arange(simulation_start_epoch, simulation_end_epoch + 1.0, 300.0)
+    compact_history = numerical_simulation.CompactVariationalHistory(
+        variational_solver, output_times, single_precision_sensitivity=False)
+    assert compact_history.compact_storage_size < compact_history.full_storage_size
+    assert len(variational_solver.state_transition_matrix_history) == 0
+    assert len(variational_solver.sensitivity_matrix_history) == 0
+
+    maximum_state_transition_entry = max(
+        np.max(np.abs(matrix)) for matrix in full_state_transition_history.values())
+    assert compact_history.maximum_state_transition_error < 1.0E-6 * maximum_state_transition_entry
+
+    number_of_sensitivity_parameters = 1 if estimate_gravitational_parameter else 0
+    if estimate_gravitational_parameter:
+        maximum_sensitivity_entry = max(np.max(np.abs(matrix)) for matrix in full_sensitivity_history.values())
+        assert compact_history.maximum_sensitivity_error < 1.0E-6 * maximum_sensitivity_entry
+    else:
+        assert compact_history.maximum_sensitivity_error == 0.0
+
+    for time in [output_times[0], 0.5 * (output_times[3] + output_times[4]), output_times[-1]]:
+        combined_matrix = compact_history.state_transition_interface.state_transition_sensitivity_at_epoch(time)
+        assert combined_matrix.shape == (6, 6 + number_of_sensitivity_parameters)
+        assert np.array_equal(
+            variational_solver.state_transition_interface.state_transition_sensitivity_at_epoch(time), combined_matrix)
+
+
+def test_compact_variational_history_without_clearing():
+    """ The full history of the solver must be retained if requested.
+    """
+    bodies, integrator_settings, propagator_settings = create_dynamics_setup()
+    parameters_to_estimate = estimation_setup.create_parameter_set(
+        estimation_setup.parameter.initial_states(propagator_settings, bodies), bodies)
+    variational_solver = numerical_simulation.SingleArcVariationalSimulator(
+        bodies, integrator_settings, propagator_settings, parameters_to_estimate)
+    number_of_epochs = len(variational_solver.state_transition_matrix_history)
+
+    output_times = np.arange(simulation_start_epoch, simulation_end_epoch + 1.0, 300.0)
+    numerical_simulation.CompactVariationalHistory(variational_solver, output_times, clear_full_solution=False)
+    assert len(variational_solver.state_transition_matrix_history) == number_of_epochs
+
+
+@pytest.mark.parametrize("number_of_threads", [1, 4])
+def test_reduced_variational_equations_estimation(number_of_threads):
+    """ Estimation with reduced variational equations must match the estimation with the full variational equations.
+    """
+    estimation_outputs = []
+    for reduce_variational_equations in [False, True]:
+        bodies, integrator_settings, propagator_settings = create_dynamics_setup()
+        link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+        observation_settings = [estimation_setup.observation.cartesian_position(
+            link_ends, bias_settings=estimation_setup.observation.absolute_bias(np.zeros(3)))]
+
+        parameter_settings = estimation_setup.parameter.initial_states(propagator_settings, bodies)
+        parameter_settings.append(estimation_setup.parameter.absolute_observation_bias(
+            link_ends, estimation_setup.observation.position_observable_type))
+        parameters_to_estimate = estimation_setup.create_parameter_set(parameter_settings, bodies)
+        estimator = numerical_simulation.Estimator(
+            bodies, parameters_to_estimate, observation_settings, integrator_settings, propagator_settings,
+            reduce_variational_equations=reduce_variational_equations)
+        if reduce_variational_equations:
+            assert estimator.variational_solver.number_of_removed_parameters == 3
+
+        observation_times = np.linspace(simulation_start_epoch + 600.0, simulation_end_epoch - 600.0, 100)
+        simulation_settings = [estimation_setup.observation.tabulated_simulation_settings(
+            estimation_setup.observation.position_observable_type, link_ends, observation_times,
+            estimation_setup.observation.observed_body)]
+        estimation_setup.observation.add_noise_models_to_settings(
+            simulation_settings, [estimation_setup.observation.gaussian_noise(5.0, seed=1)])
+        observations = estimation.simulate_observations(simulation_settings, estimator.observation_simulators, bodies)
+
+        parameters_to_estimate.parameter_vector = parameters_to_estimate.parameter_vector + np.array(
+            [100.0, -50.0, 20.0, 0.1, -0.05, 0.02, 10.0, -10.0, 5.0])
+        pod_input = estimation.PodInput(observations, parameters_to_estimate.parameter_set_size)
+        pod_input.define_estimation_settings(
+            print_output_to_terminal=False, number_of_threads=number_of_threads, observation_chunk_size=30)
+        estimation_outputs.append(estimator.perform_estimation(
+            pod_input, estimation.estimation_convergence_checker(maximum_iterations=3)))
+
+    full_output, reduced_output = estimation_outputs
+    assert np.allclose(reduced_output.parameter_history, full_output.parameter_history, rtol=1.0E-10, atol=1.0E-6)
+    assert np.allclose(reduced_output.inverse_covariance, full_output.inverse_covariance, rtol=1.0E-8)
+    assert np.allclose(reduced_output.final_residuals, full_output.final_residuals, rtol=1.0E-8, atol=1.0E-6)
+
+
+def simulate_position_noise(estimation_setup_fixture, noise_models, number_of_epochs=2000):
+    """ Simulate the position observations of the Earth orbiter with a list of noise models, returning only the noise.
+    """
+    bodies, estimator, parameters_to_estimate, observations, true_parameters = estimation_setup_fixture
+    link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+    observation_times = np.linspace(simulation_start_epoch + 600.0, simulation_end_epoch - 600.0, number_of_epochs)
+    simulated_observations = []
+    for noise_model_list in [[], noise_models]:
+        simulation_settings = [estimation_setup.observation.tabulated_simulation_settings(
+            estimation_setup.observation.position_observable_type, link_ends, observation_times,
+            estimation_setup.observation.observed_body)]
+        if len(noise_model_list) > 0:
+            estimation_setup.observation.add_noise_models_to_settings(simulation_settings, noise_model_list)
+        simulated_observations.append(estimation.simulate_observations(
+            simulation_settings, estimator.observation_simulators, bodies).concatenated_observations)
+    return simulated_observations[1] - simulated_observations[0]
+
+
+def test_combined_noise_model_independence(estimation_setup_fixture):
+    """ Noise models that are combined on one observable (with the same seed) must draw independent random numbers.
+    """
+    standard_deviation = 2.0
+    half_width = 3.0
+
+    # Two identical Gaussian models: independent noise has a standard deviation of sqrt(2) sigma (not 2 sigma)
+    double_gaussian_noise = simulate_position_noise(
+        estimation_setup_fixture, [estimation_setup.observation.gaussian_noise(standard_deviation),
+                                   estimation_setup.observation.gaussian_noise(standard_deviation)])
+    assert abs(np.std(double_gaussian_noise) / (np.sqrt(2.0) * standard_deviation) - 1.0) < 0.05
+
+    # The Gaussian model draws the same numbers alone and when combined, from which the uniform noise is isolated
+    gaussian_noise = simulate_position_noise(
+        estimation_setup_fixture, [estimation_setup.observation.gaussian_noise(standard_deviation)])
+    combined_noise = simulate_position_noise(
+        estimation_setup_fixture, [estimation_setup.observation.gaussian_noise(standard_deviation),
+                                   estimation_setup.observation.uniform_noise(-half_width, half_width)])
+    uniform_noise = combined_noise - gaussian_noise
+    assert np.all(np.abs(uniform_noise) <= half_width + 1.0E-6)
+    assert abs(np.std(uniform_noise) / (half_width / np.sqrt(3.0)) - 1.0) < 0.05
+    assert abs(np.corrcoef(gaussian_noise, uniform_noise)[0, 1]) < 0.06
+
+
+def test_monte_carlo_covariance_thread_count_invariance(estimation_setup_fixture):
+    """ Monte Carlo statistics must be bit-identical for any number of threads.
+    """
+    bodies, estimator, parameters_to_estimate, observations, true_parameters = estimation_setup_fixture
+    pod_input = estimation.PodInput(observations, parameters_to_estimate.parameter_set_size)
+    pod_input.define_estimation_settings(print_output_to_terminal=False, observation_chunk_size=30)
+
+    statistics_per_thread_count = []
+    for number_of_threads in [1, 3, 8]:
+        covariance_analysis = estimation.MonteCarloCovarianceAnalysis(estimator, pod_input, number_of_threads)
+        covariance_analysis.run_samples(300, 3, observation_bias_standard_deviation=1.0)
+        covariance_analysis.run_samples(100, 4)
+        statistics_per_thread_count.append(
+            (covariance_analysis.mean_estimation_error, covariance_analysis.estimation_error_covariance,
+             covariance_analysis.mean_residual_rms, covariance_analysis.residual_rms_standard_deviation))
+
+    for statistics in statistics_per_thread_count[1:]:
+        for statistic, single_thread_statistic in zip(statistics, statistics_per_thread_count[0]):
+            assert np.array_equal(statistic, single_thread_statistic)
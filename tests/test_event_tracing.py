@@ -0,0 +1,93 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup
+import json
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+
+def propagate_orbit():
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([7000.0E3, 0.01, np.deg2rad(60.0), 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(3600.0))
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(0.0, 10.0)
+    numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def test_trace_file_format(tmp_path):
+    """ The trace file must be Chrome trace-event JSON, with a thread name for each thread, and a complete event for
+    each traced phase.
+    """
+    trace_file_path = str(tmp_path / "trace.json")
+    assert not numerical_simulation.is_tracing_enabled()
+    numerical_simulation.start_tracing(trace_file_path)
+    assert numerical_simulation.is_tracing_enabled()
+    try:
+        propagate_orbit()
+        propagate_orbit()
+    finally:
+        number_of_events = numerical_simulation.stop_tracing()
+    assert not numerical_simulation.is_tracing_enabled()
+
+    with open(trace_file_path) as trace_file:
+        trace = json.load(trace_file)
+    assert trace["displayTimeUnit"] == "ms"
+
+    metadata_events = [event for event in trace["traceEvents"] if event["ph"] == "M"]
+    complete_events = [event for event in trace["traceEvents"] if event["ph"] == "X"]
+    assert len(metadata_events) + len(complete_events) == len(trace["traceEvents"])
+    assert len(complete_events) == number_of_events
+
+    thread_indices = set()
+    for event in metadata_events:
+        assert event["name"] == "thread_name"
+        assert event["pid"] == 1
+        assert event["args"]["name"] == "thread " + str(event["tid"])
+        thread_indices.add(event["tid"])
+    assert thread_indices == set(range(len(metadata_events)))
+
+    for event in complete_events:
+        assert set(event.keys()) == {"name", "cat", "ph", "ts", "dur", "pid", "tid"}
+        assert event["pid"] == 1
+        assert event["tid"] in thread_indices
+        assert event["ts"] >= 0.0
+        assert event["dur"] >= 0.0
+
+    propagation_events = [event for event in complete_events if event["name"] == "single_arc_simulation"]
+    assert len(propagation_events) == 2
+    assert all(event["cat"] == "propagation" for event in propagation_events)
+    assert propagation_events[1]["ts"] >= propagation_events[0]["ts"] + propagation_events[0]["dur"]
+
+
+def test_no_events_recorded_while_disabled(tmp_path):
+    propagate_orbit()
+    trace_file_path = str(tmp_path / "empty_trace.json")
+    numerical_simulation.start_tracing(trace_file_path)
+    assert numerical_simulation.stop_tracing() == 0
+    with open(trace_file_path) as trace_file:
+        assert json.load(trace_file)["traceEvents"] == []
+
+
+def test_tracing_state_errors(tmp_path):
+    with pytest.raises(RuntimeError, match="tracing is not enabled"):
+        numerical_simulation.stop_tracing()
+
+    numerical_simulation.start_tracing(str(tmp_path / "trace.json"))
+    try:
+        with pytest.raises(RuntimeError, match="tracing is already enabled"):
+            numerical_simulation.start_tracing(str(tmp_path / "other_trace.json"))
+    finally:
+        numerical_simulation.stop_tracing()
@@ -0,0 +1,135 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup, propagation
+import locale
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+simulation_start_epoch = 0.0
+
+
+def create_bodies():
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+    return bodies
+
+
+def evaluate_time_expression(expression, time, tables={}, variables={}):
+    """ Evaluate an expression at a given time, through the bank angle of an expression aerodynamic guidance.
+    """
+    guidance = propagation.expression_aerodynamic_guidance(
+        create_bodies(), bank_angle=expression, variables=variables, tables=tables)
+    guidance.updateGuidance(time)
+    return guidance.bank_angle
+
+
+@pytest.mark.parametrize("expression, expected_value", [
+    ("1 + 2 * 3 - 4 / 2", 5.0),
+    ("-2 ^ 2", -4.0),
+    ("2 ^ 3 ^ 2", 512.0),
+    ("2 ** 3", 8.0),
+    ("(1 + 2) * 3", 9.0),
+    ("time / 10", 12.5),
+    ("sqrt(16) + abs(-2) + max(1, 3) + atan2(0, 1)", 9.0),
+    ("cos(pi)", -1.0),
+    ("time > 100 and time <= 125", 1.0),
+    ("time < 100 or not (time == 125)", 0.0),
+    ("time != 125 || !0", 1.0),
+    ("if(time > 100, 1.5, 2.5)", 1.5),
+    ("if(time < 100, 1 / 0, 2.5)", 2.5),
+    ("0 and (1 / 0 > 0)", 0.0),
+    ("schedule(time)", 2.5),
+    ("schedule(-100)", 0.0),
+    ("schedule(1000)", 5.0)])
+def test_expression_evaluation(expression, expected_value):
+    """ Operator precedence and associativity, functions, lazy logical operators and tables.
+    """
+    tables = {"schedule": ([0.0, 100.0, 150.0], [0.0, 0.0, 5.0])}
+    assert evaluate_time_expression(expression, 125.0, tables) == pytest.approx(expected_value, abs=1.0E-15)
+
+
+@pytest.mark.parametrize("expression, error_message", [
+    ("1 +", "unexpected"),
+    ("(1 + 2", "expected '\\)'"),
+    ("1 2", "unexpected '2'"),
+    ("1 $ 2", "unknown character"),
+    ("altitude < 120.0E3", "unknown variable altitude"),
+    ("unknown_function(1)", "unknown function or table unknown_function"),
+    ("atan2(1)", "function atan2 requires 2"),
+    ("position[1.5]", "index of variable position must be a non-negative integer"),
+    ("position[-1]", "index of variable position must be a non-negative integer"),
+    ("position[1", "expected '\\]'")])
+def test_expression_parsing_errors(expression, error_message):
+    """ Expressions are compiled on creation, so errors must be raised before any evaluation.
+    """
+    variables = {"position": propagation_setup.dependent_variable.relative_position("Satellite", "Earth")}
+    with pytest.raises(RuntimeError, match=error_message):
+        evaluate_time_expression(expression, 0.0, variables=variables)
+
+
+def test_expression_numbers_independent_of_locale():
+    """ Numbers must be parsed with a decimal point, also when the numeric locale uses a decimal comma.
+    """
+    original_locale = locale.setlocale(locale.LC_NUMERIC)
+    for locale_name in ["de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "nl_NL.UTF-8"]:
+        try:
+            locale.setlocale(locale.LC_NUMERIC, locale_name)
+            break
+        except locale.Error:
+            continue
+    else:
+        pytest.skip("no locale with a decimal comma is available")
+
+    try:
+        assert evaluate_time_expression("1.5 + 2.5E-1 * 1.0e1", 0.0) == 4.0
+    finally:
+        locale.setlocale(locale.LC_NUMERIC, original_locale)
+
+
+def test_expression_table_errors():
+    with pytest.raises(RuntimeError, match="different sizes"):
+        evaluate_time_expression("schedule(time)", 0.0, {"schedule": ([0.0, 1.0], [0.0])})
+    with pytest.raises(RuntimeError, match="not strictly increasing"):
+        evaluate_time_expression("schedule(time)", 0.0, {"schedule": ([0.0, 0.0], [0.0, 1.0])})
+
+
+def create_termination_propagation(termination_settings, bodies):
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([8000.0E3, 0.1, 0.5, 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state, termination_settings)
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(simulation_start_epoch, 10.0)
+    return numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def test_expression_termination():
+    """ The propagation must stop at the first step at which the condition over the dependent variables is true.
+    """
+    bodies = create_bodies()
+    termination_settings = propagation_setup.propagator.expression_termination(
+        bodies, "distance > 8500.0E3 and position[2] >= -1.0E9",
+        {"distance": propagation_setup.dependent_variable.relative_distance("Satellite", "Earth"),
+         "position": propagation_setup.dependent_variable.relative_position("Satellite", "Earth")})
+    state_history = create_termination_propagation(termination_settings, bodies).state_history
+
+    epochs = sorted(state_history.keys())
+    assert np.linalg.norm(state_history[epochs[-1]][:3]) > 8500.0E3
+    assert np.linalg.norm(state_history[epochs[-2]][:3]) <= 8500.0E3
+
+
+def test_expression_termination_index_out_of_range():
+    bodies = create_bodies()
+    termination_settings = propagation_setup.propagator.expression_termination(
+        bodies, "position[3] > 0.0",
+        {"position": propagation_setup.dependent_variable.relative_position("Satellite", "Earth")})
+    with pytest.raises(RuntimeError, match="index 3 of variable position is out of range"):
+        create_termination_propagation(termination_settings, bodies)
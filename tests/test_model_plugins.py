@@ -0,0 +1,101 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup
+import glob
+import os
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+# Plugins built from tests/plugins/testModelPlugin.cpp by the tudatpy_test_model_plugin(_abi_mismatch) targets
+plugin_directory = os.path.join(os.path.dirname(os.path.abspath(__file__)), "plugins")
+
+constant_acceleration = [1.0E-6, -2.0E-6, 3.0E-6]
+
+
+def get_plugin_path(target_name):
+    plugin_paths = [path for path in glob.glob(os.path.join(plugin_directory, target_name + ".*"))
+                    if not path.endswith(".cpp")]
+    if not plugin_paths:
+        pytest.skip("Test model plugin " + target_name + " has not been built")
+    return plugin_paths[0]
+
+
+@pytest.fixture(scope="module")
+def loaded_plugin_path():
+    """ Loads the test plugin once, since its models remain registered for the lifetime of the process.
+    """
+    plugin_path = get_plugin_path("tudatpy_test_model_plugin")
+    if "test_constant_acceleration" not in propagation_setup.get_registered_plugin_models():
+        model_names = propagation_setup.load_model_plugin(plugin_path)
+        assert model_names == ["test_constant_acceleration", "test_constant_torque"]
+    return plugin_path
+
+
+def propagate_orbit(bodies, custom_acceleration):
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()],
+                                           "Satellite": [custom_acceleration]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([7000.0E3, 0.01, np.deg2rad(50.0), 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(3600.0))
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(0.0, 10.0)
+    return numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings).state_history
+
+
+def create_bodies():
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+    bodies.get("Satellite").mass = 100.0
+    return bodies
+
+
+def test_plugin_registration(loaded_plugin_path):
+    registered_models = propagation_setup.get_registered_plugin_models()
+    assert registered_models["test_constant_acceleration"] == loaded_plugin_path
+    assert registered_models["test_constant_torque"] == loaded_plugin_path
+
+    with pytest.raises(RuntimeError, match="test_constant_acceleration is already registered"):
+        propagation_setup.load_model_plugin(loaded_plugin_path)
+    with pytest.raises(RuntimeError, match="Error when loading model plugin"):
+        propagation_setup.load_model_plugin(os.path.join(plugin_directory, "non_existing_plugin.so"))
+
+
+def test_plugin_abi_version_mismatch(loaded_plugin_path):
+    """ A plugin built for a different interface version must be rejected, without registering its models.
+    """
+    mismatched_plugin_path = get_plugin_path("tudatpy_test_model_plugin_abi_mismatch")
+    registered_models = propagation_setup.get_registered_plugin_models()
+    with pytest.raises(RuntimeError, match=r"plugin was built for interface version \d+, but version \d+ is required"):
+        propagation_setup.load_model_plugin(mismatched_plugin_path)
+    assert propagation_setup.get_registered_plugin_models() == registered_models
+
+
+def test_plugin_acceleration_matches_custom_acceleration(loaded_plugin_path):
+    bodies = create_bodies()
+    plugin_states = propagate_orbit(bodies, propagation_setup.acceleration.plugin(
+        bodies, "test_constant_acceleration", "Satellite", "Earth", constant_acceleration))
+    custom_states = propagate_orbit(create_bodies(), propagation_setup.acceleration.custom(
+        lambda time: np.array(constant_acceleration)))
+    assert list(plugin_states.keys()) == list(custom_states.keys())
+    for epoch, state in plugin_states.items():
+        assert np.allclose(state, custom_states[epoch], rtol=1.0E-14, atol=1.0E-8)
+
+
+def test_plugin_model_creation_errors(loaded_plugin_path):
+    bodies = create_bodies()
+    propagation_setup.torque.plugin(bodies, "test_constant_torque", "Satellite", "Earth", [0.0, 0.0, 1.0E-3])
+    with pytest.raises(RuntimeError, match="could not be created from the 1 given parameters"):
+        propagation_setup.acceleration.plugin(bodies, "test_constant_acceleration", "Satellite", "Earth", [1.0])
+    with pytest.raises(RuntimeError, match="model is not of the requested type"):
+        propagation_setup.acceleration.plugin(
+            bodies, "test_constant_torque", "Satellite", "Earth", constant_acceleration)
+    with pytest.raises(RuntimeError, match="no such model is registered"):
+        propagation_setup.acceleration.plugin(bodies, "non_existing_model", "Satellite", "Earth")
@@ -0,0 +1,62 @@
+from tudatpy.kernel.numerical_simulation import estimation_setup, estimation
+import numpy as np
+import pytest
+
+
+def create_position_collection(number_of_epochs=50):
+    link_ends = {estimation_setup.observation.observed_body: ("Delfi", "")}
+    times = np.linspace(0.0, 3600.0, number_of_epochs)
+    values = np.random.default_rng(1).normal(size=(number_of_epochs, 3))
+    collection = estimation.ObservationCollection.from_arrays(
+        estimation_setup.observation.position_observable_type, link_ends, times, values)
+    return collection, times, values
+
+
+def test_save_and_load(tmp_path):
+    collection, times, values = create_position_collection()
+    file_name = str(tmp_path / "observations.bin")
+    collection.save(file_name)
+
+    loaded_collection = estimation.ObservationCollection.load(file_name)
+    assert np.array_equal(loaded_collection.concatenated_observations, values.flatten())
+    assert np.array_equal(loaded_collection.observation_times(estimation_setup.observation.position_observable_type),
+                          np.repeat(times, 3))
+
+
+def test_load_truncated_file(tmp_path):
+    collection, times, values = create_position_collection()
+    file_name = str(tmp_path / "observations.bin")
+    collection.save(file_name)
+    with open(file_name, "rb") as observation_file:
+        file_contents = observation_file.read()
+    with open(file_name, "wb") as observation_file:
+        observation_file.write(file_contents[:-8])
+
+    with pytest.raises(RuntimeError):
+        estimation.ObservationCollection.load(file_name)
+
+
+def test_load_inconsistent_header(tmp_path):
+    collection, times, values = create_position_collection()
+    file_name = str(tmp_path / "observations.bin")
+    collection.save(file_name)
+    with open(file_name, "rb") as observation_file:
+        file_contents = bytearray(observation_file.read())
+
+    # Observable size and number of epochs directly precede the epochs of the (single) observation set
+    header_end = len(file_contents) - 8 * times.size * 4
+    size_fields = [(header_end - 12, np.int32(1).tobytes()), (header_end - 8, np.int64(2 ** 40).tobytes())]
+    for field_start, field_value in size_fields:
+        corrupted_contents = file_contents.copy()
+        corrupted_contents[field_start:field_start + len(field_value)] = field_value
+        with open(file_name, "wb") as observation_file:
+            observation_file.write(corrupted_contents)
+        with pytest.raises(RuntimeError):
+            estimation.ObservationCollection.load(file_name)
+
+
+def test_observation_times_outlive_collection():
+    collection, times, values = create_position_collection()
+    observation_times = collection.observation_times(estimation_setup.observation.position_observable_type)
+    del collection
+    assert np.array_equal(observation_times, np.repeat(times, 3))
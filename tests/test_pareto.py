@@ -0,0 +1,51 @@
+from tudatpy.kernel.math import pareto
+import numpy as np
+import pytest
+
+
+def brute_force_ranks(objective_values):
+    """ Reference non-dominated sorting by repeatedly peeling off the non-dominated points.
+    """
+    number_of_points = objective_values.shape[0]
+    ranks = -np.ones(number_of_points, dtype=int)
+    current_rank = 0
+    while np.any(ranks < 0):
+        remaining = np.where(ranks < 0)[0]
+        current_front = []
+        for i in remaining:
+            others = objective_values[remaining]
+            dominated = np.any(np.all(others <= objective_values[i], axis=1) &
+                               np.any(others < objective_values[i], axis=1))
+            if not dominated:
+                current_front.append(i)
+        ranks[current_front] = current_rank
+        current_rank += 1
+    return ranks
+
+
+@pytest.mark.parametrize("number_of_objectives", [1, 2, 3, 4, 5])
+def test_non_dominated_sorting(number_of_objectives):
+    """ Compare native non-dominated sorting to brute force reference, including duplicate points.
+    """
+    rng = np.random.default_rng(42)
+    objective_values = rng.integers(0, 6, size=(300, number_of_objectives)).astype(float)
+
+    fronts, ranks = pareto.non_dominated_sorting(objective_values)
+    assert np.array_equal(ranks, brute_force_ranks(objective_values))
+    assert sum(len(front) for front in fronts) == objective_values.shape[0]
+    for rank, front in enumerate(fronts):
+        assert np.all(ranks[front] == rank)
+
+    # Result must not depend on the number of threads
+    single_thread_ranks = pareto.non_dominated_sorting_ranks(objective_values, number_of_threads=1)
+    assert np.array_equal(single_thread_ranks, ranks)
+
+
+def test_non_dominated_sorting_maximization():
+    """ Maximizing an objective is equivalent to minimizing its negative.
+    """
+    rng = np.random.default_rng(1)
+    objective_values = rng.random((500, 3))
+    ranks = pareto.non_dominated_sorting_ranks(objective_values, [False, True, False])
+    objective_values[:, 1] *= -1.0
+    assert np.array_equal(ranks, brute_force_ranks(objective_values))
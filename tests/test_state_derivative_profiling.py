@@ -0,0 +1,76 @@
+from tudatpy.kernel import numerical_simulation
+from tudatpy.kernel.astro import element_conversion
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, propagation_setup
+import numpy as np
+import pytest
+
+
+spice.load_standard_kernels()
+
+step_size = 10.0
+number_of_steps = 360
+
+
+def propagate_orbit():
+    """ Propagation of an Earth orbiter under point mass gravity of the Earth and Moon, with a fixed-step RK4 integrator.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth", "Moon"], "Earth", "J2000")
+    bodies = environment_setup.create_system_of_bodies(body_settings)
+    bodies.create_empty_body("Satellite")
+
+    acceleration_settings = {"Satellite": {"Earth": [propagation_setup.acceleration.point_mass_gravity()],
+                                           "Moon": [propagation_setup.acceleration.point_mass_gravity()]}}
+    acceleration_models = propagation_setup.create_acceleration_models(
+        bodies, acceleration_settings, ["Satellite"], ["Earth"])
+    initial_state = element_conversion.keplerian_to_cartesian(
+        np.array([7000.0E3, 0.01, np.deg2rad(60.0), 0.0, 0.0, 0.0]), bodies.get("Earth").gravitational_parameter)
+    propagator_settings = propagation_setup.propagator.translational(
+        ["Earth"], acceleration_models, ["Satellite"], initial_state,
+        propagation_setup.propagator.time_termination(number_of_steps * step_size))
+    integrator_settings = propagation_setup.integrator.runge_kutta_4(0.0, step_size)
+    return bodies, numerical_simulation.SingleArcSimulator(bodies, integrator_settings, propagator_settings)
+
+
+def test_profile_counts_and_timings():
+    bodies, dynamics_simulator = propagate_orbit()
+    state_history = dynamics_simulator.state_history
+    profile = dynamics_simulator.profile_state_derivative(
+        bodies, [propagation_setup.dependent_variable.keplerian_state("Satellite", "Earth")])
+
+    # Four state derivative evaluations per RK4 step
+    assert profile.number_of_steps == number_of_steps
+    assert profile.number_of_function_evaluations == 4 * number_of_steps
+
+    entries_per_category = dict()
+    for entry in profile.entries:
+        entries_per_category.setdefault(entry.category, []).append(entry)
+    assert len(entries_per_category["state_derivative"]) == 1
+    assert len(entries_per_category["acceleration"]) == 2
+    assert [entry.name for entry in entries_per_category["ephemeris"]] == ["Earth", "Moon"]
+    assert len(entries_per_category["dependent_variable"]) == 1
+    assert "flight_conditions" not in entries_per_category
+
+    # Models are timed at every state derivative evaluation, dependent variables after every step
+    for entry in profile.entries:
+        expected_number_of_calls = number_of_steps if entry.category == "dependent_variable" \
+            else 4 * number_of_steps
+        assert entry.number_of_calls == expected_number_of_calls
+        assert entry.total_time >= 0.0
+        assert entry.mean_time == pytest.approx(entry.total_time / entry.number_of_calls)
+
+    state_derivative_entry = entries_per_category["state_derivative"][0]
+    assert state_derivative_entry.total_time > 0.0
+    assert state_derivative_entry.total_time > max(
+        entry.total_time for entry in entries_per_category["acceleration"])
+
+    # The report lists all entries
+    report_lines = profile.report().splitlines()
+    assert "({} function evaluations, {} steps)".format(4 * number_of_steps, number_of_steps) in report_lines[0]
+    assert len(report_lines) == 2 + len(profile.entries)
+    assert str(profile) == profile.report()
+
+    # The saved results of the dynamics simulator are not modified
+    assert dynamics_simulator.state_history.keys() == state_history.keys()
+    for epoch, state in dynamics_simulator.state_history.items():
+        assert np.array_equal(state, state_history[epoch])
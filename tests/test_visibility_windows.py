@@ -0,0 +1,86 @@
+from tudatpy.kernel.interface import spice
+from tudatpy.kernel.numerical_simulation import environment_setup, estimation_setup, estimation
+import numpy as np
+
+
+spice.load_standard_kernels()
+
+earth_radius = 6378.0E3
+target_semi_major_axis = 7000.0E3
+observer_distance = 1.0E9
+
+
+def create_bodies():
+    """ Target on a circular equatorial orbit around a spherical Earth, observed from a fixed point on the -x axis.
+    """
+    body_settings = environment_setup.get_default_body_settings(["Earth"], "Earth", "J2000")
+    body_settings.get("Earth").shape_settings = environment_setup.shape.spherical(earth_radius)
+    gravitational_parameter = spice.get_body_gravitational_parameter("Earth")
+
+    body_settings.add_empty_settings("Target")
+    body_settings.get("Target").ephemeris_settings = environment_setup.ephemeris.keplerian(
+        [target_semi_major_axis, 0.0, 0.0, 0.0, 0.0, 0.0], 0.0, gravitational_parameter, "Earth", "J2000")
+    body_settings.add_empty_settings("Observer")
+    body_settings.get("Observer").ephemeris_settings = environment_setup.ephemeris.constant(
+        np.array([-observer_distance, 0.0, 0.0, 0.0, 0.0, 0.0]), "Earth", "J2000")
+    return environment_setup.create_system_of_bodies(body_settings), gravitational_parameter
+
+
+def compute_occultation_edge_angle():
+    """ True anomaly at which the line from the observer to the target is tangent to the Earth, found by bisection.
+    """
+    def margin(angle):
+        target_position = target_semi_major_axis * np.array([np.cos(angle), np.sin(angle)])
+        link_vector = target_position - np.array([-observer_distance, 0.0])
+        return observer_distance * target_semi_major_axis * np.sin(angle) / np.linalg.norm(link_vector) - earth_radius
+
+    lower_angle, upper_angle = 0.0, 0.5 * np.pi
+    for _ in range(100):
+        middle_angle = 0.5 * (lower_angle + upper_angle)
+        if margin(middle_angle) < 0.0:
+            lower_angle = middle_angle
+        else:
+            upper_angle = middle_angle
+    return 0.5 * (lower_angle + upper_angle)
+
+
+def test_visibility_windows_match_occultation_geometry():
+    bodies, gravitational_parameter = create_bodies()
+    mean_motion = np.sqrt(gravitational_parameter / target_semi_major_axis ** 3)
+    orbital_period = 2.0 * np.pi / mean_motion
+    end_time = 2.5 * orbital_period
+
+    link_ends = {estimation_setup.observation.transmitter: ("Target", ""),
+                 estimation_setup.observation.receiver: ("Observer", "")}
+    viability_settings = [estimation_setup.observation.body_occultation_viability(("Observer", ""), "Earth")]
+    visibility_windows = estimation_setup.observation.compute_visibility_windows(
+        [link_ends], viability_settings, bodies, 0.0, end_time, 60.0)
+
+    # The target starts behind the Earth, and is visible outside an arc of +/- the edge angle around zero anomaly
+    edge_angle = compute_occultation_edge_angle()
+    expected_windows = [(edge_angle / mean_motion, (2.0 * np.pi - edge_angle) / mean_motion),
+                        ((2.0 * np.pi + edge_angle) / mean_motion, (4.0 * np.pi - edge_angle) / mean_motion),
+                        ((4.0 * np.pi + edge_angle) / mean_motion, end_time)]
+
+    assert len(visibility_windows) == 1
+    assert len(visibility_windows[0]) == len(expected_windows)
+    for window, expected_window in zip(visibility_windows[0], expected_windows):
+        assert abs(window[0] - expected_window[0]) < 1.0E-2
+        assert abs(window[1] - expected_window[1]) < 1.0E-2
+
+    # Observations simulated in the windows are all viable, and are only sampled inside the windows
+    sampling_interval = 120.0
+    simulation_settings = estimation_setup.observation.tabulated_simulation_settings_in_windows(
+        estimation_setup.observation.one_way_range_type, [link_ends], visibility_windows, sampling_interval,
+        reference_link_end_type=estimation_setup.observation.transmitter, viability_settings=viability_settings)
+    observation_simulators = estimation_setup.create_observation_simulators(
+        [estimation_setup.observation.one_way_range(link_ends)], bodies)
+    observations = estimation.simulate_observations(simulation_settings, observation_simulators, bodies)
+
+    observation_times = np.array(observations.concatenated_times)
+    expected_number_of_observations = sum(
+        int(np.floor(window[1] / sampling_interval) - np.ceil(window[0] / sampling_interval)) + 1
+        for window in visibility_windows[0])
+    assert len(observation_times) == expected_number_of_observations
+    for observation_time in observation_times:
+        assert any(window[0] <= observation_time <= window[1] for window in visibility_windows[0])
@@ -12,6 +12,7 @@
 #include "expose_math/expose_numerical_integrators.h"
 #include "expose_math/expose_root_finders.h"
 #include "expose_math/expose_geometry.h"
+#include "expose_math/expose_pareto.h"
 
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -38,6 +39,9 @@ void expose_math(py::module &m) {
   auto geometry = m.def_submodule("geometry");
   expose_geometry(geometry);
 
+  auto pareto = m.def_submodule("pareto");
+  expose_pareto(pareto);
+
 }
 };
 
@@ -0,0 +1,45 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "expose_pareto.h"
+
+#include "tudatpy/docstrings.h"
+#include "tudatpy/math/nonDominatedSorting.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+
+namespace py = pybind11;
+namespace to = tudat::optimization;
+
+namespace tudatpy {
+
+void expose_pareto(py::module &m) {
+
+    m.def("non_dominated_sorting",
+          &to::performNonDominatedSorting,
+          py::arg("objective_values"),
+          py::arg("maximize_objective") = std::vector< bool >( ),
+          py::arg("number_of_threads") = 0,
+          py::call_guard< py::gil_scoped_release >( ),
+          get_docstring("non_dominated_sorting").c_str() );
+
+    m.def("non_dominated_sorting_ranks",
+          &to::computeNonDominatedSortingRanks,
+          py::arg("objective_values"),
+          py::arg("maximize_objective") = std::vector< bool >( ),
+          py::arg("number_of_threads") = 0,
+          py::call_guard< py::gil_scoped_release >( ),
+          get_docstring("non_dominated_sorting_ranks").c_str() );
+
+}
+
+}// namespace tudatpy
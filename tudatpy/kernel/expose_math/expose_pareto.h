@@ -0,0 +1,24 @@
+/*    Copyright (c) 2010-2021, Delft University of Technology
+ *    All rights reserved
+ *
+ *    This file is part of the TudatPy. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDATPY_EXPOSE_PARETO_H
+#define TUDATPY_EXPOSE_PARETO_H
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace tudatpy {
+
+void expose_pareto(py::module &m);
+
+}
+
+#endif//TUDATPY_EXPOSE_PARETO_H
@@ -20,6 +20,13 @@
 #include "expose_numerical_simulation/expose_estimation.h"
 #include "expose_numerical_simulation/expose_propagation.h"
 
+#include "tudatpy/basics/eventTracing.h"
+#include "tudatpy/numerical_simulation/estimation/extendedOrbitDeterminationManager.h"
+#include "tudatpy/numerical_simulation/propagation/compactVariationalHistory.h"
+#include "tudatpy/numerical_simulation/propagation/denseOutputPropagation.h"
+#include "tudatpy/numerical_simulation/propagation/reducedVariationalEquations.h"
+#include "tudatpy/numerical_simulation/propagation/stateDerivativeProfiling.h"
+
 namespace py = pybind11;
 namespace tp = tudat::propagators;
 namespace tss = tudat::simulation_setup;
@@ -57,16 +64,7 @@ void expose_numerical_simulation(py::module &m) {
           std::shared_ptr<tp::SingleArcDynamicsSimulator<double, double>>>(m,
                                                                            "SingleArcSimulator",
                                                                            get_docstring("SingleArcSimulator").c_str())
-          .def(py::init<
-                       const tudat::simulation_setup::SystemOfBodies &,
-                       const std::shared_ptr<tudat::numerical_integrators::IntegratorSettings<double>>,
-                       const std::shared_ptr<tp::PropagatorSettings<double>>,
-                       const bool,
-                       const bool,
-                       const bool,
-                       const bool,
-                       const bool,
-                       const bool>(),
+          .def(py::init(&tp::createSingleArcDynamicsSimulator<double>),
                py::arg("bodies"),
                py::arg("integrator_settings"),
                py::arg("propagator_settings"),
@@ -78,9 +76,13 @@ void expose_numerical_simulation(py::module &m) {
                py::arg("print_state_data") = true,
           get_docstring("SingleArcSimulator.ctor").c_str())
           .def("integrate_equations_of_motion",
-               &tp::SingleArcDynamicsSimulator<double, double>::integrateEquationsOfMotion,
+               &tp::integrateSingleArcEquationsOfMotion<double>,
                py::arg("initial_states"),
                get_docstring("SingleArcSimulator.integrate_equations_of_motion").c_str())
+          .def("resume_from_checkpoint",
+               &tp::resumeEquationsOfMotionFromCheckpoint<double>,
+               py::arg("checkpoint_file_path") = "",
+               get_docstring("SingleArcSimulator.resume_from_checkpoint").c_str())
           .def_property_readonly("state_history",
                                  &tp::SingleArcDynamicsSimulator<double, double>::getEquationsOfMotionNumericalSolution,
                                  get_docstring("SingleArcSimulator.state_history").c_str())
@@ -128,7 +130,12 @@ void expose_numerical_simulation(py::module &m) {
                                  get_docstring("SingleArcSimulator.integration_completed_successfully").c_str())
           .def_property_readonly("dependent_variable_ids",
                                  &tp::SingleArcDynamicsSimulator<double, double>::getDependentVariableIds,
-                                 get_docstring("SingleArcSimulator.dependent_variable_ids").c_str());
+                                 get_docstring("SingleArcSimulator.dependent_variable_ids").c_str())
+          .def("profile_state_derivative",
+               &tp::profileStateDerivative<double>,
+               py::arg("bodies"),
+               py::arg("dependent_variables") = std::vector<std::shared_ptr<tp::SingleDependentVariableSaveSettings>>(),
+               get_docstring("SingleArcSimulator.profile_state_derivative").c_str());
 //          .def_property_readonly("initial_propagation_time",
 //                                 &tp::SingleArcDynamicsSimulator<double, double>::getInitialPropagationTime,
 //                                 get_docstring("initial_propagation_time").c_str());
@@ -152,6 +159,18 @@ void expose_numerical_simulation(py::module &m) {
 //               &tp::SingleArcDynamicsSimulator<double, double>::enableDependentVariableDataPrinting,
 //               get_docstring("enable_dependent_variable_terminal_printing").c_str());
 
+  m.def("start_tracing",
+        &tudat::utilities::startTracing,
+        py::arg("trace_file_path"),
+        get_docstring("start_tracing").c_str());
+
+  m.def("stop_tracing",
+        &tudat::utilities::stopTracing,
+        get_docstring("stop_tracing").c_str());
+
+  m.def("is_tracing_enabled",
+        &tudat::utilities::isTracingEnabled,
+        get_docstring("is_tracing_enabled").c_str());
 
 
   //TODO: Remove variationalOnlyIntegratorSettings
@@ -159,16 +178,23 @@ void expose_numerical_simulation(py::module &m) {
           tp::SingleArcVariationalEquationsSolver<double, double>,
           std::shared_ptr<tp::SingleArcVariationalEquationsSolver<double, double>>>(m, "SingleArcVariationalSimulator",
                                                                                     get_docstring("SingleArcVariationalSimulator").c_str() )
-          .def(py::init<
-               const tudat::simulation_setup::SystemOfBodies&,
-               const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings<double>>,
-               const std::shared_ptr< tp::PropagatorSettings<double>>,
-               const std::shared_ptr< tep::EstimatableParameterSet< double > >,
-               const bool,
-               const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > >,
-               const bool,
-               const bool,
-               const bool >(),
+          .def(py::init([](const tudat::simulation_setup::SystemOfBodies& bodies,
+                           const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings<double>> integratorSettings,
+                           const std::shared_ptr< tp::PropagatorSettings<double>> propagatorSettings,
+                           const std::shared_ptr< tep::EstimatableParameterSet< double > > parametersToEstimate,
+                           const bool integrateEquationsConcurrently,
+                           const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > > variationalOnlyIntegratorSettings,
+                           const bool clearNumericalSolutions,
+                           const bool integrateOnCreation,
+                           const bool setIntegratedResult)
+               {
+                   tni::checkIntegratorSettingsWithoutDenseOutput(integratorSettings, "variational equations solver");
+                   tni::checkIntegratorSettingsWithoutDenseOutput(variationalOnlyIntegratorSettings, "variational equations solver");
+                   return std::make_shared<tp::SingleArcVariationalEquationsSolver<double, double>>(
+                               bodies, integratorSettings, propagatorSettings, parametersToEstimate,
+                               integrateEquationsConcurrently, variationalOnlyIntegratorSettings,
+                               clearNumericalSolutions, integrateOnCreation, setIntegratedResult);
+               }),
                py::arg("bodies"),
                py::arg("integrator_settings"),
                py::arg("propagator_settings"),
@@ -204,43 +230,131 @@ void expose_numerical_simulation(py::module &m) {
           .def_property_readonly("state_history",
                                  &tp::SingleArcVariationalEquationsSolver<double, double>::getEquationsOfMotionSolution,
                                  get_docstring("SingleArcVariationalSimulator.state_history").c_str() )
+          .def_property_readonly("state_transition_interface",
+                                 &tp::SingleArcVariationalEquationsSolver<double, double>::getStateTransitionMatrixInterface,
+                                 get_docstring("SingleArcVariationalSimulator.state_transition_interface").c_str() )
           .def_property_readonly("dynamics_simulator",
                                  &tp::SingleArcVariationalEquationsSolver<double, double>::getDynamicsSimulator,
                                  get_docstring("SingleArcVariationalSimulator.dynamics_simulator").c_str() );
 
   py::class_<
-          tss::OrbitDeterminationManager<double, double>,
-          std::shared_ptr<tss::OrbitDeterminationManager<double, double>>>(m, "Estimator",
-                                                                           get_docstring("Estimator").c_str() )
-          .def(py::init<const tss::SystemOfBodies&,
+          tp::ReducedSingleArcVariationalEquationsSolver,
+          std::shared_ptr<tp::ReducedSingleArcVariationalEquationsSolver>,
+          tp::SingleArcVariationalEquationsSolver<double, double>>(m, "ReducedSingleArcVariationalSimulator",
+                                                                   get_docstring("ReducedSingleArcVariationalSimulator").c_str() )
+          .def(py::init<
+               const tudat::simulation_setup::SystemOfBodies&,
+               const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings<double>>,
+               const std::shared_ptr< tp::PropagatorSettings<double>>,
                const std::shared_ptr< tep::EstimatableParameterSet< double > >,
-               const std::vector< std::shared_ptr< tom::ObservationModelSettings > >&,
-               const std::shared_ptr< tni::IntegratorSettings< double > >,
-               const std::shared_ptr< tp::PropagatorSettings< double > >,
+               const bool,
+               const std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > >,
+               const bool,
+               const bool,
+               const bool >(),
+               py::arg("bodies"),
+               py::arg("integrator_settings"),
+               py::arg("propagator_settings"),
+               py::arg("estimated_parameters"),
+               py::arg("integrate_equations_concurrently") = true,
+               py::arg("variational_only_integrator_settings") = std::shared_ptr< tudat::numerical_integrators::IntegratorSettings< double > >( ),
+               py::arg("clear_numerical_solutions") = false,
+               py::arg("integrate_on_creation") = true,
+               py::arg("set_integrated_result") = false,
+               get_docstring("ReducedSingleArcVariationalSimulator.ctor").c_str() )
+          .def_property("full_parameter_vector",
+                        &tp::ReducedSingleArcVariationalEquationsSolver::getFullParametersToEstimate,
+                        &tp::ReducedSingleArcVariationalEquationsSolver::resetFullParameterEstimate,
+                        get_docstring("ReducedSingleArcVariationalSimulator.full_parameter_vector").c_str() )
+          .def_property_readonly("full_state_transition_interface",
+                                 &tp::ReducedSingleArcVariationalEquationsSolver::getFullStateTransitionInterface,
+                                 get_docstring("ReducedSingleArcVariationalSimulator.full_state_transition_interface").c_str() )
+          .def_property_readonly("number_of_removed_parameters",
+                                 &tp::ReducedSingleArcVariationalEquationsSolver::getNumberOfRemovedParameters,
+                                 get_docstring("ReducedSingleArcVariationalSimulator.number_of_removed_parameters").c_str() );
+
+  py::class_<
+          tp::CompactVariationalEquationsHistory,
+          std::shared_ptr<tp::CompactVariationalEquationsHistory>>(m, "CompactVariationalHistory",
+                                                                   get_docstring("CompactVariationalHistory").c_str() )
+          .def(py::init<
+               const std::shared_ptr< tp::SingleArcVariationalEquationsSolver< double, double > >,
+               const std::vector< double >&,
+               const bool,
+               const int,
                const bool >( ),
+               py::arg("variational_solver"),
+               py::arg("output_times"),
+               py::arg("single_precision_sensitivity") = true,
+               py::arg("interpolation_order") = 8,
+               py::arg("clear_full_solution") = true,
+               get_docstring("CompactVariationalHistory.ctor").c_str() )
+          .def_property_readonly("state_transition_interface",
+                                 &tp::CompactVariationalEquationsHistory::getStateTransitionInterface,
+                                 get_docstring("CompactVariationalHistory.state_transition_interface").c_str() )
+          .def_property_readonly("full_storage_size",
+                                 &tp::CompactVariationalEquationsHistory::getFullStorageSize,
+                                 get_docstring("CompactVariationalHistory.full_storage_size").c_str() )
+          .def_property_readonly("compact_storage_size",
+                                 &tp::CompactVariationalEquationsHistory::getCompactStorageSize,
+                                 get_docstring("CompactVariationalHistory.compact_storage_size").c_str() )
+          .def_property_readonly("maximum_state_transition_error",
+                                 &tp::CompactVariationalEquationsHistory::getMaximumStateTransitionMatrixError,
+                                 get_docstring("CompactVariationalHistory.maximum_state_transition_error").c_str() )
+          .def_property_readonly("maximum_sensitivity_error",
+                                 &tp::CompactVariationalEquationsHistory::getMaximumSensitivityMatrixError,
+                                 get_docstring("CompactVariationalHistory.maximum_sensitivity_error").c_str() );
+
+  py::class_<
+          tss::ExtendedOrbitDeterminationManager<double, double>,
+          std::shared_ptr<tss::ExtendedOrbitDeterminationManager<double, double>>>(m, "Estimator",
+                                                                           get_docstring("Estimator").c_str() )
+          .def(py::init([](const tss::SystemOfBodies& bodies,
+                           const std::shared_ptr< tep::EstimatableParameterSet< double > > parametersToEstimate,
+                           const std::vector< std::shared_ptr< tom::ObservationModelSettings > >& observationSettings,
+                           const std::shared_ptr< tni::IntegratorSettings< double > > integratorSettings,
+                           const std::shared_ptr< tp::PropagatorSettings< double > > propagatorSettings,
+                           const bool propagateOnCreation,
+                           const bool reduceVariationalEquations)
+               {
+                   tudat::utilities::ScopedTraceEvent traceEvent("create_estimator", "estimation");
+                   tni::checkIntegratorSettingsWithoutDenseOutput(integratorSettings, "estimator");
+                   return std::make_shared<tss::ExtendedOrbitDeterminationManager<double, double>>(
+                               bodies, parametersToEstimate, observationSettings, integratorSettings,
+                               propagatorSettings, propagateOnCreation, reduceVariationalEquations);
+               }),
                py::arg("bodies"),
                py::arg("estimated_parameters"),
                py::arg("observation_settings"),
                py::arg("integrator_settings"),
                py::arg("propagator_settings"),
                py::arg("integrate_on_creation") = true,
+               py::arg("reduce_variational_equations") = false,
                get_docstring("Estimator.ctor").c_str() )
           .def_property_readonly("observation_simulators",
-                                 &tss::OrbitDeterminationManager<double, double>::getObservationSimulators,
+                                 &tss::ExtendedOrbitDeterminationManager<double, double>::getObservationSimulators,
                                  get_docstring("Estimator.observation_simulators").c_str() )
           .def_property_readonly("observation_managers",
-                                 &tss::OrbitDeterminationManager<double, double>::getObservationManagers,
+                                 &tss::ExtendedOrbitDeterminationManager<double, double>::getObservationManagers,
                                  get_docstring("Estimator.observation_managers").c_str() )
           .def_property_readonly("state_transition_interface",
-                                 &tss::OrbitDeterminationManager<double, double>::getStateTransitionAndSensitivityMatrixInterface,
+                                 &tss::ExtendedOrbitDeterminationManager<double, double>::getStateTransitionAndSensitivityMatrixInterface,
                                  get_docstring("Estimator.state_transition_interface").c_str() )
           .def("perform_estimation",
-               &tss::OrbitDeterminationManager<double, double>::estimateParameters,
+               &tss::ExtendedOrbitDeterminationManager<double, double>::performEstimation,
                py::arg( "estimation_input" ),
                py::arg( "convergence_checker" ) = std::make_shared< tss::EstimationConvergenceChecker >( ),
+               py::call_guard< py::gil_scoped_release >( ),
                get_docstring("Estimator.perform_estimation").c_str() )
+          .def("compute_residuals_and_design_matrix",
+               &tss::ExtendedOrbitDeterminationManager<double, double>::computeResidualsAndDesignMatrix,
+               py::arg( "observations" ),
+               py::arg( "number_of_threads" ) = 1,
+               py::arg( "observation_chunk_size" ) = 10000,
+               py::call_guard< py::gil_scoped_release >( ),
+               get_docstring("Estimator.compute_residuals_and_design_matrix").c_str() )
           .def_property_readonly("variational_solver",
-               &tss::OrbitDeterminationManager<double, double>::getVariationalEquationsSolver,
+               &tss::ExtendedOrbitDeterminationManager<double, double>::getVariationalEquationsSolver,
                                  get_docstring("Estimator.variational_solver").c_str() );
 };
 
@@ -11,6 +11,7 @@
 #include "expose_environment.h"
 
 #include "tudatpy/docstrings.h"
+#include "tudatpy/numerical_simulation/environment/cachedEphemeris.h"
 
 #include <tudat/astro/aerodynamics.h>
 #include <tudat/astro/ephemerides.h>
@@ -376,6 +377,33 @@ void expose_environment(py::module &m) {
                  py::arg("tle") = nullptr,
                  py::arg("use_sdp") = false);
 
+    py::class_<te::CachedEphemeris,
+            std::shared_ptr<te::CachedEphemeris>,
+            te::Ephemeris>(m, "CachedEphemeris", get_docstring("CachedEphemeris").c_str())
+            .def_property_readonly("original_ephemeris", &te::CachedEphemeris::getOriginalEphemeris,
+                                   get_docstring("CachedEphemeris.original_ephemeris").c_str())
+            .def_property_readonly("number_of_hits", &te::CachedEphemeris::getNumberOfHits,
+                                   get_docstring("CachedEphemeris.number_of_hits").c_str())
+            .def_property_readonly("number_of_misses", &te::CachedEphemeris::getNumberOfMisses,
+                                   get_docstring("CachedEphemeris.number_of_misses").c_str())
+            .def_property_readonly("hit_rate", &te::CachedEphemeris::getHitRate,
+                                   get_docstring("CachedEphemeris.hit_rate").c_str())
+            .def("clear", &te::CachedEphemeris::clearCache,
+                 get_docstring("CachedEphemeris.clear").c_str());
+
+    m.def("add_ephemeris_caches",
+          &tss::addEphemerisCaches,
+          py::arg("bodies"),
+          py::arg("body_names"),
+          py::arg("maximum_number_of_entries") = 1000000,
+          get_docstring("add_ephemeris_caches").c_str() );
+
+    m.def("remove_ephemeris_caches",
+          &tss::removeEphemerisCaches,
+          py::arg("bodies"),
+          py::arg("body_names"),
+          get_docstring("remove_ephemeris_caches").c_str() );
+
     /*!
      **************   ROTATION MODELS  ******************
      */
@@ -14,6 +14,8 @@
 #include <tudat/simulation/environment_setup.h>
 #include <tudat/astro/reference_frames/referenceFrameTransformations.h>
 
+#include "tudatpy/numerical_simulation/environment/cFunctionEnvironmentSettings.h"
+
 //#include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -88,6 +90,16 @@ namespace aerodynamic_coefficients {
               py::arg("are_coefficients_in_negative_axis_direction") = true,
               get_docstring("custom").c_str());
 
+        m.def("custom",
+              &tss::customAerodynamicCoefficientSettingsFromCFunction,
+              py::arg("force_coefficient_function"),
+              py::arg("reference_area"),
+              py::arg("independent_variable_names"),
+              py::arg("are_coefficients_in_aerodynamic_frame") = true,
+              py::arg("are_coefficients_in_negative_axis_direction") = true,
+              py::arg("user_data") = 0,
+              get_docstring("custom", 1).c_str());
+
         m.def("tabulated",
               py::overload_cast<
                       const std::vector<double>,
@@ -210,6 +222,15 @@ namespace aerodynamic_coefficients {
               py::arg("is_scaling_absolute") = false,
               get_docstring("scaled_by_vector_function").c_str());
 
+        m.def("scaled_by_vector_function",
+              &tss::scaledAerodynamicCoefficientSettingsFromCFunction,
+              py::arg("unscaled_coefficient_settings"),
+              py::arg("force_scaling_vector_function"),
+              py::arg("moment_scaling_vector_function"),
+              py::arg("is_scaling_absolute") = false,
+              py::arg("user_data") = 0,
+              get_docstring("scaled_by_vector_function", 1).c_str());
+
     }
 
 }// namespace aerodynamic_coefficients
@@ -14,6 +14,8 @@
 #include <tudat/simulation/environment_setup.h>
 #include <tudat/astro/reference_frames/referenceFrameTransformations.h>
 
+#include "tudatpy/numerical_simulation/environment/cFunctionEnvironmentSettings.h"
+
 //#include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -114,6 +116,15 @@ namespace atmosphere {
               py::arg("ratio_of_specific_heats") = 1.4,
               get_docstring("custom_four_dimensional_constant_temperature").c_str());
 
+        m.def("custom_four_dimensional_constant_temperature",
+              &tss::customConstantTemperatureAtmosphereSettingsFromCFunction,
+              py::arg("density_function"),
+              py::arg("constant_temperature"),
+              py::arg("specific_gas_constant") = tudat::physical_constants::SPECIFIC_GAS_CONSTANT_AIR,
+              py::arg("ratio_of_specific_heats") = 1.4,
+              py::arg("user_data") = 0,
+              get_docstring("custom_four_dimensional_constant_temperature", 1).c_str());
+
 
         m.def("scaled_by_function",
               py::overload_cast<const std::shared_ptr<tss::AtmosphereSettings>,
@@ -14,6 +14,8 @@
 #include <tudat/simulation/environment_setup.h>
 #include <tudat/astro/reference_frames/referenceFrameTransformations.h>
 
+#include "tudatpy/numerical_simulation/environment/cFunctionEnvironmentSettings.h"
+
 //#include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -293,12 +295,28 @@ namespace ephemeris {
               py::arg("is_scaling_absolute") = false,
               get_docstring("scaled_by_vector_function", 0).c_str());
 
+        m.def("scaled_by_vector_function",
+              &tss::scaledEphemerisSettingsFromCFunction,
+              py::arg("unscaled_ephemeris_settings"),
+              py::arg("scaling_vector_function"),
+              py::arg("is_scaling_absolute") = false,
+              py::arg("user_data") = 0,
+              get_docstring("scaled_by_vector_function", 1).c_str());
+
         m.def("custom",
               &tss::customEphemerisSettings,
               py::arg("custom_state_function"),
               py::arg("frame_origin") = "SSB",
               py::arg("frame_orientation") = "ECLIPJ2000",
               get_docstring("custom").c_str());
+
+        m.def("custom",
+              &tss::customEphemerisSettingsFromCFunction,
+              py::arg("custom_state_function"),
+              py::arg("frame_origin") = "SSB",
+              py::arg("frame_orientation") = "ECLIPJ2000",
+              py::arg("user_data") = 0,
+              get_docstring("custom", 1).c_str());
     }
 
 
@@ -13,6 +13,11 @@
 #include "tudat/astro/propagators/propagateCovariance.h"
 
 #include "tudatpy/docstrings.h"
+#include "tudatpy/numerical_simulation/estimation/batchedCovariancePropagation.h"
+#include "tudatpy/numerical_simulation/estimation/extendedPodInputOutput.h"
+#include "tudatpy/numerical_simulation/estimation/monteCarloCovarianceAnalysis.h"
+#include "tudatpy/numerical_simulation/estimation/observationCollectionArrays.h"
+#include "tudatpy/numerical_simulation/estimation/parallelObservationSimulation.h"
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -34,6 +39,65 @@ namespace tudatpy {
 namespace numerical_simulation {
 namespace estimation {
 
+//! Function to retrieve the state transition and sensitivity matrices at a list of epochs, as (epochs x rows x columns) array
+py::array_t< double > getCombinedStateTransitionAndSensitivityMatrixArray(
+        const std::shared_ptr< tp::CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        const bool useFullParameterVector )
+{
+    const std::pair< int, int > matrixSize = tp::getCombinedStateTransitionAndSensitivityMatrixSize(
+                stateTransitionInterface, useFullParameterVector );
+    py::array_t< double > matrixArray( std::vector< py::ssize_t >{
+                                           static_cast< py::ssize_t >( evaluationTimes.size( ) ),
+                                           matrixSize.first, matrixSize.second } );
+    double* matrixData = matrixArray.mutable_data( );
+    {
+        py::gil_scoped_release release;
+        tp::getCombinedStateTransitionAndSensitivityMatrices(
+                    stateTransitionInterface, evaluationTimes, useFullParameterVector, matrixData );
+    }
+    return matrixArray;
+}
+
+//! Function to propagate a covariance matrix to a list of epochs, as (epochs x states x states) array
+py::array_t< double > propagateCovarianceArray(
+        const Eigen::MatrixXd& initialCovariance,
+        const std::shared_ptr< tp::CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        const int numberOfThreads )
+{
+    const py::ssize_t numberOfStates = stateTransitionInterface->getStateTransitionMatrixSize( );
+    py::array_t< double > covarianceArray( std::vector< py::ssize_t >{
+                                               static_cast< py::ssize_t >( evaluationTimes.size( ) ),
+                                               numberOfStates, numberOfStates } );
+    double* covarianceData = covarianceArray.mutable_data( );
+    {
+        py::gil_scoped_release release;
+        tp::propagateCovarianceToArray(
+                    initialCovariance, stateTransitionInterface, evaluationTimes, covarianceData, numberOfThreads );
+    }
+    return covarianceArray;
+}
+
+//! Function to propagate the formal errors to a list of epochs, as (epochs x states) array
+py::array_t< double > propagateFormalErrorsArray(
+        const Eigen::MatrixXd& initialCovariance,
+        const std::shared_ptr< tp::CombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface,
+        const std::vector< double >& evaluationTimes,
+        const int numberOfThreads )
+{
+    const py::ssize_t numberOfStates = stateTransitionInterface->getStateTransitionMatrixSize( );
+    py::array_t< double > formalErrorArray( std::vector< py::ssize_t >{
+                                                static_cast< py::ssize_t >( evaluationTimes.size( ) ), numberOfStates } );
+    double* formalErrorData = formalErrorArray.mutable_data( );
+    {
+        py::gil_scoped_release release;
+        tp::propagateFormalErrorsToArray(
+                    initialCovariance, stateTransitionInterface, evaluationTimes, formalErrorData, numberOfThreads );
+    }
+    return formalErrorArray;
+}
+
 
 void expose_estimation(py::module &m) {
 
@@ -105,12 +169,22 @@ void expose_estimation(py::module &m) {
                                                           get_docstring("ObservationSimulator_6").c_str() );
 
     m.def("simulate_observations",
-          &tss::simulateObservations< >,
+          &tss::simulateObservationsWithTracing< >,
           py::arg("simulation_settings"),
           py::arg("observation_simulators" ),
           py::arg("bodies"),
           get_docstring("simulate_observations").c_str() );
 
+    m.def("simulate_observations_parallel",
+          &tss::simulateObservationsInParallel< >,
+          py::arg("simulation_settings"),
+          py::arg("observation_settings" ),
+          py::arg("bodies"),
+          py::arg("number_of_threads") = 0,
+          py::arg("epochs_per_chunk") = 1000,
+          py::call_guard< py::gil_scoped_release >( ),
+          get_docstring("simulate_observations_parallel").c_str() );
+
     m.def("compute_target_angles_and_range",
           &tss::getTargetAnglesAndRange,
           py::arg("bodies"),
@@ -126,8 +200,35 @@ void expose_estimation(py::module &m) {
                                                            get_docstring("ObservationCollection").c_str() )
             .def_property_readonly("concatenated_times", &tom::ObservationCollection<>::getConcatenatedTimeVector,
                                    get_docstring("ObservationCollection.concatenated_times").c_str() )
-            .def_property_readonly("concatenated_observations", &tom::ObservationCollection<>::getObservationVector,
-                                   get_docstring("ObservationCollection.concatenated_observations").c_str() );
+            .def_property_readonly("concatenated_observations", &tom::getConcatenatedObservationsReference,
+                                   get_docstring("ObservationCollection.concatenated_observations").c_str() )
+            .def_static("from_arrays", &tom::createObservationCollectionFromArrays,
+                        py::arg("observable_type"),
+                        py::arg("link_ends"),
+                        py::arg("times"),
+                        py::arg("values"),
+                        py::arg("reference_link_end") = tom::receiver,
+                        get_docstring("ObservationCollection.from_arrays").c_str() )
+            .def("observations", &tom::getObservationsReference,
+                 py::arg("observable_type"),
+                 py::arg("link_ends") = tom::LinkEnds( ),
+                 py::return_value_policy::reference_internal,
+                 get_docstring("ObservationCollection.observations").c_str() )
+            .def("observation_times", &tom::getObservationTimes,
+                 py::arg("observable_type"),
+                 py::arg("link_ends") = tom::LinkEnds( ),
+                 get_docstring("ObservationCollection.observation_times").c_str() )
+            .def("save", &tom::saveObservationCollectionToBinaryFile,
+                 py::arg("file_name"),
+                 get_docstring("ObservationCollection.save").c_str() )
+            .def_static("load", &tom::loadObservationCollectionFromBinaryFile,
+                        py::arg("file_name"),
+                        get_docstring("ObservationCollection.load").c_str() );
+
+    m.def("merge_observation_collections",
+          &tom::mergeObservationCollections,
+          py::arg("observation_collections"),
+          get_docstring("merge_observation_collections").c_str() );
 
     /*!
      *************** STATE TRANSITION INTERFACE ***************
@@ -148,6 +249,11 @@ void expose_estimation(py::module &m) {
                  getFullCombinedStateTransitionAndSensitivityMatrix,
                  py::arg("time"),
                  get_docstring("CombinedStateTransitionAndSensitivityMatrixInterface.full_state_transition_sensitivity_at_epoch").c_str() )
+            .def("state_transition_sensitivity_at_epochs",
+                 &getCombinedStateTransitionAndSensitivityMatrixArray,
+                 py::arg("times"),
+                 py::arg("full_parameter_vector") = false,
+                 get_docstring("CombinedStateTransitionAndSensitivityMatrixInterface.state_transition_sensitivity_at_epochs").c_str() )
             .def_property_readonly(
                 "state_transition_size",
                 &tp::CombinedStateTransitionAndSensitivityMatrixInterface::getStateTransitionMatrixSize,
@@ -186,6 +292,22 @@ void expose_estimation(py::module &m) {
           py::arg("output_times"),
           get_docstring("propagate_formal_errors").c_str() );
 
+    m.def("propagate_covariance_array",
+          &propagateCovarianceArray,
+          py::arg("initial_covariance"),
+          py::arg("state_transition_interface"),
+          py::arg("output_times"),
+          py::arg("number_of_threads") = 0,
+          get_docstring("propagate_covariance_array").c_str() );
+
+    m.def("propagate_formal_errors_array",
+          &propagateFormalErrorsArray,
+          py::arg("initial_covariance"),
+          py::arg("state_transition_interface"),
+          py::arg("output_times"),
+          py::arg("number_of_threads") = 0,
+          get_docstring("propagate_formal_errors_array").c_str() );
+
 
 
     /*!
@@ -214,10 +336,16 @@ void expose_estimation(py::module &m) {
              py::arg("number_of_iterations_without_improvement") = 2,
              get_docstring("estimation_convergence_checker").c_str() );
 
+    py::enum_< tss::EstimationSolverTypes >(m, "EstimationSolverTypes",
+                                            get_docstring("EstimationSolverTypes").c_str() )
+            .value("normal_equations_solver", tss::EstimationSolverTypes::normal_equations_solver )
+            .value("householder_qr_solver", tss::EstimationSolverTypes::householder_qr_solver )
+            .value("square_root_information_filter_solver", tss::EstimationSolverTypes::square_root_information_filter_solver )
+            .export_values();
 
     py::class_<
-            tss::PodInput<double, double>,
-            std::shared_ptr<tss::PodInput<double, double>>>(m, "PodInput",
+            tss::ExtendedPodInput<double, double>,
+            std::shared_ptr<tss::ExtendedPodInput<double, double>>>(m, "PodInput",
                                                             get_docstring("PodInput").c_str() )
             .def(py::init<
                  const std::shared_ptr< tom::ObservationCollection< > >&,
@@ -230,66 +358,128 @@ void expose_estimation(py::module &m) {
                  py::arg( "apriori_parameter_correction" ) = Eigen::VectorXd( 0 ),
              get_docstring("PodInput.ctor").c_str() )
             .def( "set_constant_weight",
-                  &tss::PodInput<double, double>::setConstantWeightsMatrix,
+                  &tss::ExtendedPodInput<double, double>::setConstantWeightsMatrix,
                   py::arg( "weight" ),
                   get_docstring("PodInput.set_constant_weight").c_str() )
             .def( "set_constant_weight_per_observable",
-                  &tss::PodInput<double, double>::setConstantPerObservableWeightsMatrix,
+                  &tss::ExtendedPodInput<double, double>::setConstantPerObservableWeightsMatrix,
                   py::arg( "weight_per_observable" ),
                   get_docstring("PodInput.set_constant_weight_per_observable").c_str() )
 //            .def( "set_constant_weight_per_observable_and_link_end",
-//                  &tss::PodInput<double, double>::setConstantPerObservableAndLinkEndsWeights,
+//                  &tss::ExtendedPodInput<double, double>::setConstantPerObservableAndLinkEndsWeights,
 //                  py::arg( "weight_per_observable_and_link" ) )
             .def( "define_estimation_settings",
-                  &tss::PodInput<double, double>::defineEstimationSettings,
+                  &tss::ExtendedPodInput<double, double>::defineEstimationSettings,
                   py::arg( "reintegrate_equations_on_first_iteration" ) = true,
                   py::arg( "reintegrate_variational_equations" ) = true,
                   py::arg( "save_design_matrix" ) = true,
                   py::arg( "print_output_to_terminal" ) = true,
                   py::arg( "save_residuals_and_parameters_per_iteration" ) = true,
                   py::arg( "save_state_history_per_iteration" ) = false,
-                  get_docstring("PodInput.define_estimation_settings").c_str() );
+                  py::arg( "number_of_threads" ) = 1,
+                  py::arg( "observation_chunk_size" ) = 10000,
+                  py::arg( "linear_update_threshold" ) = 0.0,
+                  get_docstring("PodInput.define_estimation_settings").c_str() )
+            .def_property( "solver_type",
+                           &tss::ExtendedPodInput<double, double>::getSolverType,
+                           &tss::ExtendedPodInput<double, double>::setSolverType,
+                           get_docstring("PodInput.solver_type").c_str() );
 
     py::class_<
-            tss::PodOutput<double, double>,
-            std::shared_ptr<tss::PodOutput<double, double>>>(m, "PodOutput",
+            tss::ExtendedPodOutput<double, double>,
+            std::shared_ptr<tss::ExtendedPodOutput<double, double>>>(m, "PodOutput",
                                                              get_docstring("PodOutput").c_str() )
             .def_property_readonly("inverse_covariance",
-                                   &tss::PodOutput<double, double>::getUnnormalizedInverseCovarianceMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getUnnormalizedInverseCovarianceMatrix,
                                    get_docstring("PodOutput.inverse_covariance").c_str() )
             .def_property_readonly("covariance",
-                                   &tss::PodOutput<double, double>::getUnnormalizedCovarianceMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getUnnormalizedCovarianceMatrix,
                                    get_docstring("PodOutput.covariance").c_str() )
             .def_property_readonly("formal_errors",
-                                   &tss::PodOutput<double, double>::getFormalErrorVector,
+                                   &tss::ExtendedPodOutput<double, double>::getFormalErrorVector,
                                    get_docstring("PodOutput.formal_errors").c_str() )
             .def_property_readonly("correlations",
-                                   &tss::PodOutput<double, double>::getCorrelationMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getCorrelationMatrix,
                                    get_docstring("PodOutput.correlations").c_str() )
             .def_property_readonly("residual_history",
-                                   &tss::PodOutput<double, double>::getResidualHistoryMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getResidualHistoryMatrix,
                                    get_docstring("PodOutput.residual_history").c_str() )
             .def_property_readonly("parameter_history",
-                                   &tss::PodOutput<double, double>::getParameterHistoryMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getParameterHistoryMatrix,
                                    get_docstring("PodOutput.parameter_history").c_str() )
             .def_property_readonly("design_matrix",
-                                   &tss::PodOutput<double, double>::getUnnormalizedInformationMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getUnnormalizedInformationMatrix,
                                    get_docstring("PodOutput.design_matrix").c_str() )
             .def_property_readonly("normalized_design_matrix",
-                                   &tss::PodOutput<double, double>::getNormalizedInformationMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getNormalizedInformationMatrixReference,
                                    get_docstring("PodOutput.normalized_design_matrix").c_str() )
             .def_property_readonly("weighted_design_matrix",
-                                   &tss::PodOutput<double, double>::getUnnormalizedWeightedInformationMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getUnnormalizedWeightedInformationMatrix,
                                    get_docstring("PodOutput.weighted_design_matrix").c_str() )
             .def_property_readonly("weighted_normalized_design_matrix",
-                                   &tss::PodOutput<double, double>::getNormalizedWeightedInformationMatrix,
+                                   &tss::ExtendedPodOutput<double, double>::getNormalizedWeightedInformationMatrix,
                                    get_docstring("PodOutput.weighted_normalized_design_matrix").c_str() )
             .def_readonly("normalization_terms",
-                                   &tss::PodOutput<double, double>::informationMatrixTransformationDiagonal_,
+                                   &tss::ExtendedPodOutput<double, double>::informationMatrixTransformationDiagonal_,
                                    get_docstring("PodOutput.normalization_terms").c_str() )
             .def_readonly("final_residuals",
-                                   &tss::PodOutput<double, double>::residuals_,
-                                   get_docstring("PodOutput.final_residuals").c_str() );
+                                   &tss::ExtendedPodOutput<double, double>::residuals_,
+                                   get_docstring("PodOutput.final_residuals").c_str() )
+            .def_property_readonly("computation_time_per_phase",
+                                   &tss::ExtendedPodOutput<double, double>::getComputationTimePerPhase,
+                                   get_docstring("PodOutput.computation_time_per_phase").c_str() )
+            .def_property_readonly("number_of_propagations",
+                                   &tss::ExtendedPodOutput<double, double>::getNumberOfPropagations,
+                                   get_docstring("PodOutput.number_of_propagations").c_str() )
+            .def_property_readonly("number_of_linear_updates",
+                                   &tss::ExtendedPodOutput<double, double>::getNumberOfLinearUpdates,
+                                   get_docstring("PodOutput.number_of_linear_updates").c_str() );
+
+    py::class_<
+            tss::MonteCarloCovarianceAnalysis<double, double>,
+            std::shared_ptr<tss::MonteCarloCovarianceAnalysis<double, double>>>(m, "MonteCarloCovarianceAnalysis",
+                                                                               get_docstring("MonteCarloCovarianceAnalysis").c_str() )
+            .def(py::init<
+                 const std::shared_ptr< tss::ExtendedOrbitDeterminationManager< double, double > >,
+                 const std::shared_ptr< tss::ExtendedPodInput< double, double > >,
+                 const int >( ),
+                 py::arg("estimator"),
+                 py::arg("estimation_input"),
+                 py::arg("number_of_threads") = 1,
+                 py::call_guard< py::gil_scoped_release >( ),
+                 get_docstring("MonteCarloCovarianceAnalysis.ctor").c_str() )
+            .def("run_samples",
+                 &tss::MonteCarloCovarianceAnalysis<double, double>::runSamples,
+                 py::arg("number_of_samples"),
+                 py::arg("seed"),
+                 py::arg("perturb_apriori_values") = false,
+                 py::arg("observation_bias_standard_deviation") = 0.0,
+                 py::call_guard< py::gil_scoped_release >( ),
+                 get_docstring("MonteCarloCovarianceAnalysis.run_samples").c_str() )
+            .def("reset_statistics",
+                 &tss::MonteCarloCovarianceAnalysis<double, double>::resetStatistics,
+                 get_docstring("MonteCarloCovarianceAnalysis.reset_statistics").c_str() )
+            .def_property_readonly("number_of_samples",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getNumberOfSamples,
+                                   get_docstring("MonteCarloCovarianceAnalysis.number_of_samples").c_str() )
+            .def_property_readonly("mean_estimation_error",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getMeanEstimationError,
+                                   get_docstring("MonteCarloCovarianceAnalysis.mean_estimation_error").c_str() )
+            .def_property_readonly("estimation_error_covariance",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getEstimationErrorCovariance,
+                                   get_docstring("MonteCarloCovarianceAnalysis.estimation_error_covariance").c_str() )
+            .def_property_readonly("formal_covariance",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getFormalCovariance,
+                                   get_docstring("MonteCarloCovarianceAnalysis.formal_covariance").c_str() )
+            .def_property_readonly("mean_residual_rms",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getMeanResidualRms,
+                                   get_docstring("MonteCarloCovarianceAnalysis.mean_residual_rms").c_str() )
+            .def_property_readonly("residual_rms_standard_deviation",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getResidualRmsStandardDeviation,
+                                   get_docstring("MonteCarloCovarianceAnalysis.residual_rms_standard_deviation").c_str() )
+            .def_property_readonly("design_matrix",
+                                   &tss::MonteCarloCovarianceAnalysis<double, double>::getDesignMatrix,
+                                   get_docstring("MonteCarloCovarianceAnalysis.design_matrix").c_str() );
 
 
 
@@ -15,6 +15,8 @@
 #include "tudat/simulation/estimation_setup/observationSimulationSettings.h"
 
 #include "tudatpy/docstrings.h"
+#include "tudatpy/numerical_simulation/estimation/observationNoiseModels.h"
+#include "tudatpy/numerical_simulation/estimation/visibilityWindows.h"
 
 namespace tss = tudat::simulation_setup;
 namespace tom = tudat::observation_models;
@@ -357,6 +359,17 @@ void expose_observation_setup(py::module &m) {
           py::arg("occulting_body" ),
           get_docstring("body_occultation_viability_list").c_str() );
 
+    m.def("compute_visibility_windows",
+          &tss::computeVisibilityWindowsForLinks,
+          py::arg("link_ends_list"),
+          py::arg("viability_settings"),
+          py::arg("bodies"),
+          py::arg("start_time"),
+          py::arg("end_time"),
+          py::arg("grid_step"),
+          py::arg("root_finder_settings") = nullptr,
+          get_docstring("compute_visibility_windows").c_str() );
+
 
     py::class_<tss::ObservationSimulationSettings<double>,
                std::shared_ptr<tss::ObservationSimulationSettings<double>>>(m, "ObservationSimulationSettings",
@@ -388,6 +401,18 @@ void expose_observation_setup(py::module &m) {
           get_docstring("tabulated_simulation_settings_list").c_str() );
 
 
+    m.def("tabulated_simulation_settings_in_windows",
+          &tss::createTabulatedObservationSimulationSettingsInWindows,
+          py::arg("observable_type"),
+          py::arg("link_ends_list"),
+          py::arg("visibility_windows"),
+          py::arg("sampling_interval"),
+          py::arg("reference_epoch") = 0.0,
+          py::arg("reference_link_end_type") = tom::receiver,
+          py::arg("viability_settings") = std::vector< std::shared_ptr< tom::ObservationViabilitySettings > >( ),
+          get_docstring("tabulated_simulation_settings_in_windows").c_str() );
+
+
     m.def("add_gaussian_noise_to_settings",
           py::overload_cast<
           const std::vector< std::shared_ptr< tss::ObservationSimulationSettings< double > > >&,
@@ -400,6 +425,55 @@ void expose_observation_setup(py::module &m) {
             get_docstring("add_gaussian_noise_to_settings").c_str() );
 
 
+    py::enum_< tss::ObservationNoiseModelTypes >(m, "ObservationNoiseModelTypes",
+                                                 get_docstring("ObservationNoiseModelTypes").c_str() )
+            .value("gaussian_observation_noise", tss::ObservationNoiseModelTypes::gaussian_observation_noise )
+            .value("uniform_observation_noise", tss::ObservationNoiseModelTypes::uniform_observation_noise )
+            .value("first_order_autoregressive_observation_noise", tss::ObservationNoiseModelTypes::first_order_autoregressive_observation_noise )
+            .value("bias_drift_observation_noise", tss::ObservationNoiseModelTypes::bias_drift_observation_noise )
+            .export_values();
+
+    py::class_<tss::ObservationNoiseModelSettings,
+            std::shared_ptr<tss::ObservationNoiseModelSettings>>(
+                m, "ObservationNoiseModelSettings",
+                get_docstring("ObservationNoiseModelSettings").c_str() );
+
+    m.def("gaussian_noise",
+          &tss::gaussianObservationNoise,
+          py::arg("standard_deviation"),
+          py::arg("mean") = 0.0,
+          py::arg("seed") = 0,
+          get_docstring("gaussian_noise").c_str() );
+
+    m.def("uniform_noise",
+          &tss::uniformObservationNoise,
+          py::arg("lower_bound"),
+          py::arg("upper_bound"),
+          py::arg("seed") = 0,
+          get_docstring("uniform_noise").c_str() );
+
+    m.def("autoregressive_noise",
+          &tss::autoregressiveObservationNoise,
+          py::arg("standard_deviation"),
+          py::arg("correlation_time"),
+          py::arg("seed") = 0,
+          get_docstring("autoregressive_noise").c_str() );
+
+    m.def("bias_drift_noise",
+          &tss::biasDriftObservationNoise,
+          py::arg("bias_standard_deviation"),
+          py::arg("drift_standard_deviation"),
+          py::arg("reference_epoch") = 0.0,
+          py::arg("seed") = 0,
+          get_docstring("bias_drift_noise").c_str() );
+
+    m.def("add_noise_models_to_settings",
+          &tss::addNoiseModelsToObservationSimulationSettings,
+          py::arg("observation_simulation_settings"),
+          py::arg("noise_model_settings"),
+          get_docstring("add_noise_models_to_settings").c_str() );
+
+
     m.def("add_viability_check_to_settings",
           py::overload_cast<
           const std::vector< std::shared_ptr< tss::ObservationSimulationSettings< double > > >&,
@@ -14,6 +14,12 @@
 #include <tudat/astro/basic_astro.h>
 #include <tudat/astro/propagators.h>
 
+#include "tudatpy/numerical_simulation/propagation/deferredDependentVariables.h"
+#include "tudatpy/numerical_simulation/propagation/denseOutputPropagation.h"
+#include "tudatpy/numerical_simulation/propagation/ensemblePropagation.h"
+#include "tudatpy/numerical_simulation/propagation/expressionConditions.h"
+#include "tudatpy/numerical_simulation/propagation/stateDerivativeProfiling.h"
+
 
 #include "expose_propagation.h"
 
@@ -61,6 +67,48 @@ namespace tudatpy {
 namespace numerical_simulation {
 namespace propagation {
 
+//! Function to propagate an ensemble of particles, returning their states as (particles x output epochs x 6) array
+/*!
+ *  Function to propagate an ensemble of particles, returning their states as (particles x output epochs x 6) array.
+ *  The function is called with the GIL released: the propagation writes to a native buffer, and the GIL is only
+ *  re-acquired to create the returned array.
+ */
+py::array_t< double > propagateEnsembleArray(
+        const tss::SystemOfBodies& bodies,
+        const std::string& centralBody,
+        const Eigen::MatrixXd& initialStates,
+        const double initialTime,
+        const std::vector< double >& outputEpochs,
+        const double initialTimeStep,
+        const double minimumStepSize,
+        const double maximumStepSize,
+        const double relativeErrorTolerance,
+        const double absoluteErrorTolerance,
+        const bool includeJ2,
+        const std::vector< std::string >& thirdBodies,
+        const Eigen::VectorXd& ballisticCoefficients,
+        const double referenceDensity,
+        const double referenceAltitude,
+        const double scaleHeight,
+        const tp::EnsembleStepSizeControl stepSizeControl,
+        const int numberOfThreads )
+{
+    std::shared_ptr< tp::EnsembleStateDerivative > stateDerivative = tp::createEnsembleStateDerivative(
+                bodies, centralBody, initialStates.rows( ), includeJ2, thirdBodies, ballisticCoefficients,
+                referenceDensity, referenceAltitude, scaleHeight );
+    std::vector< double > states( initialStates.rows( ) * outputEpochs.size( ) * 6 );
+    tp::propagateEnsemble( stateDerivative, initialStates, initialTime, outputEpochs, initialTimeStep,
+                           minimumStepSize, maximumStepSize, relativeErrorTolerance, absoluteErrorTolerance,
+                           stepSizeControl, states.data( ), numberOfThreads );
+
+    py::gil_scoped_acquire acquire;
+    py::array_t< double > stateArray( std::vector< py::ssize_t >{
+                                          static_cast< py::ssize_t >( initialStates.rows( ) ),
+                                          static_cast< py::ssize_t >( outputEpochs.size( ) ), 6 } );
+    std::copy( states.begin( ), states.end( ), stateArray.mutable_data( ) );
+    return stateArray;
+}
+
 
 void expose_propagation(py::module &m) {
 
@@ -74,6 +122,21 @@ void expose_propagation(py::module &m) {
             .def_readwrite("bank_angle", &ta::PyAerodynamicGuidance::currentBankAngle_)
             .def_readwrite("sideslip_angle", &ta::PyAerodynamicGuidance::currentAngleOfSideslip_);
 
+    py::class_<ta::ExpressionAerodynamicGuidance,
+            std::shared_ptr< ta::ExpressionAerodynamicGuidance >,
+            ta::AerodynamicGuidance >(m, "ExpressionAerodynamicGuidance",
+                                      get_docstring("ExpressionAerodynamicGuidance").c_str());
+
+    m.def("expression_aerodynamic_guidance",
+          &ta::expressionAerodynamicGuidance,
+          py::arg("bodies"),
+          py::arg("angle_of_attack") = "",
+          py::arg("bank_angle") = "",
+          py::arg("sideslip_angle") = "",
+          py::arg("variables") = std::map<std::string, std::shared_ptr<tp::SingleDependentVariableSaveSettings>>(),
+          py::arg("tables") = std::map<std::string, std::pair<std::vector<double>, std::vector<double>>>(),
+          get_docstring("expression_aerodynamic_guidance").c_str());
+
 
 
     py::class_<
@@ -141,13 +204,18 @@ void expose_propagation(py::module &m) {
           py::arg("initial_time"));
 
     m.def("get_zero_proper_mode_rotational_state",
-          py::overload_cast<
-          const tss::SystemOfBodies&,
-          const std::shared_ptr< tni::IntegratorSettings< double > >,
-          const std::shared_ptr< tp::SingleArcPropagatorSettings< double > >,
-          const double,
-          const std::vector< double >,
-          const bool >( &tp::getZeroProperModeRotationalState< > ),
+          [](const tss::SystemOfBodies& bodies,
+             const std::shared_ptr< tni::IntegratorSettings< double > > integratorSettings,
+             const std::shared_ptr< tp::SingleArcPropagatorSettings< double > > propagatorSettings,
+             const double bodyMeanRotationalRate,
+             const std::vector< double > dissipationTimes,
+             const bool propagateUndamped)
+          {
+              tni::checkIntegratorSettingsWithoutDenseOutput(integratorSettings, "zero proper mode rotational state");
+              return tp::getZeroProperModeRotationalState< >(
+                          bodies, integratorSettings, propagatorSettings, bodyMeanRotationalRate, dissipationTimes,
+                          propagateUndamped);
+          },
           py::arg("bodies"),
           py::arg("integrator_settings"),
           py::arg("propagator_settings"),
@@ -160,6 +228,70 @@ void expose_propagation(py::module &m) {
           py::arg("propagator_settings_per_type"),
           get_docstring("combine_initial_states").c_str());
 
+    m.def("compute_deferred_dependent_variables",
+          &tp::computeDeferredDependentVariables<double>,
+          py::arg("dynamics_simulator"),
+          py::arg("bodies"),
+          py::arg("dependent_variables"),
+          py::arg("evaluation_epochs") = std::vector<double>(),
+          py::arg("evaluation_stride") = 1,
+          get_docstring("compute_deferred_dependent_variables").c_str());
+
+    py::enum_<tp::EnsembleStepSizeControl>(m, "EnsembleStepSizeControl",
+                                           get_docstring("EnsembleStepSizeControl").c_str())
+            .value("common_ensemble_step_size", tp::EnsembleStepSizeControl::common_ensemble_step_size)
+            .value("per_particle_step_size", tp::EnsembleStepSizeControl::per_particle_step_size)
+            .export_values();
+
+    m.def("propagate_ensemble",
+          &propagateEnsembleArray,
+          py::arg("bodies"),
+          py::arg("central_body"),
+          py::arg("initial_states"),
+          py::arg("initial_time"),
+          py::arg("output_epochs"),
+          py::arg("initial_time_step"),
+          py::arg("minimum_step_size"),
+          py::arg("maximum_step_size"),
+          py::arg("relative_error_tolerance"),
+          py::arg("absolute_error_tolerance"),
+          py::arg("include_j2") = true,
+          py::arg("third_bodies") = std::vector<std::string>(),
+          py::arg("ballistic_coefficients") = Eigen::VectorXd(),
+          py::arg("reference_density") = 0.0,
+          py::arg("reference_altitude") = 0.0,
+          py::arg("scale_height") = 0.0,
+          py::arg("step_size_control") = tp::common_ensemble_step_size,
+          py::arg("number_of_threads") = 0,
+          py::call_guard< py::gil_scoped_release >( ),
+          get_docstring("propagate_ensemble").c_str());
+
+    py::class_<tp::StateDerivativeProfileEntry>(m, "StateDerivativeProfileEntry",
+                                                get_docstring("StateDerivativeProfileEntry").c_str())
+            .def_property_readonly("category", &tp::StateDerivativeProfileEntry::getCategory,
+                                   get_docstring("StateDerivativeProfileEntry.category").c_str())
+            .def_property_readonly("name", &tp::StateDerivativeProfileEntry::getName,
+                                   get_docstring("StateDerivativeProfileEntry.name").c_str())
+            .def_property_readonly("number_of_calls", &tp::StateDerivativeProfileEntry::getNumberOfCalls,
+                                   get_docstring("StateDerivativeProfileEntry.number_of_calls").c_str())
+            .def_property_readonly("total_time", &tp::StateDerivativeProfileEntry::getTotalTime,
+                                   get_docstring("StateDerivativeProfileEntry.total_time").c_str())
+            .def_property_readonly("mean_time", &tp::StateDerivativeProfileEntry::getMeanTime,
+                                   get_docstring("StateDerivativeProfileEntry.mean_time").c_str());
+
+    py::class_<tp::StateDerivativeProfile>(m, "StateDerivativeProfile",
+                                           get_docstring("StateDerivativeProfile").c_str())
+            .def_property_readonly("entries", &tp::StateDerivativeProfile::getEntries,
+                                   get_docstring("StateDerivativeProfile.entries").c_str())
+            .def_property_readonly("number_of_function_evaluations",
+                                   &tp::StateDerivativeProfile::getNumberOfFunctionEvaluations,
+                                   get_docstring("StateDerivativeProfile.number_of_function_evaluations").c_str())
+            .def_property_readonly("number_of_steps", &tp::StateDerivativeProfile::getNumberOfSteps,
+                                   get_docstring("StateDerivativeProfile.number_of_steps").c_str())
+            .def("report", &tp::StateDerivativeProfile::getReport,
+                 get_docstring("StateDerivativeProfile.report").c_str())
+            .def("__str__", &tp::StateDerivativeProfile::getReport);
+
     py::class_<
             tba::AccelerationModel<Eigen::Vector3d>,
             std::shared_ptr<tba::AccelerationModel<Eigen::Vector3d>>>(m, "AccelerationModel");
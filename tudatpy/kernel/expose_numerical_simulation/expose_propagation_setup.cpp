@@ -20,6 +20,8 @@
 #include "expose_propagation_setup/expose_propagator_setup.h"
 #include "expose_propagation_setup/expose_mass_rate_setup.h"
 
+#include "tudatpy/plugins/modelPluginLoader.h"
+
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -65,6 +67,15 @@ void expose_propagation_setup(py::module &m) {
     auto dependent_variable_setup = m.def_submodule("dependent_variable");
     dependent_variable::expose_dependent_variable_setup(dependent_variable_setup);
 
+    m.def("load_model_plugin",
+          &tudat::plugins::loadModelPlugin,
+          py::arg("library_path"),
+          get_docstring("load_model_plugin").c_str());
+
+    m.def("get_registered_plugin_models",
+          &tudat::plugins::getRegisteredPluginModels,
+          get_docstring("get_registered_plugin_models").c_str());
+
     m.def("create_acceleration_models",
           py::overload_cast<const tss::SystemOfBodies &,
                   const tss::SelectedAccelerationMap &,
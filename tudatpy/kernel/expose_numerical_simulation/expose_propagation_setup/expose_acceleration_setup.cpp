@@ -13,6 +13,9 @@
 #include "tudatpy/docstrings.h"
 #include <tudat/simulation/propagation_setup.h>
 
+#include "tudatpy/numerical_simulation/propagation/cFunctionPropagationSettings.h"
+#include "tudatpy/numerical_simulation/propagation/pluginModelSettings.h"
+
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -212,6 +215,21 @@ void expose_acceleration_setup(py::module &m) {
           py::arg( "acceleration_function" ),
           get_docstring("custom").c_str());
 
+    m.def("custom",
+          &tss::customAccelerationSettingsFromCFunction,
+          py::arg( "acceleration_function" ),
+          py::arg( "user_data" ) = 0,
+          get_docstring("custom", 1).c_str());
+
+    m.def("plugin",
+          &tss::pluginAccelerationSettings,
+          py::arg( "bodies" ),
+          py::arg( "model_name" ),
+          py::arg( "body_undergoing_acceleration" ),
+          py::arg( "body_exerting_acceleration" ),
+          py::arg( "model_parameters" ) = std::vector< double >( ),
+          get_docstring("plugin").c_str());
+
     m.def("direct_tidal_dissipation_acceleration", &tss::directTidalDissipationAcceleration,
           py::arg("k2_love_number"),
           py::arg("time_lag"),
@@ -11,6 +11,7 @@
 #include "expose_integrator_setup.h"
 
 #include "tudatpy/docstrings.h"
+#include "tudatpy/numerical_simulation/propagation/denseOutputPropagation.h"
 #include <tudat/simulation/propagation_setup.h>
 
 #include <pybind11/chrono.h>
@@ -108,6 +109,12 @@ namespace integrator {
                                                                          "RungeKuttaVariableStepSizeSettingsScalarTolerances",
                                                                          get_docstring("RungeKuttaVariableStepSizeSettingsScalarTolerances").c_str());
 
+            py::class_<tni::DenseOutputIntegratorSettings<double>,
+                    std::shared_ptr<tni::DenseOutputIntegratorSettings<double>>,
+                    tni::IntegratorSettings<double>>(m, "DenseOutputIntegratorSettings",
+                                                     get_docstring("DenseOutputIntegratorSettings").c_str())
+                    .def_readwrite("output_epochs", &tni::DenseOutputIntegratorSettings<double>::outputEpochs_);
+
             py::class_<tni::BulirschStoerIntegratorSettings<double>,
                     std::shared_ptr<tni::BulirschStoerIntegratorSettings<double>>,
                     tni::IntegratorSettings<double>>(m, "BulirschStoerIntegratorSettings",
@@ -171,6 +178,23 @@ namespace integrator {
                   py::arg("throw_exception_if_minimum_step_exceeded") = true,
                   get_docstring("runge_kutta_variable_step_size_vector_tolerances").c_str());
 
+            m.def("runge_kutta_dense_output",
+                  &tni::denseOutputRungeKuttaSettings<double>,
+                  py::arg("initial_time"),
+                  py::arg("initial_time_step"),
+                  py::arg("output_epochs"),
+                  py::arg("minimum_step_size"),
+                  py::arg("maximum_step_size"),
+                  py::arg("relative_error_tolerance"),
+                  py::arg("absolute_error_tolerance"),
+                  py::arg("safety_factor") = 0.8,
+                  py::arg("maximum_factor_increase") = 4.0,
+                  py::arg("minimum_factor_increase") = 0.1,
+                  py::arg("throw_exception_if_minimum_step_exceeded") = true,
+                  py::arg("checkpoint_file_path") = "",
+                  py::arg("checkpoint_interval") = 600.0,
+                  get_docstring("runge_kutta_dense_output").c_str());
+
             m.def("bulirsch_stoer",
                   &tni::bulirschStoerIntegratorSettings<double>,
                   py::arg("initial_time"),
@@ -15,6 +15,8 @@
 #include <tudat/simulation/propagation_setup.h>
 #include <tudat/astro/propagators/getZeroProperModeRotationalInitialState.h>
 
+#include "tudatpy/numerical_simulation/propagation/expressionConditions.h"
+
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -407,6 +409,16 @@ void expose_propagator_setup(py::module &m) {
                                                 get_docstring(
                                                     "PropagationHybridTerminationSettings").c_str());
 
+    py::class_<
+            tp::PropagationExpressionTerminationSettings,
+            std::shared_ptr<tp::PropagationExpressionTerminationSettings>,
+            tp::PropagationCustomTerminationSettings>(m, "PropagationExpressionTerminationSettings",
+                                                      get_docstring(
+                                                          "PropagationExpressionTerminationSettings").c_str())
+            .def_property_readonly("condition",
+                                   &tp::PropagationExpressionTerminationSettings::getCondition,
+                                   get_docstring("PropagationExpressionTerminationSettings.condition").c_str());
+
     //                .def(py::init<
     //                             const std::shared_ptr<tp::SingleDependentVariableSaveSettings>,
     //                             const double,
@@ -450,6 +462,14 @@ void expose_propagator_setup(py::module &m) {
           py::arg("fulfill_single_condition"),
           get_docstring("hybrid_termination").c_str());
 
+    m.def("expression_termination",
+          &tp::propagationExpressionTerminationSettings,
+          py::arg("bodies"),
+          py::arg("condition"),
+          py::arg("variables"),
+          py::arg("tables") = std::map<std::string, std::pair<std::vector<double>, std::vector<double>>>(),
+          get_docstring("expression_termination").c_str());
+
 }
 
 }// namespace propagator
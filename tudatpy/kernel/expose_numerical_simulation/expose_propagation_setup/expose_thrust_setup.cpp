@@ -13,6 +13,8 @@
 #include "tudatpy/docstrings.h"
 #include <tudat/simulation/propagation_setup.h>
 
+#include "tudatpy/numerical_simulation/propagation/cFunctionPropagationSettings.h"
+
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -293,6 +295,13 @@ void expose_thrust_setup(py::module &m) {
           py::arg("custom_thrust_reset_function" ) = std::function< void( const double ) >( ),
           get_docstring("custom_thrust_magnitude").c_str());
 
+    m.def("custom_thrust_magnitude", &tss::fromCFunctionThrustMagnitudeSettings,
+          py::arg("thrust_magnitude_function"),
+          py::arg("specific_impulse_function"),
+          py::arg("body_fixed_thrust_direction" ) = Eigen::Vector3d::UnitX( ),
+          py::arg("user_data") = 0,
+          get_docstring("custom_thrust_magnitude", 1).c_str());
+
     // TODO: EngineModel still to be implemented
 //    m.def("from_body_thrust_magnitude", &tss::fromBodyThrustMagnitudeSettings,
 //          py::arg("use_all_engines") = false,
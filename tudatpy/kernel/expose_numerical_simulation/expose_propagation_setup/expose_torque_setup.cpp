@@ -13,6 +13,8 @@
 #include "tudatpy/docstrings.h"
 #include <tudat/simulation/propagation_setup.h>
 
+#include "tudatpy/numerical_simulation/propagation/pluginModelSettings.h"
+
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
@@ -85,6 +87,14 @@ namespace torque {
               py::arg("scaling_function") = nullptr,
               get_docstring("custom").c_str());
 
+        m.def("plugin", &tss::pluginTorqueSettings,
+              py::arg("bodies"),
+              py::arg("model_name"),
+              py::arg("body_undergoing_torque"),
+              py::arg("body_exerting_torque"),
+              py::arg("model_parameters") = std::vector< double >( ),
+              get_docstring("plugin").c_str());
+
 
         // NOTE: the only unexposed torque model is dissipativeTorque, but it is probably obsolete
     }
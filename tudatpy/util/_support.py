@@ -1,5 +1,5 @@
 import numpy as np
-from ..kernel.math import interpolators
+from ..kernel.math import interpolators, pareto
 import os
 from typing import List, Dict, Union
 
@@ -223,16 +223,13 @@ def pareto_optimums(points: list, operator:Union[None,List[Union[min,max]]]=None
         # Show the plot
         plt.show()
     """
-    points = np.asarray(points)
+    points = np.asarray(points, dtype=float)
     if operator is None:
-        sign = np.ones(points.shape[1])
+        maximize_objective = []
     else:
         if len(operator) != points.shape[1]:
             raise IndexError("The length of the sign argument does not correspond with the number of points.")
-        sign = np.asarray([1 if o == min else -1 for o in operator])
-    points = np.asarray([p*sign for p in points])
-    pareto_optimal = np.ones(points.shape[0], dtype=bool)
-    for i, c in enumerate(points):
-        if pareto_optimal[i]:
-            pareto_optimal[pareto_optimal] = np.any(points[pareto_optimal]<=c, axis=1)
-    return pareto_optimal
\ No newline at end of file
+        maximize_objective = [o == max for o in operator]
+    # The non-dominated sorting is done natively, points of rank 0 form the Pareto front
+    ranks = pareto.non_dominated_sorting_ranks(points, maximize_objective)
+    return ranks == 0
\ No newline at end of file